@@ -0,0 +1,87 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+
+#include <string>
+
+#include "tclap/CmdLine.h"
+
+#include <nomlib/config.hpp>
+#include <nomlib/version.hpp>
+#include <nomlib/serializers.hpp>
+
+/// Name of our application.
+const std::string APP_NAME = "json2bin";
+
+// Precompile a JSON asset for nom::BinaryDeserializer
+//
+// ./json2bin Resources/tests/serializers/json/inventory.json inventory.bin
+nom::int32 main ( nom::int32 argc, char* argv[] )
+{
+  using namespace TCLAP;
+
+  std::string json_filename;
+  std::string filename;
+
+  try
+  {
+    CmdLine cmd( APP_NAME, ' ', nom::NOM_VERSION.version_string() );
+
+    // NOTE: These must always be added to the command parser in the order
+    // that they are given
+    UnlabeledValueArg<std::string> input_arg( "input", "The JSON file to read",
+                                              true, "", "<input>.json", cmd );
+
+    UnlabeledValueArg<std::string> output_arg( "output",
+                                               "The binary file to write", true,
+                                               "", "<output>.bin", cmd );
+
+    cmd.parse(argc, argv);
+
+    json_filename = input_arg.getValue();
+    filename = output_arg.getValue();
+  }
+  catch( TCLAP::ArgException &e )
+  {
+    NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
+                  e.error(), "for arg", e.argId() );
+
+    return NOM_EXIT_FAILURE;
+  }
+
+  // NOTE: nom::init is not called, as it changes the working directory that
+  // relative file paths are resolved against
+  if( nom::convert_json_to_binary(json_filename, filename) == false ) {
+    NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
+                  "Could not convert", json_filename, "to", filename );
+
+    return NOM_EXIT_FAILURE;
+  }
+
+  return NOM_EXIT_SUCCESS;
+}
@@ -31,19 +31,17 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <memory>
 #include <functional>
+#include <string>
 #include <vector>
 #include <map>
-#include <deque>
 
 #include "nomlib/config.hpp"
+#include "nomlib/actions/DispatchQueue.hpp"
 
 namespace nom {
 
 // Forward declarations
 class IActionObject;
-class DispatchQueue;
-
-typedef std::function<void()> action_callback_func;
 
 /// \brief Interface for running and controlling action flow
 class ActionPlayer
@@ -54,6 +52,18 @@ class ActionPlayer
     /// \see ::actions_running, ::cancel_actions
     typedef std::vector<const char*> action_names;
 
+    /// \brief An opaque identifier of an enqueued action.
+    ///
+    /// \remarks Handles are cheap to copy and compare, and remain safe to use
+    /// after the action has completed -- a stale handle never refers to
+    /// another action.
+    ///
+    /// \see ::enqueue_action
+    typedef uint64 handle_type;
+
+    /// \brief The handle value that never refers to an action.
+    static const handle_type INVALID_HANDLE = 0;
+
     /// \brief The status of the player.
     enum State
     {
@@ -121,6 +131,14 @@ class ActionPlayer
     /// \see nom::IActionObject::set_name.
     bool action_running(const std::string& action_id) const;
 
+    /// \brief Get the completion status of an action.
+    ///
+    /// \param handle The handle returned by ::enqueue_action.
+    ///
+    /// \returns Boolean TRUE if the action is still running, and boolean
+    /// FALSE if the action has completed or was cancelled.
+    bool action_running(handle_type handle) const;
+
     /// \brief Stop executing an action.
     ///
     /// \param action_id The unique identifier of the action to stop.
@@ -128,6 +146,11 @@ class ActionPlayer
     /// \see nom::IActionObject::set_name.
     bool cancel_action(const std::string& action_id);
 
+    /// \brief Stop executing an action.
+    ///
+    /// \param handle The handle returned by ::enqueue_action.
+    bool cancel_action(handle_type handle);
+
     void cancel_actions(const action_names& actions);
 
     /// \brief Stop executing the enqueued actions.
@@ -159,6 +182,28 @@ class ActionPlayer
     bool run_action(  const std::shared_ptr<IActionObject>& action,
                       const action_callback_func& completion_func );
 
+    /// \brief Enqueue an action with an optional completion callback.
+    ///
+    /// \param action The action to run.
+    ///
+    /// \param completion_func The function to call when the action is
+    /// completed -- passing NULL here is valid.
+    ///
+    /// \returns A handle to the enqueued action on success, or
+    /// nom::ActionPlayer::INVALID_HANDLE on failure.
+    ///
+    /// \remarks Only actions with a name are indexed by name; if an action
+    /// using the same name is already running, it is removed before the new
+    /// action is added. Unnamed actions are only reachable through the
+    /// returned handle.
+    ///
+    /// \remarks Once the player has grown to the number of actions that run
+    /// concurrently, enqueueing an unnamed action performs no heap
+    /// allocations of its own.
+    handle_type
+    enqueue_action( const std::shared_ptr<IActionObject>& action,
+                    const action_callback_func& completion_func = nullptr );
+
     /// \brief Run the enqueued actions' update loop.
     ///
     /// \param delta_time Reserved for application-defined implementations.
@@ -172,46 +217,71 @@ class ActionPlayer
     bool update(real32 delta_time);
 
   private:
-    /// \brief Enqueue an action that runs on a specific dispatch queue.
-    ///
-    /// \param action The action to run; NULL actions are valid.
+    static const char* DEBUG_CLASS_NAME;
+
+    /// \brief An enqueued action, stored contiguously in the order that it
+    /// was enqueued.
+    struct ActionEntry
+    {
+      DispatchEnqueue dispatch;
+
+      /// \brief The handle of this entry; its slot refers back to the entry.
+      handle_type handle = INVALID_HANDLE;
+
+      /// \brief The name that the action was indexed by, if any.
+      std::string name;
+    };
+
+    /// \brief An indirection from a handle to an entry.
     ///
-    /// \param completion_func The function to call when the action is
-    /// completed -- passing NULL here is valid.
+    /// \remarks The generation is bumped each time the slot is freed, so that
+    /// stale handles can be detected.
+    struct ActionSlot
+    {
+      uint32 generation = 1;
+
+      /// \brief The position of the entry while the slot is in use, or the
+      /// next free slot.
+      uint32 index = 0;
+    };
+
+    /// \brief Free the slot of an entry and release its resources.
     ///
-    /// \param dispatch_queue A valid nom::DispatchQueue to run the action on.
-    ///
-    /// \remarks It is **not** safe to enqueue more than one action per
-    /// nom::DispatchQueue instance. When two or more actions share the same
-    /// instance, it runs the risk of causing memory access violations in the
-    /// form of double-freeing their dispatch queues upon completion (I believe
-    /// this actually happens in ActionPlayer::update, but alas!). Using a
-    /// reference counting mechanism, such as shared_ptr, resolves the issue,
-    /// but if only that was the end of it ...
-    ///   The update loop in nom::DispatchQueue iterates through actions
-    /// sequentially, which breaks actions that are intended to run in parallel,
-    /// i.e.: nom::GroupAction -- but even that problem is trivial to solve.
-    /// The ~25..50% performance penalty observed made me decide that it was
-    /// not worth the trouble, at least until I can find a use case for this
-    /// issue.
-    bool run_action(  const std::shared_ptr<IActionObject>& action,
-                      std::unique_ptr<DispatchQueue> dispatch_queue,
-                      const action_callback_func& completion_func );
+    /// \remarks The entry is left in place until the next ::compact call.
+    void remove_entry(nom::size_type index);
 
-    static const char* DEBUG_CLASS_NAME;
+    /// \brief Erase the entries of completed and cancelled actions.
+    void compact();
 
-    typedef
-    std::map<std::string, std::unique_ptr<DispatchQueue>> container_type;
+    /// \brief Get whether an entry belongs to an action that has neither
+    /// completed nor been cancelled.
+    bool entry_running(const ActionEntry& entry) const;
 
-    typedef container_type::iterator container_iterator;
+    /// \brief Get the position of an entry from its handle.
+    ///
+    /// \returns The position of the entry, or -1 when the handle is stale.
+    int64 find_entry(handle_type handle) const;
 
     ActionPlayer::State player_state_;
 
     /// \brief Enqueued actions.
-    container_type actions_;
+    std::vector<ActionEntry> actions_;
+
+    /// \brief The handle indirection table.
+    std::vector<ActionSlot> slots_;
+
+    /// \brief The first free slot, or slots_.size() when there are none.
+    uint32 free_slot_ = 0;
+
+    /// \brief The index of the named actions.
+    std::map<std::string, handle_type> names_;
+
+    /// \brief The number of actions that have not completed.
+    nom::size_type num_actions_ = 0;
 
-    /// \brief The actions pending removal.
-    std::deque<container_iterator> free_list_;
+    /// \brief Whether ::update is iterating the actions; erasing entries is
+    /// deferred until the iteration is finished.
+    bool updating_ = false;
 };
 
 } // namespace nom
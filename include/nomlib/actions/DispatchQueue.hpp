@@ -40,10 +40,26 @@ namespace nom {
 
 // Forward declarations
 class IActionObject;
-struct DispatchEnqueue;
 
 typedef std::function<void()> action_callback_func;
 
+/// \brief Internal representation of an enqueued action.
+struct DispatchEnqueue
+{
+  /// \brief The enqueued action.
+  std::shared_ptr<IActionObject> action;
+
+  /// \brief The action's last known state in reference to the player's state.
+  ///
+  /// \remarks One of the nom::ActionPlayer::State enumeration values; the
+  /// default is nom::ActionPlayer::State::RUNNING.
+  uint32 last_action_state = 0;
+
+  /// \brief An optional function pointer that is called when the action is
+  /// completed.
+  action_callback_func on_completion_callback;
+};
+
 /// \brief The internal processing queue for actions
 class DispatchQueue
 {
@@ -91,15 +107,37 @@ class DispatchQueue
     DispatchQueue::State
     update(uint32 player_state, real32 delta_time);
 
+    /// \brief Remove all of the enqueued actions.
+    ///
+    /// \remarks The storage of the queue is kept for re-use.
+    void clear();
+
+    /// \brief Advance a single enqueued action by one frame.
+    ///
+    /// \param player_state One of the ActionPlayer::State enumeration values.
+    ///
+    /// \param delta_time Reserved for application-defined implementations.
+    ///
+    /// \returns DispatchQueue::State::RUNNING if the action is still
+    /// executing, or DispatchQueue::State::IDLING when the action has
+    /// completed.
+    ///
+    /// \remarks The completion callback of the action is **not** called; this
+    /// is left up to the caller.
+    static DispatchQueue::State
+    update_action(  DispatchEnqueue& enqueued_action, uint32 player_state,
+                    real32 delta_time );
+
   private:
     static const char* DEBUG_CLASS_NAME;
 
-    typedef std::vector<std::unique_ptr<DispatchEnqueue>> container_type;
-    typedef container_type::iterator iterator_type;
+    typedef std::vector<DispatchEnqueue> container_type;
 
     /// \brief Enqueued actions.
     container_type actions_;
-    iterator_type actions_iterator_;
+
+    /// \brief The position of the action being executed.
+    nom::size_type actions_index_ = 0;
 
     /// \brief The total number of actions enqueued.
     nom::size_type num_actions_ = 0;
@@ -50,9 +50,11 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
   #include "nomlib/audio/AL/Listener.hpp"
   #include "nomlib/audio/AL/Music.hpp"
   #include "nomlib/audio/AL/Sound.hpp"
+  #include "nomlib/audio/AL/SoundBank.hpp"
   #include "nomlib/audio/AL/SoundBuffer.hpp"
   #include "nomlib/audio/AL/SoundFile.hpp"
   #include "nomlib/audio/AL/SoundSource.hpp"
+  #include "nomlib/audio/AL/VoicePool.hpp"
 #endif
 
 #endif // include guard defined
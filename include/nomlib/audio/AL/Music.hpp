@@ -31,27 +31,173 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <iostream>
 #include <memory>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include "nomlib/config.hpp"
 #include "nomlib/audio/AL/SoundSource.hpp"
 
 namespace nom {
 
+// Forward declarations
+class SoundFile;
+
 class Music: public SoundSource
 {
   public:
+    /// \brief The number of buffers queued on the source while streaming.
+    static const nom::size_type NUM_STREAM_BUFFERS = 4;
+
+    /// \brief The length of audio held by each stream buffer, in
+    /// milliseconds.
+    static const uint32 STREAM_BUFFER_MS = 250;
+
+    /// \brief The interval at which the stream thread refills the processed
+    /// buffers, in milliseconds.
+    static const uint32 STREAM_UPDATE_MS = 10;
+
     Music ( void );
     Music ( const ISoundBuffer& copy );
     virtual ~Music( void );
 
+    /// \brief Disabled copy constructor.
+    Music(const Music& rhs) = delete;
+
+    /// \brief Disabled copy assignment operator.
+    Music& operator =(const Music& rhs) = delete;
+
     void setBuffer ( const ISoundBuffer& copy );
 
+    /// \brief Stream an audio file from disk.
+    ///
+    /// \param filename The path to an audio file supported by libsndfile.
+    ///
+    /// \remarks The first buffers are decoded before this method returns, so
+    /// that playback starts immediately. The remainder of the file is decoded
+    /// in chunks on a background thread while the music is playing.
+    bool open(const std::string& filename);
+
+    /// \brief Stop streaming and release the audio file.
+    void close();
+
+    /// \brief Get whether this music is streamed from an audio file.
+    bool streaming() const;
+
+    /// \brief Set the region of the audio file to repeat while looping.
+    ///
+    /// \param start_seconds The position to jump back to.
+    /// \param end_seconds The position to jump back from; zero denotes the end
+    /// of the file.
+    ///
+    /// \remarks Playback starts from the beginning of the file and enters the
+    /// loop region from there, i.e.: an intro followed by a looping part.
+    void set_loop_points(real32 start_seconds, real32 end_seconds);
+
+    /// \brief Get the position that playback jumps back to while looping, in
+    /// seconds.
+    real32 loop_start() const;
+
+    /// \brief Get the position that playback jumps back from while looping,
+    /// in seconds.
+    real32 loop_end() const;
+
+    bool getLooping() const;
+    void setLooping(bool loops);
+
+    real32 getPlayPosition() const;
+    void setPlayPosition(real32 seconds);
+
+    SoundStatus getStatus() const;
+
     void Play ( void );
     void Stop ( void );
     void Pause ( void );
 
   private:
-    //SoundFile *fp;
+    /// \brief An OpenAL buffer of the stream.
+    struct StreamBuffer
+    {
+      uint32 id = 0;
+
+      /// \brief The frame of the audio file that the buffer starts at.
+      int64 start_frame = 0;
+
+      bool queued = false;
+    };
+
+    /// \brief The stream thread's loop.
+    void run();
+
+    /// \brief Requeue the buffers that the source has finished playing.
+    ///
+    /// \remarks The stream lock must be held.
+    void update_stream();
+
+    /// \brief Decode and queue every buffer that is not queued.
+    ///
+    /// \remarks The stream lock must be held.
+    void queue_buffers();
+
+    /// \brief Decode the next chunk of the audio file into a buffer and queue
+    /// it on the source.
+    ///
+    /// \returns Boolean FALSE when there is nothing left to decode.
+    ///
+    /// \remarks The stream lock must be held.
+    bool queue_buffer(nom::size_type index);
+
+    /// \brief Detach every buffer from the stopped source and seek the audio
+    /// file.
+    ///
+    /// \remarks The stream lock must be held.
+    void rewind_stream(int64 frame);
+
+    /// \brief Convert seconds to a frame offset of the audio file.
+    int64 to_frame(real32 seconds) const;
+
+    /// \brief The frame that playback jumps back to while looping.
+    int64 loop_start_frame() const;
+
+    /// \brief The frame that decoding stops at; the end of the loop region
+    /// while looping, or else the end of the file.
+    int64 loop_end_frame() const;
+
+    /// \brief The streamed audio file; NULL when the music is not streamed.
+    std::unique_ptr<SoundFile> file_;
+
+    StreamBuffer buffers_[NUM_STREAM_BUFFERS];
+
+    /// \brief The positions of the queued buffers, in the order that they
+    /// were queued.
+    nom::size_type queue_[NUM_STREAM_BUFFERS];
+    nom::size_type queue_head_ = 0;
+    nom::size_type queue_size_ = 0;
+
+    /// \brief The decoding buffer, sized to one stream buffer.
+    std::vector<int16> samples_;
+
+    /// \brief The frame of the audio file that is decoded next.
+    int64 read_frame_ = 0;
+
+    bool end_of_stream_ = false;
+    bool looping_ = false;
+    real32 loop_start_ = 0.0f;
+    real32 loop_end_ = 0.0f;
+
+    /// \brief Whether the stream should be playing; the source itself stops
+    /// when it runs out of queued buffers.
+    bool playing_ = false;
+
+    bool running_ = false;
+    std::thread thread_;
+
+    /// \brief Guards the stream state and the source against the stream
+    /// thread.
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
 };
 
 } // namespace nom
@@ -76,6 +76,12 @@ namespace priv {
 
 void al_err(const std::string& func, const std::string& file, uint32 line);
 
+/// \brief Get the OpenAL format of 16-bit samples for a number of channels.
+///
+/// \returns The format enumeration, or zero when the number of channels is
+/// not supported by the implementation.
+uint32 al_channel_format(uint32 num_channels);
+
 } // namespace priv
 } // namespace nom
 
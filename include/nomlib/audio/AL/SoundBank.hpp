@@ -0,0 +1,127 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#ifndef NOMLIB_AL_SOUND_BANK_HPP
+#define NOMLIB_AL_SOUND_BANK_HPP
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "nomlib/config.hpp"
+
+namespace nom {
+
+// Forward declarations
+class SoundBuffer;
+
+/// \brief A named collection of sound effects, decoded in parallel
+class SoundBank
+{
+  public:
+    SoundBank();
+
+    ~SoundBank();
+
+    /// \brief Disabled copy constructor.
+    SoundBank(const SoundBank& rhs) = delete;
+
+    /// \brief Disabled copy assignment operator.
+    SoundBank& operator =(const SoundBank& rhs) = delete;
+
+    /// \brief Load every audio file in a directory.
+    ///
+    /// \param dir_path The directory to load; sub-directories are skipped.
+    /// \param num_threads The number of worker threads to decode with; zero
+    /// uses one per hardware thread.
+    ///
+    /// \returns The number of sounds loaded.
+    ///
+    /// \remarks The sounds are named after their file name, i.e.:
+    /// "explosion.wav". Files that cannot be decoded are skipped.
+    nom::size_type load_dir( const std::string& dir_path,
+                             nom::size_type num_threads = 0 );
+
+    /// \brief Load a list of audio files.
+    ///
+    /// \param filenames The paths of the files to load; the sounds are named
+    /// after the path as given.
+    /// \param num_threads The number of worker threads to decode with; zero
+    /// uses one per hardware thread.
+    ///
+    /// \returns The number of sounds loaded.
+    nom::size_type load( const std::vector<std::string>& filenames,
+                         nom::size_type num_threads = 0 );
+
+    /// \brief Get a loaded sound.
+    ///
+    /// \returns A non-owning pointer to the sound buffer, or NULL when no
+    /// sound by the name was loaded.
+    SoundBuffer* find(const std::string& name) const;
+
+    /// \brief Get the number of sounds loaded.
+    nom::size_type size() const;
+
+    /// \brief Release every sound.
+    void clear();
+
+  private:
+    /// \brief Decode the files on worker threads and upload them to OpenAL on
+    /// the calling thread.
+    nom::size_type load( const std::vector<std::string>& names,
+                         const std::vector<std::string>& filenames,
+                         nom::size_type num_threads );
+
+    std::map<std::string, std::unique_ptr<SoundBuffer>> buffers_;
+};
+
+} // namespace nom
+
+#endif // include guard defined
+
+/// \class nom::SoundBank
+/// \ingroup audio
+///
+/// Decoding is the costly part of loading a sound, and each file decodes
+/// independently; the bank spreads the files over worker threads. The
+/// buffers are created and uploaded on the thread that loads the bank.
+///
+/// ## Usage Examples
+///
+/// \code
+///
+/// nom::SoundBank sounds;
+/// sounds.load_dir( nom::File().resource_path() + "/sfx" );
+///
+/// nom::SoundBuffer* explosion = sounds.find("explosion.wav");
+/// if( explosion != nullptr ) {
+///   voices.play(*explosion);
+/// }
+///
+/// \endcode
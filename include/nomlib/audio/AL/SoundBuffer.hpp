@@ -55,8 +55,40 @@ class SoundBuffer: public ISoundBuffer
     // getChannelCount
     // ...
 
+    /// \brief Decode an audio file and upload it to the buffer.
+    ///
+    /// \remarks The decoded samples are released once uploaded, unless they
+    /// are retained; see ::set_retain_samples.
     bool load ( const std::string& filename );
 
+    /// \brief Decode an audio file held in memory and upload it to the
+    /// buffer.
+    ///
+    /// \param data The contents of the audio file.
+    /// \param size The size of the data in bytes.
+    bool load(const void* data, nom::size_type size);
+
+    /// \brief Upload decoded samples to the buffer.
+    ///
+    /// \param samples Interleaved 16-bit samples; the vector is taken over.
+    /// \param channel_count The number of channels per sample frame.
+    /// \param sample_rate The number of sample frames per second.
+    bool load(  std::vector<int16>&& samples, uint32 channel_count,
+                uint32 sample_rate );
+
+    /// \brief Keep a copy of the decoded samples after they are uploaded.
+    ///
+    /// \remarks This is disabled by default, as the OpenAL implementation
+    /// keeps its own copy of the samples.
+    void set_retain_samples(bool retain);
+
+    bool retain_samples() const;
+
+    /// \brief Get the decoded samples of the last load.
+    ///
+    /// \remarks This is empty unless the samples are retained.
+    const std::vector<int16>& samples() const;
+
   private:
     friend class Sound; // Sound class needs access to attach & detach methods
 
@@ -72,13 +104,16 @@ class SoundBuffer: public ISoundBuffer
     /// Used internally by OpenAL for identification of audio buffer
     uint32 buffer;
 
-    /// We load our audio data into this buffer
-    std::vector<int16> samples;
+    /// We decode our audio data into this buffer
+    std::vector<int16> samples_;
+
+    /// Whether samples_ is kept after the data is uploaded
+    bool retain_samples_ = false;
 
     /// Duration of sound buffer
     ///
     /// Default: zero (0)
-    int64 buffer_duration;
+    int64 buffer_duration = 0;
 };
 
 } // namespace nom
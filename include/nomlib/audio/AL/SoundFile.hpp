@@ -38,9 +38,17 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Forward declarations
 struct SNDFILE_tag {};
+struct SF_INFO;
 
 namespace nom {
 
+namespace priv {
+
+// Forward declarations
+struct SoundFileStream;
+
+} // namespace priv
+
 class SoundFile
 {
   public:
@@ -62,23 +70,69 @@ class SoundFile
     /// Obtain audio data size in bytes
     int64 getDataByteSize ( void ) const;
 
+    /// \brief Get the number of sample frames in the audio file.
+    ///
+    /// \remarks A frame holds one sample for each channel.
+    int64 frame_count() const;
+
     bool open ( const std::string& filename );
+
+    /// \brief Decode an audio file held in memory.
+    ///
+    /// \param data The contents of the audio file; it must outlive this
+    /// object, as it is read from while decoding.
+    /// \param size The size of the data in bytes.
+    bool open(const void* data, nom::size_type size);
+
+    /// \brief Decode an audio file through a read-only memory mapping.
+    ///
+    /// \remarks The file is held by a nom::MappedFile; this falls back to
+    /// ::open when the file cannot be read that way.
+    bool open_mapped(const std::string& filename);
+
+    /// \brief Decode the remainder of the audio file.
+    ///
+    /// \param data The samples are appended to this vector; it is grown once
+    /// to fit the whole file.
     bool read ( std::vector<int16>& data );
 
+    /// \brief Decode the next chunk of samples from the audio file.
+    ///
+    /// \param data The output buffer; it must hold at least num_samples.
+    /// \param num_samples The number of samples to decode; this should be a
+    /// multiple of the channel count.
+    ///
+    /// \returns The number of samples decoded, or zero at the end of the file.
+    int64 read(int16* data, int64 num_samples);
+
+    /// \brief Set the position of the next read.
+    ///
+    /// \param frame The sample frame offset from the start of the file.
+    bool seek(int64 frame);
+
   private:
+    /// \brief Take ownership of an opened file and record its format.
+    bool set_file(SNDFILE_tag* fp, const SF_INFO& info);
+
+    /// \brief The in-memory source of the audio file, when it is not read
+    /// from disk by libsndfile.
+    ///
+    /// \remarks This is declared ahead of fp, as it must outlive it.
+    std::unique_ptr<priv::SoundFileStream> stream_;
+
     /// SNDFILE* file descriptor
     /// \todo Change me to a std::unique_ptr
     std::shared_ptr<SNDFILE_tag> fp;
     /// Extracted audio stream from file
     std::vector<int16> samples;
     /// Total number of samples in the file
-    int64 sample_count;
+    int64 sample_count = 0;
     /// Number of audio channels used by sound
-    uint32 channel_count;
+    uint32 channel_count = 0;
     /// Number of samples per second
-    uint32 sample_rate;
+    uint32 sample_rate = 0;
     /// OpenAL compatible audio channels used by sound
-    int32 channel_format;
+    int32 channel_format = 0;
 };
 
 std::string libsndfile_version();
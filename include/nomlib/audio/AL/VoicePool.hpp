@@ -0,0 +1,219 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#ifndef NOMLIB_AL_VOICE_POOL_HPP
+#define NOMLIB_AL_VOICE_POOL_HPP
+
+#include <vector>
+
+#include "nomlib/config.hpp"
+
+namespace nom {
+
+// Forward declarations
+class ISoundBuffer;
+
+/// \brief A fixed set of OpenAL sources shared by fire-and-forget sounds
+class VoicePool
+{
+  public:
+    /// \brief An opaque identifier of a playing voice.
+    ///
+    /// \remarks A handle goes stale once its voice has finished playing or
+    /// has been stolen; a stale handle never refers to another voice.
+    typedef uint64 handle_type;
+
+    /// \brief The handle value that never refers to a voice.
+    static const handle_type INVALID_HANDLE = 0;
+
+    /// \brief The priority of a voice when none is given.
+    static const int DEFAULT_PRIORITY = 0;
+
+    /// \brief The number of voices allocated when none is given.
+    static const nom::size_type DEFAULT_NUM_VOICES = 16;
+
+    VoicePool();
+
+    ~VoicePool();
+
+    /// \brief Disabled copy constructor.
+    VoicePool(const VoicePool& rhs) = delete;
+
+    /// \brief Disabled copy assignment operator.
+    VoicePool& operator =(const VoicePool& rhs) = delete;
+
+    /// \brief Allocate the sources of the pool.
+    ///
+    /// \param num_voices The maximum number of sounds that may play at once.
+    ///
+    /// \returns Boolean TRUE when at least one source was allocated.
+    ///
+    /// \remarks Fewer voices than requested are allocated when the OpenAL
+    /// implementation runs out of sources; see ::num_voices.
+    bool initialize(nom::size_type num_voices = DEFAULT_NUM_VOICES);
+
+    /// \brief Stop every voice and release the sources of the pool.
+    void shutdown();
+
+    /// \brief Get the number of sources owned by the pool.
+    nom::size_type num_voices() const;
+
+    /// \brief Get the number of voices that are playing.
+    nom::size_type num_active() const;
+
+    /// \brief Get the number of voices that were cut short to make room for
+    /// another sound.
+    nom::size_type num_stolen() const;
+
+    /// \brief Play a sound on a free voice.
+    ///
+    /// \param buffer The audio to play; it must outlive the voice, see
+    /// ::stop(const ISoundBuffer&).
+    /// \param priority The importance of the sound; when every voice is
+    /// busy, the oldest voice of the lowest priority that is not above this
+    /// one is stolen.
+    /// \param gain A number between 0..100 (min/max).
+    /// \param pitch The pitch multiplier of the sound.
+    ///
+    /// \returns A handle to the voice on success, or
+    /// nom::VoicePool::INVALID_HANDLE when every voice is playing a sound of
+    /// a higher priority.
+    ///
+    /// \remarks The voice is recycled on its own once playback ends; there is
+    /// nothing to release.
+    handle_type play( const ISoundBuffer& buffer,
+                      int priority = DEFAULT_PRIORITY,
+                      real32 gain = 100.0f, real32 pitch = 1.0f );
+
+    /// \brief Get whether a voice is still playing.
+    bool playing(handle_type handle) const;
+
+    /// \brief Stop a voice and return it to the pool.
+    ///
+    /// \returns Boolean FALSE when the handle is stale.
+    bool stop(handle_type handle);
+
+    /// \brief Stop every voice playing a buffer.
+    ///
+    /// \remarks This must be done before the buffer is destroyed, as OpenAL
+    /// refuses to delete a buffer that a source is playing.
+    void stop(const ISoundBuffer& buffer);
+
+    /// \brief Stop every voice.
+    void stop_all();
+
+    /// \brief Return the voices that have finished playing to the pool.
+    ///
+    /// \remarks Finished voices are also picked up by ::play as needed, so
+    /// calling this once per frame only keeps ::num_active current.
+    void update();
+
+  private:
+    struct Voice
+    {
+      uint32 source_id = 0;
+
+      /// \brief Bumped each time the voice is recycled, so that stale
+      /// handles can be detected.
+      uint32 generation = 1;
+
+      /// \brief The buffer bound to the source; zero when the voice is free.
+      uint32 buffer_id = 0;
+
+      int priority = DEFAULT_PRIORITY;
+
+      /// \brief The order in which the voice was started; lower is older.
+      uint64 sequence = 0;
+
+      bool active = false;
+    };
+
+    /// \brief Get the position of a voice from its handle.
+    ///
+    /// \returns The position of the voice, or -1 when the handle is stale.
+    int64 find_voice(handle_type handle) const;
+
+    /// \brief Pick the voice to play a new sound on.
+    ///
+    /// \returns The position of the voice, or -1 when there is none.
+    int64 acquire(int priority);
+
+    /// \brief Return a voice to the pool if its source has stopped.
+    ///
+    /// \returns Boolean TRUE when the voice is free.
+    bool reclaim(Voice& voice);
+
+    /// \brief Stop a voice and return it to the pool.
+    void release(Voice& voice);
+
+    std::vector<Voice> voices_;
+
+    /// \brief The number of active voices, as of the last check.
+    nom::size_type num_active_ = 0;
+
+    nom::size_type num_stolen_ = 0;
+
+    uint64 sequence_ = 0;
+};
+
+} // namespace nom
+
+#endif // include guard defined
+
+/// \class nom::VoicePool
+/// \ingroup audio
+///
+/// Creating and deleting an OpenAL source for every sound effect is costly,
+/// and the number of sources is limited by the implementation -- past it,
+/// new sounds silently fail to play. The pool allocates its sources once and
+/// hands them out to one-shot sounds, stealing the least important voice when
+/// it runs out.
+///
+/// ## Usage Examples
+///
+/// \code
+///
+/// nom::SoundBuffer explosion;
+/// explosion.load("explosion.wav");
+///
+/// nom::VoicePool voices;
+/// voices.initialize();
+///
+/// // Fire and forget
+/// voices.play(explosion);
+///
+/// // The player's own sounds should not be cut off by the background noise
+/// auto handle = voices.play(explosion, 10);
+///
+/// // Once per frame
+/// voices.update();
+///
+/// // Before the buffer goes away
+/// voices.stop(explosion);
+///
+/// \endcode
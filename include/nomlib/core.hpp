@@ -36,6 +36,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nomlib/core/ObjectTypeInfo.hpp"
 #include "nomlib/core/IObject.hpp"
 #include "nomlib/core/SDL2Logger.hpp"
+#include "nomlib/core/AsyncLogWriter.hpp"
 #include "nomlib/core/ConsoleOutput.hpp"
 #include <nomlib/core/err.hpp>
 
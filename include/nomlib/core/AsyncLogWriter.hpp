@@ -0,0 +1,269 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#ifndef NOMLIB_CORE_ASYNC_LOG_WRITER_HPP
+#define NOMLIB_CORE_ASYNC_LOG_WRITER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "nomlib/config.hpp"
+
+namespace nom {
+
+/// \brief The logging facility options.
+///
+/// \see nom::SDL2Logger::initialize
+struct LogOptions
+{
+  /// \brief The destinations of log messages.
+  enum: uint32
+  {
+    OUTPUT_CONSOLE = 0x1,
+    OUTPUT_FILE = 0x2
+  };
+
+  /// \brief The handling of log messages when the log queue is full.
+  enum Overflow
+  {
+    /// \brief Discard the message.
+    OVERFLOW_DROP = 0,
+
+    /// \brief Wait on the writer thread to make room for the message.
+    OVERFLOW_BLOCK,
+
+    /// \brief Discard the message; the number of discarded messages is
+    /// written out once the writer has caught up.
+    OVERFLOW_COUNT
+  };
+
+  /// \brief Output the log messages from a background thread.
+  ///
+  /// \remarks When FALSE, the messages are written to the console by the
+  /// calling thread, and the remaining options are ignored.
+  bool async = false;
+
+  /// \brief A bit mask of the OUTPUT_* destinations.
+  uint32 outputs = OUTPUT_CONSOLE;
+
+  /// \brief The file path of the log file, used with OUTPUT_FILE.
+  std::string file_path = "nomlib.log";
+
+  /// \brief The size in bytes at which the log file is rotated; zero
+  /// disables rotation.
+  nom::size_type max_file_size = 1024 * 1024;
+
+  /// \brief The number of log files kept, including the current file; the
+  /// older files are suffixed with .1, .2 and so on.
+  uint32 max_files = 3;
+
+  /// \brief The number of log messages that the queue holds; rounded up to
+  /// a power of two.
+  nom::size_type queue_capacity = 1024;
+
+  /// \brief One of the nom::LogOptions::Overflow enumeration values.
+  Overflow overflow = OVERFLOW_DROP;
+};
+
+namespace priv {
+
+/// \brief Log output function for SDL_LogMessage that enqueues the message
+/// onto the nom::AsyncLogWriter set by ::set_async_log_writer.
+///
+/// \remarks The user data pointer is not used to find the writer, as it may
+/// refer to a writer that is being destroyed. While no writer is set, the
+/// message is written out by the calling thread.
+void async_log_message( void* ptr, int cat, SDL_LogPriority prio,
+                        const char* msg );
+
+/// \brief Set the nom::AsyncLogWriter that ::async_log_message enqueues onto.
+///
+/// \returns The previous writer, or NULL. No thread is still enqueueing onto
+/// it once this returns, so it may be destroyed.
+///
+/// \remarks This is safe to call while other threads are logging, but not
+/// from more than one thread at a time.
+AsyncLogWriter* set_async_log_writer(AsyncLogWriter* writer);
+
+} // namespace priv
+
+/// \brief Background writer for log messages.
+///
+/// \remarks Messages are copied into a bounded, lock-free queue by the logging
+/// threads and written out to the console and log file by the writer thread.
+/// The logging threads never wait on I/O -- only on a full queue, when the
+/// overflow policy is nom::LogOptions::OVERFLOW_BLOCK.
+class AsyncLogWriter
+{
+  public:
+    typedef AsyncLogWriter self_type;
+
+    /// \brief The maximal length of a queued log message, including the
+    /// null-terminator; longer messages are truncated.
+    static const nom::size_type MAX_RECORD_LENGTH = 1024;
+
+    /// \brief The number of per-category message counters; categories at or
+    /// beyond this value share the last counter.
+    static const int MAX_CATEGORIES = 64;
+
+    /// \brief Start the writer thread.
+    AsyncLogWriter(const LogOptions& options);
+
+    /// \brief Write out the remaining messages and stop the writer thread.
+    ~AsyncLogWriter();
+
+    AsyncLogWriter(const self_type& rhs) = delete;
+    self_type& operator =(const self_type& rhs) = delete;
+
+    const LogOptions& options() const;
+
+    /// \brief Get the number of queue slots.
+    nom::size_type capacity() const;
+
+    /// \brief Get the number of messages accepted into the queue.
+    ///
+    /// \param cat The logging category of the messages.
+    uint64 num_logged(int cat) const;
+
+    /// \brief Get the number of messages discarded on a full queue.
+    ///
+    /// \param cat The logging category of the messages.
+    uint64 num_dropped(int cat) const;
+
+    /// \brief Get the number of messages discarded on a full queue, across
+    /// all logging categories.
+    uint64 num_dropped() const;
+
+    /// \brief Enqueue a log message.
+    ///
+    /// \returns Boolean FALSE when the message was discarded because the queue
+    /// was full.
+    ///
+    /// \remarks This method is safe to call from any thread.
+    bool push(int cat, SDL_LogPriority prio, const char* msg);
+
+    /// \brief Wait until the messages enqueued so far have been written out.
+    void flush();
+
+  private:
+    struct LogRecord
+    {
+      int category;
+      SDL_LogPriority priority;
+      char message[MAX_RECORD_LENGTH];
+    };
+
+    /// \brief A slot of the queue; the sequence number tells the producers
+    /// and the consumer whose turn it is to use the slot.
+    struct LogCell
+    {
+      std::atomic<nom::size_type> sequence;
+      LogRecord record;
+    };
+
+    static int category_index(int cat);
+
+    /// \brief Reserve a queue slot and copy the message into it.
+    bool try_push(int cat, SDL_LogPriority prio, const char* msg);
+
+    /// \brief Wake the writer thread if it is waiting on new messages.
+    void notify();
+
+    /// \brief The writer thread loop.
+    void run();
+
+    /// \brief Write out the messages that are ready in the queue.
+    ///
+    /// \returns The number of messages that were written.
+    nom::size_type drain();
+
+    void write_record(const LogRecord& record);
+
+    bool open_file();
+
+    /// \brief Shift the older log files by one and start a new log file.
+    void rotate_file();
+
+    LogOptions options_;
+
+    std::unique_ptr<LogCell[]> cells_;
+    nom::size_type mask_ = 0;
+
+    /// \brief The next slot to be reserved by a producer.
+    std::atomic<nom::size_type> enqueue_pos_;
+
+    /// \brief The next slot to be written out; only used by the writer thread.
+    nom::size_type dequeue_pos_ = 0;
+
+    /// \brief The number of messages written out.
+    std::atomic<nom::size_type> num_written_;
+
+    std::atomic<uint64> num_logged_[MAX_CATEGORIES];
+    std::atomic<uint64> num_dropped_[MAX_CATEGORIES];
+
+    /// \brief Discarded messages that have yet to be reported; used with
+    /// nom::LogOptions::OVERFLOW_COUNT.
+    std::atomic<uint64> unreported_drops_;
+
+    std::atomic<bool> running_;
+    std::atomic<bool> sleeping_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+
+    std::ofstream file_;
+    nom::size_type file_size_ = 0;
+
+    std::thread thread_;
+};
+
+} // namespace nom
+
+#endif // include guard defined
+
+/// \class nom::AsyncLogWriter
+/// \ingroup core
+///
+/// The writer is normally installed by nom::SDL2Logger::initialize:
+///
+/// \code
+/// nom::LogOptions opts;
+/// opts.async = true;
+/// opts.outputs = nom::LogOptions::OUTPUT_CONSOLE | nom::LogOptions::OUTPUT_FILE;
+/// opts.file_path = "game.log";
+///
+/// nom::SDL2Logger::initialize(opts);
+/// \endcode
+///
+/// Console output keeps the colors of the synchronous output. Messages
+/// from a single thread are written out in the order that they were logged.
+///
@@ -29,11 +29,15 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef NOMLIB_CORE_SDL2_LOGGER_HPP
 #define NOMLIB_CORE_SDL2_LOGGER_HPP
 
+#include <ostream>
 #include <sstream>
+#include <streambuf>
 #include <string>
 
 #include <SDL.h>
 
+#include "nomlib/types.hpp"
+
 /// \brief The predefined logging categories.
 ///
 /// \remarks By default: NOM_LOG_CATEGORY_APPLICATION is enabled at the
@@ -163,6 +167,10 @@ enum LogPriority
   NOM_NUM_LOG_PRIORITIES = SDL_NUM_LOG_PRIORITIES
 };
 
+// Forward declarations
+struct LogOptions;
+class AsyncLogWriter;
+
 namespace priv {
 
 /// \brief Customized log output function for SDL_LogMessage
@@ -171,6 +179,33 @@ namespace priv {
 /// Windows platforms.
 void log_message( void* ptr, int cat, SDL_LogPriority prio, const char* msg );
 
+/// \brief Fixed-size output buffer for a log message.
+///
+/// \remarks Characters that do not fit are discarded; a log message is never
+/// allocated from the heap.
+class LogBuffer: public std::streambuf
+{
+  public:
+    /// \brief The maximal length of a log message, including the trailing
+    /// newline and null-terminator.
+    ///
+    /// \remarks This is the length that SDL_LogMessage truncates to.
+    static const nom::size_type MAX_MESSAGE_LENGTH = SDL_MAX_LOG_MESSAGE;
+
+    LogBuffer();
+
+    /// \brief Get the number of characters written to the buffer.
+    nom::size_type size() const;
+
+    /// \brief Terminate the message with a newline.
+    ///
+    /// \returns The null-terminated message.
+    const char* terminate();
+
+  private:
+    char buffer_[MAX_MESSAGE_LENGTH];
+};
+
 } // namespace priv
 
 /// \brief Helper method for nom::SDL2Logger.
@@ -203,6 +238,44 @@ class SDL2Logger
     /// \see NOM_LOG_CATEGORY enumeration.
     static void initialize();
 
+    /// \brief Set the default logging category priority levels and the
+    /// output of the log messages.
+    ///
+    /// \param options The log output options; when nom::LogOptions::async is
+    /// TRUE, the messages are written by a background nom::AsyncLogWriter.
+    ///
+    /// \remarks This may be called again to change the output; the messages
+    /// of a previous nom::AsyncLogWriter are written out first. Other threads
+    /// may keep logging meanwhile, but this and ::shutdown must not be called
+    /// from more than one thread at a time.
+    static void initialize(const LogOptions& options);
+
+    /// \brief Write out the pending log messages and revert to logging from
+    /// the calling thread.
+    static void shutdown();
+
+    /// \brief Wait until the log messages logged so far have been written out.
+    ///
+    /// \remarks This is a no-op unless the log messages are output
+    /// asynchronously.
+    static void flush();
+
+    /// \brief Get the background log writer.
+    ///
+    /// \returns A non-owned pointer to the writer, or NULL when the log
+    /// messages are output from the logging thread.
+    static AsyncLogWriter* log_writer();
+
+    /// \brief Get whether a message would be output.
+    ///
+    /// \param cat   The logging category of the message.
+    /// \param prio  The logging priority of the message.
+    ///
+    /// \remarks This is the same test that SDL_LogMessage uses to drop
+    /// messages. The logging macros call this before any of their arguments
+    /// are evaluated.
+    static bool enabled( int cat, nom::LogPriority prio );
+
     /// \brief Default constructor; initialize the log category to NOM and
     /// the log priority to LogPriority::NOM_LOG_PRIORITY_INFO.
     SDL2Logger();
@@ -222,6 +295,9 @@ class SDL2Logger
     /// Care must be taken when using this interface outside the provided
     /// macros, as the message is not output until this point.
     ///
+    /// Messages below the category's logging priority are neither formatted
+    /// nor sent.
+    ///
     /// If you wish to set a custom log output function for logging, you should
     /// do so before destruction occurs.
     ~SDL2Logger();
@@ -232,6 +308,10 @@ class SDL2Logger
     template <typename Type, typename ... Args>
     void write( const Type& f, const Args& ... rest )
     {
+      if( this->enabled_ == false ) {
+        return;
+      }
+
       nom::write_debug_output( this->output_stream(), f );
 
       this->write( " " );
@@ -248,11 +328,19 @@ class SDL2Logger
     template <typename Type>
     void write( const Type& f )
     {
+      if( this->enabled_ == false ) {
+        return;
+      }
+
       nom::write_debug_output( this->output_stream(), f );
     }
 
     void write(uint8_t f)
     {
+      if( this->enabled_ == false ) {
+        return;
+      }
+
       nom::write_debug_output(this->output_stream(), (int)f);
     }
 
@@ -273,7 +361,10 @@ class SDL2Logger
     /// \brief Get the log message.
     ///
     /// \returns A reference to the logger's C++ output stream.
-    std::ostringstream& output_stream();
+    ///
+    /// \remarks The stream writes to a fixed-size buffer; see
+    /// nom::priv::LogBuffer.
+    std::ostream& output_stream();
 
     /// \brief Convert an underlying implementation's logging priority level.
     ///
@@ -300,7 +391,7 @@ class SDL2Logger
     /// \remarks This object cannot be copied.
     ///
     /// \note The object cannot be copied because of the usage of
-    /// std::ostringstream.
+    /// std::ostream.
     SDL2Logger( const self_type& rhs ) = delete;
 
     /// \brief Copy assignment constructor.
@@ -308,7 +399,7 @@ class SDL2Logger
     /// \remarks This object cannot be copy assigned.
     ///
     /// \note The object cannot be copied because of the usage of
-    /// std::ostringstream.
+    /// std::ostream.
     self_type& operator =( const self_type& rhs ) = delete;
 
     /// \brief The logging category of the log message.
@@ -317,14 +408,23 @@ class SDL2Logger
     /// \brief The logging priority of the log message.
     nom::LogPriority priority_;
 
+    /// \brief Whether the message passes the category's logging priority.
+    bool enabled_;
+
+    /// \brief The log message storage.
+    priv::LogBuffer buffer_;
+
     /// \brief The log message stream.
-    std::ostringstream os_;
+    std::ostream os_;
 
     /// \brief Ensure one-time initialization of the setting of logging category
     /// priorities.
     ///
     /// \see NOM_LOG_CATEGORY_* enumeration.
     static bool initialized_;
+
+    /// \brief The background log writer, if any.
+    static AsyncLogWriter* log_writer_;
 };
 
 } // namespace nom
@@ -355,3 +455,16 @@ class SDL2Logger
 ///
 /// \see Convenience logging macros -- NOM_LOG_* -- for the primary usage API.
 ///
+/// Log messages are written out from the logging thread by default. To keep
+/// console and file I/O off of time-critical threads, install a
+/// nom::AsyncLogWriter with nom::SDL2Logger::initialize(const LogOptions&).
+///
+/// The logging macros test the category's priority before the logger is
+/// constructed, so a filtered out message costs no more than the priority
+/// lookup -- its arguments are not even evaluated. Priorities below
+/// NOM_LOG_MIN_PRIORITY are removed at compile time:
+///
+/// \code
+/// cmake -D NOM_LOG_MIN_PRIORITY=4 .. # Keep warnings, errors & critical
+/// \endcode
+///
@@ -26,53 +26,38 @@ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 ******************************************************************************/
-#ifndef NOMLIB_GRAPHICS_FONTS_FONT_ROW_HPP
-#define NOMLIB_GRAPHICS_FONTS_FONT_ROW_HPP
-
-#include <vector>
+#ifndef NOMLIB_CORE_SLOT_HANDLE_HPP
+#define NOMLIB_CORE_SLOT_HANDLE_HPP
 
 #include "nomlib/config.hpp"
 
 namespace nom {
-
-/// \brief Container structure for a row of glyphs
-struct FontRow
+namespace priv {
+
+/// \brief Pack the index of a slot and the generation of its occupant into
+/// a handle.
+///
+/// \remarks Handles are 64-bit integers; the generation is stored in the
+/// upper half, so that a handle of a freed slot never matches the slot's
+/// next occupant.
+inline uint64 make_slot_handle(uint32 index, uint32 generation)
 {
-  /// Default constructor
-  FontRow ( void ) :
-    width ( 0 ),
-    top ( 0 ),
-    height ( 0 )
-  {
-    //NOM_LOG_TRACE(NOM);
-  }
-
-  /// Destructor
-  ~FontRow ( void )
-  {
-    //NOM_LOG_TRACE(NOM);
-  }
-
-  FontRow ( uint top, uint height ) :
-    width ( 0 ),
-    top ( top ),
-    height ( height )
-  {
-    //NOM_LOG_TRACE(NOM);
-  }
+  return( (NOM_SCAST(uint64, generation) << 32) | index );
+}
 
-  /// Current width of the row
-  uint width;
-
-  /// Y position of the row into the texture
-  uint top;
-
-  /// Height of the row
-  uint height;
-};
+/// \brief Get the slot index of a handle.
+inline uint32 slot_handle_index(uint64 handle)
+{
+  return NOM_SCAST(uint32, handle & 0xFFFFFFFF);
+}
 
-typedef std::vector<FontRow> PageRow;
+/// \brief Get the occupant generation of a handle.
+inline uint32 slot_handle_generation(uint64 handle)
+{
+  return NOM_SCAST(uint32, handle >> 32);
+}
 
+} // namespace priv
 } // namespace nom
 
 #endif // include guard defined
@@ -35,18 +35,21 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <nomlib/graphics/Text.hpp>
 #include <nomlib/graphics/RendererInfo.hpp>
 #include <nomlib/graphics/Texture.hpp>
+#include <nomlib/graphics/TextureAtlas.hpp>
 #include <nomlib/graphics/DisplayMode.hpp>
 #include <nomlib/graphics/RenderWindow.hpp>
 #include <nomlib/graphics/Renderer.hpp>
 #include <nomlib/graphics/IDrawable.hpp>
 #include <nomlib/graphics/Gradient.hpp>
 #include <nomlib/graphics/Image.hpp>
+#include <nomlib/graphics/QuadBatch.hpp>
+#include <nomlib/graphics/SkylinePacker.hpp>
 #include <nomlib/graphics/fonts/BMFont.hpp>
 #include <nomlib/graphics/fonts/BitmapFont.hpp>
 #include <nomlib/graphics/fonts/FontMetrics.hpp>
 #include <nomlib/graphics/fonts/FontPage.hpp>
-#include <nomlib/graphics/fonts/FontRow.hpp>
 #include <nomlib/graphics/fonts/Glyph.hpp>
+#include <nomlib/graphics/fonts/GlyphAtlas.hpp>
 #include <nomlib/graphics/fonts/TrueTypeFont.hpp>
 #include <nomlib/graphics/fonts/Font.hpp>
 #include <nomlib/graphics/shapes/Shape.hpp>
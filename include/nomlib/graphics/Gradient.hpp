@@ -39,7 +39,6 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nomlib/math/Transformable.hpp"
 #include "nomlib/math/Color4.hpp"
 #include "nomlib/graphics/IDrawable.hpp"
-#include "nomlib/graphics/shapes/Rectangle.hpp"
 #include "nomlib/core/helpers.hpp"
 
 namespace nom {
@@ -145,6 +144,10 @@ class Gradient: public Transformable
 
     /// \brief Set the gradient colors used in the rendering of the gradient
     /// fill.
+    ///
+    /// \param colors The color stops of the gradient, evenly spaced from the
+    /// start to the end of the fill direction; two or more stops are blended
+    /// linearly in between.
     void set_colors( const Color4iColors& colors );
 
     /// \brief Swap the first and last color used in the gradient fill.
@@ -166,31 +169,47 @@ class Gradient: public Transformable
     /// \brief Implements the IDrawable::update method.
     void update( void );
 
-    void strategy_top_down( void );
-    void strategy_left_right( void );
+    /// \brief Compute the color of every step along the fill direction.
+    ///
+    /// \param length The number of steps that the color stops are spread
+    /// over.
+    ///
+    /// \remarks The colors are stored in nom::Gradient::ramp_ as
+    /// SDL_PIXELFORMAT_ARGB8888 pixels.
+    void update_ramp( int length );
+
+    /// \brief Write the rows of a vertical gradient into locked pixels.
+    void strategy_top_down( uint8* pixels, int pitch );
+
+    /// \brief Write the rows of a horizontal gradient into locked pixels.
+    void strategy_left_right( uint8* pixels, int pitch );
 
-    /// \brief Synchronize the texture cache with the generated rectangles.
+    /// \brief Write the gradient into the texture cache.
     ///
     /// \returns Boolean TRUE when the texture cache has been successfully
     /// updated, boolean FALSE when it hasn't been updated, such as when the
-    /// rendering context is invalid, or if the driver does not support FBOs.
+    /// rendering context is invalid.
+    ///
+    /// \remarks The pixels are written in a single pass over a streaming
+    /// texture; the texture is only re-allocated when the size changes.
+    ///
+    /// \remarks A vertex-colored quad through SDL_RenderGeometry -- as
+    /// nom::QuadBatch uses when NOM_USE_SDL2_RENDER_GEOMETRY is defined --
+    /// would save the pixel writes, but the renderer interpolates its colors,
+    /// so the pixels would vary by backend and no longer match the reference
+    /// images of GradientTest. The pixels are only written when the gradient
+    /// changes, and drawing the cache is a single copy each frame either way.
     bool update_cache();
 
-    /// \brief Rectangles cache; this is used to build the texture cache.
-    std::vector<Rectangle> rectangles_;
-
     /// \brief Render cache for the gradient.
-    ///
-    /// \remarks This greatly optimizes performance of this class when there
-    /// are a large number of rectangles being drawn (i.e.: high resolution
-    /// gradient being used as a backdrop, or several gradient objects).
     std::shared_ptr<Texture> texture_;
 
-    /// \brief The starting & ending colors used in the gradient fill.
+    /// \brief The pixel color of each step along the fill direction.
     ///
-    /// \todo Finish implementing vectorized color container support; we only
-    /// use the first and last color of whatever is set in the container at the
-    /// moment.
+    /// \see ::update_ramp
+    std::vector<uint32> ramp_;
+
+    /// \brief The color stops used in the gradient fill.
     Color4iColors gradient_;
 
     /// \brief Additional offset coordinates, in pixels.
@@ -0,0 +1,157 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#ifndef NOMLIB_GRAPHICS_QUAD_BATCH_HPP
+#define NOMLIB_GRAPHICS_QUAD_BATCH_HPP
+
+#include <vector>
+
+#include <SDL.h>
+
+#include "nomlib/config.hpp"
+#include "nomlib/math/Color4.hpp"
+#include "nomlib/math/Point2.hpp"
+#include "nomlib/math/Size2.hpp"
+#include "nomlib/math/Rect.hpp"
+
+// SDL_RenderGeometry was introduced in SDL 2.0.18; older versions fall back
+// to one SDL_RenderCopy call per quad.
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  #define NOM_USE_SDL2_RENDER_GEOMETRY
+#endif
+
+namespace nom {
+
+// Forward declarations
+class Texture;
+
+/// \brief A list of textured quads that share a single texture source.
+class QuadBatch
+{
+  public:
+    typedef QuadBatch self_type;
+
+    /// \brief Default constructor; initialize an empty batch.
+    QuadBatch();
+
+    /// \brief Destructor.
+    ~QuadBatch();
+
+    /// \brief Get the number of quads stored in the batch.
+    nom::size_type size() const;
+
+    /// \brief Query whether or not the batch has any quads to render.
+    bool empty() const;
+
+    /// \brief Get the rectangle enclosing all of the quads, relative to the
+    /// origin of the batch.
+    ///
+    /// \returns IntRect::zero when the batch is empty.
+    const IntRect& bounds() const;
+
+    /// \brief Pre-allocate storage for the given number of quads.
+    void reserve(nom::size_type quads);
+
+    /// \brief Remove all of the quads from the batch.
+    ///
+    /// \remarks The allocated storage is kept for re-use.
+    void clear();
+
+    /// \brief Append a quad to the batch.
+    ///
+    /// \param source The bounds of the quad within the texture source.
+    /// \param dest   The rendering position and size of the quad, relative to
+    ///               the origin of the batch.
+    void append(const IntRect& source, const IntRect& dest);
+
+    /// \brief Render every quad of the batch in a single submission.
+    ///
+    /// \param target   The rendering context to draw to.
+    /// \param texture  The texture source that the quads are copied from.
+    /// \param offset   The rendering position of the batch origin.
+    /// \param color    The color and alpha modulation of every quad.
+    ///
+    /// \remarks The geometry is only rebuilt when the quads, offset, color or
+    /// texture dimensions have changed since the previous call.
+    ///
+    /// \note Without SDL_RenderGeometry, the color parameter is unused and the
+    /// texture's own color and alpha modulation applies instead.
+    void draw(  SDL_Renderer* target, const Texture& texture,
+                const Point2i& offset, const Color4i& color ) const;
+
+  private:
+    /// \brief Texture source bounds; one per quad.
+    std::vector<SDL_Rect> sources_;
+
+    /// \brief Rendering bounds relative to the batch origin; one per quad.
+    std::vector<SDL_Rect> dests_;
+
+    /// \brief The union of all of the destination bounds.
+    IntRect bounds_;
+
+    #if defined(NOM_USE_SDL2_RENDER_GEOMETRY)
+      /// \brief Rebuild the vertex and index buffers used by SDL's geometry
+      /// renderer.
+      void update_geometry( const Size2i& texture_dims, const Point2i& offset,
+                            const Color4i& color ) const;
+
+      mutable std::vector<SDL_Vertex> vertices_;
+      mutable std::vector<int> indices_;
+
+      /// \brief The state the vertex buffer was last built with.
+      mutable bool geometry_dirty_;
+      mutable Size2i geometry_dims_;
+      mutable Point2i geometry_offset_;
+      mutable Color4i geometry_color_;
+    #endif
+};
+
+} // namespace nom
+
+#endif // include guard defined
+
+/// \class nom::QuadBatch
+/// \ingroup graphics
+///
+/// A batch is built up once with ::append -- for example, one quad per glyph
+/// of a text string, copied from the font's texture atlas -- and may then be
+/// drawn every frame at the cost of one render call, instead of one render
+/// call per quad.
+///
+/// \code
+///
+/// nom::QuadBatch batch;
+///
+/// batch.append( IntRect(0, 0, 8, 8), IntRect(0, 0, 8, 8) );
+/// batch.append( IntRect(8, 0, 8, 8), IntRect(9, 0, 8, 8) );
+///
+/// // Rendering loop
+/// batch.draw( window.renderer(), atlas, Point2i(25, 25), Color4i::White );
+///
+/// \endcode
+///
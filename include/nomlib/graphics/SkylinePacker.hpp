@@ -0,0 +1,126 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#ifndef NOMLIB_GRAPHICS_SKYLINE_PACKER_HPP
+#define NOMLIB_GRAPHICS_SKYLINE_PACKER_HPP
+
+#include <vector>
+
+#include "nomlib/config.hpp"
+#include "nomlib/math/Rect.hpp"
+#include "nomlib/math/Size2.hpp"
+
+namespace nom {
+
+/// \brief Rectangle bin packer for texture atlases
+///
+/// \remarks The packer tracks the upper contour (skyline) of the rectangles
+/// placed so far, and places each new rectangle at the lowest position along
+/// the skyline that it fits in.
+class SkylinePacker
+{
+  public:
+    typedef SkylinePacker self_type;
+
+    /// \brief Default constructor; initialize an empty bin.
+    SkylinePacker();
+
+    /// \brief Construct a packer for a bin of the given dimensions.
+    SkylinePacker(const Size2i& bin_size);
+
+    ~SkylinePacker();
+
+    /// \brief Get the dimensions of the bin.
+    const Size2i& size() const;
+
+    /// \brief Get the fraction of the bin's area covered by the rectangles
+    /// packed so far, in the range of 0..1.
+    real32 occupancy() const;
+
+    /// \brief Forget all of the packed rectangles and start over with an
+    /// empty bin.
+    void reset(const Size2i& bin_size);
+
+    /// \brief Enlarge the bin.
+    ///
+    /// \remarks The rectangles packed so far keep their positions; the new
+    /// space is appended to the right and bottom edges of the bin. Requests to
+    /// shrink the bin are ignored.
+    void grow(const Size2i& bin_size);
+
+    /// \brief Find room for a rectangle.
+    ///
+    /// \param dims The width and height of the rectangle.
+    ///
+    /// \returns The position of the rectangle within the bin on success, or
+    /// nom::IntRect::null when there is no room left in the bin.
+    IntRect pack(const Size2i& dims);
+
+  private:
+    /// \brief A horizontal segment of the skyline.
+    struct SkylineNode
+    {
+      int x;
+      int y;
+      int width;
+    };
+
+    /// \brief Get the height that a rectangle would rest at when placed at
+    /// the left edge of a segment.
+    ///
+    /// \returns The resting height, or -1 when the rectangle does not fit.
+    int fit(nom::size_type index, const Size2i& dims) const;
+
+    /// \brief Raise the skyline over a newly placed rectangle.
+    void add_level(nom::size_type index, const IntRect& rect);
+
+    /// \brief Join adjacent segments of the same height.
+    void merge();
+
+    std::vector<SkylineNode> skyline_;
+
+    Size2i size_;
+
+    /// \brief The area covered by the rectangles packed so far.
+    int64 used_area_;
+};
+
+} // namespace nom
+
+#endif // include guard defined
+
+/// \class nom::SkylinePacker
+/// \ingroup graphics
+///
+/// \brief Bottom-left skyline rectangle packing.
+///
+/// \see nom::TrueTypeFont
+///
+/// # References
+/// [A Thousand Ways to Pack the Bin](http://clb.demon.fi/files/RectangleBinPack.pdf)
+///
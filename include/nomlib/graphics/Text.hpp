@@ -30,7 +30,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define NOMLIB_GRAPHICS_TEXT_HPP
 
 #include <iostream>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "nomlib/config.hpp"
 #include "nomlib/graphics/IDrawable.hpp"
@@ -38,6 +40,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nomlib/math/Point2.hpp"
 #include "nomlib/math/Size2.hpp"
 #include "nomlib/graphics/Texture.hpp"
+#include "nomlib/graphics/QuadBatch.hpp"
 #include "nomlib/graphics/fonts/Font.hpp"
 
 namespace nom {
@@ -64,9 +67,49 @@ class Text: public Transformable
       Strikethrough = 16
     };
 
+    /// \brief The available strategies for rendering the text's glyphs.
+    enum RenderMode: uint32
+    {
+      /// \brief The glyph quads are laid out once from the font's texture
+      /// atlas and submitted in a single batched draw call (default).
+      GlyphBatch = 0,
+
+      /// \brief The glyphs are rendered once to an intermediate texture that
+      /// is drawn in their place.
+      ///
+      /// \remarks The texture is only rendered again after the text string,
+      /// font, point size, color or style has changed, which makes this mode
+      /// the better choice for static text, such as labels and menu entries.
+      /// The text falls back to Text::RenderMode::GlyphBatch while its texture
+      /// would not fit within the cache budget.
+      ///
+      /// \see ::set_cache_budget
+      RenderToTexture
+    };
+
+    /// \brief The default memory budget, in bytes, shared by the textures of
+    /// every text using Text::RenderMode::RenderToTexture.
+    static const nom::size_type DEFAULT_CACHE_BUDGET;
+
     /// Default constructor
     Text( void );
 
+    /// \brief Get the memory budget, in bytes, of the rendered text textures.
+    static nom::size_type cache_budget();
+
+    /// \brief Get the memory, in bytes, used by the rendered text textures.
+    static nom::size_type cache_memory();
+
+    /// \brief Set the memory budget, in bytes, shared by the textures of every
+    /// text using Text::RenderMode::RenderToTexture.
+    ///
+    /// \remarks Lowering the budget does not release existing textures; it
+    /// only prevents new textures from being created until enough memory has
+    /// been released.
+    ///
+    /// \see Text::DEFAULT_CACHE_BUDGET
+    static void set_cache_budget(nom::size_type bytes);
+
     /// Destructor
     ~Text( void );
 
@@ -90,18 +133,14 @@ class Text: public Transformable
 
     /// \brief Copy constructor.
     ///
-    /// \internal
-    /// \remarks This is necessary for the std::unique_ptr instance we use for
-    /// the cached texture.
-    /// \endinternal
+    /// \remarks The rendered text texture is not shared with the copy; the
+    /// copy renders its own texture when it is first drawn.
     Text(const self_type& rhs);
 
     /// \brief Copy assignment operator.
     ///
-    /// \internal
-    /// \remarks This is necessary for the std::unique_ptr instance we use for
-    /// the cached texture.
-    /// \endinternal
+    /// \remarks The rendered text texture is not shared with the copy; the
+    /// copy renders its own texture when it is first drawn.
     self_type& operator =(const self_type& rhs);
 
     /// \brief Set the position of the rendered text.
@@ -136,6 +175,9 @@ class Text: public Transformable
     /// \remarks  This calculation should mimic the rendering calculations
     ///           precisely.
     ///
+    /// \note The width of the object's own text string is cached; see
+    /// Transformable::size.
+    ///
     /// \returns  Non-negative integer value of the object's text string width,
     ///           in pixels, on success. Zero (0) integer value on failure;
     ///           a possible combination of: no font, bad font, no text string
@@ -165,6 +207,18 @@ class Text: public Transformable
     /// Get text character size (in pixels?)
     uint text_size ( void ) const;
 
+    /// \brief Get the rendering strategy used for the text.
+    ///
+    /// \see Text::RenderMode
+    RenderMode render_mode() const;
+
+    /// \brief Get whether the text is drawn from its rendered texture.
+    ///
+    /// \returns Boolean TRUE when the text uses
+    /// Text::RenderMode::RenderToTexture and its texture is up to date, and
+    /// boolean FALSE otherwise.
+    bool cached() const;
+
     /// \brief Set the font to use in rendering text.
     ///
     /// \remarks You must ensure that you are passing a valid nom::Font object
@@ -205,13 +259,95 @@ class Text: public Transformable
     /// when supported by the underlying font type.
     void set_text_kerning(bool state);
 
+    /// \brief Set the rendering strategy used for the text.
+    ///
+    /// \remarks The rendered text texture is released when switching to
+    /// Text::RenderMode::GlyphBatch.
+    ///
+    /// \see Text::RenderMode
+    void set_render_mode(RenderMode mode);
+
     /// Render text to a target
     ///
+    /// \remarks With Text::RenderMode::RenderToTexture, the texture of the
+    /// text is rendered here when it is out of date, so that any number of
+    /// changes between two frames cost one rendering.
+    ///
     /// \todo Test horizontal tabbing '\t'
     void draw(RenderTarget& target) const;
 
   private:
-    void render_text(RenderTarget& target) const;
+    /// \brief The state that must be refreshed on the next ::update call.
+    enum DirtyFlags: uint32
+    {
+      NotDirty = 0x0,
+
+      /// \brief Glyph positions, line breaks and text dimensions.
+      DirtyLayout = 0x1,
+
+      /// \brief The font's texture atlas.
+      DirtyAtlas = 0x2,
+
+      /// \brief The color modulation of the glyphs.
+      DirtyColor = 0x4,
+
+      /// \brief The texture of Text::RenderMode::RenderToTexture.
+      ///
+      /// \remarks This is implied by every other flag.
+      DirtyCache = 0x8
+    };
+
+    /// \brief The metrics of one line of laid out text.
+    struct TextLine
+    {
+      /// \brief The position of the first character of the line within the
+      /// text string.
+      nom::size_type begin;
+
+      /// \brief The position one past the last character of the line.
+      nom::size_type end;
+
+      /// \brief The width of the line, in pixels.
+      int width;
+    };
+
+    typedef std::vector<TextLine> TextLines;
+
+    /// \brief Submit the laid out glyphs to a rendering target.
+    ///
+    /// \param offset The rendering position of the text's origin.
+    void render_text(RenderTarget& target, const Point2i& offset) const;
+
+    /// \brief Compute the positions of every glyph in a text string.
+    ///
+    /// \param text_buffer The text string to lay out.
+    /// \param glyphs      The batch to append the glyph quads to, relative to
+    ///                    the text's origin; may be NULL.
+    /// \param lines       The line metrics output; may be NULL.
+    ///
+    /// \remarks This walks the font's kerning and glyph metrics once per
+    /// character, and is shared by the rendering and size calculations so
+    /// that the two always agree.
+    void layout_text( const std::string& text_buffer, QuadBatch* glyphs,
+                      TextLines* lines ) const;
+
+    /// \brief Lay out the quads of every glyph in the text string from the
+    /// font's texture atlas.
+    ///
+    /// \remarks This is only necessary when the text string, font, point size,
+    /// style or kerning changes.
+    ///
+    /// \see ::update
+    void update_layout();
+
+    /// \brief Copy the font's texture atlas into the texture that glyphs are
+    /// rendered from.
+    ///
+    /// \remarks The texture is re-created when the size of the atlas has
+    /// changed.
+    ///
+    /// \see ::update
+    bool update_atlas();
 
     /// \brief Apply requested transformations, styles, etc
     ///
@@ -222,29 +358,64 @@ class Text: public Transformable
     /// \note Implements nom::IDrawable::update.
     void update();
 
-    /// \brief Get the current text width.
+    /// \brief Get the current text width from the cached layout.
     int width() const;
 
-    /// \brief Get the current text height.
+    /// \brief Get the current text height from the cached layout.
     int height() const;
 
-    bool update_cache();
+    /// \brief Render the laid out glyphs into nom::Text::rendered_text_.
+    ///
+    /// \returns Boolean FALSE when the texture could not be rendered, such as
+    /// when it would exceed the cache budget.
+    ///
+    /// \see ::draw
+    bool update_cache() const;
 
-    int
-    multiline_width(const std::string& text_buffer, nom::size_type pos) const;
+    /// \brief Free the rendered text texture and return its memory to the
+    /// cache budget.
+    void release_cache() const;
+
+    static nom::size_type cache_budget_;
+    static nom::size_type cache_memory_;
 
     Font font_;
 
     /// \brief A texture atlas created from the nom::Font instance that is
     /// referred to in rendering a text.
     ///
-    /// \see ::set_text_size, ::update, ::render_text
+    /// \see ::update_atlas, ::render_text
     mutable Texture glyphs_texture_;
 
+    /// \brief The revision of the font's texture atlas that was last copied
+    /// into nom::Text::glyphs_texture_.
+    ///
+    /// \see nom::IFont::image_revision
+    uint32 atlas_revision_ = 0;
+
+    /// \brief The glyph quads of the text, laid out relative to the text's
+    /// origin.
+    ///
+    /// \see ::update_layout, ::render_text
+    QuadBatch glyphs_batch_;
+
+    /// \brief The line breaks of the text, computed with the glyph quads.
+    ///
+    /// \see ::update_layout
+    TextLines lines_;
+
     /// \brief The texture containing the rendered text.
     ///
     /// \see ::update_cache, ::texture, ::draw
-    std::unique_ptr<Texture> rendered_text_;
+    mutable std::unique_ptr<Texture> rendered_text_;
+
+    /// \brief The memory charged against the cache budget for
+    /// nom::Text::rendered_text_, in bytes.
+    mutable nom::size_type cache_bytes_ = 0;
+
+    /// \brief Whether nom::Text::rendered_text_ must be rendered again before
+    /// it is drawn.
+    mutable bool cache_dirty_ = false;
 
     /// Holds contents of text as a string buffer
     std::string text_;
@@ -254,8 +425,13 @@ class Text: public Transformable
     /// Current text effect set
     uint32 style_;
 
+    /// \see Text::RenderMode
+    RenderMode render_mode_;
+
+    /// \brief A bit mask of Text::DirtyFlags.
+    ///
     /// \see nom::Text::update
-    bool dirty_;
+    uint32 dirty_;
 };
 
 } // namespace nom
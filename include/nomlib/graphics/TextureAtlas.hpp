@@ -0,0 +1,266 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#ifndef NOMLIB_GRAPHICS_TEXTURE_ATLAS_HPP
+#define NOMLIB_GRAPHICS_TEXTURE_ATLAS_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <map>
+
+#include "nomlib/config.hpp"
+#include "nomlib/math/Rect.hpp"
+#include "nomlib/math/Size2.hpp"
+#include "nomlib/graphics/SkylinePacker.hpp"
+
+namespace nom {
+
+// Forward declarations
+class Image;
+class Texture;
+class SpriteSheet;
+
+/// \brief Run-time packing of many small images into a few large textures
+class TextureAtlas
+{
+  public:
+    typedef TextureAtlas self_type;
+
+    /// \brief An opaque identifier of an image packed into the atlas.
+    typedef uint32 handle_type;
+
+    /// \brief The handle value that never refers to an image.
+    static const handle_type INVALID_HANDLE = 0;
+
+    /// \brief The default width and height of the atlas pages, in pixels.
+    static const Size2i DEFAULT_PAGE_SIZE;
+
+    /// \brief The pixel format of the atlas pages.
+    static const uint32 PIXEL_FORMAT;
+
+    /// \brief Default constructor; pages are created with
+    /// TextureAtlas::DEFAULT_PAGE_SIZE and one pixel of padding.
+    TextureAtlas();
+
+    /// \brief Construct an atlas with custom page dimensions.
+    ///
+    /// \param page_size The width and height of the atlas pages; this should
+    /// not exceed nom::Texture::maximum_size.
+    /// \param padding   The number of transparent pixels kept between images,
+    /// so that filtering does not bleed neighbouring images into each other.
+    TextureAtlas(const Size2i& page_size, int padding = 1);
+
+    ~TextureAtlas();
+
+    /// \brief Disabled copy constructor.
+    TextureAtlas(const self_type& rhs) = delete;
+
+    /// \brief Disabled copy assignment operator.
+    self_type& operator =(const self_type& rhs) = delete;
+
+    /// \brief Get the number of images packed into the atlas.
+    nom::size_type size() const;
+
+    /// \brief Get the number of textures that the images are packed into.
+    nom::size_type pages() const;
+
+    /// \brief Get the dimensions of a page.
+    Size2i page_size(nom::size_type page) const;
+
+    /// \brief Get the fraction of a page's area used by images, in the range
+    /// of 0..1.
+    real32 occupancy(nom::size_type page) const;
+
+    /// \brief Get whether a handle refers to an image of this atlas.
+    bool valid(handle_type handle) const;
+
+    /// \brief Get the page that an image is packed into.
+    ///
+    /// \returns The page index, or nom::npos for an invalid handle.
+    nom::size_type page(handle_type handle) const;
+
+    /// \brief Get the position of an image within its page.
+    ///
+    /// \returns The bounds of the image, or nom::IntRect::null for an invalid
+    /// handle.
+    IntRect bounds(handle_type handle) const;
+
+    /// \brief Get the handle of a named image.
+    ///
+    /// \returns The handle of the image, or TextureAtlas::INVALID_HANDLE when
+    /// no image is known by the name.
+    handle_type find(const std::string& name) const;
+
+    /// \brief Pack a copy of an image into the atlas.
+    ///
+    /// \returns A handle to the packed image on success, or
+    /// TextureAtlas::INVALID_HANDLE on failure.
+    ///
+    /// \remarks The image is not visible to the atlas textures until the next
+    /// ::build call. Images that are larger than the page size are given a
+    /// page of their own.
+    handle_type insert(const Image& source);
+
+    /// \brief Pack a copy of an image into the atlas under a name.
+    ///
+    /// \remarks When an image of the same name has already been packed, its
+    /// handle is returned and the atlas is left untouched.
+    ///
+    /// \see ::find
+    handle_type insert(const std::string& name, const Image& source);
+
+    /// \brief Load an image file and pack it into the atlas, using the file
+    /// path as its name.
+    ///
+    /// \see nom::Image::load
+    handle_type load_file(const std::string& filename);
+
+    /// \brief Upload the images packed since the last call to the textures.
+    ///
+    /// \remarks Only the modified area of each page is uploaded; the textures
+    /// already in use by sprites are updated in place.
+    ///
+    /// \note A valid rendering context is required.
+    bool build();
+
+    /// \brief Free every page and image of the atlas.
+    ///
+    /// \remarks Textures already handed out remain valid until they are
+    /// destroyed; existing handles become invalid.
+    void clear();
+
+    /// \brief Get a new texture instance that renders an entire page.
+    ///
+    /// \remarks The returned texture shares its pixels with the page, while
+    /// its position, size and bounds are its own -- which makes it suitable
+    /// for nom::SpriteBatch, combined with ::sprite_sheet.
+    ///
+    /// \returns The texture, or NULL when the page is out of range or has
+    /// not been built yet.
+    std::shared_ptr<Texture> page_texture(nom::size_type page) const;
+
+    /// \brief Get a new texture instance that renders a single image.
+    ///
+    /// \remarks The returned texture shares its pixels with the page, and is
+    /// bound to the area of the image -- which makes it suitable for
+    /// nom::Sprite::set_texture.
+    ///
+    /// \returns The texture, or NULL when the handle is invalid or its page
+    /// has not been built yet.
+    std::shared_ptr<Texture> texture(handle_type handle) const;
+
+    /// \brief Describe a sequence of images as the frames of a sprite sheet.
+    ///
+    /// \param frames The images, in frame order; they must all be packed into
+    /// the same page.
+    ///
+    /// \returns The sprite sheet on success, or an empty sprite sheet when a
+    /// handle is invalid or the images span multiple pages.
+    ///
+    /// \see ::page_texture, nom::SpriteBatch::set_sprite_sheet
+    SpriteSheet sprite_sheet(const std::vector<handle_type>& frames) const;
+
+  private:
+    static const char* DEBUG_CLASS_NAME;
+
+    /// \brief A texture of the atlas, along with a copy of its pixels that
+    /// new images are packed into.
+    struct AtlasPage
+    {
+      std::shared_ptr<Image> image;
+      std::shared_ptr<Texture> texture;
+      SkylinePacker packer;
+
+      /// \brief The area of the image that has changed since the texture was
+      /// last uploaded, or nom::IntRect::null.
+      IntRect dirty = IntRect::null;
+    };
+
+    /// \brief The location of a packed image.
+    struct AtlasRegion
+    {
+      nom::size_type page;
+      IntRect bounds;
+    };
+
+    /// \brief Append a page of the given dimensions.
+    bool add_page(const Size2i& dims);
+
+    Size2i page_size_;
+    int padding_;
+
+    std::vector<AtlasPage> pages_;
+
+    /// \brief The packed images, indexed by their handle minus one.
+    std::vector<AtlasRegion> regions_;
+
+    /// \brief The index of the named images.
+    std::map<std::string, handle_type> names_;
+};
+
+} // namespace nom
+
+#endif // include guard defined
+
+/// \class nom::TextureAtlas
+/// \ingroup graphics
+///
+/// \brief Every distinct texture drawn in a frame costs the renderer a state
+/// change. Packing the small images of a scene -- icons, interface pieces,
+/// sprite frames -- into a handful of large pages lets sprites that share a
+/// page be drawn without switching textures in between.
+///
+/// Images are packed with nom::SkylinePacker as they are inserted, and their
+/// pixels are uploaded on the next ::build call.
+///
+/// ## Usage Examples
+///
+/// \code
+///
+/// nom::TextureAtlas atlas;
+///
+/// auto icon = atlas.load_file("icon.png");
+/// auto walk0 = atlas.load_file("walk0.png");
+/// auto walk1 = atlas.load_file("walk1.png");
+///
+/// atlas.build();
+///
+/// nom::Sprite sprite;
+/// auto icon_tex = atlas.texture(icon);
+/// sprite.set_texture(icon_tex);
+///
+/// nom::SpriteBatch walk;
+/// auto walk_tex = atlas.page_texture( atlas.page(walk0) );
+/// walk.set_texture(walk_tex);
+/// walk.set_sprite_sheet( atlas.sprite_sheet( {walk0, walk1} ) );
+///
+/// \endcode
+///
+/// \see nom::Sprite, nom::SpriteBatch
+///
@@ -97,6 +97,9 @@ class BMFont: public IFont
     /// \param character_size Not implemented.
     const Image* image(uint32 character_size) const override;
 
+    /// \param character_size Not implemented.
+    uint32 image_revision(uint32 character_size) const override;
+
     /// \param codepoint      The char identifier (an ASCII value) to lookup.
     /// \param character_size Not implemented.
     const Glyph& glyph(uint32 codepoint, uint32 character_size) const override;
@@ -78,6 +78,8 @@ class BitmapFont: public IFont
 
     const Image* image(uint32 character_size) const override;
 
+    uint32 image_revision(uint32 character_size) const override;
+
     /// \brief Obtain text character spacing width in pixels
     ///
     /// \returns  The width applied when the space carriage is encountered when
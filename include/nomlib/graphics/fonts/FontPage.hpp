@@ -32,8 +32,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <map>
 
 #include "nomlib/config.hpp"
-#include "nomlib/graphics/fonts/Glyph.hpp"
-#include "nomlib/graphics/fonts/FontRow.hpp"
+#include "nomlib/graphics/fonts/GlyphAtlas.hpp"
+#include "nomlib/graphics/SkylinePacker.hpp"
 
 namespace nom {
 
@@ -60,15 +60,23 @@ struct FontPage
   /// Container for the glyph's pixel buffer
   std::shared_ptr<Image> texture;
 
-  /// Y position of the next new row in the texture
-  uint next_row;
+  /// \brief The layout of the glyphs within the texture.
+  ///
+  /// \remarks Only used by fonts that add glyphs to the page on demand.
+  SkylinePacker packer;
 
-  /// Positioning of all the existing rows
-  PageRow rows;
+  /// \brief A number that changes each time that the texture of the page is
+  /// modified.
+  ///
+  /// \see nom::IFont::image_revision
+  uint32 revision;
 };
 
 /// Table mapping glyph data with its corresponding texture
-typedef std::map<uint32, FontPage> GlyphPage;
+///
+/// \remarks The key is defined by the font; nom::TrueTypeFont combines the
+/// character size with the font style and outline.
+typedef std::map<uint64, FontPage> GlyphPage;
 
 } // namespace nom
 
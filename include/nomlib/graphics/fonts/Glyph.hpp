@@ -29,7 +29,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef NOMLIB_GRAPHICS_GLYPH_HPP
 #define NOMLIB_GRAPHICS_GLYPH_HPP
 
-#include <map>
+#include <ostream>
+#include <string>
 
 #include "nomlib/config.hpp"
 #include "nomlib/math/Rect.hpp"
@@ -63,9 +64,6 @@ struct Glyph
   Point2i offset = Point2i::zero;
 };
 
-/// Table mapping glyph data with its corresponding texture
-typedef std::map<uint32, Glyph> GlyphAtlas;
-
 /// Pretty print the glyph
 inline std::ostream& operator << ( std::ostream& os, const Glyph& mode );
 
@@ -0,0 +1,127 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#ifndef NOMLIB_GRAPHICS_FONTS_GLYPH_ATLAS_HPP
+#define NOMLIB_GRAPHICS_FONTS_GLYPH_ATLAS_HPP
+
+#include <bitset>
+#include <utility>
+#include <vector>
+
+#include "nomlib/config.hpp"
+#include "nomlib/graphics/fonts/Glyph.hpp"
+
+namespace nom {
+
+/// \brief Table mapping glyph data with its corresponding texture
+///
+/// \remarks Glyphs within the ASCII and Latin-1 range are stored in a table
+/// indexed directly by their codepoint; all other glyphs are stored in a
+/// table sorted by their codepoint.
+class GlyphAtlas
+{
+  public:
+    typedef GlyphAtlas self_type;
+
+    /// \brief The number of codepoints stored in the directly indexed table.
+    static const uint32 DIRECT_RANGE = 256;
+
+    GlyphAtlas();
+
+    ~GlyphAtlas();
+
+    /// \brief Get the total number of glyphs stored.
+    nom::size_type size() const;
+
+    /// \brief Get whether or not the atlas holds any glyphs.
+    bool empty() const;
+
+    /// \brief Remove all of the glyphs.
+    void clear();
+
+    /// \brief Get whether or not a glyph exists for a codepoint.
+    bool contains(uint32 codepoint) const;
+
+    /// \brief Find the glyph of a codepoint.
+    ///
+    /// \returns A pointer to the glyph, or NULL when there is no glyph stored
+    /// for the codepoint.
+    const Glyph* find(uint32 codepoint) const;
+
+    /// \brief Find the glyph of a codepoint.
+    ///
+    /// \returns A pointer to the glyph, or NULL when there is no glyph stored
+    /// for the codepoint.
+    Glyph* find(uint32 codepoint);
+
+    /// \brief Get the glyph of a codepoint.
+    ///
+    /// \returns A reference to the glyph, or a reference to an empty glyph
+    /// when there is no glyph stored for the codepoint.
+    ///
+    /// \remarks This is the lookup used by nom::IFont::glyph.
+    const Glyph& glyph(uint32 codepoint) const;
+
+    /// \brief Get the glyph of a codepoint, inserting an empty glyph when
+    /// there is none stored.
+    ///
+    /// \remarks This has the same semantics as std::map::operator[]; inserting
+    /// a codepoint outside of the directly indexed range invalidates
+    /// references to the glyphs of the other codepoints outside of the range.
+    Glyph& operator [](uint32 codepoint);
+
+  private:
+    typedef std::pair<uint32, Glyph> extended_glyph;
+
+    typedef std::vector<extended_glyph> extended_container;
+
+    /// \brief The glyphs of the codepoints below nom::GlyphAtlas::DIRECT_RANGE.
+    ///
+    /// \remarks The table is allocated when the first glyph in its range is
+    /// stored.
+    std::vector<Glyph> direct_glyphs_;
+
+    /// \brief The codepoints below nom::GlyphAtlas::DIRECT_RANGE that have a
+    /// glyph stored.
+    std::bitset<DIRECT_RANGE> direct_index_;
+
+    /// \brief The glyphs of all other codepoints, sorted by codepoint.
+    extended_container extended_glyphs_;
+};
+
+} // namespace nom
+
+#endif // include guard defined
+
+/// \class nom::GlyphAtlas
+/// \ingroup graphics
+///
+/// \brief Storage of the glyphs of a nom::FontPage.
+///
+/// \see nom::BitmapFont, nom::BMFont, nom::TrueTypeFont
+///
@@ -73,6 +73,13 @@ class IFont
     virtual bool valid ( void ) const = 0;
 
     virtual const Image* image(uint32) const = 0;
+
+    /// \brief Get a number that changes each time that the texture atlas of
+    /// a character size is modified.
+    ///
+    /// \remarks nom::Text compares this number to decide when its copy of the
+    /// texture atlas must be refreshed.
+    virtual uint32 image_revision(uint32) const = 0;
     virtual enum IFont::FontType type ( void ) const = 0;
 
     virtual const Glyph& glyph ( uint32, uint32 ) const = 0;
@@ -119,7 +126,7 @@ class IFont
 /// See the source files of nom::BitmapFont for a complete example of how to
 /// write a custom font resource class that is suitable for nom::Text to
 /// render from. Supporting data structures include: nom::FontMetrics,
-/// nom::FontPage, nom::FontRow, nom::Glyph and so on.
+/// nom::FontPage, nom::GlyphAtlas, nom::Glyph and so on.
 ///
 /// \code
 ///
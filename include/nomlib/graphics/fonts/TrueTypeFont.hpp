@@ -31,6 +31,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <iostream>
 #include <string>
+#include <map>
 #include <memory>
 
 #include "nomlib/config.hpp"
@@ -72,6 +73,9 @@ class TrueTypeFont: public IFont
     ~TrueTypeFont ( void );
 
     /// \brief Copy constructor
+    ///
+    /// \remarks The glyph pages of the font are not copied; the copy
+    /// rasterizes its glyphs anew as they are requested.
     TrueTypeFont ( const TrueTypeFont& copy );
 
     /// \brief Construct a clone of the existing instance
@@ -86,10 +90,15 @@ class TrueTypeFont: public IFont
 
     /// Obtain the texture atlas used internally for rendering glyphs from
     ///
-    /// \remarks It is assumed that the requested character size is already
-    /// loaded into memory (using TrueTypeFont::set_point_size).
+    /// \remarks The atlas holds the glyphs of the current font style and
+    /// outline that have been used so far; it grows as new glyphs are
+    /// requested through ::glyph.
     const Image* image(uint32 character_size) const override;
 
+    /// \brief Get a number that changes each time that the texture atlas of
+    /// the current font style and outline is modified.
+    uint32 image_revision(uint32 character_size) const override;
+
     /// \brief Obtain text character spacing width in pixels
     ///
     /// \returns  The width applied when the space carriage is encountered when
@@ -124,10 +133,14 @@ class TrueTypeFont: public IFont
 
     /// \brief Obtain a glyph
     ///
-    /// \param    codepoint        ASCII character to lookup
-    /// \param    character_size   Reserved for future implementation
+    /// \param    codepoint        Character to lookup
+    /// \param    character_size   Point size in pixels
     ///
     /// \returns  nom::Glyph structure
+    ///
+    /// \remarks Glyphs are rasterized into the texture atlas the first time
+    /// that they are requested; an empty glyph is returned for characters
+    /// that the font does not provide.
     const Glyph& glyph ( uint32 codepoint, uint32 character_size ) const override;
 
     /// \brief Obtain font's outline size
@@ -148,14 +161,8 @@ class TrueTypeFont: public IFont
     ///
     /// \param size Point size in pixels
     ///
-    /// \remarks This is a potentially expensive call; if the glyphs for the
-    /// requested point size has not been stored (generated previously), the
-    /// generation of the font's ASCII glyph symbols must be done.
-    ///
-    /// \note For performance critical sections where scaling of the font
-    /// occurs (think: real-time), you may want to take advantage of the glyph
-    /// caching feature by making a call to this method for every used point
-    /// size of the scaling range.
+    /// \remarks The font file is opened once per point size; switching back
+    /// to a point size used before re-uses the face and glyphs of that size.
     bool set_point_size( int point_size ) override;
 
     /// \brief Set the requested font hinting style.
@@ -163,17 +170,16 @@ class TrueTypeFont: public IFont
     /// \remarks The hinting type, one of: TTF_HINTING_NORMAL, TTF_HINTING_LIGHT,
     /// TTF_HINTING_MONO or TTF_HINTING_NONE.
     ///
-    /// \note This method call forces a rebuild of the glyph cache if the input
-    /// type does not match the last known hinting.
-    ///
-    /// \fixme This feature is broken.
+    /// \note This method call discards the glyphs of every point size, style
+    /// and outline if the input type does not match the last known hinting.
     bool set_hinting( int type ) override;
 
     /// \brief Set font's outline size
     ///
     /// \param outline The outline size in pixels
     ///
-    /// \remarks This is an expensive method call; every glyph must be re-built!
+    /// \remarks The glyphs of each outline size are kept in their own texture
+    /// atlas, so switching between outline sizes does not re-build glyphs.
     bool set_outline( int outline ) override;
 
     /// \brief Set the rendering style of the font.
@@ -181,6 +187,9 @@ class TrueTypeFont: public IFont
     /// \param style A bit-mask composed of one or more of the following styles:
     /// TTF_STYLE_BOLD, TTF_STYLE_ITALIC, TTF_STYLE_UNDERLINE,
     /// TTF_STYLE_STRIKETHROUGH.
+    ///
+    /// \remarks The glyphs of each style are kept in their own texture atlas,
+    /// so switching between styles does not re-build glyphs.
     void set_font_style( uint32 style ) override;
 
     /// \brief Set the use of kerning for the font.
@@ -198,14 +207,43 @@ class TrueTypeFont: public IFont
     const FontMetrics& metrics( void ) const override;
 
   private:
-    /// \brief Trigger a rebuild of the font metrics from the current font; this
-    /// recalculates character sizes, coordinate origins, spacing, etc.
+    /// \brief Prepare the glyph page of a point size for the current font
+    /// style and outline.
     ///
     /// \param character_size Font's point size, in pixels, to build glyphs for.
-    bool build ( uint32 character_size );
+    ///
+    /// \remarks No glyphs are rasterized here; see ::rasterize.
+    bool build ( uint32 character_size ) const;
+
+    /// \brief Rasterize a glyph into a glyph page.
+    ///
+    /// \returns The new glyph, which is left empty when the font does not
+    /// provide the character.
+    const Glyph& rasterize( FontPage& page, uint32 codepoint,
+                            uint32 character_size ) const;
+
+    /// \brief Get the key of the glyph page of a point size for the current
+    /// font style and outline.
+    uint64 page_key(uint32 character_size) const;
+
+    /// \brief Get the font face opened at a point size.
+    ///
+    /// \remarks The face is opened on its first use, and its rendering
+    /// state is kept in sync with the current face.
+    TTF_Font* face(uint32 character_size) const;
+
+    /// \brief Re-read the font-wide metrics from the current face.
+    void update_metrics();
 
     const GlyphPage& pages ( void ) const;
 
+    /// \brief Get the glyph page of a character size for the current font
+    /// style and outline.
+    ///
+    /// \remarks The page used last is remembered, sparing a lookup in the
+    /// table of pages for consecutive calls with the same page key.
+    FontPage& page(uint32 character_size) const;
+
     sint sheet_width ( void ) const;
     sint sheet_height ( void ) const;
 
@@ -234,10 +272,28 @@ class TrueTypeFont: public IFont
     /// Font file data, used by SDL_ttf extension
     std::shared_ptr<TTF_Font> font_;
 
-    /// Table mapping a character size to its page -- a texture atlas combined
-    /// with corresponding glyphs data.
+    /// \brief The faces of the font file that have been opened, by point
+    /// size.
+    mutable std::map<uint32, std::shared_ptr<TTF_Font>> faces_;
+
+    /// Table mapping a character size, font style and outline to its page --
+    /// a texture atlas combined with corresponding glyphs data.
+    ///
+    /// \see ::page_key
     mutable GlyphPage pages_;
 
+    /// \brief The page of the last key requested from ::page.
+    ///
+    /// \remarks Pages are only erased when the font is re-loaded or its
+    /// hinting changes, which also resets this pointer.
+    mutable FontPage* last_page_ = nullptr;
+
+    /// \brief The page key of nom::TrueTypeFont::last_page_.
+    mutable uint64 last_page_key_ = 0;
+
+    /// \brief The source of the revision numbers of the glyph pages.
+    mutable uint32 revision_ = 0;
+
     /// General font metric data, such as the proper value for newline spacing
     FontMetrics metrics_;
 
@@ -279,11 +335,10 @@ class TrueTypeFont: public IFont
 ///
 /// // We must first load the font into memory from a file.
 ///
-/// // Cache the glyphs of the font's point size range that we plan on using;
-/// // offloads the cost of re-generating the glyph cache when the end-user
-/// // requests an increase or decrease. (An increase in load-time for a
-/// // decrease in latency upon rescaling, which is especially noticeable on
-/// // older platforms and mobile devices).
+/// // Open the faces of the font's point size range that we plan on using;
+/// // offloads the cost of re-opening the font file when the end-user
+/// // requests an increase or decrease. Glyphs are still only rasterized on
+/// // their first use.
 /// for( auto idx = 0; idx != MAX_FONT_POINT_SIZE; ++idx )
 /// {
 ///   font.set_point_size( idx + 1 );
@@ -55,6 +55,13 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nomlib/config.hpp"
 #include "nomlib/math/math_helpers.hpp"
 
+// SSE2 is part of the baseline of every x86-64 target
+#if defined(__SSE2__) || defined(_M_X64) || \
+    ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+  #define NOM_HQX_USE_SSE2
+  #include <emmintrin.h>
+#endif
+
 #define MASK_2     0x0000FF00
 #define MASK_13    0x00FF00FF
 #define MASK_RGB   0x00FFFFFF
@@ -70,13 +77,81 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace nom {
   namespace priv {
 
+/// \brief The strategies available for converting RGB pixels to YUV.
+///
+/// \remarks Both strategies produce identical results.
+///
+/// \see hqx_set_color_mode
+enum HQXColorMode
+{
+  /// \brief A direct lookup table of every 24-bit color (64 MiB), built on
+  /// first use (default).
+  HQX_COLOR_TABLE = 0,
+
+  /// \brief Per-channel weight tables (18 KiB); the YUV value is summed from
+  /// the weights of each channel on the fly.
+  HQX_COLOR_COMPACT
+};
+
+/// \brief The implementations available for the hqx pixel kernels.
+///
+/// \remarks Both implementations produce bit-identical results.
+///
+/// \see hqx_set_path
+enum HQXPath
+{
+  /// \brief The original, portable per-pixel code; kept as the reference
+  /// implementation.
+  HQX_PATH_SCALAR = 0,
+
+  /// \brief Interpolation and color difference tests computed with SIMD
+  /// instructions (default). Falls back to HQX_PATH_SCALAR when the engine is
+  /// built for a target without SSE2.
+  HQX_PATH_SIMD
+};
+
+/// \brief The Y, U and V contributions of one 8-bit color channel.
+struct YUVWeights
+{
+  real64 y;
+  real64 u;
+  real64 v;
+};
+
 /* RGB to YUV lookup table */
-extern uint32 RGBtoYUV[16777216];
+///
+/// \remarks This is NULL until ::hqxInit has been called with the
+/// HQX_COLOR_TABLE mode.
+extern uint32* RGBtoYUV;
+
+/// \brief Per-channel weights used by the HQX_COLOR_COMPACT mode.
+extern YUVWeights RGBtoYUV_R[256];
+extern YUVWeights RGBtoYUV_G[256];
+extern YUVWeights RGBtoYUV_B[256];
+
+static inline uint32 rgb_to_yuv_compact(uint32 c)
+{
+    const YUVWeights& r = RGBtoYUV_R[(c & 0xFF0000) >> 16];
+    const YUVWeights& g = RGBtoYUV_G[(c & 0x00FF00) >> 8];
+    const YUVWeights& b = RGBtoYUV_B[c & 0x0000FF];
+
+    // NOTE: The summing order must match the full table's construction in
+    // order for both modes to produce identical results.
+    uint32 y = (uint32)(int32)(r.y + g.y + b.y);
+    uint32 u = (uint32)(int32)(r.u + g.u + b.u) + 128;
+    uint32 v = (uint32)(int32)(r.v + g.v + b.v) + 128;
+
+    return (y << 16) + (u << 8) + v;
+}
 
 static inline uint32 rgb_to_yuv(uint32 c)
 {
-    // Mask against MASK_RGB to discard the alpha channel
-    return RGBtoYUV[MASK_RGB & c];
+    if( RGBtoYUV != nullptr ) {
+      // Mask against MASK_RGB to discard the alpha channel
+      return RGBtoYUV[MASK_RGB & c];
+    }
+
+    return rgb_to_yuv_compact(c);
 }
 
 /// \todo Possible FIXME
@@ -178,6 +253,245 @@ static inline uint32 Interp10(uint32 c1, uint32 c2, uint32 c3)
     return Interpolate_3(c1, 14, c2, 1, c3, 1, 4);
 }
 
+/// \brief The scalar (reference) implementation of the pixel kernel
+/// operations.
+struct HQXScalarOps
+{
+  static inline uint32 Interp1(uint32 c1, uint32 c2)
+  {
+    return priv::Interp1(c1, c2);
+  }
+
+  static inline uint32 Interp2(uint32 c1, uint32 c2, uint32 c3)
+  {
+    return priv::Interp2(c1, c2, c3);
+  }
+
+  static inline uint32 Interp3(uint32 c1, uint32 c2)
+  {
+    return priv::Interp3(c1, c2);
+  }
+
+  static inline uint32 Interp4(uint32 c1, uint32 c2, uint32 c3)
+  {
+    return priv::Interp4(c1, c2, c3);
+  }
+
+  static inline uint32 Interp5(uint32 c1, uint32 c2)
+  {
+    return priv::Interp5(c1, c2);
+  }
+
+  static inline uint32 Interp6(uint32 c1, uint32 c2, uint32 c3)
+  {
+    return priv::Interp6(c1, c2, c3);
+  }
+
+  static inline uint32 Interp7(uint32 c1, uint32 c2, uint32 c3)
+  {
+    return priv::Interp7(c1, c2, c3);
+  }
+
+  static inline uint32 Interp8(uint32 c1, uint32 c2)
+  {
+    return priv::Interp8(c1, c2);
+  }
+
+  static inline uint32 Interp9(uint32 c1, uint32 c2, uint32 c3)
+  {
+    return priv::Interp9(c1, c2, c3);
+  }
+
+  static inline uint32 Interp10(uint32 c1, uint32 c2, uint32 c3)
+  {
+    return priv::Interp10(c1, c2, c3);
+  }
+
+  /// \brief Get the bit mask of the neighbours of w[5] that differ from it
+  /// in color.
+  ///
+  /// \param w The 3x3 pixel window, indexed from one.
+  static inline int32 pattern(const uint32* w)
+  {
+    int32 pattern = 0;
+    int32 flag = 1;
+
+    uint32 yuv1 = rgb_to_yuv(w[5]);
+
+    for( int32 k = 1; k <= 9; ++k ) {
+      if( k == 5 ) continue;
+
+      if( w[k] != w[5] ) {
+        uint32 yuv2 = rgb_to_yuv(w[k]);
+        if( yuv_diff(yuv1, yuv2) ) {
+          pattern |= flag;
+        }
+      }
+      flag <<= 1;
+    }
+
+    return pattern;
+  }
+};
+
+#if defined(NOM_HQX_USE_SSE2)
+
+/// \brief The SSE2 implementation of the pixel kernel operations.
+///
+/// \remarks Each color channel is widened to a 16-bit lane, so the weighted
+/// sums cannot overflow (255 * 16 < 2^16) and the results are bit-identical to
+/// HQXScalarOps.
+struct HQXSSE2Ops
+{
+  static inline __m128i unpack(uint32 c)
+  {
+    return _mm_unpacklo_epi8( _mm_cvtsi32_si128( (int)c ),
+                              _mm_setzero_si128() );
+  }
+
+  static inline uint32 pack(__m128i sum, int32 s)
+  {
+    sum = _mm_srl_epi16( sum, _mm_cvtsi32_si128(s) );
+
+    return (uint32)_mm_cvtsi128_si32( _mm_packus_epi16(sum, sum) );
+  }
+
+  static inline uint32 Interpolate_2( uint32 c1, int16 w1, uint32 c2,
+                                      int16 w2, int32 s )
+  {
+    if( c1 == c2 ) {
+      return c1;
+    }
+
+    __m128i sum =
+      _mm_add_epi16(  _mm_mullo_epi16( unpack(c1), _mm_set1_epi16(w1) ),
+                      _mm_mullo_epi16( unpack(c2), _mm_set1_epi16(w2) ) );
+
+    return pack(sum, s);
+  }
+
+  static inline uint32 Interpolate_3( uint32 c1, int16 w1, uint32 c2,
+                                      int16 w2, uint32 c3, int16 w3,
+                                      int32 s )
+  {
+    __m128i sum =
+      _mm_add_epi16(  _mm_mullo_epi16( unpack(c1), _mm_set1_epi16(w1) ),
+                      _mm_mullo_epi16( unpack(c2), _mm_set1_epi16(w2) ) );
+    sum = _mm_add_epi16( sum, _mm_mullo_epi16( unpack(c3),
+                                               _mm_set1_epi16(w3) ) );
+
+    return pack(sum, s);
+  }
+
+  static inline uint32 Interp1(uint32 c1, uint32 c2)
+  {
+    return Interpolate_2(c1, 3, c2, 1, 2);
+  }
+
+  static inline uint32 Interp2(uint32 c1, uint32 c2, uint32 c3)
+  {
+    return Interpolate_3(c1, 2, c2, 1, c3, 1, 2);
+  }
+
+  static inline uint32 Interp3(uint32 c1, uint32 c2)
+  {
+    return Interpolate_2(c1, 7, c2, 1, 3);
+  }
+
+  static inline uint32 Interp4(uint32 c1, uint32 c2, uint32 c3)
+  {
+    return Interpolate_3(c1, 2, c2, 7, c3, 7, 4);
+  }
+
+  static inline uint32 Interp5(uint32 c1, uint32 c2)
+  {
+    return Interpolate_2(c1, 1, c2, 1, 1);
+  }
+
+  static inline uint32 Interp6(uint32 c1, uint32 c2, uint32 c3)
+  {
+    return Interpolate_3(c1, 5, c2, 2, c3, 1, 3);
+  }
+
+  static inline uint32 Interp7(uint32 c1, uint32 c2, uint32 c3)
+  {
+    return Interpolate_3(c1, 6, c2, 1, c3, 1, 3);
+  }
+
+  static inline uint32 Interp8(uint32 c1, uint32 c2)
+  {
+    return Interpolate_2(c1, 5, c2, 3, 3);
+  }
+
+  static inline uint32 Interp9(uint32 c1, uint32 c2, uint32 c3)
+  {
+    return Interpolate_3(c1, 2, c2, 3, c3, 3, 3);
+  }
+
+  static inline uint32 Interp10(uint32 c1, uint32 c2, uint32 c3)
+  {
+    return Interpolate_3(c1, 14, c2, 1, c3, 1, 4);
+  }
+
+  /// \brief Get the bit mask of the neighbours of w[5] that differ from it
+  /// in color.
+  ///
+  /// \remarks The eight color difference tests of yuv_diff are done at once,
+  /// as saturated byte differences against the per-channel thresholds.
+  static inline int32 pattern(const uint32* w)
+  {
+    uint32 yuv1 = rgb_to_yuv(w[5]);
+    uint32 yuv[8];
+
+    for( int32 k = 1, n = 0; k <= 9; ++k ) {
+      if( k == 5 ) continue;
+
+      // Identical pixels never differ; skip the lookup
+      yuv[n] = ( w[k] != w[5] ) ? rgb_to_yuv(w[k]) : yuv1;
+      ++n;
+    }
+
+    const __m128i center = _mm_set1_epi32( (int)yuv1 );
+    const __m128i threshold = _mm_set1_epi32(trY | trU | trV);
+
+    __m128i lo = _mm_loadu_si128( (const __m128i*)&yuv[0] );
+    __m128i hi = _mm_loadu_si128( (const __m128i*)&yuv[4] );
+
+    // |a - b| for each (unsigned) byte
+    lo = _mm_or_si128(  _mm_subs_epu8(lo, center),
+                        _mm_subs_epu8(center, lo) );
+    hi = _mm_or_si128(  _mm_subs_epu8(hi, center),
+                        _mm_subs_epu8(center, hi) );
+
+    // Non-zero bytes exceed their channel threshold
+    lo = _mm_cmpeq_epi32( _mm_subs_epu8(lo, threshold), _mm_setzero_si128() );
+    hi = _mm_cmpeq_epi32( _mm_subs_epu8(hi, threshold), _mm_setzero_si128() );
+
+    int32 same =  _mm_movemask_ps( _mm_castsi128_ps(lo) ) |
+                  ( _mm_movemask_ps( _mm_castsi128_ps(hi) ) << 4 );
+
+    return ~same & 0xFF;
+  }
+};
+
+#endif // defined NOM_HQX_USE_SSE2
+
+/// \brief Rescale the source rows [row_begin, row_end) of an image.
+///
+/// \remarks The rows above and below the range are read, but never written,
+/// so distinct row ranges of one image may be scaled concurrently.
+typedef void (*hqx_rows_func)(  uint32* sp, uint32 srb, uint32* dp,
+                                uint32 drb, int32 Xres, int32 Yres,
+                                int32 row_begin, int32 row_end );
+
+/// \brief Rescale an image by splitting its rows into bands across threads.
+///
+/// \param scale The kernel to run on each band.
+///
+/// \see hqx_set_max_threads
+void hqx_scale_rows(  hqx_rows_func scale, uint32* sp, uint32 srb, uint32* dp,
+                      uint32 drb, int32 Xres, int32 Yres );
+
 /// Internal function for rescaling using hq2x algorithm
 void hq2x_32_rb( uint32* sp, uint32 srb, uint32* dp, uint32 drb, int32 Xres, int32 Yres );
 
@@ -187,9 +501,40 @@ void hq3x_32_rb( uint32* sp, uint32 srb, uint32* dp, uint32 drb, int32 Xres, int
 /// Internal function for rescaling using hq4x algorithm
 void hq4x_32_rb( uint32* sp, uint32 srb, uint32* dp, uint32 drb, int32 Xres, int32 Yres );
 
-/// Public interface for initialization of hqx algorithm
+/// \brief Public interface for initialization of hqx algorithm
+///
+/// \remarks The lookup tables of the current color mode are built at most
+/// once per process; subsequent calls are cheap and thread-safe.
 void hqxInit ( void );
 
+/// \brief Get the RGB to YUV conversion strategy.
+enum HQXColorMode hqx_color_mode();
+
+/// \brief Set the RGB to YUV conversion strategy used by the hqx scalers.
+///
+/// \remarks Switching to HQX_COLOR_COMPACT releases the full lookup table, if
+/// it was built. This must not be called while a scaling operation is in
+/// progress.
+void hqx_set_color_mode(enum HQXColorMode mode);
+
+/// \brief Get the implementation used by the pixel kernels.
+enum HQXPath hqx_path();
+
+/// \brief Set the implementation used by the pixel kernels.
+void hqx_set_path(enum HQXPath path);
+
+/// \brief Get the maximum number of threads used per rescale.
+uint32 hqx_max_threads();
+
+/// \brief Set the maximum number of threads used per rescale.
+///
+/// \param num_threads The thread count; zero uses the number of hardware
+/// threads (default). A value of one rescales on the calling thread only.
+///
+/// \remarks Small images are split into fewer bands than this, so that each
+/// thread has a worthwhile amount of work.
+void hqx_set_max_threads(uint32 num_threads);
+
 /// Public interface for scaling a video surface with the hq2x algorithm
 ///
 /// Note that we expect a *source* width & height.
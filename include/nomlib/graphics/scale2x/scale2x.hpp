@@ -36,6 +36,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "nomlib/config.hpp"
 
+// SSE2 is part of the baseline of every x86-64 target
+#if defined(__SSE2__) || defined(_M_X64) || \
+    ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+  #define NOM_SCALEX_USE_SSE2
+#endif
+
 /// Uses the AdvanceMAME bitmap scaling algorithm known as scale2x to scale
 /// a surface while maintaining the quality pixel art feel of the original
 /// art. The algorithm is designed to be fast enough to process 256x256
@@ -46,6 +52,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ///
 /// See http://scale2x.sourceforge.net/
 ///
+/// 32-bit surfaces -- the common case -- take a dedicated path that compares
+/// four pixels at a time with SSE2 instructions, and may split the image
+/// into row bands across threads.
+///
 /// \todo Test the implementation of 8-bit, 16-bit & 24-bit video scaling
 /// functions.
 
@@ -59,37 +69,85 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace nom {
   namespace priv {
 
+/// \brief The implementations available for the 32-bit scaling path.
+///
+/// \remarks Both implementations produce identical results.
+///
+/// \see scalex_set_path
+enum ScaleXPath
+{
+  /// \brief Portable per-pixel code; kept as the reference implementation.
+  SCALEX_PATH_SCALAR = 0,
+
+  /// \brief Four pixels per step using SSE2 instructions (default). Falls back
+  /// to SCALEX_PATH_SCALAR when the engine is built for a target without SSE2.
+  SCALEX_PATH_SIMD
+};
+
+/// \brief Rescale the source rows [row_begin, row_end) of an image.
+///
+/// \remarks The rows above and below the range are read, but never written,
+/// so distinct row ranges of one image may be scaled concurrently.
+typedef void (*scalex_rows_func)( const uint8* source_buffer,
+                                  int32 source_pitch,
+                                  uint8* destination_buffer,
+                                  int32 destination_pitch,
+                                  int32 source_width, int32 source_height,
+                                  int32 row_begin, int32 row_end );
+
+/// \brief Rescale an image by splitting its rows into bands across threads.
+///
+/// \param scale The function to run on each band.
+///
+/// \see scalex_set_max_threads
+void scalex_scale_rows( scalex_rows_func scale, const uint8* source_buffer,
+                        int32 source_pitch, uint8* destination_buffer,
+                        int32 destination_pitch, int32 source_width,
+                        int32 source_height );
+
+/// \brief Get the implementation used by the 32-bit scaling path.
+enum ScaleXPath scalex_path();
+
+/// \brief Set the implementation used by the 32-bit scaling path.
+void scalex_set_path(enum ScaleXPath path);
+
+/// \brief Get the maximum number of threads used per rescale.
+uint32 scalex_max_threads();
+
+/// \brief Set the maximum number of threads used per rescale of a 32-bit
+/// surface.
+///
+/// \param num_threads The thread count; zero uses the number of hardware
+/// threads (default). A value of one rescales on the calling thread only.
+void scalex_set_max_threads(uint32 num_threads);
+
 /// Note that we expect the *source* width & buffer here
 /// depth is the color depth in bits -- this is commonly referred to values
 /// like: 8, 16, 24, 32.
-///
-/// \todo IMPLEMENT ME
 bool scale2x  ( void* source_buffer, void* destination_buffer,
                 const int32 source_width, const int32 source_height,
                 const int32 bits_per_pixel,
-                const int16 source_pitch, int16 destination_pitch
+                const int32 source_pitch, int32 destination_pitch
               );
 
 /// Note that we expect the *source* width & buffer here
 /// depth is the color depth in bits -- this is commonly referred to values
 /// like: 8, 16, 24, 32.
-///
-/// \todo IMPLEMENT ME
 bool scale3x  ( void* source_buffer, void* destination_buffer,
                 const int32 source_width, const int32 source_height,
                 const int32 bits_per_pixel,
-                const int16 source_pitch, int16 destination_pitch
+                const int32 source_pitch, int32 destination_pitch
               );
 
 /// Note that we expect the *source* width & buffer here
 /// depth is the color depth in bits -- this is commonly referred to values
 /// like: 8, 16, 24, 32.
 ///
-/// \todo IMPLEMENT ME
+/// \remarks This is scale2x applied twice, through an intermediate buffer.
 bool scale4x  ( void* source_buffer, void* destination_buffer,
                 const int32 source_width, const int32 source_height,
                 const int32 bits_per_pixel,
-                const int16 source_pitch, int16 destination_pitch
+                const int32 source_pitch, int32 destination_pitch
               );
 
 
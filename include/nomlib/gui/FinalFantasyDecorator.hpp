@@ -36,6 +36,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace nom {
 
+// Forward declarations
+class Texture;
+
 /// \brief Final Fantasy theme widget style.
 class FinalFantasyDecorator: public Decorator
 {
@@ -67,10 +70,35 @@ class FinalFantasyDecorator: public Decorator
     /// \brief Implements required interface IDrawable::draw.
     void draw( RenderTarget& target ) const;
 
+    /// \brief Re-implements Decorator::set_bounds.
+    ///
+    /// \remarks Moving the decorator without resizing it does not re-render
+    /// the texture cache.
+    void set_bounds( const IntRect& bounds );
+
   private:
+    /// \brief Create the gradient and border frame of the widget style.
+    ///
+    /// \param origin The rendering position of the drawables; the client area
+    /// is translated to our position regardless.
+    void build( const Point2i& origin );
+
+    /// \brief Render the widget style into the texture cache.
+    ///
+    /// \returns Boolean TRUE on success, or boolean FALSE when the renderer
+    /// is unable to render to a texture.
+    bool update_cache( void );
+
     /// \brief Color sets used to create the gradients used as the widget's
     /// background.
     Color4iColors g_colors_[2];
+
+    /// \brief The rendered widget style; this is the only thing drawn each
+    /// frame when the renderer supports render targets.
+    ///
+    /// \remarks Copies of this object share the texture, so its position is
+    /// not used; the texture is drawn at the position of the decorator.
+    std::shared_ptr<Texture> texture_;
 };
 
 } // namespace nom
@@ -32,8 +32,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nomlib/config.hpp"
 #include "nomlib/math/Point2.hpp"
 #include "nomlib/math/Size2.hpp"
-#include "nomlib/gui/Drawables.hpp"
-#include "nomlib/graphics/shapes/Line.hpp"
+#include "nomlib/math/Rect.hpp"
+#include "nomlib/math/Color4.hpp"
+#include "nomlib/math/Transformable.hpp"
 #include "nomlib/graphics/IDrawable.hpp"
 
 namespace nom {
@@ -79,6 +80,12 @@ class FinalFantasyFrame: public Transformable
     /// \brief Get the unaffected rendering area coordinates of the border.
     const IntRect& frame_bounds( void ) const;
 
+    /// \brief Get the color of the inner border line.
+    const Color4i& inner_border_color( void ) const;
+
+    /// \brief Get the color of the outer border line.
+    const Color4i& outer_border_color( void ) const;
+
     /// \brief Implements IDrawable::draw
     void draw( RenderTarget& target ) const;
 
@@ -94,16 +101,25 @@ class FinalFantasyFrame: public Transformable
     /// a GUI engine -- nom::UIWidget and friends.
     void set_frame_bounds( const IntRect& bounds );
 
+    /// \brief Set the colors of the border lines.
+    ///
+    /// \remarks The default colors are the "FinalFantasyInnerBorder" and
+    /// "FinalFantasyOuterBorder" entries of nom::SystemColors, looked up once
+    /// upon construction.
+    void set_border_colors( const Color4i& inner, const Color4i& outer );
+
   private:
     /// \brief Implements IDrawable::update
     void update( void );
 
+    /// \brief Initialize the border colors from nom::SystemColors.
+    void initialize_colors( void );
+
     /// \brief The rendering area unaffected by the rendered border.
     IntRect frame_bounds_;
 
-    /// \remarks This object internally tracks its object state for when to
-    /// clear its cached data and update.
-    Drawables drawables_;
+    Color4i inner_border_color_;
+    Color4i outer_border_color_;
 };
 
 } // namespace nom
@@ -30,6 +30,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define NOMLIB_GUI_ROCKET_SDL2_RENDER_INTERFACE_HPP
 
 // #include <memory>
+#include <vector>
 
 #include <Rocket/Core/Core.h>
 #include <Rocket/Core/RenderInterface.h>
@@ -95,6 +96,27 @@ class RocketSDL2RenderInterface: public Rocket::Core::RenderInterface
                     Rocket::Core::TextureHandle texture_handle,
                     const Rocket::Core::Vector2f& translation);
 
+    /// \brief Called by Rocket when it wants to compile geometry it believes
+    /// will be static for the foreseeable future.
+    ///
+    /// \returns An opaque handle to a copy of the geometry, which is replayed
+    /// by ::RenderCompiledGeometry without further conversion.
+    virtual Rocket::Core::CompiledGeometryHandle
+    CompileGeometry(  Rocket::Core::Vertex* vertices, int num_vertices,
+                      int* indices, int num_indices,
+                      Rocket::Core::TextureHandle texture_handle );
+
+    /// \brief Called by Rocket when it wants to render application-compiled
+    /// geometry.
+    virtual void
+    RenderCompiledGeometry( Rocket::Core::CompiledGeometryHandle geometry,
+                            const Rocket::Core::Vector2f& translation );
+
+    /// \brief Called by Rocket when it wants to release application-compiled
+    /// geometry.
+    virtual void
+    ReleaseCompiledGeometry(Rocket::Core::CompiledGeometryHandle geometry);
+
     /// Called by Rocket when it wants to enable or disable scissoring to clip content.
     virtual void EnableScissorRegion(bool enable);
 
@@ -114,12 +136,89 @@ class RocketSDL2RenderInterface: public Rocket::Core::RenderInterface
     virtual void
     ReleaseTexture(Rocket::Core::TextureHandle texture_handle);
 
+    /// \brief Start collecting geometry into batches, rather than drawing it
+    /// as it is received.
+    ///
+    /// \remarks The OpenGL state is set up once for the batches and restored
+    /// for SDL by ::flush or ::end_batch; this is called by
+    /// nom::UIContext::draw around the rendering of its context.
+    void begin_batch();
+
+    /// \brief Draw the batched geometry and restore the renderer state, so
+    /// that SDL may draw.
+    ///
+    /// \remarks Decorators that draw through the SDL renderer must call this
+    /// beforehand, so that the geometry underneath them is drawn first.
+    void flush();
+
+    /// \brief Draw the batched geometry and stop batching.
+    void end_batch();
+
     /// \brief nomlib interface bridge between SDL2 and libRocket
     ///
     /// \remarks The interface does **not** own the pointer.
     RenderWindow* window_;
 
   private:
+    /// \brief Submit geometry to OpenGL.
+    ///
+    /// \remarks The vertices are drawn in place; the render scale and the
+    /// texture coordinate scale of the texture are applied through the
+    /// modelview and texture matrices rather than per vertex.
+    void render_geometry( const Rocket::Core::Vertex* vertices,
+                          const int* indices, int num_indices,
+                          Rocket::Core::TextureHandle texture_handle,
+                          const Rocket::Core::Vector2f& translation );
+
+    /// \brief Draws of one texture that are submitted together.
+    struct GeometryBatch
+    {
+      Rocket::Core::TextureHandle texture = 0;
+
+      /// \brief Indices into batch_vertices_.
+      std::vector<int> indices;
+
+      /// \brief The bounding box of the batch, in libRocket's coordinates.
+      Rocket::Core::Vector2f min;
+      Rocket::Core::Vector2f max;
+    };
+
+    /// \brief Add geometry to the batches.
+    ///
+    /// \remarks Geometry joins an earlier batch of the same texture when it
+    /// does not overlap anything drawn since, so that the painter's order
+    /// of overlapping elements is kept.
+    void batch_geometry(  const Rocket::Core::Vertex* vertices,
+                          int num_vertices, const int* indices,
+                          int num_indices,
+                          Rocket::Core::TextureHandle texture_handle,
+                          const Rocket::Core::Vector2f& translation );
+
+    /// \brief Draw the batched geometry, leaving the OpenGL state set up
+    /// for more.
+    void draw_batches();
+
+    /// \brief Set up the OpenGL state for drawing geometry.
+    void apply_state();
+
+    /// \brief Undo ::apply_state and let SDL know that its state has been
+    /// clobbered.
+    void restore_state();
+
+    /// \brief Whether geometry is batched rather than drawn immediately.
+    bool batching_ = false;
+
+    /// \brief Whether ::apply_state is in effect.
+    bool state_applied_ = false;
+
+    /// \brief The vertices of every batch, translated.
+    std::vector<Rocket::Core::Vertex> batch_vertices_;
+
+    /// \brief The batches in drawing order; the entries past num_batches_
+    /// are kept to reuse their storage.
+    std::vector<GeometryBatch> batches_;
+    nom::size_type num_batches_ = 0;
+
     /// \brief Shader context function pointer
     ///
     /// \note We bypass the use of GLEW by requesting this extension through
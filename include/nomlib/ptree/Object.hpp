@@ -26,23 +26,133 @@ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 ******************************************************************************/
-#ifndef NOMLIB_SYSTEM_PTREE_OBJECT_HPP
-#define NOMLIB_SYSTEM_PTREE_OBJECT_HPP
+#ifndef NOMLIB_PTREE_OBJECT_HPP
+#define NOMLIB_PTREE_OBJECT_HPP
 
-#include <map>
+#include <utility>
+#include <vector>
 
 #include "nomlib/config.hpp"
-#include "nomlib/system/ptree/ptree_config.hpp"
-#include "nomlib/system/ptree/VString.hpp" // nom::VString
-#include "nomlib/system/ptree/ptree_forwards.hpp" // nom::Value
+#include "nomlib/ptree/ptree_config.hpp"
+#include "nomlib/ptree/VString.hpp" // nom::VString
+#include "nomlib/ptree/ptree_forwards.hpp" // nom::Value
 
 namespace nom {
 
-typedef std::map<VString, Value> Object;
-typedef std::map<VString, Value>::const_iterator ObjectConstIterator;
-typedef std::map<VString, Value>::iterator ObjectIterator;
-typedef std::pair<VString, Value> ObjectPair;
+/// \brief Member key / value pairs of a nom::Value object node
+class Object
+{
+  public:
+    typedef Object self_type;
+    typedef std::pair<VString, Value> value_type;
+    typedef std::vector<value_type> container_type;
+    typedef container_type::iterator iterator;
+    typedef container_type::const_iterator const_iterator;
+    typedef nom::size_type size_type;
+
+    /// \brief Objects with more members than this are looked up through a
+    /// hash index; smaller objects are searched linearly.
+    static const size_type INDEX_THRESHOLD = 8;
+
+    Object();
+
+    ~Object();
+
+    /// \brief Copy constructor.
+    Object(const self_type& rhs);
+
+    /// \brief Copy assignment operator.
+    self_type& operator =(const self_type& rhs);
+
+    /// \brief Move constructor.
+    Object(self_type&& rhs);
+
+    /// \brief Move assignment operator.
+    self_type& operator =(self_type&& rhs);
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    size_type size() const;
+    bool empty() const;
+
+    /// \brief Remove all members.
+    void clear();
+
+    /// \brief Reserve storage for the given number of members.
+    void reserve(size_type num_members);
+
+    /// \brief Search for a member by its key.
+    ///
+    /// \returns An iterator to the member on success, or ::end on failure.
+    iterator find(const VString& key);
+    const_iterator find(const VString& key) const;
+
+    /// \brief Access a member by its key, appending a null value member when
+    /// the key does not exist yet.
+    Value& operator[](const VString& key);
+
+    /// \brief Append a member, unless its key already exists.
+    ///
+    /// \returns An iterator to the member with the given key, and whether the
+    /// member was inserted.
+    std::pair<iterator, bool> insert(const value_type& member);
+    std::pair<iterator, bool> insert(value_type&& member);
+
+    /// \brief Remove a member.
+    ///
+    /// \returns An iterator to the member that followed the removed member.
+    iterator erase(iterator pos);
+
+    /// \brief Equality comparison operator.
+    ///
+    /// \remarks Objects holding the same members are equal, regardless of the
+    /// order that the members were inserted in.
+    bool operator ==(const self_type& rhs) const;
+
+    bool operator !=(const self_type& rhs) const;
+
+    /// \brief Lesser than comparison operator.
+    ///
+    /// \remarks The members are compared in the order of their keys.
+    bool operator <(const self_type& rhs) const;
+
+  private:
+    static const size_type npos = static_cast<size_type>(-1);
+
+    /// \brief Obtain the position of the member with the given key.
+    ///
+    /// \returns The position on success, or npos on failure.
+    size_type position(const VString& key) const;
+
+    /// \brief Add the member at the given position to the hash index.
+    void index_member(size_type pos);
+
+    /// \brief Build the hash index from scratch, or drop it when the object
+    /// has become small enough to be searched linearly.
+    void rebuild_index();
+
+    /// \brief The members, in insertion order.
+    container_type members_;
+
+    /// \brief Open addressing hash table of member positions plus one; zero
+    /// denotes an empty slot. Empty until there are more than
+    /// INDEX_THRESHOLD members.
+    std::vector<uint32> index_;
+};
 
 } // namespace nom
 
 #endif // include guard defined
+
+/// \class nom::Object
+/// \ingroup ptree
+///
+/// A flat, insertion-ordered replacement for std::map<VString, Value>. The
+/// members are stored contiguously, so that building, copying and walking an
+/// object does not allocate one tree node per member.
+///
+/// Iterators and references to members are invalidated by insertion and
+/// removal of members.
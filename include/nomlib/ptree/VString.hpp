@@ -30,13 +30,16 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define NOMLIB_PTREE_VSTRING_HPP
 
 #include <cstring>
+#include <string>
 
 #include "nomlib/config.hpp"
+#include "nomlib/ptree/ptree_config.hpp"
 
 namespace nom {
 
 typedef nom::size_type ArrayIndex;
 
+/// \brief An interned member key for nom::Value objects
 class VString
 {
   public:
@@ -53,6 +56,20 @@ class VString
     /// \brief Construct a member key from a C++ string.
     VString(const std::string& key);
 
+    /// \brief Get the member key for a C string, without interning it.
+    ///
+    /// \returns The interned key when the string has been interned before,
+    /// or else a key that matches no member.
+    ///
+    /// \remarks For lookups, so that looking up missing or generated names
+    /// does not grow the key pool.
+    static self_type find(const char* key);
+
+    /// \brief Get the member key for a C++ string, without interning it.
+    ///
+    /// \see VString::find(const char*)
+    static self_type find(const std::string& key);
+
     /// \brief Construct a member key from an array element index.
     VString(ArrayIndex index);
 
@@ -62,32 +79,54 @@ class VString
     /// \brief Copy assignment operator.
     self_type& operator =(const self_type& rhs);
 
+    /// \brief Move constructor.
+    VString(self_type&& rhs);
+
+    /// \brief Move assignment operator.
+    self_type& operator =(self_type&& rhs);
+
     /// \brief Lesser than comparison operator.
     ///
-    /// \note This is required for an implementation inside std::map.
+    /// \remarks Member keys are ordered by their string contents.
     bool operator <(const self_type& rhs) const;
 
     /// \brief Equality comparison operator.
     ///
-    /// \note This is required for an implementation inside std::map.
+    /// \remarks Member keys are compared by their interned address.
     bool operator ==(const self_type& rhs) const;
 
     /// \brief Get the C++ string stored for this member key.
     std::string string() const;
 
     /// \brief Get the C string stored for this member key.
+    ///
+    /// \remarks Equal keys share the same address, which remains valid for
+    /// the lifetime of the program.
     const char* c_str() const;
 
     /// \brief Get the stored array index key.
     ArrayIndex index() const;
 
   private:
-    void swap(self_type& rhs);
+    /// \brief The interned key string; never NULL.
+    const char* key_;
 
-    std::string cstr_;
     ArrayIndex index_;
 };
 
 } // namespace nom
 
 #endif // include guard defined
+
+/// \class nom::VString
+/// \ingroup ptree
+///
+/// Member names repeat heavily across a document -- every frame of a sprite
+/// sheet has its own "x", "y", "w" and "h" keys. Each distinct key string is
+/// stored once, in a process-wide pool, and a VString holds a pointer to it;
+/// copying or destroying a key never allocates and comparing two keys for
+/// equality is a pointer comparison.
+///
+/// Interned strings are never released, so VString is meant for member
+/// names, not for arbitrary string data. Interning is thread-safe.
+///
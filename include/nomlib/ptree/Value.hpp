@@ -142,6 +142,21 @@ class Value
     /// \note Type 6 or 7
     Value(const Object& obj);
 
+    /// \brief Construct an object node by taking over the given values.
+    ///
+    /// \note Type 7
+    Value(Object&& obj);
+
+    /// \brief Construct an array node.
+    ///
+    /// \note Type 6
+    Value(const Array& arr);
+
+    /// \brief Construct an array node by taking over the given values.
+    ///
+    /// \note Type 6
+    Value(Array&& arr);
+
     /// \brief Construct a Value container node of a specified type.
     Value(ValueType type);
 
@@ -151,10 +166,21 @@ class Value
     /// \brief Copy assignment operator.
     Value::SelfType& operator =(const SelfType& rhs);
 
+    /// \brief Move constructor.
+    ///
+    /// \remarks The moved from object is left as a ValueType::Null type.
+    Value(SelfType&& rhs);
+
+    /// \brief Move assignment operator.
+    ///
+    /// \remarks The moved from object is left as a ValueType::Null type.
+    Value::SelfType& operator =(SelfType&& rhs);
+
     /// \brief Exchange the contents of the container; copy & swap idiom.
     ///
     /// \remarks In particular, one must be careful to keep track of copying our
-    /// char* strings as necessary.
+    /// char* strings as necessary. Strings stored in-place move along with the
+    /// object, so pointers obtained from ::get_cstring are invalidated.
     ///
     /// \note This method is used in the implementation of the copy assignment
     /// operator.
@@ -303,6 +329,9 @@ class Value
     ///
     /// \returns On err, nullptr is returned.
     ///
+    /// \remarks The pointer is valid for as long as this object is neither
+    /// modified, moved nor destroyed.
+    ///
     /// ~~\remarks A copy of the stored C string is made, therefore no ownership
     /// transfers occur; you are responsible for freeing the returned C string.~~
     const char* get_cstring() const;
@@ -325,9 +354,9 @@ class Value
 
     /// \brief Obtain the array values of the object.
     ///
-    /// \returns ~~Return-by-value cloned copy of the nom::Array pointer held by
-    /// this object.~~
-    const Object array() const;
+    /// \returns Return-by-value copy of the array elements, or an empty array
+    /// when the object is not an array node.
+    const Array array() const;
 
     /// \brief Obtain the object tree of the object.
     ///
@@ -365,6 +394,9 @@ class Value
     /// in order to have the compiler recognize the request and route to the
     /// correct constructor.
     ///
+    /// \remarks The array is grown with null values when the index is past
+    /// its end.
+    ///
     /// \note In contrast to the standard STL method overloads for
     /// ::operator[](int), nom::Value should always perform bounds checking.
     Value& operator[](ArrayIndex index);
@@ -382,9 +414,7 @@ class Value
     /// integers are the "default" literal integer type, at least on my
     /// development system).
     ///
-    /// \todo Fix index methods -- VString, ValueBaseIterator & co; this method
-    /// call relies on our half-finished implementation stemming from the
-    /// VString class.
+    /// \returns Value::null when the index is past the end of the array.
     ///
     /// \note In contrast to the standard STL method overloads for
     /// ::operator[](int), nom::Value should always perform bounds checking.
@@ -412,6 +442,9 @@ class Value
     /// \brief Insert array elements.
     Value& push_back(const Value& val);
 
+    /// \brief Insert array elements by moving them into place.
+    Value& push_back(Value&& val);
+
     /// \brief Search the object for an existing member.
     ///
     /// \returns The found member key upon success, or Value::null upon failure.
@@ -488,6 +521,39 @@ class Value
     const std::string dump(const Value& object, int depth = 0) const;
 
   private:
+    /// \brief Reference counted storage for array and object nodes.
+    ///
+    /// \see Value.cpp
+    template <typename T>
+    struct SharedNode;
+
+    /// \brief The maximal length of a string stored in-place, including its
+    /// null terminator.
+    static const nom::size_type SMALL_STRING_SIZE = sizeof(real64) * 2;
+
+    /// \brief Internal helper method for initializing a string value.
+    void init_string(const char* str, nom::size_type length);
+
+    /// \brief Free the stored value; the object is left as a
+    /// ValueType::Null type.
+    void release();
+
+    /// \brief Take over the stored value of another object, leaving it as a
+    /// ValueType::Null type.
+    void steal(Value& rhs);
+
+    /// \brief Obtain the object node for modification.
+    ///
+    /// \remarks A node that is shared with other objects is copied first, so
+    /// that the modification is only seen through this object.
+    Object* mutable_object();
+
+    /// \brief Obtain the array node for modification.
+    ///
+    /// \remarks A node that is shared with other objects is copied first, so
+    /// that the modification is only seen through this object.
+    Array* mutable_array();
+
     /// \brief Internal helper method for nom::Value::dump.
     const std::string dump_key(const Value& key) const;
 
@@ -517,13 +583,21 @@ class Value
       bool bool_;           // Type 4
       // NOTE: Instance-owned pointer.
       const char* string_;  // Type 5
-      // NOTE: Instance-owned pointer.
-      Object* object_;      // Type 6 and 7
+      // NOTE: Strings shorter than SMALL_STRING_SIZE are stored in-place.
+      char small_string_[SMALL_STRING_SIZE];  // Type 5
+      // NOTE: Pointers shared by copies of this object; the node is copied on
+      // the first modification made through any of them.
+      SharedNode<Array>* array_;    // Type 6
+      SharedNode<Object>* object_;  // Type 7
     };
 
     /// \brief The type of stored value in this instance.
     enum ValueType type_;
 
+    /// \brief Whether the string value is stored in ValueHolder::small_string_
+    /// (as opposed to an instance-owned pointer).
+    bool inline_string_;
+
     /// \brief The stored value in this instance.
     ValueHolder value_;
 };
@@ -554,6 +628,18 @@ std::ostream& operator <<(std::ostream& os, const Value& val);
 ///   Boost::PropertyTree
 ///   Apple's PropertyList (.plist)
 ///
+/// Copying a nom::Value is cheap: array and object nodes are shared between
+/// the copies, and are only copied once a copy is modified -- e.g.: by the
+/// non-const ::operator[], ::push_back, ::erase, ::clear or the non-const
+/// iterators. Note that a reference obtained through one of the non-const
+/// accessors refers to the node as it was at the time, so it should not be
+/// kept across a copy of the object that it was obtained from.
+///
+/// Array elements are stored contiguously, and object members are stored in
+/// insertion order (see also: nom::Object). A reference to an element or a
+/// member is invalidated when another one is added to the same node, just
+/// like with std::vector.
+///
 /// \todo Implement support for (un)-signed 64-bit integers
 ///
 /// \todo Implement support for comments (XML & JSON style)
@@ -63,6 +63,9 @@ class ValueConstIterator: public ValueIteratorBase
     /// \brief Copy constructor
     ValueConstIterator(const ObjectIterator& rhs);
 
+    /// \brief Construct an iterator over array elements.
+    ValueConstIterator(const ArrayIterator& rhs, ArrayIndex index);
+
     SelfType& operator =(const DerivedType& rhs);
 
     /// \brief Obtain a pointer to the iterator's object.
@@ -57,6 +57,9 @@ class ValueIterator: public ValueIteratorBase
     /// \brief Copy constructor
     ValueIterator(const ObjectIterator& rhs);
 
+    /// \brief Construct an iterator over array elements.
+    ValueIterator(const ArrayIterator& rhs, ArrayIndex index);
+
     /// \brief Copy assignment
     SelfType& operator =(const SelfType& rhs);
 
@@ -52,6 +52,7 @@ class ValueIteratorBase
     enum IteratorType
     {
       Null = 0,         // Type 0 (default)
+      ArrayValues,      // Type 6
       ObjectValues      // Type 7
     };
 
@@ -63,6 +64,12 @@ class ValueIteratorBase
 
     ValueIteratorBase(const ObjectIterator& rhs);
 
+    /// \brief Construct an iterator over array elements.
+    ///
+    /// \param rhs   The array element to refer to.
+    /// \param index The position of the element within its array.
+    ValueIteratorBase(const ArrayIterator& rhs, ArrayIndex index);
+
     /// \brief query validity of the object.
     ///
     /// \returns The object is always assumed to be invalid when
@@ -71,8 +78,8 @@ class ValueIteratorBase
 
     /// \brief Obtain the index of the referenced value.
     ///
-    /// \returns The array element's index on success, or -1 if the referenced
-    /// value is not an array element.
+    /// \returns The array element's index on success, or zero (0) if the
+    /// referenced value is not an array element.
     ArrayIndex index() const;
 
     /// \brief Obtain the current index or member key value.
@@ -108,6 +115,12 @@ class ValueIteratorBase
     /// \brief A pointer to the object type iterator
     ObjectIterator object_;
 
+    /// \brief A pointer to the array type iterator
+    ArrayIterator array_;
+
+    /// \brief The position of the array type iterator.
+    ArrayIndex index_;
+
     enum IteratorType type_;
 };
 
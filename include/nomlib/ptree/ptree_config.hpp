@@ -31,4 +31,16 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "nomlib/config.hpp"
 
+// Log the construction and destruction of nom::Value and nom::VString
+// objects. These run once for every node and member key of a tree, so the
+// calls are compiled out entirely unless this is defined.
+// #define NOM_DEBUG_PTREE_TRACE
+
+#if defined( NOM_DEBUG_PTREE_TRACE )
+  #define NOM_PTREE_TRACE() \
+    NOM_LOG_TRACE_PRIO( NOM_LOG_CATEGORY_TRACE, NOM_LOG_PRIORITY_VERBOSE )
+#else
+  #define NOM_PTREE_TRACE()
+#endif
+
 #endif // include guard defined
@@ -29,19 +29,23 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef NOMLIB_SYSTEM_PTREE_TYPES_HPP
 #define NOMLIB_SYSTEM_PTREE_TYPES_HPP
 
-#include <map>
+#include <vector>
 
 #include "nomlib/config.hpp"
 #include "nomlib/ptree/ptree_config.hpp"
 #include "nomlib/ptree/VString.hpp"
 #include "nomlib/ptree/ptree_forwards.hpp" // nom::Value
+#include "nomlib/ptree/Object.hpp"
 
 namespace nom {
 
-typedef std::pair<VString, Value> ObjectPair;
-typedef std::map<VString, Value> Object;
-typedef std::map<VString, Value>::const_iterator ObjectConstIterator;
-typedef std::map<VString, Value>::iterator ObjectIterator;
+typedef Object::value_type ObjectPair;
+typedef Object::const_iterator ObjectConstIterator;
+typedef Object::iterator ObjectIterator;
+
+typedef std::vector<Value> Array;
+typedef std::vector<Value>::const_iterator ArrayConstIterator;
+typedef std::vector<Value>::iterator ArrayIterator;
 
 } // namespace nom
 
@@ -37,8 +37,11 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nomlib/serializers/JsonConfigFile.hpp"
 #include "nomlib/serializers/JsonCppSerializer.hpp"
 #include "nomlib/serializers/JsonCppDeserializer.hpp"
+#include "nomlib/serializers/JsonDeserializer.hpp"
 #include "nomlib/serializers/RapidXmlSerializer.hpp"
 #include "nomlib/serializers/RapidXmlDeserializer.hpp"
+#include "nomlib/serializers/BinarySerializer.hpp"
+#include "nomlib/serializers/BinaryDeserializer.hpp"
 
 #include "nomlib/serializers/MiniHTML.hpp"
 
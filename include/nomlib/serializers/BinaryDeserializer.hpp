@@ -0,0 +1,116 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#ifndef NOMLIB_SERIALIZERS_BINARY_DESERIALIZER_HPP
+#define NOMLIB_SERIALIZERS_BINARY_DESERIALIZER_HPP
+
+#include <string>
+
+#include "nomlib/config.hpp"
+#include "nomlib/serializers/serializers_config.hpp"
+#include "nomlib/serializers/IValueDeserializer.hpp"
+#include "nomlib/ptree.hpp"
+
+namespace nom {
+
+/// \brief Restoring of nom::Value objects from binary documents written by
+/// nom::BinarySerializer.
+class BinaryDeserializer: public IValueDeserializer
+{
+  public:
+    BinaryDeserializer();
+
+    ~BinaryDeserializer();
+
+    /// \brief Decode a binary document as a nom::Value object.
+    ///
+    /// \param source std::string used as a byte buffer holding the document.
+    ///
+    /// \returns nom::Value object filled from the document on success, or
+    /// nom::Value::null on err.
+    ///
+    /// \note Implements IValueDeserializer interface.
+    Value deserialize(const std::string& source) override;
+
+    /// \brief Decode a binary document from a memory buffer as a nom::Value
+    /// object.
+    ///
+    /// \param source The document.
+    /// \param length The size of the document, in bytes.
+    ///
+    /// \returns nom::Value object filled from the document on success, or
+    /// nom::Value::null on err.
+    Value deserialize(const char* source, nom::size_type length);
+
+    /// \brief Decode a binary file as a nom::Value object.
+    ///
+    /// \param filename Absolute file path to data to deserialize from.
+    /// \param output nom::Value container to store resulting data in.
+    ///
+    /// \remarks The file is mapped into memory and decoded in place.
+    ///
+    /// \note Implements IValueDeserializer interface.
+    bool load(const std::string& filename, Value& output) override;
+
+  private:
+    /// \brief Decode a memory buffer into a nom::Value object.
+    ///
+    /// \returns Boolean FALSE on a malformed document, which is logged.
+    bool parse(const char* source, nom::size_type length, Value& output) const;
+};
+
+} // namespace nom
+
+#endif // include guard defined
+
+/// \class nom::BinaryDeserializer
+/// \ingroup serializers
+///
+/// See nom::BinarySerializer for the layout of the document. Decoding never
+/// copies the input: the string table is indexed as a list of views into the
+/// buffer -- the mapped file, when using ::load -- and strings are read from
+/// there as they are stored into the nom::Value tree. Each member key is
+/// interned once per document, no matter how many objects use it.
+///
+/// Every length and index is checked against the size of the document, so
+/// truncated or corrupt input fails to load instead of being read past its
+/// end.
+///
+/// ## Usage Examples
+///
+/// \code
+///
+/// nom::BinaryDeserializer fp;
+/// nom::Value sheet;
+///
+/// if( fp.load("sprites.bin", sheet) == false ) {
+///   // Handle err
+/// }
+///
+/// \endcode
+///
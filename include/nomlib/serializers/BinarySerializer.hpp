@@ -0,0 +1,141 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#ifndef NOMLIB_SERIALIZERS_BINARY_SERIALIZER_HPP
+#define NOMLIB_SERIALIZERS_BINARY_SERIALIZER_HPP
+
+#include <string>
+#include <unordered_map>
+
+#include "nomlib/config.hpp"
+#include "nomlib/serializers/serializers_config.hpp"
+#include "nomlib/serializers/IValueSerializer.hpp"
+#include "nomlib/ptree.hpp"
+
+namespace nom {
+
+/// \brief Saving of nom::Value objects to compact binary documents.
+class BinarySerializer: public IValueSerializer
+{
+  public:
+    BinarySerializer();
+
+    ~BinarySerializer();
+
+    /// \brief Output a nom::Value object as a binary document.
+    ///
+    /// \returns The encoded document; the std::string is used as a byte
+    /// buffer and may contain null bytes.
+    ///
+    /// \note Implements IValueSerializer interface.
+    std::string serialize(const Value& source) override;
+
+    /// \brief Output a nom::Value object to a binary file.
+    ///
+    /// \param source nom::Value object to serialize.
+    /// \param filename Absolute file path to save resulting output to.
+    ///
+    /// \note Implements IValueSerializer interface.
+    bool save(const Value& source, const std::string& filename) override;
+
+  private:
+    /// \brief Append the encoding of a nom::Value to the value stream.
+    void write_value(const Value& source, std::string& dest);
+
+    /// \brief Get the string table index of a string, adding the string to
+    /// the table when it is not there yet.
+    uint32 string_index(const char* str);
+
+    /// \brief The string table index of every string written so far.
+    std::unordered_map<std::string, uint32> strings_;
+
+    /// \brief The encoded string table.
+    std::string table_;
+};
+
+/// \brief Convert a JSON file to a binary document.
+///
+/// \param json_filename Absolute file path to the JSON input.
+/// \param filename Absolute file path to save the binary output to.
+///
+/// \returns Boolean TRUE on success, or boolean FALSE when the input could not
+/// be parsed or the output could not be saved.
+///
+/// \see nom::JsonDeserializer, nom::BinarySerializer
+bool convert_json_to_binary( const std::string& json_filename,
+                             const std::string& filename );
+
+} // namespace nom
+
+#endif // include guard defined
+
+/// \class nom::BinarySerializer
+/// \ingroup serializers
+///
+/// The output is meant to be loaded by nom::BinaryDeserializer, in place of
+/// parsing the same data as JSON at startup. All numbers are stored in
+/// little-endian byte order with a fixed width, whatever the host.
+///
+/// A document is made of a header, a string table and a value stream:
+///
+/// | Field             | Size                                              |
+/// |-------------------|---------------------------------------------------|
+/// | Signature, "NOMV" | uint32                                            |
+/// | Version           | uint32                                            |
+/// | String count      | uint32                                            |
+/// | String table size | uint32, in bytes                                  |
+/// | Value stream size | uint32, in bytes                                  |
+/// | String table      | per string: uint32 length, the bytes and a null   |
+/// | Value stream      | the root value                                    |
+///
+/// Every string value and member key is stored once in the string table, and
+/// is referred to by its uint32 index from the value stream. Each value
+/// starts with a uint8 nom::Value::ValueType, followed by:
+///
+/// | Type            | Payload                                             |
+/// |-----------------|-----------------------------------------------------|
+/// | Null            | (none)                                              |
+/// | SignedInteger   | int32                                               |
+/// | UnsignedInteger | uint32                                              |
+/// | RealNumber      | IEEE-754 binary64                                   |
+/// | String          | uint32 string index                                 |
+/// | Boolean         | uint8                                               |
+/// | ArrayValues     | uint32 count, then each element value               |
+/// | ObjectValues    | uint32 count, then each uint32 key index and value  |
+///
+/// ## Usage Examples
+///
+/// \code
+///
+/// // Precompile a JSON asset
+/// if( nom::convert_json_to_binary("sprites.json", "sprites.bin") == false ) {
+///   // Handle err
+/// }
+///
+/// \endcode
+///
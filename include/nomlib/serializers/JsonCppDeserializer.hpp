@@ -109,8 +109,6 @@ class JsonCppDeserializer: public IValueDeserializer
     bool read_object( const Json::Value& object, Value& dest ) const;
 };
 
-std::unique_ptr<IValueDeserializer> make_unique_json_deserializer();
-
 } // namespace nom
 
 #endif // include guard defined
@@ -0,0 +1,122 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#ifndef NOMLIB_SERIALIZERS_JSON_DESERIALIZER_HPP
+#define NOMLIB_SERIALIZERS_JSON_DESERIALIZER_HPP
+
+#include <memory>
+#include <string>
+
+#include "nomlib/config.hpp"
+#include "nomlib/serializers/serializers_config.hpp"
+#include "nomlib/serializers/IValueDeserializer.hpp"
+#include "nomlib/ptree.hpp"
+
+namespace nom {
+
+/// \brief Restoring of nom::Value objects from JSON documents in a single
+/// pass.
+class JsonDeserializer: public IValueDeserializer
+{
+  public:
+    JsonDeserializer();
+
+    ~JsonDeserializer();
+
+    /// \brief Parse JSON data as a nom::Value object.
+    ///
+    /// \param source std::string containing valid JSON.
+    ///
+    /// \returns nom::Value object filled from JSON-compliant input on success,
+    /// or nom::Value::null on err.
+    ///
+    /// \note Implements IDeserializer interface.
+    Value deserialize(const std::string& source) override;
+
+    /// \brief Parse JSON data from a memory buffer as a nom::Value object.
+    ///
+    /// \param source The JSON input; it does not need to be null-terminated.
+    /// \param length The size of the input, in bytes.
+    ///
+    /// \returns nom::Value object filled from JSON-compliant input on success,
+    /// or nom::Value::null on err.
+    Value deserialize(const char* source, nom::size_type length);
+
+    /// \brief Parse a JSON file as a nom::Value object.
+    ///
+    /// \param filename Absolute file path to data to deserialize from.
+    /// \param output nom::Value container to store resulting data in.
+    ///
+    /// \remarks The file is mapped into memory and parsed in place.
+    ///
+    /// \note Implements IDeserializer interface.
+    bool load(const std::string& filename, Value& output) override;
+
+  private:
+    /// \brief Parse a memory buffer into a nom::Value object.
+    ///
+    /// \returns Boolean FALSE on a syntax error, which is logged.
+    bool parse(const char* source, nom::size_type length, Value& output) const;
+};
+
+/// \brief Create the preferred JSON deserializer.
+std::unique_ptr<IValueDeserializer> make_unique_json_deserializer();
+
+} // namespace nom
+
+#endif // include guard defined
+
+/// \class nom::JsonDeserializer
+/// \ingroup json
+///
+/// Unlike nom::JsonCppDeserializer, which parses into a Json::Value tree and
+/// then converts that tree, this deserializer builds the nom::Value tree
+/// directly while it scans the input. Nested arrays and objects are kept on
+/// an explicit stack rather than the call stack, so deeply nested input does
+/// not risk overflowing it.
+///
+/// The parser is lenient in the same ways that nom::JsonCppDeserializer is by
+/// default: C and C++ style comments are skipped, and the top-level value may
+/// be of any type. Numbers are stored as nom::Value::SignedInteger when they
+/// fit in an int, nom::Value::UnsignedInteger when they fit in an unsigned
+/// int, and nom::Value::RealNumber otherwise. When a member key repeats
+/// within an object, the last value wins.
+///
+/// ## Usage Examples
+///
+/// \code
+///
+/// nom::JsonDeserializer fp;
+/// nom::Value sheet;
+///
+/// if( fp.load("sprites.json", sheet) == false ) {
+///   // Handle err
+/// }
+///
+/// \endcode
+///
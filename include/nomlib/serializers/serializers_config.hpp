@@ -55,6 +55,16 @@ enum DeserializerOptions: uint32
                       // the serializer.
 };
 
+/// \brief The signature at the start of nom::BinarySerializer output; "NOMV"
+/// when read as bytes.
+const uint32 BINARY_VALUE_SIGNATURE = 0x564D4F4E;
+
+/// \brief The format revision of nom::BinarySerializer output.
+const uint32 BINARY_VALUE_VERSION = 1;
+
+/// \brief The size, in bytes, of the header of nom::BinarySerializer output.
+const nom::size_type BINARY_VALUE_HEADER_SIZE = 20;
+
 } // namespace nom
 
 #endif // include guard defined
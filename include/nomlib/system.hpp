@@ -37,6 +37,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <nomlib/system/dialog_messagebox.hpp>
 #include <nomlib/system/Path.hpp>
 #include <nomlib/system/File.hpp>
+#include <nomlib/system/MappedFile.hpp>
 #include <nomlib/system/SDLApp.hpp>
 #include <nomlib/system/EventHandler.hpp>
 #include <nomlib/system/Joystick.hpp>
@@ -30,6 +30,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define NOMLIB_SYSTEM_INPUT_MAPPER_INPUT_STATE_MAPPER_HPP
 
 #include <map>
+#include <vector>
 
 #include "nomlib/config.hpp"
 #include "nomlib/system/InputMapper/InputActionMapper.hpp"
@@ -121,9 +122,55 @@ class InputStateMapper
     void set_event_handler(EventHandler& evt_handler);
 
   private:
+    /// \brief An input action of an active state, indexed by the event that
+    /// it reacts to.
+    struct InputDispatch
+    {
+      /// \brief The event type and input identifier of the action.
+      ///
+      /// \see ::dispatch_key
+      uint64 key;
+
+      /// \brief Non-owned pointer; the action is owned by its state.
+      const InputAction* action;
+    };
+
+    typedef std::vector<InputDispatch> DispatchIndex;
+
+    /// \brief Get the index key of an event.
+    ///
+    /// \param ev  The event or action criteria to compute the key of.
+    /// \param key The key output; the event type and the key, button, axis or
+    /// hat of the event.
+    ///
+    /// \returns Boolean FALSE when the event type is never mapped to actions,
+    /// such as mouse motion events.
+    static bool dispatch_key(const Event& ev, uint64& key);
+
+    /// \brief Re-build the dispatch index from the active states.
+    ///
+    /// \remarks Actions that share a key are kept in the order of their
+    /// states and their insertion, which is the order that they are triggered
+    /// in.
+    void update_index();
+
+    /// \brief Mark the dispatch index out of date.
+    ///
+    /// \remarks The actions of a state that is erased while events are being
+    /// dispatched are kept alive until the dispatch has finished.
+    void invalidate_index();
+
     /// \brief Internal event handler for triggering mapped action states.
+    ///
+    /// \remarks The event is matched against the actions indexed by its type
+    /// and key, button, axis or hat -- no other actions are visited. When an
+    /// action callback changes the states, the remaining actions are not
+    /// triggered by the same event.
     void on_event(const Event& ev);
 
+    /// \brief Test an input action against an event of the same index key.
+    bool on_action(const InputAction& mapping, const Event& ev);
+
     /// \brief Internal event handler for matching a keyboard action to a
     /// keyboard event.
     bool on_key_press(const InputAction& mapping, const Event& ev);
@@ -160,6 +207,22 @@ class InputStateMapper
     EventHandler* event_handler_ = nullptr;
 
     InputStateMap states_;
+
+    /// \brief The actions of the active states, sorted by their index key.
+    DispatchIndex index_;
+
+    /// \brief Whether nom::InputStateMapper::index_ must be re-built.
+    bool index_dirty_ = true;
+
+    /// \brief Incremented each time that the states are modified; a dispatch
+    /// in progress stops when this changes.
+    uint32 index_generation_ = 0;
+
+    /// \brief The depth of the ::on_event calls in progress.
+    uint32 dispatching_ = 0;
+
+    /// \brief The actions of states erased during ::on_event.
+    std::vector<InputActionMapper::ActionMap> retired_actions_;
 };
 
 } // namespace nom
@@ -0,0 +1,107 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#ifndef NOMLIB_SYSTEM_MAPPED_FILE_HPP
+#define NOMLIB_SYSTEM_MAPPED_FILE_HPP
+
+#include <string>
+#include <vector>
+
+#include "nomlib/config.hpp"
+
+namespace nom {
+
+/// \brief Read-only view of a file's contents
+class MappedFile
+{
+  public:
+    MappedFile();
+
+    ~MappedFile();
+
+    /// \brief Disabled copy constructor.
+    MappedFile(const MappedFile& rhs) = delete;
+
+    /// \brief Disabled copy assignment operator.
+    MappedFile& operator =(const MappedFile& rhs) = delete;
+
+    /// \brief Map a file into memory for reading.
+    ///
+    /// \returns Boolean TRUE when the file's contents are available through
+    /// ::data, or boolean FALSE when the file could not be read.
+    ///
+    /// \remarks When the platform cannot map the file, its contents are read
+    /// into memory instead.
+    bool open(const std::string& filename);
+
+    /// \brief Release the file's contents.
+    void close();
+
+    /// \brief Get the file's contents.
+    ///
+    /// \returns A pointer to the first byte of the file, or NULL when the
+    /// file is empty or not open.
+    ///
+    /// \remarks The contents are not null-terminated.
+    const char* data() const;
+
+    /// \brief Get the size of the file, in bytes.
+    nom::size_type size() const;
+
+  private:
+    const char* data_;
+    nom::size_type size_;
+
+    /// \brief The memory mapping to release; NULL when the contents were read
+    /// into the buffer.
+    void* mapping_;
+
+    std::vector<char> buffer_;
+};
+
+} // namespace nom
+
+#endif // include guard defined
+
+/// \class nom::MappedFile
+/// \ingroup system
+///
+/// Mapping lets the loaders parse a file in place, without copying it into a
+/// string first; pages are read in by the OS as the parser reaches them.
+///
+/// ## Usage Examples
+///
+/// \code
+///
+/// nom::MappedFile fp;
+/// if( fp.open("sprites.json") == true ) {
+///   parse( fp.data(), fp.size() );
+/// }
+///
+/// \endcode
+///
@@ -28,23 +28,18 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 #include "nomlib/actions/ActionPlayer.hpp"
 
+// Private headers
+#include "nomlib/core/slot_handle.hpp"
+
 // Forward declarations
 #include "nomlib/actions/IActionObject.hpp"
 #include "nomlib/actions/DispatchQueue.hpp"
 
 namespace nom {
 
-// A unique identifier that is auto-generated for actions without an assigned
-// name.
-static uint64 next_action_id_ = 0;
-
-static uint64 generate_action_id()
-{
-  return( ++(next_action_id_) );
-}
-
 // Static initializations
 const char* ActionPlayer::DEBUG_CLASS_NAME = "[ActionPlayer]:";
+const ActionPlayer::handle_type ActionPlayer::INVALID_HANDLE;
 
 ActionPlayer::ActionPlayer() :
   player_state_(ActionPlayer::State::RUNNING)
@@ -59,12 +54,12 @@ ActionPlayer::~ActionPlayer()
 
 bool ActionPlayer::idle() const
 {
-  return(this->actions_.size() == 0 && this->free_list_.size() == 0);
+  return(this->num_actions_ == 0);
 }
 
 nom::size_type ActionPlayer::num_actions() const
 {
-  return this->actions_.size();
+  return this->num_actions_;
 }
 
 ActionPlayer::State ActionPlayer::player_state() const
@@ -89,9 +84,9 @@ void ActionPlayer::stop()
 
 bool ActionPlayer::action_running(const std::string& action_id) const
 {
-  auto res = this->actions_.find(action_id);
+  auto res = this->names_.find(action_id);
 
-  if( res == this->actions_.end() ) {
+  if( res == this->names_.end() ) {
     // The action is **not** running
     return false;
   } else {
@@ -100,23 +95,40 @@ bool ActionPlayer::action_running(const std::string& action_id) const
   }
 }
 
+bool ActionPlayer::action_running(handle_type handle) const
+{
+  return( this->find_entry(handle) != -1 );
+}
+
 bool ActionPlayer::cancel_action(const std::string& action_id)
 {
-  auto res = this->actions_.find(action_id);
+  auto res = this->names_.find(action_id);
 
-  if( res == this->actions_.end() ) {
+  if( res == this->names_.end() ) {
     // Err -- no action by that name found
     return false;
-  } else {
+  }
 
-    // Success -- action was found
-    this->actions_.erase(res);
+  // Success -- action was found
+  return this->cancel_action(res->second);
+}
 
-    return true;
+bool ActionPlayer::cancel_action(handle_type handle)
+{
+  int64 index = this->find_entry(handle);
+
+  if( index == -1 ) {
+    // Err -- the action has already completed
+    return false;
+  }
+
+  this->remove_entry(index);
+
+  if( this->updating_ == false ) {
+    this->compact();
   }
 
-  // Err -- no action by that name found
-  return false;
+  return true;
 }
 
 void
@@ -129,8 +141,15 @@ ActionPlayer::cancel_actions(const ActionPlayer::action_names& actions)
 
 void ActionPlayer::cancel_actions()
 {
-  this->free_list_.clear();
-  this->actions_.clear();
+  for( nom::size_type index = 0; index != this->actions_.size(); ++index ) {
+    if( this->entry_running( this->actions_[index] ) == true ) {
+      this->remove_entry(index);
+    }
+  }
+
+  if( this->updating_ == false ) {
+    this->compact();
+  }
 }
 
 bool ActionPlayer::run_action(const std::shared_ptr<IActionObject>& action)
@@ -142,22 +161,64 @@ bool ActionPlayer::
 run_action( const std::shared_ptr<IActionObject>& action,
             const action_callback_func& completion_func )
 {
-  std::string action_id;
+  return( this->enqueue_action(action, completion_func) != INVALID_HANDLE );
+}
+
+ActionPlayer::handle_type
+ActionPlayer::enqueue_action( const std::shared_ptr<IActionObject>& action,
+                              const action_callback_func& completion_func )
+{
+  if( action == nullptr ) {
+    NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
+                  "Could not enqueue the action -- action was NULL." );
+    return INVALID_HANDLE;
+  }
+
+  const std::string& action_id = action->name();
+
+  if( action_id.length() > 0 ) {
+
+    auto res = this->names_.find(action_id);
+    if( res != this->names_.end() ) {
+
+      // NOTE: This logging category is disabled by default
+      NOM_LOG_WARN( NOM_LOG_CATEGORY_ACTION_PLAYER,
+                    "Another action with the same name exists -- overwriting",
+                    "with", action_id );
+
+      this->cancel_action(res->second);
+    }
+  }
 
-  auto dispatch_queue =
-    nom::create_dispatch_queue<DispatchQueue>();
-  if( dispatch_queue != nullptr ) {
-    return this->run_action(action, std::move(dispatch_queue), completion_func);
+  // Re-use a free slot when possible
+  uint32 slot = this->free_slot_;
+  if( slot == this->slots_.size() ) {
+    this->slots_.emplace_back();
+    ++this->free_slot_;
+  } else {
+    this->free_slot_ = this->slots_[slot].index;
   }
 
-  if( action != nullptr ) {
-    action_id = action->name();
+  ActionSlot& action_slot = this->slots_[slot];
+  action_slot.index = this->actions_.size();
+
+  handle_type handle = priv::make_slot_handle(slot, action_slot.generation);
+
+  this->actions_.emplace_back();
+  ActionEntry& entry = this->actions_.back();
+  entry.dispatch.action = action;
+  entry.dispatch.last_action_state = ActionPlayer::State::RUNNING;
+  entry.dispatch.on_completion_callback = completion_func;
+  entry.handle = handle;
+
+  if( action_id.length() > 0 ) {
+    entry.name = action_id;
+    this->names_[action_id] = handle;
   }
 
-  NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION, "Failed to enqueue action: ",
-                "could not allocate memory for the dispatch queue!\n",
-                "[action_id]:", action_id );
-  return false;
+  ++this->num_actions_;
+
+  return handle;
 }
 
 bool ActionPlayer::update(real32 delta_time)
@@ -165,46 +226,53 @@ bool ActionPlayer::update(real32 delta_time)
   ActionPlayer::State player_state = this->player_state();
   DispatchQueue::State dispatch_running = DispatchQueue::State::IDLING;
 
-  // Process the queue in FIFO order
-  for( auto itr = this->actions_.begin(); itr != this->actions_.end(); ++itr ) {
+  // Actions enqueued from within a completion callback are first updated on
+  // the next call
+  nom::size_type num_entries = this->actions_.size();
 
-    auto action_id = itr->first;
-    auto action_queue = itr->second.get();
+  this->updating_ = true;
 
-    // This is a valid condition; enqueued actions are subject to being removed
-    // before their completion, i.e.: ::run_action will happily overwrite
-    // existing action keys
-    if( action_queue == nullptr ) {
-      NOM_LOG_DEBUG(  NOM_LOG_CATEGORY_ACTION_PLAYER, DEBUG_CLASS_NAME,
-                      "enqueue erasable (NULL)", "[action_id]:", action_id );
+  // Process the queue in FIFO order
+  for( nom::size_type index = 0; index != num_entries; ++index ) {
 
-      this->free_list_.emplace_back(itr);
-    } else {
+    // Cancelled action
+    if( this->entry_running( this->actions_[index] ) == false ) {
+      continue;
+    }
 
-      dispatch_running = (action_queue)->update(player_state, delta_time);
+    // NOTE: The action is moved out of the storage while it runs, as the
+    // storage may be re-allocated by actions enqueued from within the action
+    DispatchEnqueue dispatch = std::move(this->actions_[index].dispatch);
 
-      if( dispatch_running == DispatchQueue::State::IDLING ) {
-        NOM_LOG_DEBUG(  NOM_LOG_CATEGORY_ACTION_PLAYER, DEBUG_CLASS_NAME,
-                        "enqueue erasable", "[action_id]:", action_id );
+    dispatch_running =
+      DispatchQueue::update_action(dispatch, player_state, delta_time);
 
-        this->free_list_.emplace_back(itr);
-      } // end if IDLE
-    } // end if action queue is valid
-  } // end for loop
+    ActionEntry& entry = this->actions_[index];
+    if( this->entry_running(entry) == false ) {
+      // The action was cancelled from within itself
+      continue;
+    }
 
+    if( dispatch_running == DispatchQueue::State::IDLING ) {
+      NOM_LOG_DEBUG(  NOM_LOG_CATEGORY_ACTION_PLAYER, DEBUG_CLASS_NAME,
+                      "erasing action", "[action_id]:", entry.name );
 
-  // Erase the actions from the queue in LIFO order
-  while( this->free_list_.empty() == false ) {
-    auto res = this->free_list_.front();
+      // The action is no longer running by the time its callback is called
+      this->remove_entry(index);
 
-    NOM_LOG_DEBUG(  NOM_LOG_CATEGORY_ACTION_PLAYER, DEBUG_CLASS_NAME,
-                    "erasing action", "[action_id]:", res->first );
+      // Holla back
+      if( dispatch.on_completion_callback != nullptr ) {
+        dispatch.on_completion_callback.operator()();
+      }
+    } else {
+      entry.dispatch = std::move(dispatch);
+    }
+  } // end for loop
 
-    this->actions_.erase(res);
-    this->free_list_.pop_front();
-  }
+  this->updating_ = false;
+  this->compact();
 
-  if( this->actions_.empty() == true ) {
+  if( this->num_actions_ == 0 ) {
     // Finished update iterations; all actions are completed
     return false;
   }
@@ -215,51 +283,83 @@ bool ActionPlayer::update(real32 delta_time)
 
 // Private scope
 
-bool ActionPlayer::
-run_action( const std::shared_ptr<IActionObject>& action,
-            std::unique_ptr<DispatchQueue> dispatch_queue,
-            const action_callback_func& completion_func )
+void ActionPlayer::remove_entry(nom::size_type index)
 {
-  std::string action_id;
+  ActionEntry& entry = this->actions_[index];
+  uint32 slot = priv::slot_handle_index(entry.handle);
+  ActionSlot& action_slot = this->slots_[slot];
 
-  if( action == nullptr ) {
-    NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
-                  "Could not enqueue the action -- action was NULL." );
-    return false;
+  if( entry.name.length() > 0 ) {
+
+    auto res = this->names_.find(entry.name);
+    if( res != this->names_.end() && res->second == entry.handle ) {
+      this->names_.erase(res);
+    }
   }
 
-  if( dispatch_queue == nullptr ) {
-    NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
-                  "Could not enqueue the action -- dispatch queue was NULL." );
-    return false;
+  // Invalidate the outstanding handles of the slot and return it to the free
+  // list
+  ++action_slot.generation;
+  if( action_slot.generation == 0 ) {
+    action_slot.generation = 1;
   }
+  action_slot.index = this->free_slot_;
+  this->free_slot_ = slot;
 
-  action_id = action->name();
+  entry.dispatch.action.reset();
+  entry.dispatch.on_completion_callback = nullptr;
 
-  if( action_id.length() > 0 ) {
-    // Use the existing action name
-  } else {
-    uint64 id = nom::generate_action_id();
-    NOM_ASSERT(id <= std::numeric_limits<uint64>::max() );
-    action_id = std::to_string(id);
-    action->set_name(action_id);
-  }
+  --this->num_actions_;
+}
 
-  if( dispatch_queue->enqueue_action(action, completion_func) == false ) {
-    return false;
+void ActionPlayer::compact()
+{
+  nom::size_type num_entries = 0;
+
+  // Stable; the remaining actions keep their relative order
+  for( nom::size_type index = 0; index != this->actions_.size(); ++index ) {
+
+    ActionEntry& entry = this->actions_[index];
+    if( this->entry_running(entry) == false ) {
+      continue;
+    }
+
+    if( index != num_entries ) {
+      this->actions_[num_entries] = std::move(entry);
+    }
+
+    uint32 slot = priv::slot_handle_index(this->actions_[num_entries].handle);
+    this->slots_[slot].index = num_entries;
+    ++num_entries;
   }
 
-  // NOTE: This logging category is disabled by default
-  if( this->action_running(action_id) == true) {
+  // NOTE: Shrinking does not release the capacity of the storage
+  this->actions_.resize(num_entries);
+}
 
-    NOM_LOG_WARN( NOM_LOG_CATEGORY_ACTION_PLAYER,
-                  "Another action with the same name exists -- overwriting",
-                  "with", action_id );
-  } // end if action was running
+bool ActionPlayer::entry_running(const ActionEntry& entry) const
+{
+  const ActionSlot& action_slot =
+    this->slots_[ priv::slot_handle_index(entry.handle) ];
 
-  this->actions_[action_id] = std::move(dispatch_queue);
+  return( action_slot.generation == priv::slot_handle_generation(entry.handle) );
+}
 
-  return true;
+int64 ActionPlayer::find_entry(handle_type handle) const
+{
+  uint32 slot = priv::slot_handle_index(handle);
+
+  if( handle == INVALID_HANDLE || slot >= this->slots_.size() ) {
+    return -1;
+  }
+
+  const ActionSlot& action_slot = this->slots_[slot];
+  if( action_slot.generation != priv::slot_handle_generation(handle) ) {
+    // Stale handle; the action has completed
+    return -1;
+  }
+
+  return action_slot.index;
 }
 
 } // namespace nom
@@ -36,19 +36,6 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace nom {
 
-// Internal representation of an enqueued action.
-struct DispatchEnqueue
-{
-  // The enqueued action.
-  std::shared_ptr<IActionObject> action;
-
-  /// \brief The action's last known state in reference to the player's state.
-  uint32 last_action_state = ActionPlayer::State::RUNNING;
-
-  // An optional function pointer that is called when the action is completed.
-  action_callback_func on_completion_callback;
-};
-
 // Static initializations
 const char* DispatchQueue::DEBUG_CLASS_NAME = "[DispatchQueue]:";
 
@@ -71,82 +58,49 @@ bool DispatchQueue::
 enqueue_action( const std::shared_ptr<IActionObject>& action,
                 const action_callback_func& completion_func )
 {
-  auto enqueued_action =
-    nom::make_unique<DispatchEnqueue>();
-  if( enqueued_action == nullptr ) {
-    NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
-                  "Failed to enqueue the action:",
-                  "could not allocate memory for the dispatch entry!" );
-    return false;
-  }
-
-  enqueued_action->action = action;
-  enqueued_action->on_completion_callback = completion_func;
+  DispatchEnqueue enqueued_action;
+  enqueued_action.action = action;
+  enqueued_action.last_action_state = ActionPlayer::State::RUNNING;
+  enqueued_action.on_completion_callback = completion_func;
 
   this->actions_.emplace_back( std::move(enqueued_action) );
-  this->actions_iterator_ = this->actions_.begin();
+  this->actions_index_ = 0;
   ++this->num_actions_;
 
   return true;
 }
 
+void DispatchQueue::clear()
+{
+  this->actions_.clear();
+  this->actions_index_ = 0;
+  this->num_actions_ = 0;
+}
+
 DispatchQueue::State
 DispatchQueue::update(uint32 player_state, real32 delta_time)
 {
-  auto itr = this->actions_iterator_;
-  auto actions_end = this->actions_.end();
-
-  if( itr == actions_end ) {
+  if( this->actions_index_ >= this->actions_.size() ) {
     // Finished updating; nothing left to do
     return State::IDLING;
   }
 
-  auto action = (*itr)->action;
-  if( action == nullptr ) {
+  DispatchEnqueue& enqueued_action = this->actions_[this->actions_index_];
+  if( enqueued_action.action == nullptr ) {
     // Finished updating; nothing left to do
     return State::IDLING;
   }
 
-  uint32 &last_action_state = (*itr)->last_action_state;
-
-  IActionObject::FrameState action_status =
-    IActionObject::FrameState::COMPLETED;
-
-  action_status = action->next_frame(delta_time);
-
-  // Handle the current action state with respect to the global player state
-  if( action_status != IActionObject::FrameState::COMPLETED ) {
-
-    if( player_state == ActionPlayer::State::PAUSED &&
-        last_action_state != ActionPlayer::State::PAUSED )
-    {
-      action->pause(delta_time);
-      last_action_state =
-        ActionPlayer::State::PAUSED;
-    } else if(  player_state == ActionPlayer::State::STOPPED &&
-                last_action_state != ActionPlayer::State::STOPPED )
-    {
-      action->rewind(delta_time);
-      last_action_state =
-        ActionPlayer::State::STOPPED;
-    } else if(  player_state == ActionPlayer::State::RUNNING &&
-                last_action_state != ActionPlayer::State::RUNNING )
-    {
-      action->resume(delta_time);
-      last_action_state =
-        ActionPlayer::State::RUNNING;
-    } // end if status != COMPLETED
-  }
-
   // EOF -- handle internal clean up
-  if( action_status == IActionObject::FrameState::COMPLETED ) {
-
-    std::string action_id = action->name();
+  if( DispatchQueue::update_action( enqueued_action, player_state,
+                                    delta_time ) == State::IDLING )
+  {
+    std::string action_id = enqueued_action.action->name();
     action_callback_func completion_func =
-      (*itr)->on_completion_callback;
+      enqueued_action.on_completion_callback;
 
     --this->num_actions_;
-    ++this->actions_iterator_;
+    ++this->actions_index_;
 
     NOM_LOG_DEBUG(  NOM_LOG_CATEGORY_ACTION_QUEUE, DEBUG_CLASS_NAME,
                     "erasing:", action_id, "[remaining_actions]:",
@@ -160,7 +114,7 @@ DispatchQueue::update(uint32 player_state, real32 delta_time)
     }
   } // end if FrameState::COMPLETED
 
-  if( this->actions_iterator_ == actions_end ) {
+  if( this->actions_index_ >= this->actions_.size() ) {
     // Finished update cycle
     return State::IDLING;
   } else {
@@ -169,4 +123,44 @@ DispatchQueue::update(uint32 player_state, real32 delta_time)
   }
 }
 
+DispatchQueue::State
+DispatchQueue::update_action( DispatchEnqueue& enqueued_action,
+                              uint32 player_state, real32 delta_time )
+{
+  IActionObject* action = enqueued_action.action.get();
+  uint32 &last_action_state = enqueued_action.last_action_state;
+
+  IActionObject::FrameState action_status =
+    IActionObject::FrameState::COMPLETED;
+
+  action_status = action->next_frame(delta_time);
+
+  if( action_status == IActionObject::FrameState::COMPLETED ) {
+    return State::IDLING;
+  }
+
+  // Handle the current action state with respect to the global player state
+  if( player_state == ActionPlayer::State::PAUSED &&
+      last_action_state != ActionPlayer::State::PAUSED )
+  {
+    action->pause(delta_time);
+    last_action_state =
+      ActionPlayer::State::PAUSED;
+  } else if(  player_state == ActionPlayer::State::STOPPED &&
+              last_action_state != ActionPlayer::State::STOPPED )
+  {
+    action->rewind(delta_time);
+    last_action_state =
+      ActionPlayer::State::STOPPED;
+  } else if(  player_state == ActionPlayer::State::RUNNING &&
+              last_action_state != ActionPlayer::State::RUNNING )
+  {
+    action->resume(delta_time);
+    last_action_state =
+      ActionPlayer::State::RUNNING;
+  }
+
+  return State::RUNNING;
+}
+
 } // namespace nom
@@ -30,12 +30,21 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Private headers
 #include "nomlib/audio/AL/OpenAL.hpp"
+#include "nomlib/audio/AL/SoundFile.hpp"
+
+#include <algorithm>
+#include <chrono>
 
 // Forward declarations
 #include "nomlib/audio/ISoundBuffer.hpp"
 
 namespace nom {
 
+// Static initializations
+const nom::size_type Music::NUM_STREAM_BUFFERS;
+const uint32 Music::STREAM_BUFFER_MS;
+const uint32 Music::STREAM_UPDATE_MS;
+
 Music::Music ( void )
 {
   NOM_LOG_TRACE( NOM_LOG_CATEGORY_TRACE_AUDIO );
@@ -52,42 +61,533 @@ Music::~Music ( void )
 {
   NOM_LOG_TRACE( NOM_LOG_CATEGORY_TRACE_AUDIO );
 
-  this->Stop();
+  this->close();
+
+  if( this->source_id_ != 0 ) {
+    this->Stop();
+
+    AL_CLEAR_ERR();
+    alDeleteSources(1, &this->source_id_);
+    AL_CHECK_ERR_VOID();
+  }
 }
 
 void Music::setBuffer(const ISoundBuffer& copy)
 {
   NOM_LOG_TRACE( NOM_LOG_CATEGORY_TRACE_AUDIO );
 
+  this->close();
+
   // FIXME: Rethink where we should be doing this!
-  AL_CLEAR_ERR();
-  alGenSources(1, &this->source_id_);
-  AL_CHECK_ERR_VOID();
+  if( this->source_id_ == 0 ) {
+    AL_CLEAR_ERR();
+    alGenSources(1, &this->source_id_);
+    AL_CHECK_ERR_VOID();
+  }
 
   AL_CLEAR_ERR();
   alSourcei(this->source_id_, AL_BUFFER, copy.get() );
   AL_CHECK_ERR_VOID();
 }
 
-void Music::Play ( void )
+bool Music::open(const std::string& filename)
 {
+  NOM_LOG_TRACE( NOM_LOG_CATEGORY_TRACE_AUDIO );
+
+  this->close();
+
+  std::unique_ptr<SoundFile> fp( new SoundFile() );
+  if( fp->open(filename) == false ) {
+    return false;
+  }
+
+  if( fp->getChannelFormat() == 0 || fp->getSampleRate() == 0 ) {
+    NOM_LOG_ERR( NOM_LOG_CATEGORY_AUDIO,
+                 "Could not stream audio file: unsupported channel count",
+                 fp->getChannelCount(), "for", filename );
+    return false;
+  }
+
+  if( this->source_id_ == 0 ) {
+    AL_CLEAR_ERR();
+    alGenSources(1, &this->source_id_);
+    AL_CHECK_ERR_VOID();
+  } else {
+    AL_CLEAR_ERR();
+    alSourceStop(this->source_id_);
+    alSourcei(this->source_id_, AL_BUFFER, AL_NONE);
+    AL_CHECK_ERR_VOID();
+  }
+
+  // Looping is done by the stream, as the source only ever sees a few buffers
   AL_CLEAR_ERR();
-  alSourcePlay(this->source_id_);
+  alSourcei(this->source_id_, AL_LOOPING, AL_FALSE);
   AL_CHECK_ERR_VOID();
+
+  for( nom::size_type i = 0; i != NUM_STREAM_BUFFERS; ++i ) {
+    AL_CLEAR_ERR();
+    alGenBuffers(1, &this->buffers_[i].id);
+    AL_CHECK_ERR_VOID();
+
+    this->buffers_[i].queued = false;
+  }
+
+  // The decoding buffer is the only memory held for the audio data, no matter
+  // the length of the file
+  nom::size_type num_frames =
+    (fp->getSampleRate() * STREAM_BUFFER_MS) / 1000;
+  this->samples_.resize(num_frames * fp->getChannelCount());
+
+  this->file_ = std::move(fp);
+  this->queue_head_ = 0;
+  this->queue_size_ = 0;
+  this->read_frame_ = 0;
+  this->end_of_stream_ = false;
+  this->playing_ = false;
+
+  // Decode the first buffers up front, so that playback starts without
+  // waiting on the stream thread
+  this->queue_buffers();
+
+  this->running_ = true;
+  this->thread_ = std::thread(&Music::run, this);
+
+  return true;
 }
 
-void Music::Stop ( void )
+void Music::close()
 {
+  if( this->streaming() == false ) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    this->running_ = false;
+  }
+
+  this->wake_.notify_one();
+  if( this->thread_.joinable() == true ) {
+    this->thread_.join();
+  }
+
   AL_CLEAR_ERR();
   alSourceStop(this->source_id_);
+  alSourcei(this->source_id_, AL_BUFFER, AL_NONE);
   AL_CHECK_ERR_VOID();
+
+  for( nom::size_type i = 0; i != NUM_STREAM_BUFFERS; ++i ) {
+    AL_CLEAR_ERR();
+    alDeleteBuffers(1, &this->buffers_[i].id);
+    AL_CHECK_ERR_VOID();
+
+    this->buffers_[i] = StreamBuffer();
+  }
+
+  this->queue_head_ = 0;
+  this->queue_size_ = 0;
+  this->playing_ = false;
+
+  std::vector<int16>().swap(this->samples_);
+  this->file_.reset();
+}
+
+bool Music::streaming() const
+{
+  return( this->file_ != nullptr );
+}
+
+void Music::set_loop_points(real32 start_seconds, real32 end_seconds)
+{
+  if( start_seconds < 0.0f || end_seconds < 0.0f ||
+      ( end_seconds > 0.0f && end_seconds <= start_seconds ) )
+  {
+    NOM_LOG_ERR( NOM_LOG_CATEGORY_AUDIO, "Invalid loop points:", start_seconds,
+                 end_seconds );
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  this->loop_start_ = start_seconds;
+  this->loop_end_ = end_seconds;
+}
+
+real32 Music::loop_start() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->loop_start_;
+}
+
+real32 Music::loop_end() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->loop_end_;
+}
+
+bool Music::getLooping() const
+{
+  if( this->streaming() == false ) {
+    return SoundSource::getLooping();
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->looping_;
+}
+
+void Music::setLooping(bool loops)
+{
+  if( this->streaming() == false ) {
+    SoundSource::setLooping(loops);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  this->looping_ = loops;
+
+  // Pick the stream back up when looping is enabled after the last buffer
+  // was decoded, but before it finished playing
+  if( loops == true && this->end_of_stream_ == true && this->queue_size_ > 0 ) {
+    int64 frame = this->loop_start_frame();
+    if( this->file_->seek(frame) == true ) {
+      this->read_frame_ = frame;
+      this->end_of_stream_ = false;
+    }
+  }
+}
+
+real32 Music::getPlayPosition() const
+{
+  if( this->streaming() == false ) {
+    return SoundSource::getPlayPosition();
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex_);
+
+  int64 frame = this->read_frame_;
+  if( this->queue_size_ > 0 ) {
+    ALint offset = 0;
+
+    // The offset is relative to the oldest buffer still in the queue
+    AL_CLEAR_ERR();
+    alGetSourcei(this->source_id_, AL_SAMPLE_OFFSET, &offset);
+    AL_CHECK_ERR_VOID();
+
+    const StreamBuffer& buffer = this->buffers_[this->queue_[this->queue_head_]];
+    frame = buffer.start_frame + offset;
+  }
+
+  int64 end_frame = this->loop_end_frame();
+  if( frame >= end_frame ) {
+    int64 start_frame = this->loop_start_frame();
+
+    if( this->looping_ == true && end_frame > start_frame ) {
+      frame = start_frame + ( (frame - end_frame) % (end_frame - start_frame) );
+    } else {
+      frame = end_frame;
+    }
+  }
+
+  return NOM_SCAST(real32, frame) / this->file_->getSampleRate();
+}
+
+void Music::setPlayPosition(real32 seconds)
+{
+  if( this->streaming() == false ) {
+    SoundSource::setPlayPosition(seconds);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex_);
+
+  this->rewind_stream( this->to_frame(seconds) );
+  this->queue_buffers();
+
+  if( this->playing_ == true ) {
+    AL_CLEAR_ERR();
+    alSourcePlay(this->source_id_);
+    AL_CHECK_ERR_VOID();
+  }
+}
+
+SoundStatus Music::getStatus() const
+{
+  if( this->streaming() == false ) {
+    return SoundSource::getStatus();
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex_);
+
+  // The source stops on its own when the stream falls behind; the music is
+  // still playing as far as the user is concerned
+  if( this->playing_ == true ) {
+    return SoundStatus::Playing;
+  }
+
+  return SoundSource::getStatus();
+}
+
+void Music::Play ( void )
+{
+  if( this->streaming() == false ) {
+    AL_CLEAR_ERR();
+    alSourcePlay(this->source_id_);
+    AL_CHECK_ERR_VOID();
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    ALint state = AL_STOPPED;
+    AL_CLEAR_ERR();
+    alGetSourcei(this->source_id_, AL_SOURCE_STATE, &state);
+    AL_CHECK_ERR_VOID();
+
+    if( state != AL_PLAYING ) {
+      // Start over once the stream has played through to its end
+      if( state != AL_PAUSED && this->queue_size_ == 0 ) {
+        this->rewind_stream(0);
+        this->queue_buffers();
+      }
+
+      AL_CLEAR_ERR();
+      alSourcePlay(this->source_id_);
+      AL_CHECK_ERR_VOID();
+    }
+
+    this->playing_ = true;
+  }
+
+  this->wake_.notify_one();
+}
+
+void Music::Stop ( void )
+{
+  if( this->streaming() == false ) {
+    AL_CLEAR_ERR();
+    alSourceStop(this->source_id_);
+    AL_CHECK_ERR_VOID();
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex_);
+
+  this->playing_ = false;
+  this->rewind_stream(0);
+  this->queue_buffers();
 }
 
 void Music::Pause()
 {
+  if( this->streaming() == false ) {
+    AL_CLEAR_ERR();
+    alSourcePause(this->source_id_);
+    AL_CHECK_ERR_VOID();
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex_);
+
+  this->playing_ = false;
+
   AL_CLEAR_ERR();
   alSourcePause(this->source_id_);
   AL_CHECK_ERR_VOID();
 }
 
+void Music::run()
+{
+  std::unique_lock<std::mutex> lock(this->mutex_);
+
+  while( this->running_ == true ) {
+
+    if( this->playing_ == true ) {
+      this->update_stream();
+    }
+
+    this->wake_.wait_for( lock, std::chrono::milliseconds(STREAM_UPDATE_MS) );
+  }
+}
+
+void Music::update_stream()
+{
+  ALint num_processed = 0;
+
+  AL_CLEAR_ERR();
+  alGetSourcei(this->source_id_, AL_BUFFERS_PROCESSED, &num_processed);
+  AL_CHECK_ERR_VOID();
+
+  // Buffers are processed in the order that they were queued
+  while( num_processed > 0 && this->queue_size_ > 0 ) {
+    nom::size_type index = this->queue_[this->queue_head_];
+    ALuint buffer_id = 0;
+
+    AL_CLEAR_ERR();
+    alSourceUnqueueBuffers(this->source_id_, 1, &buffer_id);
+    AL_CHECK_ERR_VOID();
+
+    this->buffers_[index].queued = false;
+    this->queue_head_ = (this->queue_head_ + 1) % NUM_STREAM_BUFFERS;
+    --this->queue_size_;
+    --num_processed;
+
+    this->queue_buffer(index);
+  }
+
+  ALint state = AL_STOPPED;
+  AL_CLEAR_ERR();
+  alGetSourcei(this->source_id_, AL_SOURCE_STATE, &state);
+  AL_CHECK_ERR_VOID();
+
+  if( state != AL_PLAYING ) {
+
+    if( this->queue_size_ > 0 ) {
+      // The source ran out of buffers before we could refill them
+      AL_CLEAR_ERR();
+      alSourcePlay(this->source_id_);
+      AL_CHECK_ERR_VOID();
+    } else {
+      // Every buffer up to the end of the stream has been played
+      this->playing_ = false;
+    }
+  }
+}
+
+void Music::queue_buffers()
+{
+  for( nom::size_type i = 0; i != NUM_STREAM_BUFFERS; ++i ) {
+
+    if( this->buffers_[i].queued == false ) {
+      if( this->queue_buffer(i) == false ) {
+        break;
+      }
+    }
+  }
+}
+
+bool Music::queue_buffer(nom::size_type index)
+{
+  const int64 num_channels = this->file_->getChannelCount();
+  const int64 max_frames = this->samples_.size() / num_channels;
+  int64 num_frames = 0;
+  bool rewound = false;
+
+  StreamBuffer& buffer = this->buffers_[index];
+  buffer.start_frame = this->read_frame_;
+
+  while( num_frames < max_frames && this->end_of_stream_ == false ) {
+
+    int64 end_frame = this->loop_end_frame();
+    int64 num_read = 0;
+
+    if( this->read_frame_ < end_frame ) {
+      int64 num_wanted =
+        std::min(max_frames - num_frames, end_frame - this->read_frame_);
+
+      num_read =
+        this->file_->read(  this->samples_.data() + (num_frames * num_channels),
+                            num_wanted * num_channels ) / num_channels;
+
+      num_frames += num_read;
+      this->read_frame_ += num_read;
+    }
+
+    if( num_read > 0 ) {
+      rewound = false;
+
+      if( this->read_frame_ < end_frame ) {
+        continue;
+      }
+    }
+
+    // Reached the end of the file or of the loop region; an empty loop
+    // region ends the stream rather than spinning on it
+    if( this->looping_ == false || rewound == true ) {
+      this->end_of_stream_ = true;
+    } else {
+      int64 start_frame = this->loop_start_frame();
+
+      if( this->file_->seek(start_frame) == false ) {
+        this->end_of_stream_ = true;
+      } else {
+        this->read_frame_ = start_frame;
+        rewound = true;
+      }
+    }
+  }
+
+  if( num_frames < 1 ) {
+    return false;
+  }
+
+  AL_CLEAR_ERR();
+  alBufferData( buffer.id, this->file_->getChannelFormat(),
+                this->samples_.data(),
+                num_frames * num_channels * sizeof(int16),
+                this->file_->getSampleRate() );
+  AL_CHECK_ERR_VOID();
+
+  AL_CLEAR_ERR();
+  alSourceQueueBuffers(this->source_id_, 1, &buffer.id);
+  AL_CHECK_ERR_VOID();
+
+  buffer.queued = true;
+  this->queue_[ (this->queue_head_ + this->queue_size_) % NUM_STREAM_BUFFERS ] =
+    index;
+  ++this->queue_size_;
+
+  return true;
+}
+
+void Music::rewind_stream(int64 frame)
+{
+  // Detaching the buffer releases the whole queue of a stopped source
+  AL_CLEAR_ERR();
+  alSourceStop(this->source_id_);
+  alSourcei(this->source_id_, AL_BUFFER, AL_NONE);
+  AL_CHECK_ERR_VOID();
+
+  for( nom::size_type i = 0; i != NUM_STREAM_BUFFERS; ++i ) {
+    this->buffers_[i].queued = false;
+  }
+
+  this->queue_head_ = 0;
+  this->queue_size_ = 0;
+  this->end_of_stream_ = false;
+
+  if( this->file_->seek(frame) == false ) {
+    frame = 0;
+    this->file_->seek(frame);
+  }
+
+  this->read_frame_ = frame;
+}
+
+int64 Music::to_frame(real32 seconds) const
+{
+  int64 frame = NOM_SCAST(int64, seconds * this->file_->getSampleRate() );
+
+  return std::max<int64>( 0, std::min(frame, this->file_->frame_count() ) );
+}
+
+int64 Music::loop_start_frame() const
+{
+  int64 frame = this->to_frame(this->loop_start_);
+
+  if( frame >= this->loop_end_frame() ) {
+    return 0;
+  }
+
+  return frame;
+}
+
+int64 Music::loop_end_frame() const
+{
+  if( this->looping_ == true && this->loop_end_ > 0.0f ) {
+    return this->to_frame(this->loop_end_);
+  }
+
+  return this->file_->frame_count();
+}
+
 } // namespace nom
@@ -81,5 +81,19 @@ void al_err(const std::string& func, const std::string& file, uint32 line)
   } // end if AL_NO_ERROR
 }
 
+uint32 al_channel_format(uint32 num_channels)
+{
+  switch(num_channels)
+  {
+    default: return 0; break;
+    case 1: return alGetEnumValue("AL_FORMAT_MONO16"); break;
+    case 2: return alGetEnumValue("AL_FORMAT_STEREO16"); break;
+    case 4: return alGetEnumValue("AL_FORMAT_QUAD16"); break;
+    case 6: return alGetEnumValue("AL_FORMAT_51CHN16"); break;
+    case 7: return alGetEnumValue("AL_FORMAT_61CHN16"); break;
+    case 8: return alGetEnumValue("AL_FORMAT_71CHN16"); break;
+  }
+}
+
 } // namespace priv
 } // namespace nom
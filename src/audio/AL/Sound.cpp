@@ -78,9 +78,11 @@ void Sound::setBuffer(const ISoundBuffer& copy)
   this->buffer->attach(this);
 
   // FIXME: Rethink where we should be doing this!
-  AL_CLEAR_ERR();
-  alGenSources(1, &this->source_id_);
-  AL_CHECK_ERR_VOID();
+  if( this->source_id_ == 0 ) {
+    AL_CLEAR_ERR();
+    alGenSources(1, &this->source_id_);
+    AL_CHECK_ERR_VOID();
+  }
 
   AL_CLEAR_ERR();
   alSourcei(this->source_id_, AL_BUFFER, this->buffer->get() );
@@ -0,0 +1,192 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include "nomlib/audio/AL/SoundBank.hpp"
+
+// Private headers
+#include "nomlib/audio/AL/SoundBuffer.hpp"
+#include "nomlib/audio/AL/SoundFile.hpp"
+#include "nomlib/system/File.hpp"
+#include "nomlib/system/Path.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace nom {
+
+namespace {
+
+/// \brief The decoded samples of one file of the bank.
+struct DecodedSound
+{
+  std::vector<int16> samples;
+  uint32 channel_count = 0;
+  uint32 sample_rate = 0;
+  bool decoded = false;
+};
+
+/// \brief Decode the files of the bank until none are left.
+void decode_sounds( const std::vector<std::string>& filenames,
+                    std::vector<DecodedSound>& sounds,
+                    std::atomic<nom::size_type>& next_sound )
+{
+  nom::size_type index = 0;
+
+  while( ( index = next_sound++ ) < filenames.size() ) {
+    SoundFile fp;
+    DecodedSound& sound = sounds[index];
+
+    if( fp.open_mapped(filenames[index]) == true &&
+        fp.read(sound.samples) == true )
+    {
+      sound.channel_count = fp.getChannelCount();
+      sound.sample_rate = fp.getSampleRate();
+      sound.decoded = true;
+    }
+  }
+}
+
+} // namespace
+
+SoundBank::SoundBank()
+{
+  NOM_LOG_TRACE( NOM_LOG_CATEGORY_TRACE_AUDIO );
+}
+
+SoundBank::~SoundBank()
+{
+  NOM_LOG_TRACE( NOM_LOG_CATEGORY_TRACE_AUDIO );
+}
+
+nom::size_type
+SoundBank::load_dir(const std::string& dir_path, nom::size_type num_threads)
+{
+  File fp;
+  Path dir(dir_path);
+  std::vector<std::string> names;
+  std::vector<std::string> filenames;
+
+  if( fp.is_dir(dir_path) == false ) {
+    NOM_LOG_ERR( NOM_LOG_CATEGORY_AUDIO, "Could not load sound bank:",
+                 dir_path, "is not a directory." );
+    return 0;
+  }
+
+  std::vector<std::string> entries = fp.read_dir(dir_path);
+  std::sort( entries.begin(), entries.end() );
+
+  for( auto it = entries.begin(); it != entries.end(); ++it ) {
+    std::string filename = dir.prepend(*it);
+
+    if( fp.is_file(filename) == true ) {
+      names.push_back(*it);
+      filenames.push_back(filename);
+    }
+  }
+
+  return this->load(names, filenames, num_threads);
+}
+
+nom::size_type
+SoundBank::load( const std::vector<std::string>& filenames,
+                 nom::size_type num_threads )
+{
+  return this->load(filenames, filenames, num_threads);
+}
+
+SoundBuffer* SoundBank::find(const std::string& name) const
+{
+  auto res = this->buffers_.find(name);
+
+  if( res == this->buffers_.end() ) {
+    return nullptr;
+  }
+
+  return res->second.get();
+}
+
+nom::size_type SoundBank::size() const
+{
+  return this->buffers_.size();
+}
+
+void SoundBank::clear()
+{
+  this->buffers_.clear();
+}
+
+nom::size_type
+SoundBank::load( const std::vector<std::string>& names,
+                 const std::vector<std::string>& filenames,
+                 nom::size_type num_threads )
+{
+  std::vector<DecodedSound> sounds( filenames.size() );
+  std::atomic<nom::size_type> next_sound(0);
+  std::vector<std::thread> workers;
+  nom::size_type num_loaded = 0;
+
+  if( num_threads == 0 ) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency() );
+  }
+
+  // The calling thread decodes alongside the workers
+  num_threads = std::min(num_threads, filenames.size() );
+  for( nom::size_type i = 1; i < num_threads; ++i ) {
+    workers.emplace_back( decode_sounds, std::cref(filenames),
+                          std::ref(sounds), std::ref(next_sound) );
+  }
+
+  decode_sounds(filenames, sounds, next_sound);
+
+  for( auto it = workers.begin(); it != workers.end(); ++it ) {
+    it->join();
+  }
+
+  for( nom::size_type i = 0; i != sounds.size(); ++i ) {
+    DecodedSound& sound = sounds[i];
+
+    if( sound.decoded == false ) {
+      NOM_LOG_ERR( NOM_LOG_CATEGORY_AUDIO, "Could not load sound:",
+                   filenames[i] );
+      continue;
+    }
+
+    std::unique_ptr<SoundBuffer> buffer( new SoundBuffer() );
+    if( buffer->load( std::move(sound.samples), sound.channel_count,
+                      sound.sample_rate ) == true )
+    {
+      this->buffers_[ names[i] ] = std::move(buffer);
+      ++num_loaded;
+    }
+  }
+
+  return num_loaded;
+}
+
+} // namespace nom
@@ -74,30 +74,88 @@ bool SoundBuffer::load ( const std::string& filename )
 {
   SoundFile fp;
 
-  if ( ! fp.open ( filename ) )
+  if ( ! fp.open_mapped ( filename ) )
   {
 NOM_LOG_ERR ( NOM, "Could not load audio: " + filename );
     return false;
   }
 
-  if ( ! fp.read ( this->samples ) )
+  std::vector<int16> samples;
+  if ( ! fp.read ( samples ) )
   {
 NOM_LOG_ERR ( NOM, "Could not read audio samples: " + filename );
     return false;
   }
 
-  this->buffer_duration = ( 1000 * fp.getSampleCount() / fp.getSampleRate() / fp.getChannelCount() );
+  return this->load( std::move(samples), fp.getChannelCount(),
+                     fp.getSampleRate() );
+}
+
+bool SoundBuffer::load(const void* data, nom::size_type size)
+{
+  SoundFile fp;
+
+  if( fp.open(data, size) == false ) {
+    return false;
+  }
+
+  std::vector<int16> samples;
+  if( fp.read(samples) == false ) {
+    NOM_LOG_ERR( NOM_LOG_CATEGORY_AUDIO, "Could not read audio samples." );
+    return false;
+  }
+
+  return this->load( std::move(samples), fp.getChannelCount(),
+                     fp.getSampleRate() );
+}
+
+bool SoundBuffer::load( std::vector<int16>&& samples, uint32 channel_count,
+                        uint32 sample_rate )
+{
+  uint32 channel_format = priv::al_channel_format(channel_count);
+
+  if( channel_format == 0 || sample_rate == 0 || samples.empty() == true ) {
+    NOM_LOG_ERR( NOM_LOG_CATEGORY_AUDIO,
+                 "Could not load audio: unsupported format;", channel_count,
+                 "channels at", sample_rate, "Hz" );
+    return false;
+  }
+
+  this->samples_ = std::move(samples);
+
+  this->buffer_duration =
+    ( 1000 * NOM_SCAST(int64, this->samples_.size() ) / sample_rate / channel_count );
 
   AL_CLEAR_ERR();
   // Fill the audio buffer with loaded sample data
-  alBufferData(this->buffer, fp.getChannelFormat(),
-               &this->samples.front(), fp.getDataByteSize(),
-               fp.getSampleRate() );
+  alBufferData(this->buffer, channel_format,
+               this->samples_.data(), this->samples_.size() * sizeof(int16),
+               sample_rate );
   AL_CHECK_ERR_VOID();
 
+  // OpenAL has made its own copy of the samples
+  if( this->retain_samples_ == false ) {
+    std::vector<int16>().swap(this->samples_);
+  }
+
   return true;
 }
 
+void SoundBuffer::set_retain_samples(bool retain)
+{
+  this->retain_samples_ = retain;
+}
+
+bool SoundBuffer::retain_samples() const
+{
+  return this->retain_samples_;
+}
+
+const std::vector<int16>& SoundBuffer::samples() const
+{
+  return this->samples_;
+}
+
 void SoundBuffer::attach ( Sound* sound ) const
 {
   sounds.insert ( sound );
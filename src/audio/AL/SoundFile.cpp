@@ -28,14 +28,89 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 #include "nomlib/audio/AL/SoundFile.hpp"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
 // Private headers
 #include "nomlib/audio/AL/OpenAL.hpp"
+#include "nomlib/system/MappedFile.hpp"
 
 // Forward declarations (third-party)
 #include <sndfile.h>
 
 namespace nom {
 
+namespace priv {
+
+/// \brief An audio file held in memory, read by libsndfile through its
+/// virtual I/O interface.
+struct SoundFileStream
+{
+  const uint8* data = nullptr;
+  sf_count_t size = 0;
+  sf_count_t offset = 0;
+
+  /// \brief The file that holds the data; not open when the data is owned by
+  /// the caller.
+  MappedFile file;
+};
+
+sf_count_t memory_io_length(void* user_data)
+{
+  return NOM_SCAST(SoundFileStream*, user_data)->size;
+}
+
+sf_count_t memory_io_seek(sf_count_t offset, int whence, void* user_data)
+{
+  auto stream = NOM_SCAST(SoundFileStream*, user_data);
+
+  switch(whence)
+  {
+    default:
+    case SEEK_SET: break;
+    case SEEK_CUR: offset += stream->offset; break;
+    case SEEK_END: offset += stream->size; break;
+  }
+
+  if( offset < 0 || offset > stream->size ) {
+    return -1;
+  }
+
+  stream->offset = offset;
+
+  return stream->offset;
+}
+
+sf_count_t memory_io_read(void* ptr, sf_count_t count, void* user_data)
+{
+  auto stream = NOM_SCAST(SoundFileStream*, user_data);
+
+  count = std::min(count, stream->size - stream->offset);
+  std::memcpy(ptr, stream->data + stream->offset, count);
+  stream->offset += count;
+
+  return count;
+}
+
+sf_count_t memory_io_write(const void*, sf_count_t, void*)
+{
+  // Read-only
+  return 0;
+}
+
+sf_count_t memory_io_tell(void* user_data)
+{
+  return NOM_SCAST(SoundFileStream*, user_data)->offset;
+}
+
+SF_VIRTUAL_IO MEMORY_IO = {
+  memory_io_length, memory_io_seek, memory_io_read, memory_io_write,
+  memory_io_tell
+};
+
+} // namespace priv
+
 SoundFile::SoundFile ( void )
 {
   NOM_LOG_TRACE( NOM_LOG_CATEGORY_TRACE_AUDIO );
@@ -76,46 +151,134 @@ int64 SoundFile::getDataByteSize ( void ) const
   return this->getSampleCount() * sizeof ( int16 );
 }
 
-bool SoundFile::open ( const std::string& filename )
+int64 SoundFile::frame_count() const
 {
-  SF_INFO info;
+  if( this->channel_count == 0 ) {
+    return 0;
+  }
+
+  return this->sample_count / this->channel_count;
+}
 
-  this->fp = std::shared_ptr<SNDFILE> ( sf_open ( filename.c_str(), SFM_READ, &info ), sf_close );
+bool SoundFile::open ( const std::string& filename )
+{
+  SF_INFO info = {};
 
-  if ( this->fp.get() == nullptr )
+  SNDFILE* fp = sf_open(filename.c_str(), SFM_READ, &info);
+  if ( fp == nullptr )
   {
 NOM_LOG_ERR ( NOM, "Could not not audio file: " + filename );
     return false;
   }
 
+  this->fp.reset();
+  this->stream_.reset();
+
+  return this->set_file(fp, info);
+}
+
+bool SoundFile::open(const void* data, nom::size_type size)
+{
+  SF_INFO info = {};
+
+  std::unique_ptr<priv::SoundFileStream> stream( new priv::SoundFileStream() );
+  stream->data = NOM_SCAST(const uint8*, data);
+  stream->size = size;
+
+  SNDFILE* fp =
+    sf_open_virtual(&priv::MEMORY_IO, SFM_READ, &info, stream.get() );
+  if( fp == nullptr ) {
+    NOM_LOG_ERR( NOM_LOG_CATEGORY_AUDIO, "Could not open audio data:",
+                 sf_strerror(nullptr) );
+    return false;
+  }
+
+  // The stream must not be released before the new file is opened, as the
+  // previous file may still be reading from it
+  this->fp.reset();
+  this->stream_ = std::move(stream);
+
+  return this->set_file(fp, info);
+}
+
+bool SoundFile::open_mapped(const std::string& filename)
+{
+  std::unique_ptr<priv::SoundFileStream> stream( new priv::SoundFileStream() );
+
+  if( stream->file.open(filename) == false || stream->file.size() == 0 ) {
+    return this->open(filename);
+  }
+
+  stream->data = reinterpret_cast<const uint8*>( stream->file.data() );
+  stream->size = stream->file.size();
+
+  SF_INFO info = {};
+  SNDFILE* fp =
+    sf_open_virtual(&priv::MEMORY_IO, SFM_READ, &info, stream.get() );
+  if( fp == nullptr ) {
+    NOM_LOG_ERR( NOM_LOG_CATEGORY_AUDIO, "Could not open audio file:",
+                 filename, sf_strerror(nullptr) );
+    return false;
+  }
+
+  this->fp.reset();
+  this->stream_ = std::move(stream);
+
+  return this->set_file(fp, info);
+}
+
+bool SoundFile::set_file(SNDFILE* fp, const SF_INFO& info)
+{
+  this->fp = std::shared_ptr<SNDFILE> ( fp, sf_close );
+
   this->channel_count = info.channels;
   // sample_count should be the same size as samples
   this->sample_count = info.frames * info.channels;
   this->sample_rate = info.samplerate;
+  this->channel_format = priv::al_channel_format(info.channels);
 
-  switch ( info.channels )
-  {
-    default: this->channel_format = 0; break;
-    case 1: this->channel_format = alGetEnumValue ( "AL_FORMAT_MONO16" ); break;
-    case 2: this->channel_format = alGetEnumValue ( "AL_FORMAT_STEREO16" ); break;
-    case 4: this->channel_format = alGetEnumValue ( "AL_FORMAT_QUAD16" ); break;
-    case 6: this->channel_format = alGetEnumValue ( "AL_FORMAT_51CHN16" ); break;
-    case 7: this->channel_format = alGetEnumValue ( "AL_FORMAT_61CHN16" ); break;
-    case 8: this->channel_format = alGetEnumValue ( "AL_FORMAT_71CHN16" ); break;
+  return true;
+}
+
+bool SoundFile::read ( std::vector<int16>& data )
+{
+  nom::size_type offset = data.size();
+
+  // Decode straight into the vector, rather than growing it chunk by chunk
+  data.resize(offset + this->sample_count);
+  offset += this->read(data.data() + offset, this->sample_count);
+  data.resize(offset);
+
+  // Not every format knows its length up front; probe for the rest into a
+  // separate buffer, so that the vector only grows when there is more
+  int16 chunk[BUFFER_SIZE];
+  int64 read_size = 0;
+  while( ( read_size = this->read(chunk, BUFFER_SIZE) ) > 0 ) {
+    data.insert(data.end(), chunk, chunk + read_size);
   }
 
   return true;
 }
 
-bool SoundFile::read ( std::vector<int16>& data )
+int64 SoundFile::read(int16* data, int64 num_samples)
 {
-  sf_count_t read_size = 0;
-  std::vector<int16> read_buffer;
-  read_buffer.resize ( BUFFER_SIZE );
+  if( this->fp == nullptr || data == nullptr || num_samples < 1 ) {
+    return 0;
+  }
 
-  while ( ( read_size = sf_read_short ( this->fp.get(), read_buffer.data(), read_buffer.size() ) ) != 0 )
-  {
-    data.insert ( data.end(), read_buffer.begin(), read_buffer.begin() + read_size);
+  return sf_read_short(this->fp.get(), data, num_samples);
+}
+
+bool SoundFile::seek(int64 frame)
+{
+  if( this->fp == nullptr ) {
+    return false;
+  }
+
+  if( sf_seek(this->fp.get(), frame, SEEK_SET) < 0 ) {
+    NOM_LOG_ERR( NOM_LOG_CATEGORY_AUDIO, "Could not seek audio file to frame:",
+                 frame );
+    return false;
   }
 
   return true;
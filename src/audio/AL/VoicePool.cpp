@@ -0,0 +1,289 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include "nomlib/audio/AL/VoicePool.hpp"
+
+// Private headers
+#include "nomlib/audio/AL/OpenAL.hpp"
+#include "nomlib/core/slot_handle.hpp"
+
+// Forward declarations
+#include "nomlib/audio/ISoundBuffer.hpp"
+
+namespace nom {
+
+// Static initializations
+const VoicePool::handle_type VoicePool::INVALID_HANDLE;
+const int VoicePool::DEFAULT_PRIORITY;
+const nom::size_type VoicePool::DEFAULT_NUM_VOICES;
+
+VoicePool::VoicePool()
+{
+  NOM_LOG_TRACE( NOM_LOG_CATEGORY_TRACE_AUDIO );
+}
+
+VoicePool::~VoicePool()
+{
+  NOM_LOG_TRACE( NOM_LOG_CATEGORY_TRACE_AUDIO );
+
+  this->shutdown();
+}
+
+bool VoicePool::initialize(nom::size_type num_voices)
+{
+  this->shutdown();
+
+  this->voices_.reserve(num_voices);
+  for( nom::size_type i = 0; i != num_voices; ++i ) {
+    Voice voice;
+
+    // We check the error state directly, rather than through
+    // AL_CHECK_ERR_VOID -- running out of sources is expected here
+    alGetError();
+    alGenSources(1, &voice.source_id);
+    if( alGetError() != AL_NO_ERROR ) {
+      NOM_LOG_WARN( NOM_LOG_CATEGORY_AUDIO,
+                    "Could only allocate", this->voices_.size(), "of",
+                    num_voices, "voices." );
+      break;
+    }
+
+    this->voices_.push_back(voice);
+  }
+
+  return( this->voices_.empty() == false );
+}
+
+void VoicePool::shutdown()
+{
+  for( auto it = this->voices_.begin(); it != this->voices_.end(); ++it ) {
+    this->release(*it);
+
+    AL_CLEAR_ERR();
+    alDeleteSources(1, &it->source_id);
+    AL_CHECK_ERR_VOID();
+  }
+
+  this->voices_.clear();
+  this->num_active_ = 0;
+}
+
+nom::size_type VoicePool::num_voices() const
+{
+  return this->voices_.size();
+}
+
+nom::size_type VoicePool::num_active() const
+{
+  return this->num_active_;
+}
+
+nom::size_type VoicePool::num_stolen() const
+{
+  return this->num_stolen_;
+}
+
+VoicePool::handle_type
+VoicePool::play( const ISoundBuffer& buffer, int priority, real32 gain,
+                 real32 pitch )
+{
+  int64 index = this->acquire(priority);
+  if( index < 0 ) {
+    return INVALID_HANDLE;
+  }
+
+  Voice& voice = this->voices_[index];
+  voice.buffer_id = buffer.get();
+  voice.priority = priority;
+  voice.sequence = ++this->sequence_;
+  voice.active = true;
+  ++this->num_active_;
+
+  AL_CLEAR_ERR();
+  alSourcei(voice.source_id, AL_BUFFER, voice.buffer_id);
+  // De-normalize; 0..100 -> 0..1
+  alSourcef(voice.source_id, AL_GAIN, gain / 100.0f);
+  alSourcef(voice.source_id, AL_PITCH, pitch);
+  alSourcePlay(voice.source_id);
+  AL_CHECK_ERR_VOID();
+
+  return priv::make_slot_handle(index, voice.generation);
+}
+
+bool VoicePool::playing(handle_type handle) const
+{
+  int64 index = this->find_voice(handle);
+  if( index < 0 ) {
+    return false;
+  }
+
+  ALint state = AL_STOPPED;
+
+  AL_CLEAR_ERR();
+  alGetSourcei(this->voices_[index].source_id, AL_SOURCE_STATE, &state);
+  AL_CHECK_ERR_VOID();
+
+  return( state == AL_PLAYING );
+}
+
+bool VoicePool::stop(handle_type handle)
+{
+  int64 index = this->find_voice(handle);
+  if( index < 0 ) {
+    return false;
+  }
+
+  this->release(this->voices_[index]);
+
+  return true;
+}
+
+void VoicePool::stop(const ISoundBuffer& buffer)
+{
+  uint32 buffer_id = buffer.get();
+
+  for( auto it = this->voices_.begin(); it != this->voices_.end(); ++it ) {
+    if( it->active == true && it->buffer_id == buffer_id ) {
+      this->release(*it);
+    }
+  }
+}
+
+void VoicePool::stop_all()
+{
+  for( auto it = this->voices_.begin(); it != this->voices_.end(); ++it ) {
+    this->release(*it);
+  }
+}
+
+void VoicePool::update()
+{
+  for( auto it = this->voices_.begin(); it != this->voices_.end(); ++it ) {
+    this->reclaim(*it);
+  }
+}
+
+int64 VoicePool::find_voice(handle_type handle) const
+{
+  uint32 index = priv::slot_handle_index(handle);
+
+  if( handle == INVALID_HANDLE || index >= this->voices_.size() ) {
+    return -1;
+  }
+
+  const Voice& voice = this->voices_[index];
+  if( voice.active == false ||
+      voice.generation != priv::slot_handle_generation(handle) )
+  {
+    return -1;
+  }
+
+  return index;
+}
+
+int64 VoicePool::acquire(int priority)
+{
+  int64 victim = -1;
+
+  for( nom::size_type i = 0; i != this->voices_.size(); ++i ) {
+    Voice& voice = this->voices_[i];
+
+    if( this->reclaim(voice) == true ) {
+      return i;
+    }
+
+    // Steal the lowest priority voice, and the oldest of those
+    if( voice.priority > priority ) {
+      continue;
+    }
+
+    if( victim < 0 ) {
+      victim = i;
+    } else {
+      const Voice& candidate = this->voices_[victim];
+
+      if( voice.priority < candidate.priority ||
+          ( voice.priority == candidate.priority &&
+            voice.sequence < candidate.sequence ) )
+      {
+        victim = i;
+      }
+    }
+  }
+
+  if( victim >= 0 ) {
+    this->release(this->voices_[victim]);
+    ++this->num_stolen_;
+  }
+
+  return victim;
+}
+
+bool VoicePool::reclaim(Voice& voice)
+{
+  if( voice.active == false ) {
+    return true;
+  }
+
+  ALint state = AL_STOPPED;
+
+  AL_CLEAR_ERR();
+  alGetSourcei(voice.source_id, AL_SOURCE_STATE, &state);
+  AL_CHECK_ERR_VOID();
+
+  if( state == AL_PLAYING || state == AL_PAUSED ) {
+    return false;
+  }
+
+  this->release(voice);
+
+  return true;
+}
+
+void VoicePool::release(Voice& voice)
+{
+  if( voice.active == false ) {
+    return;
+  }
+
+  AL_CLEAR_ERR();
+  alSourceStop(voice.source_id);
+  alSourcei(voice.source_id, AL_BUFFER, AL_NONE);
+  AL_CHECK_ERR_VOID();
+
+  // Zero is reserved for nom::VoicePool::INVALID_HANDLE
+  if( ++voice.generation == 0 ) {
+    voice.generation = 1;
+  }
+
+  voice.buffer_id = 0;
+  voice.active = false;
+  --this->num_active_;
+}
+
+} // namespace nom
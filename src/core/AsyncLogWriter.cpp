@@ -0,0 +1,427 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include "nomlib/core/AsyncLogWriter.hpp"
+
+// Private headers
+#include <cstring>
+#include <chrono>
+
+namespace nom {
+
+namespace priv {
+
+/// \brief The writer that async_log_message enqueues onto.
+static std::atomic<AsyncLogWriter*> async_log_writer(nullptr);
+
+/// \brief Flipped between zero and one each time the writer is replaced.
+static std::atomic<int> async_log_epoch(0);
+
+/// \brief The number of async_log_message calls in progress, per epoch.
+static std::atomic<int> num_async_loggers[2];
+
+void async_log_message( void* ptr, int cat, SDL_LogPriority prio,
+                        const char* msg )
+{
+  int epoch = 0;
+
+  // Count this call under the current epoch. The epoch is checked again
+  // after counting, so that a call is never counted under an epoch that
+  // set_async_log_writer has already finished waiting on
+  while( true ) {
+    epoch = async_log_epoch.load();
+    num_async_loggers[epoch].fetch_add(1);
+
+    if( async_log_epoch.load() == epoch ) {
+      break;
+    }
+
+    num_async_loggers[epoch].fetch_sub(1);
+  }
+
+  AsyncLogWriter* writer = async_log_writer.load();
+
+  if( writer != nullptr ) {
+    writer->push(cat, prio, msg);
+  } else {
+    log_message(ptr, cat, prio, msg);
+  }
+
+  num_async_loggers[epoch].fetch_sub(1);
+}
+
+AsyncLogWriter* set_async_log_writer(AsyncLogWriter* writer)
+{
+  AsyncLogWriter* previous = async_log_writer.exchange(writer);
+
+  // Calls that began after the flip load the new writer; wait out the calls
+  // counted before it, which may still be using the previous one
+  int epoch = async_log_epoch.load();
+  async_log_epoch.store(1 - epoch);
+
+  while( num_async_loggers[epoch].load() != 0 ) {
+    std::this_thread::yield();
+  }
+
+  return previous;
+}
+
+} // namespace priv
+
+AsyncLogWriter::AsyncLogWriter(const LogOptions& options) :
+  options_(options)
+{
+  nom::size_type capacity = 2;
+  while( capacity < this->options_.queue_capacity ) {
+    capacity *= 2;
+  }
+  this->options_.queue_capacity = capacity;
+
+  this->cells_.reset( new LogCell[capacity] );
+  this->mask_ = capacity - 1;
+
+  for( nom::size_type idx = 0; idx != capacity; ++idx ) {
+    this->cells_[idx].sequence.store(idx, std::memory_order_relaxed);
+  }
+
+  for( int idx = 0; idx != MAX_CATEGORIES; ++idx ) {
+    this->num_logged_[idx].store(0, std::memory_order_relaxed);
+    this->num_dropped_[idx].store(0, std::memory_order_relaxed);
+  }
+
+  this->enqueue_pos_.store(0, std::memory_order_relaxed);
+  this->num_written_.store(0, std::memory_order_relaxed);
+  this->unreported_drops_.store(0, std::memory_order_relaxed);
+  this->sleeping_.store(false, std::memory_order_relaxed);
+  this->running_.store(true, std::memory_order_relaxed);
+
+  if( this->options_.outputs & LogOptions::OUTPUT_FILE ) {
+    this->open_file();
+  }
+
+  this->thread_ = std::thread( [=]() { this->run(); } );
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+  this->running_.store(false);
+  this->notify();
+
+  if( this->thread_.joinable() == true ) {
+    this->thread_.join();
+  }
+}
+
+const LogOptions& AsyncLogWriter::options() const
+{
+  return this->options_;
+}
+
+nom::size_type AsyncLogWriter::capacity() const
+{
+  return this->mask_ + 1;
+}
+
+uint64 AsyncLogWriter::num_logged(int cat) const
+{
+  return this->num_logged_[category_index(cat)].load();
+}
+
+uint64 AsyncLogWriter::num_dropped(int cat) const
+{
+  return this->num_dropped_[category_index(cat)].load();
+}
+
+uint64 AsyncLogWriter::num_dropped() const
+{
+  uint64 total = 0;
+
+  for( int idx = 0; idx != MAX_CATEGORIES; ++idx ) {
+    total += this->num_dropped_[idx].load();
+  }
+
+  return total;
+}
+
+bool AsyncLogWriter::push(int cat, SDL_LogPriority prio, const char* msg)
+{
+  int index = category_index(cat);
+
+  while( this->try_push(cat, prio, msg) == false ) {
+
+    if( this->options_.overflow != LogOptions::OVERFLOW_BLOCK ) {
+      this->num_dropped_[index].fetch_add(1, std::memory_order_relaxed);
+      this->unreported_drops_.fetch_add(1, std::memory_order_relaxed);
+      this->notify();
+      return false;
+    }
+
+    this->notify();
+    std::this_thread::yield();
+  }
+
+  this->num_logged_[index].fetch_add(1, std::memory_order_relaxed);
+  this->notify();
+
+  return true;
+}
+
+void AsyncLogWriter::flush()
+{
+  const nom::size_type num_enqueued = this->enqueue_pos_.load();
+
+  while( this->num_written_.load() < num_enqueued ) {
+    this->notify();
+    std::this_thread::yield();
+  }
+}
+
+// Private scope
+
+// Static
+int AsyncLogWriter::category_index(int cat)
+{
+  if( cat < 0 || cat >= MAX_CATEGORIES ) {
+    return MAX_CATEGORIES - 1;
+  }
+
+  return cat;
+}
+
+bool AsyncLogWriter::try_push(int cat, SDL_LogPriority prio, const char* msg)
+{
+  LogCell* cell = nullptr;
+  nom::size_type pos = this->enqueue_pos_.load(std::memory_order_relaxed);
+
+  // A slot is free for the producer when its sequence number equals the
+  // position, and it is still being written out while the number lags behind
+  while( true ) {
+
+    cell = &this->cells_[pos & this->mask_];
+    nom::size_type seq = cell->sequence.load(std::memory_order_acquire);
+    intptr_t diff = NOM_SCAST(intptr_t, seq) - NOM_SCAST(intptr_t, pos);
+
+    if( diff == 0 ) {
+      if( this->enqueue_pos_.compare_exchange_weak(
+          pos, pos + 1, std::memory_order_relaxed) == true )
+      {
+        break;
+      }
+    } else if( diff < 0 ) {
+      // Queue is full
+      return false;
+    } else {
+      pos = this->enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+
+  LogRecord& record = cell->record;
+  record.category = cat;
+  record.priority = prio;
+  std::strncpy(record.message, msg, MAX_RECORD_LENGTH - 1);
+  record.message[MAX_RECORD_LENGTH - 1] = '\0';
+
+  // Publish the record to the writer
+  cell->sequence.store(pos + 1, std::memory_order_release);
+
+  return true;
+}
+
+void AsyncLogWriter::notify()
+{
+  // Pairs with the fence of the writer thread before it goes to sleep
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if( this->sleeping_.load(std::memory_order_relaxed) == true ) {
+    std::lock_guard<std::mutex> lock(this->wake_mutex_);
+    this->wake_.notify_one();
+  }
+}
+
+void AsyncLogWriter::run()
+{
+  while( true ) {
+
+    if( this->drain() > 0 ) {
+      continue;
+    }
+
+    uint64 num_drops = this->unreported_drops_.exchange(0);
+    if( num_drops > 0 && this->options_.overflow == LogOptions::OVERFLOW_COUNT )
+    {
+      LogRecord record;
+      record.category = NOM_LOG_CATEGORY_APPLICATION;
+      record.priority = SDL_LOG_PRIORITY_WARN;
+      std::string notice = std::to_string(num_drops) +
+        " log messages were dropped; the log queue was full\n";
+      std::strncpy(record.message, notice.c_str(), MAX_RECORD_LENGTH - 1);
+      record.message[MAX_RECORD_LENGTH - 1] = '\0';
+      this->write_record(record);
+      std::cout.flush();
+    }
+
+    if( this->running_.load() == false ) {
+      // Write out anything enqueued while we were checking
+      if( this->drain() == 0 ) {
+        break;
+      }
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(this->wake_mutex_);
+    this->sleeping_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    LogCell& cell = this->cells_[this->dequeue_pos_ & this->mask_];
+    if( cell.sequence.load(std::memory_order_acquire) != this->dequeue_pos_ + 1 &&
+        this->running_.load() == true )
+    {
+      this->wake_.wait_for(lock, std::chrono::milliseconds(100));
+    }
+
+    this->sleeping_.store(false, std::memory_order_relaxed);
+  }
+
+  if( this->file_.is_open() == true ) {
+    this->file_.close();
+  }
+}
+
+nom::size_type AsyncLogWriter::drain()
+{
+  nom::size_type num_records = 0;
+
+  while( true ) {
+
+    LogCell& cell = this->cells_[this->dequeue_pos_ & this->mask_];
+    nom::size_type seq = cell.sequence.load(std::memory_order_acquire);
+
+    if( seq != this->dequeue_pos_ + 1 ) {
+      // Nothing more has been published yet
+      break;
+    }
+
+    this->write_record(cell.record);
+
+    // Hand the slot back to the producers
+    cell.sequence.store( this->dequeue_pos_ + this->mask_ + 1,
+                         std::memory_order_release );
+    ++this->dequeue_pos_;
+    ++num_records;
+  }
+
+  if( num_records > 0 ) {
+
+    if( this->options_.outputs & LogOptions::OUTPUT_FILE ) {
+      this->file_.flush();
+    }
+
+    this->num_written_.fetch_add(num_records);
+  }
+
+  return num_records;
+}
+
+void AsyncLogWriter::write_record(const LogRecord& record)
+{
+  if( this->options_.outputs & LogOptions::OUTPUT_CONSOLE ) {
+    priv::log_message(nullptr, record.category, record.priority, record.message);
+  }
+
+  if( this->file_.is_open() == false ) {
+    return;
+  }
+
+  nom::size_type length = std::strlen(record.message);
+  const std::string& prefix = SDL2Logger::priority_prefixes_[record.priority];
+  nom::size_type record_size = prefix.size() + 2 + length + 1;
+
+  if( this->options_.max_file_size > 0 && this->file_size_ > 0 &&
+      this->file_size_ + record_size > this->options_.max_file_size )
+  {
+    this->rotate_file();
+  }
+
+  this->file_ << prefix << ": ";
+  this->file_.write(record.message, length);
+
+  // Messages logged through SDL2Logger are newline-terminated already
+  if( length == 0 || record.message[length - 1] != '\n' ) {
+    this->file_ << '\n';
+  }
+
+  this->file_size_ += record_size;
+}
+
+bool AsyncLogWriter::open_file()
+{
+  this->file_.open( this->options_.file_path.c_str(),
+                    std::ios::out | std::ios::app | std::ios::binary );
+
+  if( this->file_.is_open() == false ) {
+    // Do not log this error through SDL, so that we never reach back into the
+    // queue
+    std::cerr << "Could not open log file: " << this->options_.file_path
+              << std::endl;
+    return false;
+  }
+
+  this->file_.seekp(0, std::ios::end);
+  this->file_size_ = this->file_.tellp();
+
+  return true;
+}
+
+void AsyncLogWriter::rotate_file()
+{
+  const std::string& path = this->options_.file_path;
+
+  this->file_.close();
+
+  if( this->options_.max_files > 1 ) {
+
+    std::string oldest = path + "." + std::to_string(this->options_.max_files - 1);
+    std::remove( oldest.c_str() );
+
+    for( uint32 idx = this->options_.max_files - 1; idx > 1; --idx ) {
+      std::string from = path + "." + std::to_string(idx - 1);
+      std::string to = path + "." + std::to_string(idx);
+      std::rename( from.c_str(), to.c_str() );
+    }
+
+    std::string newest = path + ".1";
+    std::rename( path.c_str(), newest.c_str() );
+  } else {
+    std::remove( path.c_str() );
+  }
+
+  this->file_size_ = 0;
+  this->open_file();
+}
+
+} // namespace nom
@@ -31,6 +31,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // Private headers
 #include "nomlib/core/clock.hpp"
 #include "nomlib/core/ConsoleOutput.hpp"
+#include "nomlib/core/AsyncLogWriter.hpp"
 
 namespace nom {
 
@@ -87,10 +88,32 @@ void log_message( void* ptr, int cat, SDL_LogPriority prio, const char* msg )
   std::cout << msg << std::endl;
 }
 
+LogBuffer::LogBuffer()
+{
+  // Reserve room for the trailing newline and null-terminator
+  this->setp( this->buffer_, this->buffer_ + MAX_MESSAGE_LENGTH - 2 );
+}
+
+nom::size_type LogBuffer::size() const
+{
+  return this->pptr() - this->pbase();
+}
+
+const char* LogBuffer::terminate()
+{
+  char* end = this->pptr();
+
+  end[0] = '\n';
+  end[1] = '\0';
+
+  return this->buffer_;
+}
+
 } // namespace priv
 
 // Static initializations
 bool SDL2Logger::initialized_ = false;
+AsyncLogWriter* SDL2Logger::log_writer_ = nullptr;
 const std::string SDL2Logger::priority_prefixes_[NOM_NUM_LOG_PRIORITIES] =
 {
   "NULL",
@@ -102,6 +125,24 @@ const std::string SDL2Logger::priority_prefixes_[NOM_NUM_LOG_PRIORITIES] =
   "CRITICAL"
 };
 
+namespace priv {
+
+/// \brief Stop the background log writer at exit.
+struct LogWriterCleanup
+{
+  ~LogWriterCleanup()
+  {
+    SDL2Logger::shutdown();
+  }
+};
+
+// NOTE: This must be defined after SDL2Logger::priority_prefixes_, so that it
+// is destroyed first; the writer uses the prefixes while writing out the
+// remaining messages.
+static LogWriterCleanup log_writer_cleanup;
+
+} // namespace priv
+
 // Static
 bool SDL2Logger::initialized( void )
 {
@@ -134,11 +175,67 @@ void SDL2Logger::initialize()
   }
 }
 
+// Static
+void SDL2Logger::initialize(const LogOptions& options)
+{
+  SDL2Logger::initialize();
+
+  // Write out the messages of the previous writer before replacing it
+  SDL2Logger::shutdown();
+
+  if( options.async == true ) {
+    SDL2Logger::log_writer_ = new AsyncLogWriter(options);
+    priv::set_async_log_writer(SDL2Logger::log_writer_);
+    SDL_LogSetOutputFunction( priv::async_log_message, nullptr );
+  }
+}
+
+// Static
+void SDL2Logger::shutdown()
+{
+  if( SDL2Logger::log_writer_ == nullptr ) {
+    return;
+  }
+
+  // Stop enqueueing new messages before the writer goes away
+  void ( *log_output_function )( void*, int, SDL_LogPriority, const char* ) = priv::log_message;
+  SDL_LogSetOutputFunction( log_output_function, nullptr );
+
+  // Wait out the threads that are still enqueueing onto the writer
+  priv::set_async_log_writer(nullptr);
+
+  delete SDL2Logger::log_writer_;
+  SDL2Logger::log_writer_ = nullptr;
+}
+
+// Static
+void SDL2Logger::flush()
+{
+  if( SDL2Logger::log_writer_ != nullptr ) {
+    SDL2Logger::log_writer_->flush();
+  }
+}
+
+// Static
+AsyncLogWriter* SDL2Logger::log_writer()
+{
+  return SDL2Logger::log_writer_;
+}
+
+// Static
+bool SDL2Logger::enabled( int cat, nom::LogPriority prio )
+{
+  SDL2Logger::initialize();
+
+  return( SDL2Logger::SDL_priority(prio) >= SDL_LogGetPriority(cat) );
+}
+
 SDL2Logger::SDL2Logger() :
   category_{ NOM },
-  priority_{ LogPriority::NOM_LOG_PRIORITY_INFO }
+  priority_{ LogPriority::NOM_LOG_PRIORITY_INFO },
+  os_{ &buffer_ }
 {
-  SDL2Logger::initialize();
+  this->enabled_ = SDL2Logger::enabled( this->category_, this->priority_ );
 }
 
 SDL2Logger::SDL2Logger  (
@@ -146,18 +243,19 @@ SDL2Logger::SDL2Logger  (
                           nom::LogPriority prio
                         ) :
   category_{ cat },
-  priority_{ prio }
+  priority_{ prio },
+  os_{ &buffer_ }
 {
-  SDL2Logger::initialize();
+  this->enabled_ = SDL2Logger::enabled( this->category_, this->priority_ );
 }
 
 SDL2Logger::~SDL2Logger()
 {
-  this->write( "\n" );
-
-  std::string out( this->output_stream().str() );
+  if( this->enabled_ == false ) {
+    return;
+  }
 
-  SDL_LogMessage( this->category(), SDL2Logger::SDL_priority( this->priority() ), "%s", out.c_str() );
+  SDL_LogMessage( this->category(), SDL2Logger::SDL_priority( this->priority() ), "%s", this->buffer_.terminate() );
 }
 
 void SDL2Logger::write()
@@ -175,7 +273,7 @@ LogPriority SDL2Logger::priority() const
   return this->priority_;
 }
 
-std::ostringstream& SDL2Logger::output_stream()
+std::ostream& SDL2Logger::output_stream()
 {
   return this->os_;
 }
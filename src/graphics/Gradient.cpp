@@ -28,11 +28,31 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 #include "nomlib/graphics/Gradient.hpp"
 
+#include <algorithm>
+
+// Private headers (third-party)
+#include <SDL.h>
+
 // Forward declarations
 #include "nomlib/graphics/Texture.hpp"
 
 namespace nom {
 
+/// \brief The color of the texture's pixels that are not covered by the
+/// fill; red indicates that something went wrong.
+static const uint32 GRADIENT_BACKGROUND_PIXEL = 0xFFFF0000;
+
+/// \brief Pack a color into a SDL_PIXELFORMAT_ARGB8888 pixel.
+inline static
+uint32 gradient_pixel(real32 r, real32 g, real32 b, real32 a)
+{
+  // Truncate the same way that a nom::Color4i does
+  return( NOM_SCAST(uint32, NOM_SCAST(uint8, NOM_SCAST(int16, a) ) ) << 24 |
+          NOM_SCAST(uint32, NOM_SCAST(uint8, NOM_SCAST(int16, r) ) ) << 16 |
+          NOM_SCAST(uint32, NOM_SCAST(uint8, NOM_SCAST(int16, g) ) ) << 8 |
+          NOM_SCAST(uint32, NOM_SCAST(uint8, NOM_SCAST(int16, b) ) ) );
+}
+
 Gradient::Gradient( void ) :
   Transformable( Point2i::null, Size2i::null ),   // Invalid position & size
   gradient_( { Color4i::Blue, Color4i::Blue } )   // Opaque color to serve as
@@ -122,6 +142,14 @@ void Gradient::set_position( const Point2i& pos )
 {
   Transformable::set_position( pos );
 
+  // Moving the gradient does not change its pixels
+  if( this->texture_ != nullptr && this->texture_->valid() == true &&
+      this->texture_->size() == this->size() )
+  {
+    this->texture_->set_position( this->position() + this->margins() );
+    return;
+  }
+
   this->update();
 }
 
@@ -201,123 +229,146 @@ void Gradient::update( void )
 
   if( this->valid() == false ) return;
 
-  // Clear internal cache
-  this->rectangles_.clear();
-
-  if ( this->fill_direction() == FillDirection::Top )
-  {
-    this->strategy_top_down();
-  }
-  else if ( this->fill_direction() == FillDirection::Bottom )
+  if( this->update_cache() == false )
   {
-    this->reverse_colors();
-    this->strategy_top_down();
+    return;
   }
-  else if ( this->fill_direction() == FillDirection::Left )
-  {
-    this->strategy_left_right();
+}
+
+void Gradient::update_ramp( int length )
+{
+  Color4iColors stops = this->colors();
+
+  this->ramp_.clear();
+  if( length <= 0 ) {
+    return;
   }
-  else if ( this->fill_direction() == FillDirection::Right )
+
+  this->ramp_.resize( length );
+
+  // Bottom's up and right to left fills walk the color stops backwards
+  if( this->fill_direction() == FillDirection::Bottom ||
+      this->fill_direction() == FillDirection::Right )
   {
-    this->reverse_colors();
-    this->strategy_left_right();
+    std::reverse( stops.begin(), stops.end() );
   }
 
-  if( this->update_cache() == false )
+  const Color4i& first_color = stops.front();
+
+  if( stops.size() < 2 || this->dithering() == false )
   {
+    std::fill(  this->ramp_.begin(), this->ramp_.end(),
+                gradient_pixel( first_color.r, first_color.g, first_color.b,
+                                first_color.a ) );
     return;
   }
-}
 
-void Gradient::strategy_top_down ( void )
-{
-  uint32 y_offset = ( this->position().y + this->size().h ) - this->margins().y;
+  nom::size_type segments = stops.size() - 1;
+  int begin = 0;
 
-  Color4i first_color = this->start_color();
-  Color4i last_color = this->end_color();
-
-  float currentR = (float) first_color.r;
-  float currentG = (float) first_color.g;
-  float currentB = (float) first_color.b;
+  for( nom::size_type segment = 0; segment != segments; ++segment )
+  {
+    int end = NOM_SCAST( int, ( (segment + 1) * length ) / segments );
+    int steps = end - begin;
 
-  float destR = (float) ( last_color.r - first_color.r )      / ( float ) ( this->size().h - this->margins().y );
-  float destG = (float) ( last_color.g - first_color.g )  / ( float ) ( this->size().h - this->margins().y );
-  float destB = (float) ( last_color.b - first_color.b )    / ( float ) ( this->size().h - this->margins().y );
+    const Color4i& start = stops[segment];
+    const Color4i& stop = stops[segment + 1];
 
-  for ( uint32 rows = this->position().y + this->margins().y; rows < y_offset; rows++ )
-  {
-    // Calculate rendering offsets and cache for rendering to texture
-    IntRect render_coords = IntRect( this->position().x + this->margins().x, rows, this->size().w - this->margins().x, 1 );
-    Color4i render_color = Color4i( currentR, currentG, currentB );
+    float currentR = (float) start.r;
+    float currentG = (float) start.g;
+    float currentB = (float) start.b;
+    float currentA = (float) start.a;
 
-    this->rectangles_.push_back( Rectangle( render_coords, render_color ) );
+    float destR = (float) ( stop.r - start.r ) / (float) steps;
+    float destG = (float) ( stop.g - start.g ) / (float) steps;
+    float destB = (float) ( stop.b - start.b ) / (float) steps;
+    float destA = (float) ( stop.a - start.a ) / (float) steps;
 
-    if ( this->dithering() )
+    for( int step = begin; step != end; ++step )
     {
+      this->ramp_[step] =
+        gradient_pixel( currentR, currentG, currentB, currentA );
+
       currentR += destR;
       currentG += destG;
       currentB += destB;
+      currentA += destA;
     }
-  } // end blit loop
 
-  // NOM_ASSERT( this->rectangles_.size() == ( this->size().w - this->margins().y ) - 1);
-  // NOM_DUMP( this->size() );
-  // NOM_DUMP( this->rectangles_.size() );
+    begin = end;
+  }
 }
 
-void Gradient::strategy_left_right ( void )
+void Gradient::strategy_top_down( uint8* pixels, int pitch )
 {
-  uint32 x_offset = ( this->position().x + this->size().w ) - this->margins().x;
+  int width = this->size().w;
+  int height = this->size().h;
 
-  Color4i first_color = this->start_color();
-  Color4i last_color = this->end_color();
+  this->update_ramp( height - this->margins().y );
 
-  float currentR = (float) first_color.r;
-  float currentG = (float) first_color.g;
-  float currentB = (float) first_color.b;
+  // The fill is offset by the margins twice within the texture, and then
+  // drawn from the texture's bounds at the margins; see the Margins test of
+  // GradientTest.
+  int x_offset = std::min( std::max( this->margins().x * 2, 0 ), width );
+  int y_offset = this->margins().y * 2;
+  int ramp_size = this->ramp_.size();
 
-  float destR = (float) ( last_color.r - first_color.r )      / ( float ) ( this->size().w - this->margins().x );
-  float destG = (float) ( last_color.g - first_color.g )  / ( float ) ( this->size().w - this->margins().x );
-  float destB = (float) ( last_color.b - first_color.b )    / ( float ) ( this->size().w - this->margins().x );
-
-  for ( uint32 rows = this->position().x + this->margins().x; rows < x_offset; rows++ )
+  for( int rows = 0; rows < height; ++rows )
   {
-    // Calculate rendering offsets and cache for rendering to texture
-    IntRect render_coords = IntRect( rows, this->position().y + this->margins().y, 1, this->size().h - this->margins().y );
-    Color4i render_color = Color4i( currentR, currentG, currentB );
-
-    this->rectangles_.push_back( Rectangle( render_coords, render_color ) );
+    uint32* row = NOM_SCAST( uint32*, NOM_SCAST( void*, pixels + rows * pitch ) );
+    int step = rows - y_offset;
 
-    if ( this->dithering() )
-    {
-      currentR += destR;
-      currentG += destG;
-      currentB += destB;
+    uint32 color = GRADIENT_BACKGROUND_PIXEL;
+    if( step >= 0 && step < ramp_size ) {
+      color = this->ramp_[step];
     }
-  } // end blit loop
 
-  // NOM_ASSERT( this->rectangles_.size() == this->size().w );
-  // NOM_ASSERT( this->rectangles_.size() == ( this->size().w - this->margins().x ) );
-  // NOM_DUMP( this->size() );
-  // NOM_DUMP( this->rectangles_.size() );
+    std::fill( row, row + x_offset, GRADIENT_BACKGROUND_PIXEL );
+    std::fill( row + x_offset, row + width, color );
+  } // end blit loop
 }
 
-bool Gradient::update_cache()
+void Gradient::strategy_left_right( uint8* pixels, int pitch )
 {
-  RenderWindow* context = nom::render_interface();
-  NOM_ASSERT( context != nullptr );
+  int width = this->size().w;
+  int height = this->size().h;
 
-  // Sanity check
-  if( context == nullptr ) {
-    NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
-                  "Could not update texture cache for the gradient:",
-                  "invalid renderer.");
-    return false;
+  this->update_ramp( width - this->margins().x );
+
+  // The fill is offset by the margins twice within the texture, and then
+  // drawn from the texture's bounds at the margins; see the Margins test of
+  // GradientTest.
+  int x_offset = this->margins().x * 2;
+  int y_offset = std::min( std::max( this->margins().y * 2, 0 ), height );
+  int ramp_size = this->ramp_.size();
+
+  // Every row of the fill is the same; compute it once
+  uint32* fill_row = NOM_SCAST( uint32*, NOM_SCAST( void*, pixels + y_offset * pitch ) );
+  for( int cols = 0; cols < width && y_offset < height; ++cols )
+  {
+    int step = cols - x_offset;
+
+    if( step >= 0 && step < ramp_size ) {
+      fill_row[cols] = this->ramp_[step];
+    } else {
+      fill_row[cols] = GRADIENT_BACKGROUND_PIXEL;
+    }
   }
 
-  // Obtain the optimal pixel format for the platform
-  RendererInfo caps = context->caps();
+  for( int rows = 0; rows < height; ++rows )
+  {
+    uint32* row = NOM_SCAST( uint32*, NOM_SCAST( void*, pixels + rows * pitch ) );
 
+    if( rows < y_offset ) {
+      std::fill( row, row + width, GRADIENT_BACKGROUND_PIXEL );
+    } else if( rows > y_offset ) {
+      std::copy( fill_row, fill_row + width, row );
+    }
+  } // end blit loop
+}
+
+bool Gradient::update_cache()
+{
   if( this->texture_ == nullptr ) {
     NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
                   "Could not update texture cache for the gradient:",
@@ -325,8 +376,13 @@ bool Gradient::update_cache()
     return false;
   }
 
-  if( this->texture_->size() != this->size() ) {
+  if( this->size().w <= 0 || this->size().h <= 0 ) {
+    return false;
+  }
 
+  if( this->texture_->valid() == false ||
+      this->texture_->size() != this->size() )
+  {
     // Poor man's counter of how often we are re-allocating this texture
     NOM_LOG_TRACE_PRIO(NOM_LOG_CATEGORY_RENDER, NOM_LOG_PRIORITY_DEBUG);
     NOM_LOG_DEBUG(  NOM_LOG_CATEGORY_RENDER,
@@ -337,48 +393,43 @@ bool Gradient::update_cache()
     // dimensions are local to this object, we deal with translating relative
     // coordinates to what will be the absolute coordinate space -- our
     // output rendering window
-    if( this->texture_->initialize( caps.optimal_texture_format(), SDL_TEXTUREACCESS_TARGET, this->size() ) == false )
+    if( this->texture_->initialize( SDL_PIXELFORMAT_ARGB8888,
+        SDL_TEXTUREACCESS_STREAMING, this->size() ) == false )
     {
       NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
                     "Could not initialize the texture cache for the gradient." );
       return false;
     }
+
+    this->texture_->set_blend_mode( SDL_BLENDMODE_BLEND );
   }
 
   // Local coordinates (relative)
   this->texture_->set_bounds( IntRect( this->margins(), this->size() ) );
   this->texture_->set_position( this->position() + this->margins() );
 
-  // Set the rendering target to the texture (uses FBO)
-  if( context->set_render_target( this->texture_.get() ) == false ) {
+  if( this->texture_->lock() == false ) {
     NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
-                  "Could not update texture cache: failed to set rendering"
-                  "target" );
+                  "Could not update texture cache:",
+                  "failed to lock the texture." );
     return false;
   }
 
-  // Debugging aid; red background indicates something went wrong
-  if( context->fill(Color4i::Red) == false ) {
-  }
+  uint8* pixels = NOM_SCAST( uint8*, this->texture_->pixels() );
+  int pitch = this->texture_->pitch();
 
-  // Relative to absolute transformations
-  Point2i relative_pos;
-  for( auto itr = this->rectangles_.begin(); itr != this->rectangles_.end(); ++itr )
+  if( this->fill_direction() == FillDirection::Top ||
+      this->fill_direction() == FillDirection::Bottom )
   {
-    relative_pos = ( (*itr).position() - this->position() ) + this->margins();
-
-    itr->set_position(relative_pos);
-    itr->draw(*context);
+    this->strategy_top_down( pixels, pitch );
   }
-
-  // Reset the rendering target now that we are done using it.
-  if( context->reset_render_target() == false ) {
-    NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
-                  "Could not update texture cache:",
-                  "failed to reset the rendering target." );
-    return false;
+  else
+  {
+    this->strategy_left_right( pixels, pitch );
   }
 
+  this->texture_->unlock();
+
   NOM_ASSERT( this->texture_->position() == this->position() + this->margins() );
   NOM_ASSERT( this->texture_->bounds() == IntRect( this->margins(), this->size() ) );
 
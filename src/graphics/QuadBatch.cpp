@@ -0,0 +1,215 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include "nomlib/graphics/QuadBatch.hpp"
+
+#include <algorithm>
+
+// Private headers
+#include "nomlib/system/SDL_helpers.hpp"
+
+// Forward declarations
+#include "nomlib/graphics/Texture.hpp"
+
+namespace nom {
+
+QuadBatch::QuadBatch() :
+  bounds_(IntRect::zero)
+#if defined(NOM_USE_SDL2_RENDER_GEOMETRY)
+  ,
+  geometry_dirty_(true),
+  geometry_dims_(Size2i::zero),
+  geometry_offset_(Point2i::zero),
+  geometry_color_(Color4i::White)
+#endif
+{
+  // NOM_LOG_TRACE( NOM );
+}
+
+QuadBatch::~QuadBatch()
+{
+  // NOM_LOG_TRACE( NOM );
+}
+
+nom::size_type QuadBatch::size() const
+{
+  return this->dests_.size();
+}
+
+bool QuadBatch::empty() const
+{
+  return this->dests_.empty();
+}
+
+const IntRect& QuadBatch::bounds() const
+{
+  return this->bounds_;
+}
+
+void QuadBatch::reserve(nom::size_type quads)
+{
+  this->sources_.reserve(quads);
+  this->dests_.reserve(quads);
+}
+
+void QuadBatch::clear()
+{
+  this->sources_.clear();
+  this->dests_.clear();
+  this->bounds_ = IntRect::zero;
+
+  #if defined(NOM_USE_SDL2_RENDER_GEOMETRY)
+    this->geometry_dirty_ = true;
+  #endif
+}
+
+void QuadBatch::append(const IntRect& source, const IntRect& dest)
+{
+  if( this->empty() == true ) {
+    this->bounds_ = dest;
+  } else {
+    int right =
+      std::max(this->bounds_.x + this->bounds_.w, dest.x + dest.w);
+    int bottom =
+      std::max(this->bounds_.y + this->bounds_.h, dest.y + dest.h);
+
+    this->bounds_.x = std::min(this->bounds_.x, dest.x);
+    this->bounds_.y = std::min(this->bounds_.y, dest.y);
+    this->bounds_.w = right - this->bounds_.x;
+    this->bounds_.h = bottom - this->bounds_.y;
+  }
+
+  this->sources_.push_back( SDL_RECT(source) );
+  this->dests_.push_back( SDL_RECT(dest) );
+
+  #if defined(NOM_USE_SDL2_RENDER_GEOMETRY)
+    this->geometry_dirty_ = true;
+  #endif
+}
+
+void QuadBatch::draw( SDL_Renderer* target, const Texture& texture,
+                      const Point2i& offset, const Color4i& color ) const
+{
+  if( target == nullptr || texture.valid() == false || this->empty() ) {
+    return;
+  }
+
+#if defined(NOM_USE_SDL2_RENDER_GEOMETRY)
+  Size2i texture_dims( texture.width(), texture.height() );
+
+  if( this->geometry_dirty_ == true ||
+      this->geometry_dims_ != texture_dims ||
+      this->geometry_offset_ != offset ||
+      this->geometry_color_ != color )
+  {
+    this->update_geometry(texture_dims, offset, color);
+  }
+
+  if( SDL_RenderGeometry( target, texture.texture(),
+                          this->vertices_.data(), this->vertices_.size(),
+                          this->indices_.data(), this->indices_.size() ) != 0 )
+  {
+    NOM_LOG_ERR( NOM_LOG_CATEGORY_RENDER, SDL_GetError() );
+  }
+#else
+  SDL_Rect render_coords = {};
+  nom::size_type num_quads = this->size();
+
+  for( nom::size_type idx = 0; idx != num_quads; ++idx ) {
+
+    render_coords = this->dests_[idx];
+    render_coords.x += offset.x;
+    render_coords.y += offset.y;
+
+    if( SDL_RenderCopy( target, texture.texture(), &this->sources_[idx],
+                        &render_coords ) != 0 )
+    {
+      NOM_LOG_ERR( NOM_LOG_CATEGORY_RENDER, SDL_GetError() );
+      return;
+    }
+  }
+#endif
+}
+
+// Private scope
+
+#if defined(NOM_USE_SDL2_RENDER_GEOMETRY)
+void QuadBatch::update_geometry(  const Size2i& texture_dims,
+                                  const Point2i& offset,
+                                  const Color4i& color ) const
+{
+  nom::size_type num_quads = this->size();
+  SDL_Color vertex_color = SDL_COLOR(color);
+
+  // Normalize texture coordinates to [0..1]
+  float tex_w = texture_dims.w > 0 ? NOM_SCAST(float, texture_dims.w) : 1.0f;
+  float tex_h = texture_dims.h > 0 ? NOM_SCAST(float, texture_dims.h) : 1.0f;
+
+  this->vertices_.resize(num_quads * 4);
+  this->indices_.resize(num_quads * 6);
+
+  for( nom::size_type idx = 0; idx != num_quads; ++idx ) {
+
+    const SDL_Rect& src = this->sources_[idx];
+    const SDL_Rect& dest = this->dests_[idx];
+    SDL_Vertex* v = &this->vertices_[idx * 4];
+    int* i = &this->indices_[idx * 6];
+    int base = NOM_SCAST(int, idx * 4);
+
+    float left = NOM_SCAST(float, dest.x + offset.x);
+    float top = NOM_SCAST(float, dest.y + offset.y);
+    float right = left + dest.w;
+    float bottom = top + dest.h;
+
+    float u0 = src.x / tex_w;
+    float v0 = src.y / tex_h;
+    float u1 = (src.x + src.w) / tex_w;
+    float v1 = (src.y + src.h) / tex_h;
+
+    // Top-left, top-right, bottom-right, bottom-left
+    v[0] = { {left, top}, vertex_color, {u0, v0} };
+    v[1] = { {right, top}, vertex_color, {u1, v0} };
+    v[2] = { {right, bottom}, vertex_color, {u1, v1} };
+    v[3] = { {left, bottom}, vertex_color, {u0, v1} };
+
+    i[0] = base + 0;
+    i[1] = base + 1;
+    i[2] = base + 2;
+    i[3] = base + 0;
+    i[4] = base + 2;
+    i[5] = base + 3;
+  }
+
+  this->geometry_dirty_ = false;
+  this->geometry_dims_ = texture_dims;
+  this->geometry_offset_ = offset;
+  this->geometry_color_ = color;
+}
+#endif
+
+} // namespace nom
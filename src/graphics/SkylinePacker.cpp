@@ -0,0 +1,222 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include "nomlib/graphics/SkylinePacker.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace nom {
+
+SkylinePacker::SkylinePacker() :
+  size_(0, 0),
+  used_area_(0)
+{
+  //NOM_LOG_TRACE(NOM);
+}
+
+SkylinePacker::SkylinePacker(const Size2i& bin_size) :
+  size_(0, 0),
+  used_area_(0)
+{
+  //NOM_LOG_TRACE(NOM);
+
+  this->reset(bin_size);
+}
+
+SkylinePacker::~SkylinePacker()
+{
+  //NOM_LOG_TRACE(NOM);
+}
+
+const Size2i& SkylinePacker::size() const
+{
+  return this->size_;
+}
+
+real32 SkylinePacker::occupancy() const
+{
+  int64 bin_area = NOM_SCAST(int64, this->size_.w) * this->size_.h;
+
+  if( bin_area <= 0 ) {
+    return 0.0f;
+  }
+
+  return( NOM_SCAST(real32, this->used_area_) / bin_area );
+}
+
+void SkylinePacker::reset(const Size2i& bin_size)
+{
+  this->size_ = bin_size;
+  this->used_area_ = 0;
+  this->skyline_.clear();
+
+  if( bin_size.w > 0 && bin_size.h > 0 ) {
+    SkylineNode node = { 0, 0, bin_size.w };
+    this->skyline_.push_back(node);
+  }
+}
+
+void SkylinePacker::grow(const Size2i& bin_size)
+{
+  if( bin_size.w > this->size_.w ) {
+
+    // The new columns are empty from the top down
+    SkylineNode node = { this->size_.w, 0, bin_size.w - this->size_.w };
+    this->skyline_.push_back(node);
+    this->size_.w = bin_size.w;
+
+    this->merge();
+  }
+
+  if( bin_size.h > this->size_.h ) {
+    // The skyline is measured from the top of the bin, so there is nothing
+    // else to do for extra rows
+    this->size_.h = bin_size.h;
+  }
+}
+
+IntRect SkylinePacker::pack(const Size2i& dims)
+{
+  int best_bottom = std::numeric_limits<int>::max();
+  int best_width = std::numeric_limits<int>::max();
+  nom::size_type best_index = this->skyline_.size();
+  IntRect rect(IntRect::null);
+
+  if( dims.w <= 0 || dims.h <= 0 ) {
+    return IntRect::null;
+  }
+
+  for( nom::size_type index = 0; index != this->skyline_.size(); ++index ) {
+
+    int y = this->fit(index, dims);
+    if( y < 0 ) {
+      continue;
+    }
+
+    // Prefer the lowest resting position; ties go to the narrowest segment,
+    // so that wide gaps remain available for wide rectangles
+    const SkylineNode& node = this->skyline_[index];
+    if( y + dims.h < best_bottom ||
+        ( y + dims.h == best_bottom && node.width < best_width ) )
+    {
+      best_bottom = y + dims.h;
+      best_width = node.width;
+      best_index = index;
+      rect = IntRect(node.x, y, dims.w, dims.h);
+    }
+  }
+
+  if( best_index == this->skyline_.size() ) {
+    // Err -- the bin is full
+    return IntRect::null;
+  }
+
+  this->add_level(best_index, rect);
+  this->used_area_ += NOM_SCAST(int64, dims.w) * dims.h;
+
+  return rect;
+}
+
+// Private scope
+
+int SkylinePacker::fit(nom::size_type index, const Size2i& dims) const
+{
+  int x = this->skyline_[index].x;
+  int y = 0;
+  int width_left = dims.w;
+
+  if( x + dims.w > this->size_.w ) {
+    return -1;
+  }
+
+  // The rectangle rests on the highest segment that it spans
+  while( width_left > 0 ) {
+
+    if( index == this->skyline_.size() ) {
+      return -1;
+    }
+
+    const SkylineNode& node = this->skyline_[index];
+    y = std::max(y, node.y);
+
+    if( y + dims.h > this->size_.h ) {
+      return -1;
+    }
+
+    width_left -= node.width;
+    ++index;
+  }
+
+  return y;
+}
+
+void SkylinePacker::add_level(nom::size_type index, const IntRect& rect)
+{
+  SkylineNode level = { rect.x, rect.y + rect.h, rect.w };
+  this->skyline_.insert(this->skyline_.begin() + index, level);
+
+  // Shrink or remove the segments now hidden beneath the new one
+  for( nom::size_type i = index + 1; i < this->skyline_.size(); ) {
+
+    SkylineNode& node = this->skyline_[i];
+    const SkylineNode& prev = this->skyline_[i - 1];
+    int prev_right = prev.x + prev.width;
+
+    if( node.x >= prev_right ) {
+      break;
+    }
+
+    int shrink = prev_right - node.x;
+    node.x += shrink;
+    node.width -= shrink;
+
+    if( node.width <= 0 ) {
+      this->skyline_.erase(this->skyline_.begin() + i);
+    } else {
+      break;
+    }
+  }
+
+  this->merge();
+}
+
+void SkylinePacker::merge()
+{
+  for( nom::size_type i = 0; i + 1 < this->skyline_.size(); ) {
+
+    if( this->skyline_[i].y == this->skyline_[i + 1].y ) {
+      this->skyline_[i].width += this->skyline_[i + 1].width;
+      this->skyline_.erase(this->skyline_.begin() + i + 1);
+    } else {
+      ++i;
+    }
+  }
+}
+
+} // namespace nom
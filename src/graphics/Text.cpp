@@ -36,16 +36,35 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nomlib/graphics/fonts/Glyph.hpp"
 #include "nomlib/graphics/shapes/Rectangle.hpp"
 
-// #define NOM_OLD_TEXT_RENDER
-
 namespace nom {
 
+// Static initializations
+const nom::size_type Text::DEFAULT_CACHE_BUDGET = 16 * 1024 * 1024;
+nom::size_type Text::cache_budget_ = Text::DEFAULT_CACHE_BUDGET;
+nom::size_type Text::cache_memory_ = 0;
+
+nom::size_type Text::cache_budget()
+{
+  return Text::cache_budget_;
+}
+
+nom::size_type Text::cache_memory()
+{
+  return Text::cache_memory_;
+}
+
+void Text::set_cache_budget(nom::size_type bytes)
+{
+  Text::cache_budget_ = bytes;
+}
+
 Text::Text( void ) :
   Transformable(Point2i::zero, Size2i::null), // Base class
   text_size_ ( nom::DEFAULT_FONT_SIZE ),
   color_ ( Color4i::White ),
   style_ ( Text::Style::Normal ),
-  dirty_(false)
+  render_mode_(RenderMode::GlyphBatch),
+  dirty_(DirtyFlags::NotDirty)
 {
   // NOM_LOG_TRACE( NOM );
 }
@@ -53,6 +72,8 @@ Text::Text( void ) :
 Text::~Text( void )
 {
   // NOM_LOG_TRACE( NOM );
+
+  this->release_cache();
 }
 
 Text::Text  (
@@ -65,7 +86,8 @@ Text::Text  (
   text_ ( text ),
   text_size_( character_size ),
   style_( Text::Style::Normal ),
-  dirty_(false)
+  render_mode_(RenderMode::GlyphBatch),
+  dirty_(DirtyFlags::NotDirty)
 {
   // NOM_LOG_TRACE( NOM );
 
@@ -83,7 +105,8 @@ Text::Text  (
   text_ ( text ),
   text_size_( character_size ),
   style_( Text::Style::Normal ),
-  dirty_(false)
+  render_mode_(RenderMode::GlyphBatch),
+  dirty_(DirtyFlags::NotDirty)
 {
   // NOM_LOG_TRACE( NOM );
 
@@ -95,17 +118,19 @@ Text::Text(const self_type& rhs) :
   Transformable( rhs.position(), rhs.size() ),
   font_(rhs.font_),
   glyphs_texture_(rhs.glyphs_texture_),
+  atlas_revision_(rhs.atlas_revision_),
+  glyphs_batch_(rhs.glyphs_batch_),
+  lines_(rhs.lines_),
   text_(rhs.text_),
   text_size_(rhs.text_size_),
   color_(rhs.color_),
   style_(rhs.style_),
+  render_mode_(rhs.render_mode_),
   dirty_(rhs.dirty_)
 {
   // NOM_LOG_TRACE( NOM );
 
-  if( this->rendered_text_ != nullptr ) {
-    this->rendered_text_.reset( new Texture(*rhs.rendered_text_) );
-  }
+  this->cache_dirty_ = ( this->render_mode() == RenderMode::RenderToTexture );
 }
 
 Text::self_type& Text::operator =(const self_type& rhs)
@@ -114,17 +139,23 @@ Text::self_type& Text::operator =(const self_type& rhs)
   Transformable::set_size( rhs.size() );
   this->font_ = rhs.font_;
   this->glyphs_texture_ = rhs.glyphs_texture_;
-
-  if( this->rendered_text_ != nullptr ) {
-    this->rendered_text_.reset( new Texture(*rhs.rendered_text_) );
-  }
-
+  this->atlas_revision_ = rhs.atlas_revision_;
+  this->glyphs_batch_ = rhs.glyphs_batch_;
+  this->lines_ = rhs.lines_;
   this->text_ = rhs.text_;
   this->text_size_ = rhs.text_size_;
   this->color_ = rhs.color_;
   this->style_ = rhs.style_;
+  this->render_mode_ = rhs.render_mode_;
   this->dirty_ = rhs.dirty_;
 
+  // The texture is kept for re-use, but must be rendered again
+  if( this->render_mode() == RenderMode::RenderToTexture ) {
+    this->cache_dirty_ = true;
+  } else {
+    this->release_cache();
+  }
+
   return *this;
 }
 
@@ -215,7 +246,7 @@ Texture* Text::clone_texture() const
     return texture;
   }
 
-  this->render_text(*context);
+  this->render_text(*context, Point2i::zero);
 
   if( context->reset_render_target() == false ) {
     NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
@@ -246,7 +277,7 @@ bool Text::valid ( void ) const
 int Text::text_width(const std::string& text_buffer) const
 {
   int text_width = 0;
-  int max_text_width = 0;
+  TextLines lines;
 
   // Ensure that our font pointer is still valid
   if( this->valid() == false ) {
@@ -254,87 +285,13 @@ int Text::text_width(const std::string& text_buffer) const
     return text_width;
   }
 
-  for( auto pos = 0; pos < text_buffer.length(); ++pos ) {
-
-    uint32 current_char = text_buffer[pos];
-
-    if( current_char == '\n' ) {
-
-      max_text_width =
-        std::max( max_text_width, this->multiline_width(text_buffer, pos) );
-    } else {
-
-      // Printable ASCII glyph; 33..127
-      text_width =
-        std::max(text_width, this->multiline_width(text_buffer, pos) );
-    }
-  } // end for loop
-
-  return( std::max(text_width, max_text_width) );
-}
-
-// Private call
-int
-Text::multiline_width(const std::string& text_buffer, nom::size_type pos) const
-{
-  int text_width = 0;
-  int max_text_width = 0;
-  uint32 previous_kerning_char = 0;
-  int kerning_offset = 0;
-  nom::size_type text_buffer_end = text_buffer.length();
-
-  nom::size_type next_newline =
-    text_buffer.find('\n', pos + 1);
-
-  if( next_newline != std::string::npos ) {
-    text_buffer_end = next_newline;
-  } else {
-    // Use default initialized result
-  }
-
-  for(  auto character_pos = pos;
-        character_pos != text_buffer_end;
-        ++character_pos )
-  {
-    uint32 current_char = text_buffer[character_pos];
-
-    kerning_offset =
-      this->font()->kerning(  previous_kerning_char, current_char,
-                              this->text_size() );
-
-    if( kerning_offset != nom::NOM_INT_MIN ) {
-      text_width += kerning_offset;
-    }
-
-    previous_kerning_char = current_char;
-
-    if( current_char == ' ' ) {
-
-      // ASCII 32; space glyph
-      text_width +=
-        this->font()->spacing( this->text_size() );
-
-    } else if( current_char == '\t' ) {
-
-      // Tab character; indent two space glyphs
-      text_width +=
-        this->font()->spacing( this->text_size() ) * 2;
-
-    } else if( current_char == '\n' ) {
-      // Do nothing
-    } else {
-
-      text_width +=
-        this->font()->glyph(current_char, this->text_size() ).advance + 1;
-    }
+  this->layout_text(text_buffer, nullptr, &lines);
 
-    max_text_width = std::max(text_width, max_text_width);
+  for( auto itr = lines.begin(); itr != lines.end(); ++itr ) {
+    text_width = std::max(text_width, itr->width);
   }
 
-  // Padding for rendered_text_
-  // max_text_width += this->font()->spacing( this->text_size() );
-
-  return max_text_width;
+  return text_width;
 }
 
 sint Text::text_height ( const std::string& text_string ) const
@@ -391,6 +348,18 @@ uint32 Text::style( void ) const
   return this->style_;
 }
 
+Text::RenderMode Text::render_mode() const
+{
+  return this->render_mode_;
+}
+
+bool Text::cached() const
+{
+  return( this->render_mode() == RenderMode::RenderToTexture &&
+          this->cache_dirty_ == false && this->rendered_text_ != nullptr &&
+          this->rendered_text_->valid() == true );
+}
+
 void Text::set_font(const Font& font)
 {
   this->font_ = font;
@@ -410,18 +379,13 @@ void Text::set_text( const std::string& text )
   if( text != this->text() ) {
     this->text_ = text;
 
-    this->dirty_ = true;
+    this->dirty_ |= DirtyFlags::DirtyLayout;
     this->update();
   }
 }
 
 void Text::set_text_size ( uint character_size )
 {
-  RenderWindow* context = nom::render_interface();
-
-  // Default pixel format used when context is NULL
-  uint32 pixel_format = SDL_PIXELFORMAT_ARGB8888;
-
   if ( this->valid() == false )
   {
     NOM_LOG_ERR( NOM, "Could not set text size: the font is invalid." );
@@ -430,35 +394,11 @@ void Text::set_text_size ( uint character_size )
 
   this->text_size_ = character_size;
 
-  // Force a rebuild of the texture atlas at the specified point size
+  // Switch the font's texture atlas to the specified point size; our copy of
+  // the atlas is refreshed as it becomes necessary (see ::update_atlas).
   this->font()->set_point_size( this->text_size() );
 
-  if( context != nullptr ) {
-    RendererInfo caps = context->caps();
-    pixel_format = caps.optimal_texture_format();
-  }
-
-  // We can only (sanely) initialize our texture once we know the text size; we
-  // will update this texture only as it becomes necessary (see ::update).
-  if( this->glyphs_texture_.create( *this->font()->image( this->text_size() ), pixel_format, Texture::Access::Streaming ) == false ) {
-    NOM_LOG_ERR(  NOM, "Could not create texture atlas at point size:",
-                  std::to_string( this->text_size() ) );
-    return;
-  }
-
-  if( this->rendered_text_ == nullptr ) {
-    this->rendered_text_.reset( new Texture() );
-  }
-
-  NOM_ASSERT(this->rendered_text_ != nullptr);
-  if( this->rendered_text_ == nullptr ) {
-    NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
-                  "Could not create texture cache:",
-                  "failed to allocate texture memory." );
-    return;
-  }
-
-  this->dirty_ = true;
+  this->dirty_ |= DirtyFlags::DirtyAtlas | DirtyFlags::DirtyLayout;
   this->update();
 }
 
@@ -471,7 +411,8 @@ void Text::set_color( const Color4i& color )
 
   this->color_ = color;
 
-  this->dirty_ = true;
+  // The glyph positions are unaffected by color
+  this->dirty_ |= DirtyFlags::DirtyColor;
   this->update();
 }
 
@@ -485,7 +426,7 @@ void Text::set_style( uint32 style )
   // Set new style if sanity checks pass
   this->style_ = style;
 
-  this->dirty_ = true;
+  this->dirty_ |= DirtyFlags::DirtyAtlas | DirtyFlags::DirtyLayout;
   this->update();
 }
 
@@ -493,69 +434,108 @@ void Text::set_text_kerning(bool state)
 {
   this->font()->set_font_kerning(state);
 
-  this->dirty_ = true;
+  this->dirty_ |= DirtyFlags::DirtyLayout;
   this->update();
 }
 
-void Text::draw(RenderTarget& target) const
+void Text::set_render_mode(RenderMode mode)
 {
+  if( mode == this->render_mode() ) {
+    return;
+  }
+
+  this->render_mode_ = mode;
 
-#if defined(NOM_OLD_TEXT_RENDER)
-  if( this->valid() == true ) {
-    this->render_text(target);
+  if( mode == RenderMode::RenderToTexture ) {
+    this->dirty_ |= DirtyFlags::DirtyCache;
+    this->update();
+  } else {
+    this->release_cache();
   }
-#else
-  if( this->rendered_text_ != nullptr &&
-      this->rendered_text_->valid() == true )
-  {
-    this->rendered_text_->draw(target);
+}
+
+void Text::draw(RenderTarget& target) const
+{
+  if( this->valid() == false ) {
+    return;
   }
-#endif
+
+  if( this->render_mode() == RenderMode::RenderToTexture ) {
+
+    if( this->cache_dirty_ == true ) {
+      // Expensive call; on failure, the text is drawn from its glyphs until
+      // the next change
+      this->cache_dirty_ = false;
+      if( this->update_cache() == false ) {
+        this->release_cache();
+      }
+    }
+
+    if( this->rendered_text_ != nullptr &&
+        this->rendered_text_->valid() == true )
+    {
+      this->rendered_text_->draw(target);
+      return;
+    }
+  }
+
+  this->render_text( target, this->position() );
 }
 
 // Private scope
 
-void Text::render_text(RenderTarget& target) const
+void Text::render_text(RenderTarget& target, const Point2i& offset) const
+{
+  // Alpha modulation is preserved from the texture atlas
+  Color4i glyph_color( this->color().r, this->color().g, this->color().b,
+                       this->glyphs_texture_.alpha() );
+
+  this->glyphs_batch_.draw( target.renderer(), this->glyphs_texture_, offset,
+                            glyph_color );
+
+// Debugging overlay to show the bounds of the overall text rendering
+#if 0
+    IntRect text_overlay;
+    text_overlay.x = offset.x;
+    text_overlay.y = offset.y;
+    text_overlay.w = this->size().w;
+    text_overlay.h = this->size().h;
+    Color4i text_overlay_color = Color4i(151, 161, 225, 128);
+    Rectangle text_bounds(text_overlay, text_overlay_color);
+    text_bounds.draw(target);
+#endif
+}
+
+void Text::layout_text( const std::string& text_buffer, QuadBatch* glyphs,
+                        TextLines* lines ) const
 {
   int kerning_offset = 0;
   uint32 previous_char = 0;
   uint32 current_char = 0;
+  uint text_size = this->text_size();
+  nom::size_type text_length = text_buffer.length();
 
-  // Our position should always start from zero, when rendering text to a
-  // rendering target (glyphs_texture_ -> rendered_text_), so that updating
-  // text positions only effect the rendered text.
-#if defined(NOM_OLD_TEXT_RENDER)
-  Point2i pos( this->position() );
-#else
+  // Glyph positions are relative to the origin of the text, so that updating
+  // the text's position does not require the text to be laid out again.
   Point2i pos(Point2i::zero);
-#endif
-  // Additional rendering offsets; applicable to nom::BMFont
-  Point2i glyph_offset(Point2i::zero);
-
-  // Final rendering position
-  Point2i tex_pos(Point2i::zero);
 
-  double angle = 0;
+  TextLine line = { 0, 0, 0 };
 
-  std::string text_buffer = this->text();
-
-  // No font has been loaded -- nothing to draw!
-  if ( this->valid() == false )
-  {
-    NOM_LOG_ERR( NOM, "Invalid Text font" );
-    return;
+  if( glyphs != nullptr ) {
+    glyphs->clear();
+    glyphs->reserve(text_length);
   }
 
-  if ( this->style() == Text::Style::Italic )
-  {
-    // angle = 12; // 12 degrees as per SDL2_ttf
+  if( lines != nullptr ) {
+    lines->clear();
   }
 
-  for( auto i = 0; i < text_buffer.length(); ++i ) {
+  for( nom::size_type i = 0; i != text_length; ++i ) {
 
     // Apply kerning offset
     current_char = text_buffer[i];
-    kerning_offset = this->font()->kerning( previous_char, current_char, this->text_size() );
+    kerning_offset =
+      this->font()->kerning(previous_char, current_char, text_size);
 
     if( kerning_offset != nom::NOM_INT_MIN ) {
       pos.x += kerning_offset;
@@ -563,112 +543,176 @@ void Text::render_text(RenderTarget& target) const
 
     previous_char = current_char;
 
-    glyph_offset =
-      this->font()->glyph( current_char, this->text_size() ).offset;
-
-    if ( current_char == ' ' ) // Space character
+    if( current_char == ' ' ) // Space character
     {
       // Move over
-      pos.x += this->font()->spacing ( this->text_size() );
+      pos.x += this->font()->spacing(text_size);
     }
     else if( current_char == '\n' || current_char == '\v' ) // Vertical chars
     {
+      line.end = i;
+      if( lines != nullptr ) {
+        lines->push_back(line);
+      }
+
+      line.begin = i + 1;
+      line.width = 0;
+
       // Move down and back over to the beginning of line
-      pos.y += this->font()->newline ( this->text_size() );
-      pos.x = this->position().x;
+      pos.y += this->font()->newline(text_size);
+      pos.x = 0;
+      continue;
     }
     else if( current_char == '\t' ) // Tab character (we indent two spaces)
     {
-      pos.x += this->font()->spacing ( this->text_size() ) * 2;
+      pos.x += this->font()->spacing(text_size) * 2;
     }
-    else // The time to render is now!
+    else
     {
-      IntRect glyph_bounds =
-        this->font()->glyph( current_char, this->text_size() ).bounds;
-
-      Size2i tex_dims;
-      tex_dims.w = glyph_bounds.w;
-      tex_dims.h = glyph_bounds.h;
+      const Glyph& glyph = this->font()->glyph(current_char, text_size);
 
-      // Apply rendering offsets; applicable to nom::BMFont glyphs
-      tex_pos =
-        Point2i(pos.x + glyph_offset.x, pos.y + glyph_offset.y);
-      this->glyphs_texture_.set_position(tex_pos);
+      if( glyphs != nullptr ) {
+        // Apply rendering offsets; applicable to nom::BMFont glyphs
+        IntRect glyph_pos(  pos.x + glyph.offset.x, pos.y + glyph.offset.y,
+                            glyph.bounds.w, glyph.bounds.h );
 
-      this->glyphs_texture_.set_bounds(glyph_bounds);
-      this->glyphs_texture_.set_size(tex_dims);
-
-      this->glyphs_texture_.draw(target.renderer(), angle);
+        glyphs->append(glyph.bounds, glyph_pos);
+      }
 
       // Move over the width of the character with one pixel of padding
-      pos.x += ( this->font()->glyph(current_char, this->text_size() ).advance ) + 1;
+      pos.x += glyph.advance + 1;
+    }
 
-    } // end else
+    line.width = std::max(line.width, pos.x);
   } // end for loop
 
-// Debugging overlay to show the bounds of the overall text rendering
-#if 0
-    IntRect text_overlay;
-    text_overlay.x = this->position().x;
-    text_overlay.y = this->position().y;
-    text_overlay.w = this->size().w;
-    text_overlay.h = this->size().h;
-    Color4i text_overlay_color = Color4i(151, 161, 225, 128);
-    Rectangle text_bounds(text_overlay, text_overlay_color);
-    text_bounds.draw(target);
-#endif
+  line.end = text_length;
+  if( lines != nullptr ) {
+    lines->push_back(line);
+  }
+}
+
+void Text::update_layout()
+{
+  this->layout_text(this->text_, &this->glyphs_batch_, &this->lines_);
 }
 
 void Text::update()
 {
   uint32 style = this->style();
   uint32 e_style = 0;
+  uint32 dirty = this->dirty_;
 
-  if( this->dirty_ == false ) {
+  if( dirty == DirtyFlags::NotDirty ) {
     return;
   }
 
-  this->dirty_ = false;
-
-  // No font has been loaded -- nothing to draw!
+  // No font has been loaded -- nothing to draw! The changes are kept until
+  // there is a font to apply them to.
   if( this->valid() == false ) {
     return;
   }
 
-  e_style = this->font()->font_style();
+  if( dirty & DirtyFlags::DirtyAtlas ) {
 
-  if( style & Text::Style::Bold ) {
-    e_style |= TTF_STYLE_BOLD;
+    e_style = this->font()->font_style();
+
+    if( style & Text::Style::Bold ) {
+      e_style |= TTF_STYLE_BOLD;
+    }
+
+    if( style & Text::Style::Italic ) {
+      e_style |= TTF_STYLE_ITALIC;
+    }
+
+    if( style & Text::Style::Underline ) {
+      e_style |= TTF_STYLE_UNDERLINE;
+    }
+
+    if( style & Text::Style::Strikethrough ) {
+      e_style |= TTF_STYLE_STRIKETHROUGH;
+    }
+
+    // Expensive call
+    if( ! (style & Text::Style::Normal) ) {
+      this->font()->set_font_style(e_style);
+    }
   }
 
-  if( style & Text::Style::Italic ) {
-    e_style |= TTF_STYLE_ITALIC;
+  if( dirty & DirtyFlags::DirtyLayout ) {
+    // NOTE: Laying out the text may add glyphs to the font's texture atlas
+    this->update_layout();
+
+    // Set the overall size of this text label to the width & height of the
+    // text, with consideration to the font.
+    this->set_size( Size2i( this->width(), this->height() ) );
+
+    this->dirty_ &= ~DirtyFlags::DirtyLayout;
   }
 
-  if( style & Text::Style::Underline ) {
-    e_style |= TTF_STYLE_UNDERLINE;
+  // Update the texture atlas; this is necessary anytime the font's glyphs
+  // cache changes, such as when we change the text's font point size or
+  // rendering style, or new glyphs are rasterized.
+  if( (dirty & DirtyFlags::DirtyAtlas) ||
+      this->font()->image_revision( this->text_size() ) != this->atlas_revision_ )
+  {
+    // Expensive call; the remaining changes are kept on failure, so that
+    // the next update tries again
+    if( this->update_atlas() == false ) {
+      this->dirty_ |= DirtyFlags::DirtyAtlas;
+      return;
+    }
+
+    // The texture may have been re-created
+    dirty |= DirtyFlags::DirtyAtlas;
   }
 
-  if( style & Text::Style::Strikethrough ) {
-    e_style |= TTF_STYLE_STRIKETHROUGH;
+  if( dirty & (DirtyFlags::DirtyAtlas | DirtyFlags::DirtyColor) ) {
+    // Update the font's text color.
+    this->glyphs_texture_.set_color_modulation( this->color() );
   }
 
-  // Expensive call
-  if( ! (style & Text::Style::Normal) ) {
-    this->font()->set_font_style(e_style);
+  // Dirty flags cleared; we are up-to-date
+  this->dirty_ = DirtyFlags::NotDirty;
+
+  // Every change that reaches this point is visible in the rendered text; the
+  // texture is rendered again on the next ::draw call, so that several changes
+  // in one frame only cost one rendering.
+  if( this->render_mode() == RenderMode::RenderToTexture ) {
+    this->cache_dirty_ = true;
   }
+}
+
+bool Text::update_atlas()
+{
+  RenderWindow* context = nom::render_interface();
+
+  // Default pixel format used when context is NULL
+  uint32 pixel_format = SDL_PIXELFORMAT_ARGB8888;
 
-  // Update the texture atlas; this is necessary anytime we rebuild the font's
-  // glyphs cache, such as when we change the text's font point size or rendering
-  // style.
-  // This is an expensive call.
   const Image* source = this->font()->image( this->text_size() );
 
   NOM_ASSERT(source != nullptr);
-  if( source->valid() == false ) {
+  if( source == nullptr || source->valid() == false ) {
     NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
                   "Could not update glyphs texture: invalid image source." );
-    return;
+    return false;
+  }
+
+  // The texture atlas of a nom::TrueTypeFont grows as glyphs are added to it
+  if( this->glyphs_texture_.valid() == false ||
+      this->glyphs_texture_.size() != source->size() )
+  {
+    if( context != nullptr ) {
+      RendererInfo caps = context->caps();
+      pixel_format = caps.optimal_texture_format();
+    }
+
+    if( this->glyphs_texture_.create( *source, pixel_format, Texture::Access::Streaming ) == false ) {
+      NOM_LOG_ERR(  NOM, "Could not create texture atlas at point size:",
+                    std::to_string( this->text_size() ) );
+      return false;
+    }
   }
 
   // Expensive call
@@ -678,43 +722,46 @@ void Text::update()
   } else {
     NOM_LOG_ERR( NOM_LOG_CATEGORY_APPLICATION,
                 "Could not update glyphs texture: could not lock texture." );
-    return;
+    return false;
   }
 
-  // NOTE: By **not** preserving the alpha channel here, we introduce a bug that
-  // can clip off the edges of certain glyphs when using kerning -- as can be
-  // seen in the letter 'A' of the 'Kerning' tests of BMFont and TrueTypeFont.
+  // NOTE: By **not** preserving the alpha channel here, we introduce a bug
+  // that can clip off the edges of certain glyphs when using kerning -- as
+  // can be seen in the letter 'A' of the 'Kerning' tests of BMFont and
+  // TrueTypeFont.
   //
-  // The downside to blending is that we lose the original pixel data around the
-  // edges of text; the input color gets blended in with the destination color.
+  // The downside to blending is that we lose the original pixel data around
+  // the edges of text; the input color gets blended in with the destination
+  // color.
   this->glyphs_texture_.set_blend_mode(SDL_BLENDMODE_BLEND);
 
-  // Update the font's text color.
-  this->glyphs_texture_.set_color_modulation( this->color() );
-
-  // Set the overall size of this text label to the width & height of the text,
-  // with consideration to the font.
-  this->set_size( Size2i( this->width(), this->height() ) );
+  this->atlas_revision_ = this->font()->image_revision( this->text_size() );
 
-#if ! defined(NOM_OLD_TEXT_RENDER)
-  if( this->size().w > 0 && this->size().h > 0 ) {
-    // Expensive call
-    this->update_cache();
-  }
-#endif
+  return true;
 }
 
 int Text::width() const
 {
-  return this->text_width( this->text() );
+  int text_width = 0;
+
+  for( auto itr = this->lines_.begin(); itr != this->lines_.end(); ++itr ) {
+    text_width = std::max(text_width, itr->width);
+  }
+
+  return text_width;
 }
 
 int Text::height() const
 {
-  return this->text_height( this->text() );
+  // Ensure that our font pointer is still valid
+  if( this->valid() == false || this->lines_.empty() == true ) {
+    return 0;
+  }
+
+  return( this->font()->newline( this->text_size() ) * this->lines_.size() );
 }
 
-bool Text::update_cache()
+bool Text::update_cache() const
 {
   // Our cached texture dimensions should always be the same as the rendered
   // text's dimensions; if the rendered text appears cut off, the calculated
@@ -724,6 +771,11 @@ bool Text::update_cache()
   // Padding
   // texture_dims.w += this->text_width(" ");
 
+  if( texture_dims.w <= 0 || texture_dims.h <= 0 ) {
+    // Nothing to render
+    return false;
+  }
+
   RenderWindow* context = nom::render_interface();
   NOM_ASSERT(context != nullptr);
   if( context == nullptr ) {
@@ -734,22 +786,41 @@ bool Text::update_cache()
 
   // Obtain the optimal pixel format for the platform
   RendererInfo caps = context->caps();
+  uint32 pixel_format = caps.optimal_texture_format();
 
-  if( this->rendered_text_->size() != texture_dims ) {
+  if( this->rendered_text_ == nullptr ||
+      this->rendered_text_->valid() == false ||
+      this->rendered_text_->size() != texture_dims )
+  {
+    nom::size_type texture_bytes =
+      texture_dims.w * texture_dims.h * SDL_BYTESPERPIXEL(pixel_format);
+
+    // The memory of the existing texture is returned to the budget before the
+    // new texture is charged against it
+    this->release_cache();
+
+    if( Text::cache_memory_ + texture_bytes > Text::cache_budget_ ) {
+      NOM_LOG_DEBUG(  NOM_LOG_CATEGORY_RENDER,
+                      "Text cache budget exceeded; drawing from glyphs:",
+                      this->text() );
+      return false;
+    }
+
+    this->rendered_text_.reset( new Texture() );
 
     // Poor man's counter of how often we are re-allocating this texture
     // NOM_LOG_TRACE_PRIO(NOM_LOG_CATEGORY_RENDER, NOM_LOG_PRIORITY_DEBUG);
-    // NOM_LOG_DEBUG(  NOM_LOG_CATEGORY_RENDER,
-    //                 "old_size:", this->rendered_text_->size(),
-    //                 "new_size:", texture_dims );
 
-    if( this->rendered_text_->initialize( caps.optimal_texture_format(),
+    if( this->rendered_text_->initialize( pixel_format,
         SDL_TEXTUREACCESS_TARGET, texture_dims ) == false )
     {
       NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
                     "Could not update cache: failed texture creation." );
       return false;
     }
+
+    this->cache_bytes_ = texture_bytes;
+    Text::cache_memory_ += texture_bytes;
   }
 
   // Use an alpha channel; otherwise the text is rendered on a black
@@ -771,10 +842,11 @@ bool Text::update_cache()
     NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
                   "Could not update cache:",
                   "failed to set the render target's color." );
+    context->reset_render_target();
     return false;
   }
 
-  this->render_text(*context);
+  this->render_text(*context, Point2i::zero);
 
   if( context->reset_render_target() == false ) {
     NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
@@ -786,4 +858,13 @@ bool Text::update_cache()
   return true;
 }
 
+void Text::release_cache() const
+{
+  NOM_ASSERT(Text::cache_memory_ >= this->cache_bytes_);
+  Text::cache_memory_ -= this->cache_bytes_;
+  this->cache_bytes_ = 0;
+
+  this->rendered_text_.reset();
+}
+
 } // namespace nom
@@ -754,7 +754,7 @@ bool Texture::resize( enum ResizeAlgorithm scaling_algorithm )
     case ResizeAlgorithm::scale4x:
     {
       #if defined( NOM_USE_SCALEX )
-        if ( priv::scale2x  (
+        if ( priv::scale4x  (
                               this->pixels(),
                               destination.pixels(),
                               source_size.x,
@@ -0,0 +1,377 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include "nomlib/graphics/TextureAtlas.hpp"
+
+#include <algorithm>
+
+// Private headers (third-party)
+#include <SDL.h>
+
+// Forward declarations
+#include "nomlib/graphics/Image.hpp"
+#include "nomlib/graphics/Texture.hpp"
+#include "nomlib/graphics/sprite/SpriteSheet.hpp"
+#include "nomlib/system/SDL_helpers.hpp"
+
+namespace nom {
+
+// Static initializations
+const char* TextureAtlas::DEBUG_CLASS_NAME = "[TextureAtlas]:";
+const Size2i TextureAtlas::DEFAULT_PAGE_SIZE = Size2i(1024, 1024);
+const uint32 TextureAtlas::PIXEL_FORMAT = SDL_PIXELFORMAT_ARGB8888;
+
+TextureAtlas::TextureAtlas() :
+  page_size_(TextureAtlas::DEFAULT_PAGE_SIZE),
+  padding_(1)
+{
+  NOM_LOG_TRACE_PRIO(NOM_LOG_CATEGORY_TRACE_RENDER, NOM_LOG_PRIORITY_VERBOSE);
+}
+
+TextureAtlas::TextureAtlas(const Size2i& page_size, int padding) :
+  page_size_(page_size),
+  padding_(padding)
+{
+  NOM_LOG_TRACE_PRIO(NOM_LOG_CATEGORY_TRACE_RENDER, NOM_LOG_PRIORITY_VERBOSE);
+}
+
+TextureAtlas::~TextureAtlas()
+{
+  NOM_LOG_TRACE_PRIO(NOM_LOG_CATEGORY_TRACE_RENDER, NOM_LOG_PRIORITY_VERBOSE);
+}
+
+nom::size_type TextureAtlas::size() const
+{
+  return this->regions_.size();
+}
+
+nom::size_type TextureAtlas::pages() const
+{
+  return this->pages_.size();
+}
+
+Size2i TextureAtlas::page_size(nom::size_type page) const
+{
+  if( page >= this->pages_.size() ) {
+    return Size2i::null;
+  }
+
+  return this->pages_[page].packer.size();
+}
+
+real32 TextureAtlas::occupancy(nom::size_type page) const
+{
+  if( page >= this->pages_.size() ) {
+    return 0.0f;
+  }
+
+  return this->pages_[page].packer.occupancy();
+}
+
+bool TextureAtlas::valid(handle_type handle) const
+{
+  return( handle != INVALID_HANDLE && handle <= this->regions_.size() );
+}
+
+nom::size_type TextureAtlas::page(handle_type handle) const
+{
+  if( this->valid(handle) == false ) {
+    return nom::npos;
+  }
+
+  return this->regions_[handle - 1].page;
+}
+
+IntRect TextureAtlas::bounds(handle_type handle) const
+{
+  if( this->valid(handle) == false ) {
+    return IntRect::null;
+  }
+
+  return this->regions_[handle - 1].bounds;
+}
+
+TextureAtlas::handle_type TextureAtlas::find(const std::string& name) const
+{
+  auto res = this->names_.find(name);
+  if( res == this->names_.end() ) {
+    return INVALID_HANDLE;
+  }
+
+  return res->second;
+}
+
+TextureAtlas::handle_type TextureAtlas::insert(const Image& source)
+{
+  AtlasRegion region;
+  IntRect rect(IntRect::null);
+  SDL_Rect blit_coords;
+  SDL_BlendMode blend_mode = SDL_BLENDMODE_NONE;
+
+  if( source.valid() == false ) {
+    NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
+                  "Could not pack image: invalid image source." );
+    return INVALID_HANDLE;
+  }
+
+  Size2i dims = source.size();
+  Size2i padded_dims(dims.w + this->padding_, dims.h + this->padding_);
+
+  // First fit across the existing pages; pages are tried in the order that
+  // they were created, so that the earlier pages fill up first
+  for( region.page = 0; region.page != this->pages_.size(); ++region.page ) {
+    rect = this->pages_[region.page].packer.pack(padded_dims);
+    if( rect != IntRect::null ) {
+      break;
+    }
+  }
+
+  if( rect == IntRect::null ) {
+
+    // Oversized images are given a page of their own
+    Size2i page_dims( std::max(this->page_size_.w, padded_dims.w),
+                      std::max(this->page_size_.h, padded_dims.h) );
+
+    if( this->add_page(page_dims) == false ) {
+      return INVALID_HANDLE;
+    }
+
+    region.page = this->pages_.size() - 1;
+    rect = this->pages_[region.page].packer.pack(padded_dims);
+  }
+
+  NOM_ASSERT(rect != IntRect::null);
+  AtlasPage& page = this->pages_[region.page];
+
+  region.bounds = IntRect(rect.x, rect.y, dims.w, dims.h);
+
+  // Copy the pixels as they are -- including the alpha channel -- rather than
+  // blending them onto the transparent page
+  SDL_GetSurfaceBlendMode(source.image(), &blend_mode);
+  SDL_SetSurfaceBlendMode(source.image(), SDL_BLENDMODE_NONE);
+
+  blit_coords = SDL_RECT(region.bounds);
+  if( SDL_BlitSurface( source.image(), nullptr, page.image->image(),
+                       &blit_coords ) != 0 )
+  {
+    NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
+                  "Could not pack image:", SDL_GetError() );
+    SDL_SetSurfaceBlendMode(source.image(), blend_mode);
+    return INVALID_HANDLE;
+  }
+
+  SDL_SetSurfaceBlendMode(source.image(), blend_mode);
+
+  // Grow the area to upload on the next build
+  if( page.dirty == IntRect::null ) {
+    page.dirty = region.bounds;
+  } else {
+    int x2 = std::max(  page.dirty.x + page.dirty.w,
+                        region.bounds.x + region.bounds.w );
+    int y2 = std::max(  page.dirty.y + page.dirty.h,
+                        region.bounds.y + region.bounds.h );
+    page.dirty.x = std::min(page.dirty.x, region.bounds.x);
+    page.dirty.y = std::min(page.dirty.y, region.bounds.y);
+    page.dirty.w = x2 - page.dirty.x;
+    page.dirty.h = y2 - page.dirty.y;
+  }
+
+  this->regions_.push_back(region);
+
+  NOM_LOG_DEBUG(  NOM_LOG_CATEGORY_RENDER, DEBUG_CLASS_NAME,
+                  "packed:", region.bounds, "page:", region.page );
+
+  return NOM_SCAST(handle_type, this->regions_.size() );
+}
+
+TextureAtlas::handle_type
+TextureAtlas::insert(const std::string& name, const Image& source)
+{
+  handle_type handle = this->find(name);
+  if( handle != INVALID_HANDLE ) {
+    return handle;
+  }
+
+  handle = this->insert(source);
+  if( handle != INVALID_HANDLE ) {
+    this->names_[name] = handle;
+  }
+
+  return handle;
+}
+
+TextureAtlas::handle_type TextureAtlas::load_file(const std::string& filename)
+{
+  Image source;
+
+  handle_type handle = this->find(filename);
+  if( handle != INVALID_HANDLE ) {
+    return handle;
+  }
+
+  if( source.load(filename) == false ) {
+    NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
+                  "Could not pack image: failed to load", filename );
+    return INVALID_HANDLE;
+  }
+
+  return this->insert(filename, source);
+}
+
+bool TextureAtlas::build()
+{
+  for( auto itr = this->pages_.begin(); itr != this->pages_.end(); ++itr ) {
+
+    AtlasPage& page = *itr;
+    const Image& source = *page.image;
+
+    if( page.texture == nullptr ) {
+      page.texture = std::make_shared<Texture>();
+
+      if( page.texture->initialize( TextureAtlas::PIXEL_FORMAT,
+          SDL_TEXTUREACCESS_STATIC, source.size() ) == false )
+      {
+        NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
+                      "Could not build texture atlas:",
+                      "failed texture creation." );
+        page.texture.reset();
+        return false;
+      }
+
+      page.texture->set_blend_mode(SDL_BLENDMODE_BLEND);
+
+      // The whole page is uploaded, so that the padding is transparent
+      page.dirty = IntRect( Point2i::zero, source.size() );
+    }
+
+    if( page.dirty == IntRect::null ) {
+      continue;
+    }
+
+    SDL_Rect dirty_coords = SDL_RECT(page.dirty);
+    const uint8* pixels =
+      NOM_SCAST(const uint8*, source.pixels() ) +
+      page.dirty.y * source.pitch() +
+      page.dirty.x * SDL_BYTESPERPIXEL(TextureAtlas::PIXEL_FORMAT);
+
+    if( SDL_UpdateTexture(  page.texture->texture(), &dirty_coords, pixels,
+                            source.pitch() ) != 0 )
+    {
+      NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
+                    "Could not build texture atlas:", SDL_GetError() );
+      return false;
+    }
+
+    page.dirty = IntRect::null;
+  }
+
+  return true;
+}
+
+void TextureAtlas::clear()
+{
+  this->pages_.clear();
+  this->regions_.clear();
+  this->names_.clear();
+}
+
+std::shared_ptr<Texture>
+TextureAtlas::page_texture(nom::size_type page) const
+{
+  if( page >= this->pages_.size() || this->pages_[page].texture == nullptr ) {
+    return nullptr;
+  }
+
+  // A copy shares the SDL texture, while its position, size and bounds are
+  // its own
+  auto tex = std::make_shared<Texture>();
+  *tex = *this->pages_[page].texture;
+
+  return tex;
+}
+
+std::shared_ptr<Texture> TextureAtlas::texture(handle_type handle) const
+{
+  auto tex = this->page_texture( this->page(handle) );
+  if( tex == nullptr ) {
+    return nullptr;
+  }
+
+  IntRect region = this->bounds(handle);
+  tex->set_bounds(region);
+  tex->set_size( region.size() );
+
+  return tex;
+}
+
+SpriteSheet
+TextureAtlas::sprite_sheet(const std::vector<handle_type>& frames) const
+{
+  SpriteSheet sheet;
+
+  for( auto itr = frames.begin(); itr != frames.end(); ++itr ) {
+
+    if( this->valid(*itr) == false ||
+        this->page(*itr) != this->page( frames.front() ) )
+    {
+      NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
+                    "Could not create sprite sheet:",
+                    "the frames must be packed into the same page." );
+      return SpriteSheet();
+    }
+
+    sheet.append_frame( this->bounds(*itr) );
+  }
+
+  return sheet;
+}
+
+// Private scope
+
+bool TextureAtlas::add_page(const Size2i& dims)
+{
+  AtlasPage page;
+
+  page.image = std::make_shared<Image>();
+  if( page.image->create(dims, TextureAtlas::PIXEL_FORMAT) == false ) {
+    NOM_LOG_ERR(  NOM_LOG_CATEGORY_APPLICATION,
+                  "Could not create texture atlas page of size:", dims );
+    return false;
+  }
+
+  // New pages are fully transparent
+  SDL_FillRect(page.image->image(), nullptr, 0);
+
+  page.packer.reset(dims);
+
+  this->pages_.push_back(page);
+
+  return true;
+}
+
+} // namespace nom
@@ -87,20 +87,14 @@ const Image* BMFont::image(uint32 character_size) const
   return this->pages_[0].texture.get();
 }
 
-const Glyph& BMFont::glyph(uint32 codepoint, uint32 character_size) const
+uint32 BMFont::image_revision(uint32 character_size) const
 {
-  GlyphAtlas& glyphs = this->pages_[0].glyphs;
-
-  GlyphAtlas::const_iterator it = glyphs.find(codepoint);
+  return this->pages_[0].revision;
+}
 
-  if( it != glyphs.end() ) {
-    // Found a match
-    return it->second;
-  }
-  else {
-    // Err; probably going to receive an empty glyph...
-    return glyphs[codepoint];
-  }
+const Glyph& BMFont::glyph(uint32 codepoint, uint32 character_size) const
+{
+  return this->pages_[0].glyphs.glyph(codepoint);
 }
 
 int BMFont::spacing(uint32 character_size) const
@@ -245,6 +239,8 @@ bool BMFont::build(uint32 character_size)
     return false;
   }
 
+  ++this->pages_[0].revision;
+
   Size2i size( this->pages_[0].texture->size() );
 
   // Sanity checks
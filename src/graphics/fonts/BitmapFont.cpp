@@ -88,6 +88,11 @@ const Image* BitmapFont::image(uint32 character_size) const
   return this->pages_[0].texture.get();
 }
 
+uint32 BitmapFont::image_revision(uint32 character_size) const
+{
+  return this->pages_[0].revision;
+}
+
 sint BitmapFont::spacing ( uint32 character_size ) const
 {
   return this->pages_[0].glyphs[65].advance; // 'A' ASCII character
@@ -115,17 +120,7 @@ uint32 BitmapFont::font_style( void ) const
 
 const Glyph& BitmapFont::glyph ( uint32 codepoint, uint32 character_size ) const
 {
-  GlyphAtlas& glyphs = this->pages_[0].glyphs;
-
-  GlyphAtlas::const_iterator it = glyphs.find(codepoint);
-  if ( it != glyphs.end() )
-  {
-    return it->second; // Found a match
-  }
-  else
-  {
-    return glyphs[codepoint]; // Err (probably going to receive an empty glyph)
-  }
+  return this->pages_[0].glyphs.glyph(codepoint);
 }
 
 bool BitmapFont::set_point_size( int point_size )
@@ -180,6 +175,8 @@ bool BitmapFont::load( const std::string& filename )
     return false;
   }
 
+  ++this->pages_[0].revision;
+
   // Set pixel at coordinates 0, 0 to be the color mask
   uint32 key = this->pages_[0].texture->pixel(0, 0);
   this->color_mask_ = nom::pixel( key, this->pages_[0].texture->pixel_format() );
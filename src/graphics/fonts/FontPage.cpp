@@ -33,7 +33,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace nom {
 
-FontPage::FontPage()
+FontPage::FontPage() :
+  revision(0)
 {
   //NOM_LOG_TRACE(NOM);
 
@@ -58,9 +59,11 @@ bool FontPage::valid() const
 void FontPage::invalidate()
 {
   this->texture.reset( new Image() );
-  this->next_row = 0;
   this->glyphs.clear();
-  this->rows.clear();
+  this->packer.reset( Size2i(0, 0) );
+
+  // Whoever uploaded the previous texture must upload it again
+  ++this->revision;
 }
 
 } // namespace nom
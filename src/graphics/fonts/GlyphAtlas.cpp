@@ -0,0 +1,156 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include "nomlib/graphics/fonts/GlyphAtlas.hpp"
+
+#include <algorithm>
+
+namespace nom {
+
+namespace {
+
+bool codepoint_less(const std::pair<uint32, Glyph>& lhs, uint32 codepoint)
+{
+  return lhs.first < codepoint;
+}
+
+// The glyph returned for codepoints that have no glyph stored
+const Glyph EMPTY_GLYPH;
+
+} // namespace
+
+// Static initializations
+const uint32 GlyphAtlas::DIRECT_RANGE;
+
+GlyphAtlas::GlyphAtlas()
+{
+  //NOM_LOG_TRACE(NOM);
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+  //NOM_LOG_TRACE(NOM);
+}
+
+nom::size_type GlyphAtlas::size() const
+{
+  return( this->direct_index_.count() + this->extended_glyphs_.size() );
+}
+
+bool GlyphAtlas::empty() const
+{
+  return( this->direct_index_.none() && this->extended_glyphs_.empty() );
+}
+
+void GlyphAtlas::clear()
+{
+  this->direct_glyphs_.clear();
+  this->direct_index_.reset();
+  this->extended_glyphs_.clear();
+}
+
+bool GlyphAtlas::contains(uint32 codepoint) const
+{
+  return( this->find(codepoint) != nullptr );
+}
+
+const Glyph* GlyphAtlas::find(uint32 codepoint) const
+{
+  if( codepoint < DIRECT_RANGE ) {
+
+    if( this->direct_index_.test(codepoint) == true ) {
+      return &this->direct_glyphs_[codepoint];
+    }
+
+    // Err -- no glyph stored
+    return nullptr;
+  }
+
+  auto res =
+    std::lower_bound( this->extended_glyphs_.begin(),
+                      this->extended_glyphs_.end(), codepoint,
+                      codepoint_less );
+
+  if( res != this->extended_glyphs_.end() && res->first == codepoint ) {
+    return &res->second;
+  }
+
+  // Err -- no glyph stored
+  return nullptr;
+}
+
+Glyph* GlyphAtlas::find(uint32 codepoint)
+{
+  const self_type* atlas = this;
+
+  return NOM_CCAST(Glyph*, atlas->find(codepoint) );
+}
+
+const Glyph& GlyphAtlas::glyph(uint32 codepoint) const
+{
+  const Glyph* res = this->find(codepoint);
+
+  if( res != nullptr ) {
+    // Found a match
+    return *res;
+  }
+
+  // Err; the caller is going to receive an empty glyph
+  return EMPTY_GLYPH;
+}
+
+Glyph& GlyphAtlas::operator [](uint32 codepoint)
+{
+  if( codepoint < DIRECT_RANGE ) {
+
+    if( this->direct_glyphs_.empty() == true ) {
+      this->direct_glyphs_.resize(DIRECT_RANGE);
+    }
+
+    if( this->direct_index_.test(codepoint) == false ) {
+      this->direct_glyphs_[codepoint] = Glyph();
+      this->direct_index_.set(codepoint);
+    }
+
+    return this->direct_glyphs_[codepoint];
+  }
+
+  auto res =
+    std::lower_bound( this->extended_glyphs_.begin(),
+                      this->extended_glyphs_.end(), codepoint,
+                      codepoint_less );
+
+  if( res == this->extended_glyphs_.end() || res->first != codepoint ) {
+    res = this->extended_glyphs_.insert( res,
+                                         extended_glyph(codepoint, Glyph()) );
+  }
+
+  return res->second;
+}
+
+} // namespace nom
@@ -67,7 +67,11 @@ TrueTypeFont::TrueTypeFont ( const TrueTypeFont& copy ) :
   sheet_width_( copy.sheet_width() ),
   sheet_height_( copy.sheet_height() ),
   font_( copy.font_ ),
-  pages_( copy.pages() ),
+  faces_( copy.faces_ ),
+  // NOTE: The glyph pages are not copied; their textures are shared
+  // pointers, so the copies would pack and rasterize glyphs into each
+  // other's atlases. The copy rebuilds its pages on demand instead.
+  revision_( copy.revision_ ),
   metrics_( copy.metrics() ),
   filename_( copy.filename_ ),
   point_size_( copy.point_size() ),
@@ -100,12 +104,17 @@ TTF_Font* TrueTypeFont::font ( void ) const
 
 const Image* TrueTypeFont::image(uint32 character_size) const
 {
-  return this->pages_[character_size].texture.get();
+  return this->page(character_size).texture.get();
+}
+
+uint32 TrueTypeFont::image_revision(uint32 character_size) const
+{
+  return this->page(character_size).revision;
 }
 
 int TrueTypeFont::spacing ( uint32 character_size ) const
 {
-  return this->pages_[character_size].glyphs[32].advance;
+  return this->glyph(32, character_size).advance;
 }
 
 sint TrueTypeFont::point_size ( void ) const
@@ -165,17 +174,16 @@ int TrueTypeFont::kerning( uint32 first_char, uint32 second_char, uint32 charact
 
 const Glyph& TrueTypeFont::glyph ( uint32 codepoint, uint32 character_size ) const
 {
-  GlyphAtlas& glyphs = this->pages_[character_size].glyphs;
+  FontPage& page = this->page(character_size);
 
-  GlyphAtlas::const_iterator it = glyphs.find(codepoint);
-  if ( it != glyphs.end() )
-  {
-    return it->second; // Found a match
-  }
-  else
-  {
-    return glyphs[codepoint]; // Err (probably going to receive an empty glyph)
+  const Glyph* res = page.glyphs.find(codepoint);
+  if( res != nullptr ) {
+    // Found a match
+    return *res;
   }
+
+  // First use of the glyph
+  return this->rasterize(page, codepoint, character_size);
 }
 
 int TrueTypeFont::outline ( /*uint32 character_size*/void ) /*const*/
@@ -210,22 +218,23 @@ uint32 TrueTypeFont::font_style( void ) const
 
 bool TrueTypeFont::set_point_size( int point_size )
 {
-  // Expensive method call
   if ( this->point_size() != point_size )
   {
-    int original_font_size = this->point_size();
-
-    this->point_size_ = point_size;
+    // The font file is only opened the first time that a point size is used;
+    // the rendering state of the current face is carried over
+    TTF_Font* face = this->face(point_size);
 
-    if( this->load( this->filename_ ) == false )
+    if( face == nullptr )
     {
       NOM_LOG_ERR( NOM, "Could not set new point size: " + std::to_string( point_size ) );
-
-      // Restore the original point size if we fail to reload font.
-      this->point_size_ = original_font_size;
-
       return false;
     }
+
+    this->font_ = this->faces_[point_size];
+    this->point_size_ = point_size;
+    this->update_metrics();
+
+    return this->build(point_size);
   }
 
   return true;
@@ -233,7 +242,6 @@ bool TrueTypeFont::set_point_size( int point_size )
 
 bool TrueTypeFont::set_hinting( int type )
 {
-  // Expensive function call
   if( this->hinting() != type ) {
 
     if( this->valid() == true ) {
@@ -241,8 +249,10 @@ bool TrueTypeFont::set_hinting( int type )
 
       int point_size = this->point_size();
 
-      // Force a rebuild of the font page by clearing / invalidating it.
-      // this->pages_[point_size].invalidate();
+      // Hinting is not a part of the page key, so every glyph that has been
+      // rasterized so far is stale
+      this->pages_.clear();
+      this->last_page_ = nullptr;
 
       if( this->build(point_size) == false ) {
         NOM_LOG_ERR ( NOM, "Could not set requested font hinting." );
@@ -263,14 +273,14 @@ bool TrueTypeFont::set_hinting( int type )
 
 bool TrueTypeFont::set_outline( int outline )
 {
-  // Expensive function call
   if ( this->outline() != outline )
   {
     TTF_SetFontOutline ( this->font(), outline );
 
+    // Cheap when the outline size has been used before
     if ( this->build( this->point_size() ) == false )
     {
-      NOM_LOG_ERR ( NOM, "Could not set new point size." );
+      NOM_LOG_ERR ( NOM, "Could not set new outline size." );
       return false;
     }
 
@@ -286,12 +296,8 @@ void TrueTypeFont::set_font_style( uint32 style )
   {
     TTF_SetFontStyle( this->font(), style );
 
-    int point_size = this->point_size();
-
-    // Force a rebuild of the font page by clearing / invalidating it.
-    this->pages_[point_size].invalidate();
-
-    if( this->build( point_size ) == false )
+    // Cheap when the style has been used before
+    if( this->build( this->point_size() ) == false )
     {
       NOM_LOG_ERR( NOM, "Could not rebuild glyph metrics." );
     }
@@ -314,6 +320,13 @@ void TrueTypeFont::set_font_kerning( bool state )
 
 bool TrueTypeFont::load( const std::string& filename )
 {
+  if( filename != this->filename_ ) {
+    // The faces and glyphs of the previous font file are of no use anymore
+    this->faces_.clear();
+    this->pages_.clear();
+    this->last_page_ = nullptr;
+  }
+
   this->font_ = std::shared_ptr<TTF_Font> ( TTF_OpenFont ( filename.c_str(), this->point_size() ), priv::TTF_FreeFont );
 
   if ( this->valid() == false )
@@ -326,18 +339,12 @@ bool TrueTypeFont::load( const std::string& filename )
   // Store the filename for future reference; we use this cached filename for
   // when a new font point size is requested.
   this->filename_ = filename;
+  this->faces_[this->point_size()] = this->font_;
 
   // Save global font metrics; these values are dependent upon the font's
   // current point size, so we need to regenerate them even when the glyph page
   // for the given point size exists.
-  this->metrics_.height = TTF_FontHeight( this->font() );
-  this->metrics_.newline = TTF_FontLineSkip( this->font() );
-  this->metrics_.ascent = TTF_FontAscent( this->font() );
-  this->metrics_.descent = TTF_FontDescent( this->font() );
-  this->metrics_.family = TTF_FontFaceFamilyName( this->font() );
-
-  // Set the font face style name
-  this->metrics_.name = std::string( TTF_FontFaceFamilyName( this->font() ) );
+  this->update_metrics();
 
   // FIXME: This feature is broken
   // this->set_hinting( this->hinting() );
@@ -357,27 +364,10 @@ const FontMetrics& TrueTypeFont::metrics( void ) const
   return this->metrics_;
 }
 
-bool TrueTypeFont::build ( uint32 character_size )
+bool TrueTypeFont::build ( uint32 character_size ) const
 {
-  int ret = 0;                      // Error code
-  uint16 ascii_char;                // Integer type expected by SDL2_ttf
-  const uint32 starting_glyph = 32; // Space character
-  const uint32 ending_glyph = 127;  // Tilde character
-
-  // Glyph metrics
-  int advance = 0;      // Spacing between characters
-  int glyph_width = 0;  // Glyph's width in pixels
-  int glyph_height = 0; // Glyph's height in pixels
-
-  // Texture sheet calculations
-  int padding = 1;
-  int spacing = 2;
-
-  Image glyph_image;                              // Raster bitmap of a glyph
-  IntRect blit;                                   // Rendering bounding coords
-  FontPage& page = this->pages_[character_size];  // Our font's current glyph
-                                                  // page
-  Point2i sheet_size;                             // Texture atlas dimensions
+  FontPage& page = this->pages_[ this->page_key(character_size) ];
+  Size2i sheet_size;  // Texture atlas dimensions
 
   if ( this->valid() == false )
   {
@@ -385,13 +375,13 @@ bool TrueTypeFont::build ( uint32 character_size )
     return false;
   }
 
-  // Glyph page has already been calculated, so we can use this cache and spare
+  // Glyph page has already been prepared, so we can use this cache and spare
   // many CPU cycles. This resolves the thrashing issue we observed on Windows
   // OS, when quickly increasing & decreasing the font's point size, such as in
   // nomlib's app example.
   //
   // NOTE: Glyph caching trade memory for performance.
-  if( page.valid() )
+  if( page.texture->valid() == true )
   {
     // NOM_DUMP("cached");
     return true;
@@ -399,121 +389,121 @@ bool TrueTypeFont::build ( uint32 character_size )
 
   // Our starting sheet size; we will allocate a larger sheet size if needed
   // during glyph rasterization -- see ::glyph_rect.
-  //
-  // NOTE: The initial size of the texture sheet directly affects loading time.
-  sheet_size = Point2i  (
-                          this->sheet_width() * this->sheet_height(),
-                          this->sheet_width() * this->sheet_height()
-                        );
+  sheet_size = Size2i (
+                        this->sheet_width() * this->sheet_height(),
+                        this->sheet_width() * this->sheet_height()
+                      );
 
-  page.texture->initialize ( sheet_size );
+  if( page.texture->initialize( Point2i(sheet_size.w, sheet_size.h) ) == false )
+  {
+    NOM_LOG_ERR ( NOM, "Could not allocate the glyph page texture" );
+    return false;
+  }
 
-  // this->set_hinting( this->hinting() );
+  page.packer.reset(sheet_size);
 
-  // ASCII 32..127 is the standard glyph set -- 94 printable characters;
-  //
-  // 32 = ' ' (space)
-  // 65 = 'A'
-  // 122 = 'z'
-  // 126 = '~' (tilde)
+  // Turn color key transparency on so we are not left with a black,
+  // AKA non-transparent background.
+  page.texture->set_colorkey ( Color4i::Black, true );
 
-  // glyph < sheet_width() * sheet_height() = 256 glyphs
-  for ( uint32 glyph = starting_glyph; glyph < ending_glyph; ++glyph )
-  {
-    ascii_char = static_cast<uint16> ( glyph );
+  page.revision = ++this->revision_;
 
-    if ( TTF_GlyphIsProvided ( this->font(), ascii_char ) )
-    {
-      // We obtain width & height of a glyph from its rendered form
-      glyph_image.initialize ( TTF_RenderGlyph_Solid( this->font(), ascii_char, SDL_COLOR(Color4i::White) ) );
+  return true;
+}
 
-      if ( glyph_image.valid() == false )
-      {
-        NOM_LOG_ERR(NOM, TTF_GetError() );
-        return false;
-      }
+const Glyph& TrueTypeFont::rasterize( FontPage& page, uint32 codepoint,
+                                      uint32 character_size ) const
+{
+  uint16 ascii_char;                // Integer type expected by SDL2_ttf
+  int ret = 0;                      // Error code
 
-      glyph_width = glyph_image.width();
-      glyph_height = glyph_image.height();
-
-      // -_-
-      // Disappointedly, the only metric that we can use here is the advance
-      ret = TTF_GlyphMetrics  ( this->font(),
-                                ascii_char,
-                                nullptr, // Left (X) origin
-                                nullptr, // Width
-                                nullptr, // Top (Y) origin
-                                nullptr, // Height
-                                &advance
-                              );
-
-      if ( ret != 0 ) // Likely to be a missing glyph
-      {
-        NOM_LOG_ERR ( NOM, TTF_GetError() );
-        return false;
-      }
-      page.glyphs[glyph].advance = advance;
+  // Glyph metrics
+  int advance = 0;      // Spacing between characters
+  int glyph_width = 0;  // Glyph's width in pixels
+  int glyph_height = 0; // Glyph's height in pixels
 
-      // Calculate the best packing of the glyph, so that we are able to fit
-      // everything on the sheet without overlaps; if we cannot fit all of our
-      // glyphs onto the default sheet dimensions, we allocate a larger sheet
-      // size.
-      page.glyphs[glyph].bounds = this->glyph_rect ( page, glyph_width + spacing * padding, glyph_height + spacing * padding );
+  // Texture sheet calculations
+  int padding = 1;
+  int spacing = 2;
 
-      #if defined(NOM_DEBUG_SDL2_TRUE_TYPE_FONT_GLYPHS)
-        NOM_DUMP(glyph); // integer position
-        NOM_DUMP(static_cast<uchar>(glyph)); // printable
-        NOM_DUMP(this->glyph(glyph).bounds); // bounding box
-        NOM_DUMP(advance); // spacing
-      #endif
+  Image glyph_image;    // Raster bitmap of a glyph
+  IntRect blit;         // Rendering bounding coords
 
-      // Prepare the coordinates for rendering a glyph onto our texture sheet
-      // we are creating.
-      blit.x = page.glyphs[glyph].bounds.x;
-      blit.y = page.glyphs[glyph].bounds.y;
-      blit.w = -1; // Why -1 ???
-      blit.h = -1; // Why -1 ???
-      glyph_image.draw( page.texture->image(), blit );
-
-      // Dump all of the rendered glyphs as a series of image files -- the
-      // filenames will be the ASCII numeric values. The output should consist
-      // of individual glyph files, at whatever font scale previously loaded.
-      //
-      // You could easily create a new sprite sheet out of these individual
-      // frames!
-      #if defined(NOM_DEBUG_SDL2_TRUE_TYPE_FONT_GLYPHS_PNG)
-        std::string ascii_filename = std::to_string(ascii_char);
-        ascii_filename.append(".png");
-        glyph_image.save_png(ascii_filename);
-      #endif
-    } // end if glyph is provided
-  } // end for glyphs loop
+  // Characters that the font does not provide are remembered as empty glyphs,
+  // so that they are only looked up once
+  Glyph& glyph = page.glyphs[codepoint];
 
-  // Turn color key transparency on so we are not left with a black,
-  // AKA non-transparent background.
-  page.texture->set_colorkey ( Color4i::Black, true );
+  TTF_Font* face = this->face(character_size);
 
-  // Export the destination texture -- this should be a texture sheet that we
-  // expect to be able to render from within the nom::Text class.
-  #if defined(NOM_DEBUG_SDL2_TRUE_TYPE_FONT_GLYPHS)
-    // We intentionally flip color keying off here temporarily so that our eyes
-    // have an easier time.
-    //
-    // You'll may want to leave color keying on if you are interested in using
-    // these bitmap glyphs for anything else!
-    page.texture->set_colorkey ( Color4i::Black, false );
-    page.texture->save_png("ttf_dest.png");
-    page.texture->set_colorkey ( Color4i::Black, true );
-  #endif
+  // SDL2_ttf only handles the Basic Multilingual Plane
+  if( face == nullptr || codepoint > 0xFFFF ) {
+    return glyph;
+  }
+
+  ascii_char = NOM_SCAST(uint16, codepoint);
+
+  if( TTF_GlyphIsProvided(face, ascii_char) == 0 ) {
+    return glyph;
+  }
+
+  // We obtain width & height of a glyph from its rendered form
+  glyph_image.initialize ( TTF_RenderGlyph_Solid( face, ascii_char, SDL_COLOR(Color4i::White) ) );
 
-  // Build up our font-wide metrics
-  if (this->valid() == false )
+  if ( glyph_image.valid() == false )
   {
-    NOM_LOG_ERR(NOM, "Could not build font metrics; our font is invalid" );
-    return false;
+    NOM_LOG_ERR(NOM, TTF_GetError() );
+    return glyph;
   }
 
-  return true;
+  glyph_width = glyph_image.width();
+  glyph_height = glyph_image.height();
+
+  // -_-
+  // Disappointedly, the only metric that we can use here is the advance
+  ret = TTF_GlyphMetrics  ( face,
+                            ascii_char,
+                            nullptr, // Left (X) origin
+                            nullptr, // Width
+                            nullptr, // Top (Y) origin
+                            nullptr, // Height
+                            &advance
+                          );
+
+  if ( ret != 0 ) // Likely to be a missing glyph
+  {
+    NOM_LOG_ERR ( NOM, TTF_GetError() );
+    return glyph;
+  }
+  glyph.advance = advance;
+
+  // Find room for the glyph on the sheet; if the glyph does not fit onto the
+  // current sheet dimensions, we allocate a larger sheet size.
+  glyph.bounds = this->glyph_rect ( page, glyph_width + spacing * padding, glyph_height + spacing * padding );
+
+  #if defined(NOM_DEBUG_SDL2_TRUE_TYPE_FONT_GLYPHS)
+    NOM_DUMP(codepoint); // integer position
+    NOM_DUMP(glyph.bounds); // bounding box
+    NOM_DUMP(advance); // spacing
+  #endif
+
+  // Prepare the coordinates for rendering a glyph onto our texture sheet
+  blit.x = glyph.bounds.x;
+  blit.y = glyph.bounds.y;
+  blit.w = -1; // Why -1 ???
+  blit.h = -1; // Why -1 ???
+  glyph_image.draw( page.texture->image(), blit );
+
+  // Dump all of the rendered glyphs as a series of image files -- the
+  // filenames will be the ASCII numeric values.
+  #if defined(NOM_DEBUG_SDL2_TRUE_TYPE_FONT_GLYPHS_PNG)
+    std::string ascii_filename = std::to_string(ascii_char);
+    ascii_filename.append(".png");
+    glyph_image.save_png(ascii_filename);
+  #endif
+
+  page.revision = ++this->revision_;
+
+  return glyph;
 }
 
 const GlyphPage& TrueTypeFont::pages ( void ) const
@@ -521,6 +511,102 @@ const GlyphPage& TrueTypeFont::pages ( void ) const
   return this->pages_;
 }
 
+FontPage& TrueTypeFont::page(uint32 character_size) const
+{
+  uint64 key = this->page_key(character_size);
+
+  if( this->last_page_ == nullptr || this->last_page_key_ != key )
+  {
+    FontPage& page = this->pages_[key];
+
+    if( page.texture->valid() == false ) {
+      // First use of this point size, style and outline
+      this->build(character_size);
+    }
+
+    this->last_page_ = &page;
+    this->last_page_key_ = key;
+  }
+
+  return *this->last_page_;
+}
+
+uint64 TrueTypeFont::page_key(uint32 character_size) const
+{
+  uint64 style = 0;
+  uint64 outline = 0;
+
+  if( this->valid() == true ) {
+    style = TTF_GetFontStyle( this->font() );
+    outline = TTF_GetFontOutline( this->font() );
+  }
+
+  // [outline:16][style:16][character_size:32]
+  return( (outline & 0xFFFF) << 48 | (style & 0xFFFF) << 32 | character_size );
+}
+
+TTF_Font* TrueTypeFont::face(uint32 character_size) const
+{
+  TTF_Font* current_face = this->font();
+  TTF_Font* face = nullptr;
+
+  if( current_face == nullptr ) {
+    return nullptr;
+  }
+
+  if( character_size == NOM_SCAST(uint32, this->point_size() ) ) {
+    return current_face;
+  }
+
+  auto res = this->faces_.find(character_size);
+  if( res != this->faces_.end() ) {
+    face = res->second.get();
+  } else {
+
+    face = TTF_OpenFont( this->filename_.c_str(), character_size );
+    if( face == nullptr ) {
+      NOM_LOG_ERR(  NOM, "Could not open TTF file at point size:",
+                    std::to_string(character_size), TTF_GetError() );
+      return nullptr;
+    }
+
+    this->faces_[character_size] =
+      std::shared_ptr<TTF_Font>(face, priv::TTF_FreeFont);
+  }
+
+  // NOTE: SDL2_ttf flushes its glyph cache on every state change, so we only
+  // touch the state that differs
+  if( TTF_GetFontStyle(face) != TTF_GetFontStyle(current_face) ) {
+    TTF_SetFontStyle( face, TTF_GetFontStyle(current_face) );
+  }
+
+  if( TTF_GetFontOutline(face) != TTF_GetFontOutline(current_face) ) {
+    TTF_SetFontOutline( face, TTF_GetFontOutline(current_face) );
+  }
+
+  if( TTF_GetFontHinting(face) != TTF_GetFontHinting(current_face) ) {
+    TTF_SetFontHinting( face, TTF_GetFontHinting(current_face) );
+  }
+
+  if( TTF_GetFontKerning(face) != TTF_GetFontKerning(current_face) ) {
+    TTF_SetFontKerning( face, TTF_GetFontKerning(current_face) );
+  }
+
+  return face;
+}
+
+void TrueTypeFont::update_metrics()
+{
+  this->metrics_.height = TTF_FontHeight( this->font() );
+  this->metrics_.newline = TTF_FontLineSkip( this->font() );
+  this->metrics_.ascent = TTF_FontAscent( this->font() );
+  this->metrics_.descent = TTF_FontDescent( this->font() );
+  this->metrics_.family = TTF_FontFaceFamilyName( this->font() );
+
+  // Set the font face style name
+  this->metrics_.name = std::string( TTF_FontFaceFamilyName( this->font() ) );
+}
+
 sint TrueTypeFont::sheet_width ( void ) const
 {
   return this->sheet_width_;
@@ -533,87 +619,47 @@ sint TrueTypeFont::sheet_height ( void ) const
 
 const IntRect TrueTypeFont::glyph_rect ( FontPage& page, int width, int height ) const
 {
-  FontRow* row = nullptr;
-  float best_ratio = 0;
-
   // Find an optimal layout within our texture's sheet for a specified glyph
-  for ( std::vector<FontRow>::iterator it = page.rows.begin(); it != page.rows.end() && ! row; ++it )
-  {
-    float ratio = static_cast<float> ( height ) / it->height;
+  IntRect rect = page.packer.pack( Size2i(width, height) );
 
-    // Ignore rows that are either too small or too high
-    if ( ( ratio < 0.7f ) || ( ratio > 1.f ) )
+  while( rect == IntRect::null )
+  {
+    // Not enough space: resize the texture if possible
+    uint texture_width  = page.texture->width();
+    uint texture_height = page.texture->height();
+    if  (
+          ( texture_width * 2 <= Texture::maximum_size().x )
+          &&
+          ( texture_height * 2 <= Texture::maximum_size().y )
+        )
     {
-      continue;
-    }
+      // Make the texture 2 times bigger
+      Image sheet; // new (destination) sheet
+      sheet.initialize ( Point2i( texture_width * 2, texture_height * 2 ) );
 
-    // Check if there's enough horizontal space left in the row
-    if ( width > page.texture->width() - it->width )
-    {
-      continue;
-    }
+      // Copy existing texture sheet to new sheet
+      page.texture->draw ( sheet.image(), IntRect(0, 0, -1, -1) );
 
-    // Make sure that this new row is the best found so far
-    if ( ratio < best_ratio )
-    {
-      continue;
-    }
+      #if defined(NOM_DEBUG_SDL2_TRUE_TYPE_FONT_GLYPHS)
+        sheet.save_png("ttf_src.png");
+      #endif
 
-    // The current row passed all the tests: we can select it
-    row = &*it;
-    best_ratio = ratio;
-  }
+      // Re-initialize our texture sheet with a copy of the resized sheet
+      page.texture->initialize ( sheet.clone() );
+      page.texture->set_colorkey ( Color4i::Black, true );
 
-  // If we didn't find a matching row, create a new one
-  // (10% taller than the glyph)
-  if ( ! row )
-  {
-    int row_height = height + height / 10;
-    while( page.next_row + row_height >= page.texture->height() || ( width >= page.texture->width() ) )
+      // The glyphs packed so far keep their positions
+      page.packer.grow( Size2i( texture_width * 2, texture_height * 2 ) );
+      rect = page.packer.pack( Size2i(width, height) );
+    }
+    else
     {
-      // Not enough space: resize the texture if possible
-      uint texture_width  = page.texture->width();
-      uint texture_height = page.texture->height();
-      if  (
-            ( texture_width * 2 <= Texture::maximum_size().x )
-            &&
-            ( texture_height * 2 <= Texture::maximum_size().y )
-          )
-      {
-        // Make the texture 2 times bigger
-        Image sheet; // new (destination) sheet
-        sheet.initialize ( Point2i( texture_width * 2, texture_height * 2 ) );
-
-        // Copy existing texture sheet to new sheet
-        page.texture->draw ( sheet.image(), IntRect(0, 0, -1, -1) );
-
-        #if defined(NOM_DEBUG_SDL2_TRUE_TYPE_FONT_GLYPHS)
-          sheet.save_png("ttf_src.png");
-        #endif
-
-        // Re-initialize our texture sheet with a copy of the resized sheet
-        page.texture->initialize ( sheet.clone() );
-      }
-      else
-      {
-        // Oops, we've reached the maximum texture size...
-        NOM_LOG_ERR( NOM, "Failed to add new character to sheet: sheet >= maximum texture size" );
-        return IntRect ( 0, 0, 2, 2 );
-      }
+      // Oops, we've reached the maximum texture size...
+      NOM_LOG_ERR( NOM, "Failed to add new character to sheet: sheet >= maximum texture size" );
+      return IntRect ( 0, 0, 2, 2 );
     }
-
-    // We can now create the new row
-    page.rows.push_back ( FontRow ( page.next_row, row_height ) );
-    page.next_row += row_height;
-    row = &page.rows.back();
   }
 
-  // Find the glyph's rectangle on the selected row
-  IntRect rect ( row->width, row->top, width, height );
-
-  // Update the row informations
-  row->width += width;
-
   return rect;
 }
 
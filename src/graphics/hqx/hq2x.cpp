@@ -33,67 +33,76 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nomlib/graphics/hqx/hqx.hpp"
 
 #define PIXEL00_0     *dp = w[5];
-#define PIXEL00_10    *dp = Interp1(w[5], w[1]);
-#define PIXEL00_11    *dp = Interp1(w[5], w[4]);
-#define PIXEL00_12    *dp = Interp1(w[5], w[2]);
-#define PIXEL00_20    *dp = Interp2(w[5], w[4], w[2]);
-#define PIXEL00_21    *dp = Interp2(w[5], w[1], w[2]);
-#define PIXEL00_22    *dp = Interp2(w[5], w[1], w[4]);
-#define PIXEL00_60    *dp = Interp6(w[5], w[2], w[4]);
-#define PIXEL00_61    *dp = Interp6(w[5], w[4], w[2]);
-#define PIXEL00_70    *dp = Interp7(w[5], w[4], w[2]);
-#define PIXEL00_90    *dp = Interp9(w[5], w[4], w[2]);
-#define PIXEL00_100   *dp = Interp10(w[5], w[4], w[2]);
+#define PIXEL00_10    *dp = Ops::Interp1(w[5], w[1]);
+#define PIXEL00_11    *dp = Ops::Interp1(w[5], w[4]);
+#define PIXEL00_12    *dp = Ops::Interp1(w[5], w[2]);
+#define PIXEL00_20    *dp = Ops::Interp2(w[5], w[4], w[2]);
+#define PIXEL00_21    *dp = Ops::Interp2(w[5], w[1], w[2]);
+#define PIXEL00_22    *dp = Ops::Interp2(w[5], w[1], w[4]);
+#define PIXEL00_60    *dp = Ops::Interp6(w[5], w[2], w[4]);
+#define PIXEL00_61    *dp = Ops::Interp6(w[5], w[4], w[2]);
+#define PIXEL00_70    *dp = Ops::Interp7(w[5], w[4], w[2]);
+#define PIXEL00_90    *dp = Ops::Interp9(w[5], w[4], w[2]);
+#define PIXEL00_100   *dp = Ops::Interp10(w[5], w[4], w[2]);
 #define PIXEL01_0     *(dp+1) = w[5];
-#define PIXEL01_10    *(dp+1) = Interp1(w[5], w[3]);
-#define PIXEL01_11    *(dp+1) = Interp1(w[5], w[2]);
-#define PIXEL01_12    *(dp+1) = Interp1(w[5], w[6]);
-#define PIXEL01_20    *(dp+1) = Interp2(w[5], w[2], w[6]);
-#define PIXEL01_21    *(dp+1) = Interp2(w[5], w[3], w[6]);
-#define PIXEL01_22    *(dp+1) = Interp2(w[5], w[3], w[2]);
-#define PIXEL01_60    *(dp+1) = Interp6(w[5], w[6], w[2]);
-#define PIXEL01_61    *(dp+1) = Interp6(w[5], w[2], w[6]);
-#define PIXEL01_70    *(dp+1) = Interp7(w[5], w[2], w[6]);
-#define PIXEL01_90    *(dp+1) = Interp9(w[5], w[2], w[6]);
-#define PIXEL01_100   *(dp+1) = Interp10(w[5], w[2], w[6]);
+#define PIXEL01_10    *(dp+1) = Ops::Interp1(w[5], w[3]);
+#define PIXEL01_11    *(dp+1) = Ops::Interp1(w[5], w[2]);
+#define PIXEL01_12    *(dp+1) = Ops::Interp1(w[5], w[6]);
+#define PIXEL01_20    *(dp+1) = Ops::Interp2(w[5], w[2], w[6]);
+#define PIXEL01_21    *(dp+1) = Ops::Interp2(w[5], w[3], w[6]);
+#define PIXEL01_22    *(dp+1) = Ops::Interp2(w[5], w[3], w[2]);
+#define PIXEL01_60    *(dp+1) = Ops::Interp6(w[5], w[6], w[2]);
+#define PIXEL01_61    *(dp+1) = Ops::Interp6(w[5], w[2], w[6]);
+#define PIXEL01_70    *(dp+1) = Ops::Interp7(w[5], w[2], w[6]);
+#define PIXEL01_90    *(dp+1) = Ops::Interp9(w[5], w[2], w[6]);
+#define PIXEL01_100   *(dp+1) = Ops::Interp10(w[5], w[2], w[6]);
 #define PIXEL10_0     *(dp+dpL) = w[5];
-#define PIXEL10_10    *(dp+dpL) = Interp1(w[5], w[7]);
-#define PIXEL10_11    *(dp+dpL) = Interp1(w[5], w[8]);
-#define PIXEL10_12    *(dp+dpL) = Interp1(w[5], w[4]);
-#define PIXEL10_20    *(dp+dpL) = Interp2(w[5], w[8], w[4]);
-#define PIXEL10_21    *(dp+dpL) = Interp2(w[5], w[7], w[4]);
-#define PIXEL10_22    *(dp+dpL) = Interp2(w[5], w[7], w[8]);
-#define PIXEL10_60    *(dp+dpL) = Interp6(w[5], w[4], w[8]);
-#define PIXEL10_61    *(dp+dpL) = Interp6(w[5], w[8], w[4]);
-#define PIXEL10_70    *(dp+dpL) = Interp7(w[5], w[8], w[4]);
-#define PIXEL10_90    *(dp+dpL) = Interp9(w[5], w[8], w[4]);
-#define PIXEL10_100   *(dp+dpL) = Interp10(w[5], w[8], w[4]);
+#define PIXEL10_10    *(dp+dpL) = Ops::Interp1(w[5], w[7]);
+#define PIXEL10_11    *(dp+dpL) = Ops::Interp1(w[5], w[8]);
+#define PIXEL10_12    *(dp+dpL) = Ops::Interp1(w[5], w[4]);
+#define PIXEL10_20    *(dp+dpL) = Ops::Interp2(w[5], w[8], w[4]);
+#define PIXEL10_21    *(dp+dpL) = Ops::Interp2(w[5], w[7], w[4]);
+#define PIXEL10_22    *(dp+dpL) = Ops::Interp2(w[5], w[7], w[8]);
+#define PIXEL10_60    *(dp+dpL) = Ops::Interp6(w[5], w[4], w[8]);
+#define PIXEL10_61    *(dp+dpL) = Ops::Interp6(w[5], w[8], w[4]);
+#define PIXEL10_70    *(dp+dpL) = Ops::Interp7(w[5], w[8], w[4]);
+#define PIXEL10_90    *(dp+dpL) = Ops::Interp9(w[5], w[8], w[4]);
+#define PIXEL10_100   *(dp+dpL) = Ops::Interp10(w[5], w[8], w[4]);
 #define PIXEL11_0     *(dp+dpL+1) = w[5];
-#define PIXEL11_10    *(dp+dpL+1) = Interp1(w[5], w[9]);
-#define PIXEL11_11    *(dp+dpL+1) = Interp1(w[5], w[6]);
-#define PIXEL11_12    *(dp+dpL+1) = Interp1(w[5], w[8]);
-#define PIXEL11_20    *(dp+dpL+1) = Interp2(w[5], w[6], w[8]);
-#define PIXEL11_21    *(dp+dpL+1) = Interp2(w[5], w[9], w[8]);
-#define PIXEL11_22    *(dp+dpL+1) = Interp2(w[5], w[9], w[6]);
-#define PIXEL11_60    *(dp+dpL+1) = Interp6(w[5], w[8], w[6]);
-#define PIXEL11_61    *(dp+dpL+1) = Interp6(w[5], w[6], w[8]);
-#define PIXEL11_70    *(dp+dpL+1) = Interp7(w[5], w[6], w[8]);
-#define PIXEL11_90    *(dp+dpL+1) = Interp9(w[5], w[6], w[8]);
-#define PIXEL11_100   *(dp+dpL+1) = Interp10(w[5], w[6], w[8]);
+#define PIXEL11_10    *(dp+dpL+1) = Ops::Interp1(w[5], w[9]);
+#define PIXEL11_11    *(dp+dpL+1) = Ops::Interp1(w[5], w[6]);
+#define PIXEL11_12    *(dp+dpL+1) = Ops::Interp1(w[5], w[8]);
+#define PIXEL11_20    *(dp+dpL+1) = Ops::Interp2(w[5], w[6], w[8]);
+#define PIXEL11_21    *(dp+dpL+1) = Ops::Interp2(w[5], w[9], w[8]);
+#define PIXEL11_22    *(dp+dpL+1) = Ops::Interp2(w[5], w[9], w[6]);
+#define PIXEL11_60    *(dp+dpL+1) = Ops::Interp6(w[5], w[8], w[6]);
+#define PIXEL11_61    *(dp+dpL+1) = Ops::Interp6(w[5], w[6], w[8]);
+#define PIXEL11_70    *(dp+dpL+1) = Ops::Interp7(w[5], w[6], w[8]);
+#define PIXEL11_90    *(dp+dpL+1) = Ops::Interp9(w[5], w[6], w[8]);
+#define PIXEL11_100   *(dp+dpL+1) = Ops::Interp10(w[5], w[6], w[8]);
 
 namespace nom {
   namespace priv {
 
-void hq2x_32_rb( uint32* sp, uint32 srb, uint32* dp, uint32 drb, int32 Xres, int32 Yres )
+namespace {
+
+template <typename Ops>
+void hq2x_32_rows( uint32* sp, uint32 srb, uint32* dp, uint32 drb,
+                   int32 Xres, int32 Yres, int32 row_begin, int32 row_end )
 {
-  int32  i, j, k;
+  int32  i, j;
   int32  prevline, nextline;
   uint32  w[10];
   int32 dpL = (drb >> 2);
   int32 spL = (srb >> 2);
   uint8 *sRowP = (uint8 *) sp;
   uint8 *dRowP = (uint8 *) dp;
-  uint32 yuv1, yuv2;
+
+  // Start from the first row of the band
+  sRowP += srb * row_begin;
+  sp = (uint32 *) sRowP;
+  dRowP += drb * 2 * row_begin;
+  dp = (uint32 *) dRowP;
 
   //   +----+----+----+
   //   |    |    |    |
@@ -106,7 +115,7 @@ void hq2x_32_rb( uint32* sp, uint32 srb, uint32* dp, uint32 drb, int32 Xres, int
   //   | w7 | w8 | w9 |
   //   +----+----+----+
 
-  for (j=0; j<Yres; j++)
+  for (j=row_begin; j<row_end; j++)
   {
       if (j>0)      prevline = -spL; else prevline = 0;
       if (j<Yres-1) nextline =  spL; else nextline = 0;
@@ -143,23 +152,7 @@ void hq2x_32_rb( uint32* sp, uint32 srb, uint32* dp, uint32 drb, int32 Xres, int
               w[9] = w[8];
           }
 
-          int32 pattern = 0;
-          int32 flag = 1;
-
-          yuv1 = rgb_to_yuv(w[5]);
-
-          for (k=1; k<=9; k++)
-          {
-              if (k==5) continue;
-
-              if ( w[k] != w[5] )
-              {
-                  yuv2 = rgb_to_yuv(w[k]);
-                  if (yuv_diff(yuv1, yuv2))
-                      pattern |= flag;
-              }
-              flag <<= 1;
-          }
+          int32 pattern = Ops::pattern(w);
 
           switch (pattern)
           {
@@ -2815,6 +2808,21 @@ void hq2x_32_rb( uint32* sp, uint32 srb, uint32* dp, uint32 drb, int32 Xres, int
   }
 }
 
+} // namespace
+
+void hq2x_32_rb( uint32* sp, uint32 srb, uint32* dp, uint32 drb, int32 Xres, int32 Yres )
+{
+  hqx_rows_func scale = hq2x_32_rows<HQXScalarOps>;
+
+  #if defined(NOM_HQX_USE_SSE2)
+    if( hqx_path() == HQX_PATH_SIMD ) {
+      scale = hq2x_32_rows<HQXSSE2Ops>;
+    }
+  #endif
+
+  hqx_scale_rows(scale, sp, srb, dp, drb, Xres, Yres);
+}
+
 void hq2x_32 ( uint32* src, uint32* dest, int32 width, int32 height )
 {
   uint32 rowBytesL = width * 4;
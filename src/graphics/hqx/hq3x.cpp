@@ -32,73 +32,82 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 #include "nomlib/graphics/hqx/hqx.hpp"
 
-#define PIXEL00_1M  *dp = Interp1(w[5], w[1]);
-#define PIXEL00_1U  *dp = Interp1(w[5], w[2]);
-#define PIXEL00_1L  *dp = Interp1(w[5], w[4]);
-#define PIXEL00_2   *dp = Interp2(w[5], w[4], w[2]);
-#define PIXEL00_4   *dp = Interp4(w[5], w[4], w[2]);
-#define PIXEL00_5   *dp = Interp5(w[4], w[2]);
+#define PIXEL00_1M  *dp = Ops::Interp1(w[5], w[1]);
+#define PIXEL00_1U  *dp = Ops::Interp1(w[5], w[2]);
+#define PIXEL00_1L  *dp = Ops::Interp1(w[5], w[4]);
+#define PIXEL00_2   *dp = Ops::Interp2(w[5], w[4], w[2]);
+#define PIXEL00_4   *dp = Ops::Interp4(w[5], w[4], w[2]);
+#define PIXEL00_5   *dp = Ops::Interp5(w[4], w[2]);
 #define PIXEL00_C   *dp   = w[5];
 
-#define PIXEL01_1   *(dp+1) = Interp1(w[5], w[2]);
-#define PIXEL01_3   *(dp+1) = Interp3(w[5], w[2]);
-#define PIXEL01_6   *(dp+1) = Interp1(w[2], w[5]);
+#define PIXEL01_1   *(dp+1) = Ops::Interp1(w[5], w[2]);
+#define PIXEL01_3   *(dp+1) = Ops::Interp3(w[5], w[2]);
+#define PIXEL01_6   *(dp+1) = Ops::Interp1(w[2], w[5]);
 #define PIXEL01_C   *(dp+1) = w[5];
 
-#define PIXEL02_1M  *(dp+2) = Interp1(w[5], w[3]);
-#define PIXEL02_1U  *(dp+2) = Interp1(w[5], w[2]);
-#define PIXEL02_1R  *(dp+2) = Interp1(w[5], w[6]);
-#define PIXEL02_2   *(dp+2) = Interp2(w[5], w[2], w[6]);
-#define PIXEL02_4   *(dp+2) = Interp4(w[5], w[2], w[6]);
-#define PIXEL02_5   *(dp+2) = Interp5(w[2], w[6]);
+#define PIXEL02_1M  *(dp+2) = Ops::Interp1(w[5], w[3]);
+#define PIXEL02_1U  *(dp+2) = Ops::Interp1(w[5], w[2]);
+#define PIXEL02_1R  *(dp+2) = Ops::Interp1(w[5], w[6]);
+#define PIXEL02_2   *(dp+2) = Ops::Interp2(w[5], w[2], w[6]);
+#define PIXEL02_4   *(dp+2) = Ops::Interp4(w[5], w[2], w[6]);
+#define PIXEL02_5   *(dp+2) = Ops::Interp5(w[2], w[6]);
 #define PIXEL02_C   *(dp+2) = w[5];
 
-#define PIXEL10_1   *(dp+dpL) = Interp1(w[5], w[4]);
-#define PIXEL10_3   *(dp+dpL) = Interp3(w[5], w[4]);
-#define PIXEL10_6   *(dp+dpL) = Interp1(w[4], w[5]);
+#define PIXEL10_1   *(dp+dpL) = Ops::Interp1(w[5], w[4]);
+#define PIXEL10_3   *(dp+dpL) = Ops::Interp3(w[5], w[4]);
+#define PIXEL10_6   *(dp+dpL) = Ops::Interp1(w[4], w[5]);
 #define PIXEL10_C   *(dp+dpL) = w[5];
 
 #define PIXEL11     *(dp+dpL+1) = w[5];
 
-#define PIXEL12_1   *(dp+dpL+2) = Interp1(w[5], w[6]);
-#define PIXEL12_3   *(dp+dpL+2) = Interp3(w[5], w[6]);
-#define PIXEL12_6   *(dp+dpL+2) = Interp1(w[6], w[5]);
+#define PIXEL12_1   *(dp+dpL+2) = Ops::Interp1(w[5], w[6]);
+#define PIXEL12_3   *(dp+dpL+2) = Ops::Interp3(w[5], w[6]);
+#define PIXEL12_6   *(dp+dpL+2) = Ops::Interp1(w[6], w[5]);
 #define PIXEL12_C   *(dp+dpL+2) = w[5];
 
-#define PIXEL20_1M  *(dp+dpL+dpL) = Interp1(w[5], w[7]);
-#define PIXEL20_1D  *(dp+dpL+dpL) = Interp1(w[5], w[8]);
-#define PIXEL20_1L  *(dp+dpL+dpL) = Interp1(w[5], w[4]);
-#define PIXEL20_2   *(dp+dpL+dpL) = Interp2(w[5], w[8], w[4]);
-#define PIXEL20_4   *(dp+dpL+dpL) = Interp4(w[5], w[8], w[4]);
-#define PIXEL20_5   *(dp+dpL+dpL) = Interp5(w[8], w[4]);
+#define PIXEL20_1M  *(dp+dpL+dpL) = Ops::Interp1(w[5], w[7]);
+#define PIXEL20_1D  *(dp+dpL+dpL) = Ops::Interp1(w[5], w[8]);
+#define PIXEL20_1L  *(dp+dpL+dpL) = Ops::Interp1(w[5], w[4]);
+#define PIXEL20_2   *(dp+dpL+dpL) = Ops::Interp2(w[5], w[8], w[4]);
+#define PIXEL20_4   *(dp+dpL+dpL) = Ops::Interp4(w[5], w[8], w[4]);
+#define PIXEL20_5   *(dp+dpL+dpL) = Ops::Interp5(w[8], w[4]);
 #define PIXEL20_C   *(dp+dpL+dpL) = w[5];
 
-#define PIXEL21_1   *(dp+dpL+dpL+1) = Interp1(w[5], w[8]);
-#define PIXEL21_3   *(dp+dpL+dpL+1) = Interp3(w[5], w[8]);
-#define PIXEL21_6   *(dp+dpL+dpL+1) = Interp1(w[8], w[5]);
+#define PIXEL21_1   *(dp+dpL+dpL+1) = Ops::Interp1(w[5], w[8]);
+#define PIXEL21_3   *(dp+dpL+dpL+1) = Ops::Interp3(w[5], w[8]);
+#define PIXEL21_6   *(dp+dpL+dpL+1) = Ops::Interp1(w[8], w[5]);
 #define PIXEL21_C   *(dp+dpL+dpL+1) = w[5];
 
-#define PIXEL22_1M  *(dp+dpL+dpL+2) = Interp1(w[5], w[9]);
-#define PIXEL22_1D  *(dp+dpL+dpL+2) = Interp1(w[5], w[8]);
-#define PIXEL22_1R  *(dp+dpL+dpL+2) = Interp1(w[5], w[6]);
-#define PIXEL22_2   *(dp+dpL+dpL+2) = Interp2(w[5], w[6], w[8]);
-#define PIXEL22_4   *(dp+dpL+dpL+2) = Interp4(w[5], w[6], w[8]);
-#define PIXEL22_5   *(dp+dpL+dpL+2) = Interp5(w[6], w[8]);
+#define PIXEL22_1M  *(dp+dpL+dpL+2) = Ops::Interp1(w[5], w[9]);
+#define PIXEL22_1D  *(dp+dpL+dpL+2) = Ops::Interp1(w[5], w[8]);
+#define PIXEL22_1R  *(dp+dpL+dpL+2) = Ops::Interp1(w[5], w[6]);
+#define PIXEL22_2   *(dp+dpL+dpL+2) = Ops::Interp2(w[5], w[6], w[8]);
+#define PIXEL22_4   *(dp+dpL+dpL+2) = Ops::Interp4(w[5], w[6], w[8]);
+#define PIXEL22_5   *(dp+dpL+dpL+2) = Ops::Interp5(w[6], w[8]);
 #define PIXEL22_C   *(dp+dpL+dpL+2) = w[5];
 
 namespace nom {
   namespace priv {
 
-void hq3x_32_rb( uint32* sp, uint32 srb, uint32* dp, uint32 drb, int32 Xres, int32 Yres )
+namespace {
+
+template <typename Ops>
+void hq3x_32_rows( uint32* sp, uint32 srb, uint32* dp, uint32 drb,
+                   int32 Xres, int32 Yres, int32 row_begin, int32 row_end )
 {
-    int32  i, j, k;
+    int32  i, j;
     int32  prevline, nextline;
     uint32  w[10];
     int32 dpL = (drb >> 2);
     int32 spL = (srb >> 2);
     uint8 *sRowP = (uint8 *) sp;
     uint8 *dRowP = (uint8 *) dp;
-    uint32 yuv1, yuv2;
+
+    // Start from the first row of the band
+    sRowP += srb * row_begin;
+    sp = (uint32 *) sRowP;
+    dRowP += drb * 3 * row_begin;
+    dp = (uint32 *) dRowP;
 
     //   +----+----+----+
     //   |    |    |    |
@@ -111,7 +120,7 @@ void hq3x_32_rb( uint32* sp, uint32 srb, uint32* dp, uint32 drb, int32 Xres, int
     //   | w7 | w8 | w9 |
     //   +----+----+----+
 
-    for (j=0; j<Yres; j++)
+    for (j=row_begin; j<row_end; j++)
     {
         if (j>0)      prevline = -spL; else prevline = 0;
         if (j<Yres-1) nextline =  spL; else nextline = 0;
@@ -148,23 +157,7 @@ void hq3x_32_rb( uint32* sp, uint32 srb, uint32* dp, uint32 drb, int32 Xres, int
                 w[9] = w[8];
             }
 
-            int32 pattern = 0;
-            int32 flag = 1;
-
-            yuv1 = rgb_to_yuv(w[5]);
-
-            for (k=1; k<=9; k++)
-            {
-                if (k==5) continue;
-
-                if ( w[k] != w[5] )
-                {
-                    yuv2 = rgb_to_yuv(w[k]);
-                    if (yuv_diff(yuv1, yuv2))
-                        pattern |= flag;
-                }
-                flag <<= 1;
-            }
+            int32 pattern = Ops::pattern(w);
 
             switch (pattern)
             {
@@ -3793,6 +3786,21 @@ void hq3x_32_rb( uint32* sp, uint32 srb, uint32* dp, uint32 drb, int32 Xres, int
     }
 }
 
+} // namespace
+
+void hq3x_32_rb( uint32* sp, uint32 srb, uint32* dp, uint32 drb, int32 Xres, int32 Yres )
+{
+  hqx_rows_func scale = hq3x_32_rows<HQXScalarOps>;
+
+  #if defined(NOM_HQX_USE_SSE2)
+    if( hqx_path() == HQX_PATH_SIMD ) {
+      scale = hq3x_32_rows<HQXSSE2Ops>;
+    }
+  #endif
+
+  hqx_scale_rows(scale, sp, srb, dp, drb, Xres, Yres);
+}
+
 void hq3x_32 ( uint32* src, uint32* dest, int32 width, int32 height )
 {
   uint32 rowBytesL = width * 4;
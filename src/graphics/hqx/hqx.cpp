@@ -32,29 +32,161 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 #include "nomlib/graphics/hqx/hqx.hpp"
 
+// Private headers
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace nom {
   namespace priv {
 
-uint32 RGBtoYUV[16777216];
+uint32* RGBtoYUV = nullptr;
+YUVWeights RGBtoYUV_R[256];
+YUVWeights RGBtoYUV_G[256];
+YUVWeights RGBtoYUV_B[256];
 uint32 YUV1, YUV2;
 
+namespace {
+
+/// \brief Storage for the full lookup table; RGBtoYUV points into this once
+/// built.
+std::unique_ptr<uint32[]> rgb_to_yuv_table;
+
+enum HQXColorMode color_mode = HQX_COLOR_TABLE;
+
+std::atomic<int> kernel_path(HQX_PATH_SIMD);
+
+/// \brief Zero means the number of hardware threads.
+std::atomic<uint32> max_threads(0);
+
+/// \brief The fewest source rows worth handing to a thread.
+const int32 MIN_BAND_ROWS = 16;
+
+std::once_flag weights_init_flag;
+std::mutex table_mutex;
+
+void init_weights()
+{
+  for( uint32 c = 0; c < 256; ++c ) {
+    RGBtoYUV_R[c].y = 0.299 * c;
+    RGBtoYUV_R[c].u = -0.169 * c;
+    RGBtoYUV_R[c].v = 0.5 * c;
+
+    RGBtoYUV_G[c].y = 0.587 * c;
+    RGBtoYUV_G[c].u = -0.331 * c;
+    RGBtoYUV_G[c].v = -0.419 * c;
+
+    RGBtoYUV_B[c].y = 0.114 * c;
+    RGBtoYUV_B[c].u = 0.5 * c;
+    RGBtoYUV_B[c].v = -0.081 * c;
+  }
+}
+
+} // namespace
+
 void hqxInit ( void )
 {
+  // The weight tables are tiny and are used to build the full table, so they
+  // are always initialized
+  std::call_once(weights_init_flag, init_weights);
+
+  std::lock_guard<std::mutex> lock(table_mutex);
+
+  if( color_mode != HQX_COLOR_TABLE || RGBtoYUV != nullptr ) {
+    return;
+  }
+
   /* Initalize RGB to YUV lookup table */
-  uint32 c, r, g, b, y, u, v;
+  rgb_to_yuv_table.reset( new uint32[16777216] );
 
-  for (c = 0; c < 16777215; c++)
-  {
-    r = (c & 0xFF0000) >> 16;
-    g = (c & 0x00FF00) >> 8;
-    b = c & 0x0000FF;
-    y = (uint32)(0.299*r + 0.587*g + 0.114*b);
-    u = (uint32)(-0.169*r - 0.331*g + 0.5*b) + 128;
-    v = (uint32)(0.5*r - 0.419*g - 0.081*b) + 128;
-    RGBtoYUV[c] = (y << 16) + (u << 8) + v;
+  uint32* table = rgb_to_yuv_table.get();
+  for( uint32 c = 0; c < 16777216; ++c ) {
+    table[c] = rgb_to_yuv_compact(c);
   }
+
+  RGBtoYUV = table;
+}
+
+enum HQXColorMode hqx_color_mode()
+{
+  std::lock_guard<std::mutex> lock(table_mutex);
+
+  return color_mode;
 }
 
+void hqx_set_color_mode(enum HQXColorMode mode)
+{
+  std::lock_guard<std::mutex> lock(table_mutex);
+
+  color_mode = mode;
+
+  if( mode == HQX_COLOR_COMPACT ) {
+    RGBtoYUV = nullptr;
+    rgb_to_yuv_table.reset();
+  }
+}
+
+enum HQXPath hqx_path()
+{
+  return NOM_SCAST(enum HQXPath, kernel_path.load() );
+}
+
+void hqx_set_path(enum HQXPath path)
+{
+  kernel_path = path;
+}
+
+uint32 hqx_max_threads()
+{
+  return max_threads;
+}
+
+void hqx_set_max_threads(uint32 num_threads)
+{
+  max_threads = num_threads;
+}
+
+void hqx_scale_rows(  hqx_rows_func scale, uint32* sp, uint32 srb, uint32* dp,
+                      uint32 drb, int32 Xres, int32 Yres )
+{
+  int32 num_threads = max_threads;
+  if( num_threads == 0 ) {
+    num_threads = std::thread::hardware_concurrency();
+  }
+
+  int32 num_bands = std::min( num_threads, Yres / MIN_BAND_ROWS );
+  if( num_bands < 2 ) {
+    scale(sp, srb, dp, drb, Xres, Yres, 0, Yres);
+    return;
+  }
+
+  std::vector<std::thread> workers;
+  workers.reserve(num_bands - 1);
+
+  // Each band owns its rows of the destination; the source is only read
+  int32 row_begin = 0;
+  for( int32 band = 0; band != num_bands; ++band ) {
+
+    int32 row_end = ( (band + 1) * Yres ) / num_bands;
+
+    if( band == num_bands - 1 ) {
+      // The calling thread scales the last band
+      scale(sp, srb, dp, drb, Xres, Yres, row_begin, row_end);
+    } else {
+      workers.emplace_back( scale, sp, srb, dp, drb, Xres, Yres, row_begin,
+                            row_end );
+    }
+
+    row_begin = row_end;
+  }
+
+  for( auto itr = workers.begin(); itr != workers.end(); ++itr ) {
+    itr->join();
+  }
+}
 
   } // namespace priv
 } // namespace nom
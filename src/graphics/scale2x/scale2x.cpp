@@ -28,13 +28,218 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 #include "nomlib/graphics/scale2x/scale2x.hpp"
 
+// Private headers
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#if defined(NOM_SCALEX_USE_SSE2)
+  #include <emmintrin.h>
+#endif
+
 namespace nom {
   namespace priv {
 
+namespace {
+
+std::atomic<int> scaling_path(SCALEX_PATH_SIMD);
+
+/// \brief Zero means the number of hardware threads.
+std::atomic<uint32> max_threads(0);
+
+/// \brief The fewest source rows worth handing to a thread.
+const int32 MIN_BAND_ROWS = 16;
+
+/// \brief Scale the source pixels [begin, end) of one row.
+///
+/// \param b The row above, clamped to the image.
+/// \param e The row being scaled.
+/// \param h The row below, clamped to the image.
+/// \param d0 The first destination row.
+/// \param d1 The second destination row.
+void scale2x_32_row(  const uint32* b, const uint32* e, const uint32* h,
+                      uint32* d0, uint32* d1, int32 width,
+                      int32 begin, int32 end )
+{
+  uint32 E0, E1, E2, E3, B, D, E, F, H;
+
+  for( int32 x = begin; x < end; ++x ) {
+
+    B = b[x];
+    D = e[std::max(0, x - 1)];
+    E = e[x];
+    F = e[std::min(width - 1, x + 1)];
+    H = h[x];
+
+    E0 = D == B && B != F && D != H ? D : E;
+    E1 = B == F && B != D && F != H ? F : E;
+    E2 = D == H && D != B && H != F ? D : E;
+    E3 = H == F && D != H && B != F ? F : E;
+
+    d0[x*2] = E0;
+    d0[x*2+1] = E1;
+    d1[x*2] = E2;
+    d1[x*2+1] = E3;
+  }
+}
+
+#if defined(NOM_SCALEX_USE_SSE2)
+
+/// \brief Choose a where the mask is set, and b elsewhere.
+inline __m128i select(__m128i mask, __m128i a, __m128i b)
+{
+  return _mm_or_si128( _mm_and_si128(mask, a), _mm_andnot_si128(mask, b) );
+}
+
+/// \brief SSE2 version of scale2x_32_row, for the whole row.
+void scale2x_32_row_sse2( const uint32* b, const uint32* e, const uint32* h,
+                          uint32* d0, uint32* d1, int32 width )
+{
+  // The edge pixels clamp their neighbours, so leave them to the scalar code
+  int32 x = 1;
+  scale2x_32_row(b, e, h, d0, d1, width, 0, std::min(1, width) );
+
+  for( ; x + 4 < width; x += 4 ) {
+
+    __m128i B = _mm_loadu_si128( (const __m128i*)(b + x) );
+    __m128i D = _mm_loadu_si128( (const __m128i*)(e + x - 1) );
+    __m128i E = _mm_loadu_si128( (const __m128i*)(e + x) );
+    __m128i F = _mm_loadu_si128( (const __m128i*)(e + x + 1) );
+    __m128i H = _mm_loadu_si128( (const __m128i*)(h + x) );
+
+    __m128i DB = _mm_cmpeq_epi32(D, B);
+    __m128i BF = _mm_cmpeq_epi32(B, F);
+    __m128i DH = _mm_cmpeq_epi32(D, H);
+    __m128i HF = _mm_cmpeq_epi32(H, F);
+
+    // NOTE: _mm_andnot_si128(a, b) is (~a & b)
+    __m128i E0 = select( _mm_andnot_si128(BF, _mm_andnot_si128(DH, DB) ), D, E);
+    __m128i E1 = select( _mm_andnot_si128(DB, _mm_andnot_si128(HF, BF) ), F, E);
+    __m128i E2 = select( _mm_andnot_si128(DB, _mm_andnot_si128(HF, DH) ), D, E);
+    __m128i E3 = select( _mm_andnot_si128(DH, _mm_andnot_si128(BF, HF) ), F, E);
+
+    _mm_storeu_si128( (__m128i*)(d0 + x*2), _mm_unpacklo_epi32(E0, E1) );
+    _mm_storeu_si128( (__m128i*)(d0 + x*2+4), _mm_unpackhi_epi32(E0, E1) );
+    _mm_storeu_si128( (__m128i*)(d1 + x*2), _mm_unpacklo_epi32(E2, E3) );
+    _mm_storeu_si128( (__m128i*)(d1 + x*2+4), _mm_unpackhi_epi32(E2, E3) );
+  }
+
+  scale2x_32_row(b, e, h, d0, d1, width, x, width);
+}
+
+#endif // defined NOM_SCALEX_USE_SSE2
+
+void scale2x_32_rows( const uint8* srcpix, int32 srcpitch, uint8* dstpix,
+                      int32 dstpitch, int32 width, int32 height,
+                      int32 row_begin, int32 row_end )
+{
+  for( int32 looph = row_begin; looph < row_end; ++looph ) {
+    const uint32* b =
+      (const uint32*)(srcpix + std::max(0, looph - 1) * srcpitch);
+    const uint32* e = (const uint32*)(srcpix + looph * srcpitch);
+    const uint32* h =
+      (const uint32*)(srcpix + std::min(height - 1, looph + 1) * srcpitch);
+    uint32* d0 = (uint32*)(dstpix + looph * 2 * dstpitch);
+    uint32* d1 = (uint32*)(dstpix + (looph * 2 + 1) * dstpitch);
+
+    scale2x_32_row(b, e, h, d0, d1, width, 0, width);
+  }
+}
+
+#if defined(NOM_SCALEX_USE_SSE2)
+
+void scale2x_32_rows_sse2(  const uint8* srcpix, int32 srcpitch,
+                            uint8* dstpix, int32 dstpitch, int32 width,
+                            int32 height, int32 row_begin, int32 row_end )
+{
+  for( int32 looph = row_begin; looph < row_end; ++looph ) {
+    const uint32* b =
+      (const uint32*)(srcpix + std::max(0, looph - 1) * srcpitch);
+    const uint32* e = (const uint32*)(srcpix + looph * srcpitch);
+    const uint32* h =
+      (const uint32*)(srcpix + std::min(height - 1, looph + 1) * srcpitch);
+    uint32* d0 = (uint32*)(dstpix + looph * 2 * dstpitch);
+    uint32* d1 = (uint32*)(dstpix + (looph * 2 + 1) * dstpitch);
+
+    scale2x_32_row_sse2(b, e, h, d0, d1, width);
+  }
+}
+
+#endif // defined NOM_SCALEX_USE_SSE2
+
+} // namespace
+
+enum ScaleXPath scalex_path()
+{
+  return NOM_SCAST(enum ScaleXPath, scaling_path.load() );
+}
+
+void scalex_set_path(enum ScaleXPath path)
+{
+  scaling_path = path;
+}
+
+uint32 scalex_max_threads()
+{
+  return max_threads;
+}
+
+void scalex_set_max_threads(uint32 num_threads)
+{
+  max_threads = num_threads;
+}
+
+void scalex_scale_rows( scalex_rows_func scale, const uint8* source_buffer,
+                        int32 source_pitch, uint8* destination_buffer,
+                        int32 destination_pitch, int32 source_width,
+                        int32 source_height )
+{
+  int32 num_threads = max_threads;
+  if( num_threads == 0 ) {
+    num_threads = std::thread::hardware_concurrency();
+  }
+
+  int32 num_bands = std::min( num_threads, source_height / MIN_BAND_ROWS );
+  if( num_bands < 2 ) {
+    scale(  source_buffer, source_pitch, destination_buffer,
+            destination_pitch, source_width, source_height, 0,
+            source_height );
+    return;
+  }
+
+  std::vector<std::thread> workers;
+  workers.reserve(num_bands - 1);
+
+  // Each band owns its rows of the destination; the source is only read
+  int32 row_begin = 0;
+  for( int32 band = 0; band != num_bands; ++band ) {
+
+    int32 row_end = ( (band + 1) * source_height ) / num_bands;
+
+    if( band == num_bands - 1 ) {
+      // The calling thread scales the last band
+      scale(  source_buffer, source_pitch, destination_buffer,
+              destination_pitch, source_width, source_height, row_begin,
+              row_end );
+    } else {
+      workers.emplace_back( scale, source_buffer, source_pitch,
+                            destination_buffer, destination_pitch,
+                            source_width, source_height, row_begin,
+                            row_end );
+    }
+
+    row_begin = row_end;
+  }
+
+  for( auto itr = workers.begin(); itr != workers.end(); ++itr ) {
+    itr->join();
+  }
+}
+
 bool scale2x  ( void* source_buffer, void* destination_buffer,
                 const int32 source_width, const int32 source_height,
                 const int32 bits_per_pixel,
-                const int16 source_pitch, int16 destination_pitch
+                const int32 source_pitch, int32 destination_pitch
               )
 {
   // Save a temporary copy of the *existing* width & height for scaling
@@ -43,11 +248,11 @@ bool scale2x  ( void* source_buffer, void* destination_buffer,
   int32 height = source_height;
 
   // The existing video surface pitch (width) is used for scaling calculations.
-  uint16 srcpitch = source_pitch;
+  int32 srcpitch = source_pitch;
 
   // We must use the new video surface configuration for computing the pitch as
   // this is dependent upon width & height parameters.
-  uint16 dstpitch = destination_pitch;
+  int32 dstpitch = destination_pitch;
 
   // Existing & resulting pixel arrays
   uint8* srcpix = static_cast<uint8*> ( source_buffer );
@@ -148,29 +353,16 @@ bool scale2x  ( void* source_buffer, void* destination_buffer,
 
     case 32:
     {
-      uint32 E0, E1, E2, E3, B, D, E, F, H;
+      scalex_rows_func scale = scale2x_32_rows;
 
-      for ( int32 looph = 0; looph < height; ++looph)
-      {
-        for ( int32 loopw = 0; loopw < width; ++loopw)
-        {
-          B = *(uint32*)(srcpix + (std::max(0,looph-1)*srcpitch) + (4*loopw));
-          D = *(uint32*)(srcpix + (looph*srcpitch) + (4*std::max(0,loopw-1)));
-          E = *(uint32*)(srcpix + (looph*srcpitch) + (4*loopw));
-          F = *(uint32*)(srcpix + (looph*srcpitch) + (4*std::min(width-1,loopw+1)));
-          H = *(uint32*)(srcpix + (std::min(height-1,looph+1)*srcpitch) + (4*loopw));
-
-          E0 = D == B && B != F && D != H ? D : E;
-          E1 = B == F && B != D && F != H ? F : E;
-          E2 = D == H && D != B && H != F ? D : E;
-          E3 = H == F && D != H && B != F ? F : E;
+      #if defined(NOM_SCALEX_USE_SSE2)
+        if( scalex_path() == SCALEX_PATH_SIMD ) {
+          scale = scale2x_32_rows_sse2;
+        }
+      #endif
 
-          *(uint32*)(dstpix + looph*2*dstpitch + loopw*2*4) = E0;
-          *(uint32*)(dstpix + looph*2*dstpitch + (loopw*2+1)*4) = E1;
-          *(uint32*)(dstpix + (looph*2+1)*dstpitch + loopw*2*4) = E2;
-          *(uint32*)(dstpix + (looph*2+1)*dstpitch + (loopw*2+1)*4) = E3;
-        } // for width loop
-      } // for height loop
+      scalex_scale_rows(  scale, srcpix, srcpitch, dstpix, dstpitch, width,
+                          height );
     } // end case 32
     break;
   } // end switch (bits_per_pixel)
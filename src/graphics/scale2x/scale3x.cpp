@@ -28,30 +28,237 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 #include "nomlib/graphics/scale2x/scale2x.hpp"
 
+#if defined(NOM_SCALEX_USE_SSE2)
+  #include <emmintrin.h>
+#endif
+
 namespace nom {
   namespace priv {
 
+namespace {
+
+/// \brief Pixel access for each supported color depth.
+struct Pixel8
+{
+  typedef uint8 value_type;
+  static const int32 BYTES = 1;
+
+  static value_type read(const uint8* p) { return *p; }
+  static void write(uint8* p, value_type c) { *p = c; }
+};
+
+struct Pixel16
+{
+  typedef uint16 value_type;
+  static const int32 BYTES = 2;
+
+  static value_type read(const uint8* p) { return *(const uint16*)p; }
+  static void write(uint8* p, value_type c) { *(uint16*)p = c; }
+};
+
+struct Pixel24
+{
+  typedef int32 value_type;
+  static const int32 BYTES = 3;
+
+  static value_type read(const uint8* p) { return SCALE2x_READINT24(p); }
+  static void write(uint8* p, value_type c) { SCALE2x_WRITEINT24(p, c); }
+};
+
+struct Pixel32
+{
+  typedef uint32 value_type;
+  static const int32 BYTES = 4;
+
+  static value_type read(const uint8* p) { return *(const uint32*)p; }
+  static void write(uint8* p, value_type c) { *(uint32*)p = c; }
+};
+
+/// \brief Scale the source pixels [begin, end) of one row.
+///
+/// \param above The row above, clamped to the image.
+/// \param row The row being scaled.
+/// \param below The row below, clamped to the image.
+/// \param d0 The first of the three destination rows.
+template <typename Pixel>
+void scale3x_row( const uint8* above, const uint8* row, const uint8* below,
+                  uint8* d0, int32 dstpitch, int32 width,
+                  int32 begin, int32 end )
+{
+  typedef typename Pixel::value_type value_type;
+
+  const int32 bytes = Pixel::BYTES;
+  uint8* d1 = d0 + dstpitch;
+  uint8* d2 = d1 + dstpitch;
+
+  for( int32 x = begin; x < end; ++x ) {
+
+    int32 left = std::max(0, x - 1) * bytes;
+    int32 center = x * bytes;
+    int32 right = std::min(width - 1, x + 1) * bytes;
+
+    value_type A = Pixel::read(above + left);
+    value_type B = Pixel::read(above + center);
+    value_type C = Pixel::read(above + right);
+    value_type D = Pixel::read(row + left);
+    value_type E = Pixel::read(row + center);
+    value_type F = Pixel::read(row + right);
+    value_type G = Pixel::read(below + left);
+    value_type H = Pixel::read(below + center);
+    value_type I = Pixel::read(below + right);
+
+    value_type E0 = E, E1 = E, E2 = E, E3 = E, E5 = E, E6 = E, E7 = E, E8 = E;
+
+    if( B != H && D != F ) {
+      E0 = D == B ? D : E;
+      E1 = (D == B && E != C) || (B == F && E != A) ? B : E;
+      E2 = B == F ? F : E;
+      E3 = (D == B && E != G) || (D == H && E != A) ? D : E;
+      E5 = (B == F && E != I) || (H == F && E != C) ? F : E;
+      E6 = D == H ? D : E;
+      E7 = (D == H && E != I) || (H == F && E != G) ? H : E;
+      E8 = H == F ? F : E;
+    }
+
+    Pixel::write(d0 + (x*3) * bytes, E0);
+    Pixel::write(d0 + (x*3+1) * bytes, E1);
+    Pixel::write(d0 + (x*3+2) * bytes, E2);
+    Pixel::write(d1 + (x*3) * bytes, E3);
+    Pixel::write(d1 + (x*3+1) * bytes, E);
+    Pixel::write(d1 + (x*3+2) * bytes, E5);
+    Pixel::write(d2 + (x*3) * bytes, E6);
+    Pixel::write(d2 + (x*3+1) * bytes, E7);
+    Pixel::write(d2 + (x*3+2) * bytes, E8);
+  }
+}
+
+template <typename Pixel>
+void scale3x_rows(  const uint8* srcpix, int32 srcpitch, uint8* dstpix,
+                    int32 dstpitch, int32 width, int32 height,
+                    int32 row_begin, int32 row_end )
+{
+  for( int32 looph = row_begin; looph < row_end; ++looph ) {
+    scale3x_row<Pixel>( srcpix + std::max(0, looph - 1) * srcpitch,
+                        srcpix + looph * srcpitch,
+                        srcpix + std::min(height - 1, looph + 1) * srcpitch,
+                        dstpix + looph * 3 * dstpitch, dstpitch, width,
+                        0, width );
+  }
+}
+
+#if defined(NOM_SCALEX_USE_SSE2)
+
+/// \brief Choose a where the mask is set, and b elsewhere.
+inline __m128i select(__m128i mask, __m128i a, __m128i b)
+{
+  return _mm_or_si128( _mm_and_si128(mask, a), _mm_andnot_si128(mask, b) );
+}
+
+/// \brief SSE2 version of scale3x_row for 32-bit pixels, for the whole row.
+///
+/// \remarks The comparisons are done four pixels at a time; the results are
+/// then spread out to their three destination columns.
+void scale3x_32_row_sse2( const uint8* above, const uint8* row,
+                          const uint8* below, uint8* d0, int32 dstpitch,
+                          int32 width )
+{
+  const uint32* a = (const uint32*)above;
+  const uint32* e = (const uint32*)row;
+  const uint32* g = (const uint32*)below;
+  uint32* out[3] = {  (uint32*)d0, (uint32*)(d0 + dstpitch),
+                      (uint32*)(d0 + dstpitch * 2) };
+
+  // The edge pixels clamp their neighbours, so leave them to the scalar code
+  int32 x = 1;
+  scale3x_row<Pixel32>( above, row, below, d0, dstpitch, width, 0,
+                        std::min(1, width) );
+
+  for( ; x + 4 < width; x += 4 ) {
+
+    __m128i A = _mm_loadu_si128( (const __m128i*)(a + x - 1) );
+    __m128i B = _mm_loadu_si128( (const __m128i*)(a + x) );
+    __m128i C = _mm_loadu_si128( (const __m128i*)(a + x + 1) );
+    __m128i D = _mm_loadu_si128( (const __m128i*)(e + x - 1) );
+    __m128i E = _mm_loadu_si128( (const __m128i*)(e + x) );
+    __m128i F = _mm_loadu_si128( (const __m128i*)(e + x + 1) );
+    __m128i G = _mm_loadu_si128( (const __m128i*)(g + x - 1) );
+    __m128i H = _mm_loadu_si128( (const __m128i*)(g + x) );
+    __m128i I = _mm_loadu_si128( (const __m128i*)(g + x + 1) );
+
+    // NOTE: _mm_andnot_si128(a, b) is (~a & b)
+    __m128i core = _mm_andnot_si128(  _mm_cmpeq_epi32(B, H),
+                                      _mm_andnot_si128( _mm_cmpeq_epi32(D, F),
+                                                        _mm_set1_epi32(-1) ) );
+
+    __m128i DB = _mm_and_si128( core, _mm_cmpeq_epi32(D, B) );
+    __m128i BF = _mm_and_si128( core, _mm_cmpeq_epi32(B, F) );
+    __m128i DH = _mm_and_si128( core, _mm_cmpeq_epi32(D, H) );
+    __m128i HF = _mm_and_si128( core, _mm_cmpeq_epi32(H, F) );
+
+    __m128i EA = _mm_cmpeq_epi32(E, A);
+    __m128i EC = _mm_cmpeq_epi32(E, C);
+    __m128i EG = _mm_cmpeq_epi32(E, G);
+    __m128i EI = _mm_cmpeq_epi32(E, I);
+
+    __m128i result[9];
+    result[0] = select(DB, D, E);
+    result[1] = select( _mm_or_si128( _mm_andnot_si128(EC, DB),
+                                      _mm_andnot_si128(EA, BF) ), B, E );
+    result[2] = select(BF, F, E);
+    result[3] = select( _mm_or_si128( _mm_andnot_si128(EG, DB),
+                                      _mm_andnot_si128(EA, DH) ), D, E );
+    result[4] = E;
+    result[5] = select( _mm_or_si128( _mm_andnot_si128(EI, BF),
+                                      _mm_andnot_si128(EC, HF) ), F, E );
+    result[6] = select(DH, D, E);
+    result[7] = select( _mm_or_si128( _mm_andnot_si128(EI, DH),
+                                      _mm_andnot_si128(EG, HF) ), H, E );
+    result[8] = select(HF, F, E);
+
+    uint32 pixels[9][4];
+    for( int32 i = 0; i != 9; ++i ) {
+      _mm_storeu_si128( (__m128i*)pixels[i], result[i] );
+    }
+
+    for( int32 p = 0; p != 4; ++p ) {
+      for( int32 r = 0; r != 3; ++r ) {
+        uint32* dst = out[r] + (x + p) * 3;
+        dst[0] = pixels[r*3][p];
+        dst[1] = pixels[r*3+1][p];
+        dst[2] = pixels[r*3+2][p];
+      }
+    }
+  }
+
+  scale3x_row<Pixel32>( above, row, below, d0, dstpitch, width, x, width );
+}
+
+void scale3x_32_rows_sse2(  const uint8* srcpix, int32 srcpitch,
+                            uint8* dstpix, int32 dstpitch, int32 width,
+                            int32 height, int32 row_begin, int32 row_end )
+{
+  for( int32 looph = row_begin; looph < row_end; ++looph ) {
+    scale3x_32_row_sse2(
+      srcpix + std::max(0, looph - 1) * srcpitch,
+      srcpix + looph * srcpitch,
+      srcpix + std::min(height - 1, looph + 1) * srcpitch,
+      dstpix + looph * 3 * dstpitch, dstpitch, width );
+  }
+}
+
+#endif // defined NOM_SCALEX_USE_SSE2
+
+} // namespace
+
 bool scale3x  ( void* source_buffer, void* destination_buffer,
                 const int32 source_width, const int32 source_height,
                 const int32 bits_per_pixel,
-                const int16 source_pitch, int16 destination_pitch
+                const int32 source_pitch, int32 destination_pitch
               )
 {
-  // Save a temporary copy of the *existing* width & height for scaling
-  // calculation.
-  //int32 width = source_width;
-  //int32 height = source_height;
-
-  // The existing video surface pitch (width) is used for scaling calculations.
-  //uint16 srcpitch = source_pitch;
-
-  // We must use the new video surface configuration for computing the pitch as
-  // this is dependent upon width & height parameters.
-  //uint16 dstpitch = destination_pitch;
-
   // Existing & resulting pixel arrays
-  //uint8* srcpix = static_cast<uint8*> ( source_buffer );
-  //uint8* dstpix = static_cast<uint8*> ( destination_buffer );
+  const uint8* srcpix = static_cast<uint8*> ( source_buffer );
+  uint8* dstpix = static_cast<uint8*> ( destination_buffer );
 
   // Use the existing video surface BPP for choosing scaling algorithm.
   switch ( bits_per_pixel )
@@ -64,30 +271,42 @@ bool scale3x  ( void* source_buffer, void* destination_buffer,
 
     case 8:
     {
-      // Not implemented
+      scale3x_rows<Pixel8>( srcpix, source_pitch, dstpix, destination_pitch,
+                            source_width, source_height, 0, source_height );
     }
     break;
 
     case 16:
     {
-      // Not implemented
+      scale3x_rows<Pixel16>(  srcpix, source_pitch, dstpix, destination_pitch,
+                              source_width, source_height, 0, source_height );
     }
     break;
 
     case 24:
     {
-      // Not implemented
+      scale3x_rows<Pixel24>(  srcpix, source_pitch, dstpix, destination_pitch,
+                              source_width, source_height, 0, source_height );
     }
     break;
 
     case 32:
     {
-      // Not implemented
+      scalex_rows_func scale = scale3x_rows<Pixel32>;
+
+      #if defined(NOM_SCALEX_USE_SSE2)
+        if( scalex_path() == SCALEX_PATH_SIMD ) {
+          scale = scale3x_32_rows_sse2;
+        }
+      #endif
+
+      scalex_scale_rows(  scale, srcpix, source_pitch, dstpix,
+                          destination_pitch, source_width, source_height );
     }
     break;
   } // end switch (bits_per_pixel)
 
-  return false;
+  return true;
 }
 
 
@@ -28,66 +28,34 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 #include "nomlib/graphics/scale2x/scale2x.hpp"
 
+// Private headers
+#include <vector>
+
 namespace nom {
   namespace priv {
 
 bool scale4x  ( void* source_buffer, void* destination_buffer,
                 const int32 source_width, const int32 source_height,
                 const int32 bits_per_pixel,
-                const int16 source_pitch, int16 destination_pitch
+                const int32 source_pitch, int32 destination_pitch
               )
 {
-  // Save a temporary copy of the *existing* width & height for scaling
-  // calculation.
-  //int32 width = source_width;
-  //int32 height = source_height;
-
-  // The existing video surface pitch (width) is used for scaling calculations.
-  //uint16 srcpitch = source_pitch;
+  // Intermediate buffer, twice the source dimensions, with rows packed
+  // tightly
+  int32 bytes_per_pixel = bits_per_pixel / 8;
+  int32 pitch = source_width * 2 * bytes_per_pixel;
 
-  // We must use the new video surface configuration for computing the pitch as
-  // this is dependent upon width & height parameters.
-  //uint16 dstpitch = destination_pitch;
+  std::vector<uint8> buffer( pitch * source_height * 2 );
 
-  // Existing & resulting pixel arrays
-  //uint8* srcpix = static_cast<uint8*> ( source_buffer );
-  //uint8* dstpix = static_cast<uint8*> ( destination_buffer );
-
-  // Use the existing video surface BPP for choosing scaling algorithm.
-  switch ( bits_per_pixel )
+  if( scale2x ( source_buffer, buffer.data(), source_width, source_height,
+                bits_per_pixel, source_pitch, pitch ) == false )
   {
-    default: // Err, we could not determine a valid color depth!
-    {
-      return false;
-    } // end unsupported color depth
-    break;
-
-    case 8:
-    {
-      // Not implemented
-    }
-    break;
-
-    case 16:
-    {
-      // Not implemented
-    }
-    break;
-
-    case 24:
-    {
-      // Not implemented
-    }
-    break;
-
-    case 32:
-    {
-      // Not implemented
-    }
-    break;
-  } // end switch (bits_per_pixel)
+    return false;
+  }
 
-  return false;
+  return scale2x  ( buffer.data(), destination_buffer, source_width * 2,
+                    source_height * 2, bits_per_pixel, pitch,
+                    destination_pitch );
 }
 
 
@@ -65,6 +65,13 @@ ObjectTypeInfo Decorator::type( void ) const
 
 void Decorator::set_bounds( const IntRect& bounds )
 {
+  // Nothing has changed; keep our rendered state
+  if( this->drawables_.updated() == true &&
+      bounds.position() == this->position() && bounds.size() == this->size() )
+  {
+    return;
+  }
+
   Transformable::set_bounds( bounds );
 
   this->invalidate();
@@ -97,6 +97,10 @@ void DecoratorFinalFantasyFrame::RenderElement(Rocket::Core::Element* element, R
   // defined in 'body.window'.
   if( size.x <= 0 || size.y <= 0 ) return;
 
+  // Draw the batched geometry underneath us first; this must happen before
+  // the decorator has the chance to render its cache
+  target->flush();
+
   // Check for whether or not we need to update our decorator
   if( this->bounds_.x != position.x || this->bounds_.y != position.y || this->bounds_.w != size.x || this->bounds_.h != size.y )
   {
@@ -134,6 +134,9 @@ void DecoratorPhotograph::RenderElement(Rocket::Core::Element* element, Rocket::
   {
     const RenderWindow* target = p->window_;
 
+    // Draw the batched geometry underneath us first
+    p->flush();
+
     this->image_.set_position( Point2i( pos.x, pos.y ) );
     // this->image_.set_position( Point2i( 0, 0 ) );
     this->image_.draw( target->renderer() );
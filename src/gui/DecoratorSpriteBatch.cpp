@@ -129,6 +129,9 @@ void DecoratorSpriteBatch::RenderElement(Rocket::Core::Element* element, Rocket:
   {
     if( this->sprite_ )
     {
+      // Draw the batched geometry underneath us first
+      target->flush();
+
       this->sprite_->set_position( Point2i(pos.x, pos.y) );
       this->sprite_->draw( *context );
     }
@@ -30,7 +30,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Private headers
 #include "nomlib/graphics/Gradient.hpp"
+#include "nomlib/graphics/RenderWindow.hpp"
+#include "nomlib/graphics/Texture.hpp"
 #include "nomlib/gui/FinalFantasyFrame.hpp"
+#include "nomlib/system/SDL_helpers.hpp"
 
 namespace nom {
 
@@ -72,26 +75,91 @@ IDrawable::raw_ptr FinalFantasyDecorator::clone( void ) const
 
 void FinalFantasyDecorator::update( void )
 {
-  Gradient::raw_ptr grad = nullptr;
-  FinalFantasyFrame::raw_ptr frame = nullptr;
-
   // Everything is already up-to-date; nothing to do...
   if( this->drawables_.updated() == true ) return;
 
+  // Build the widget style in local coordinates, so that the cache may be
+  // moved around without being rendered again
+  this->build( Point2i::zero );
+
+  if( this->update_cache() == true )
+  {
+    // Nothing left to hold on to; ::draw blits the cache
+    this->drawables_.clear();
+  }
+  else
+  {
+    // Fall back to rendering the drawables on every frame
+    this->texture_.reset();
+    this->build( this->position() );
+  }
+
+  // Dirty flag cleared; we are up-to-date
+  this->drawables_.set_updated( true );
+}
+
+void FinalFantasyDecorator::draw( const RenderTarget& target ) const
+{
+  if( this->texture_ != nullptr )
+  {
+    // The texture cache is shared by copies of this object, so it is blitted
+    // at our own position rather than at the position of the texture
+    SDL_Rect render_coords =
+      SDL_RECT( this->position(), this->texture_->size() );
+
+    SDL_RenderCopy( target.renderer(), this->texture_->texture(), nullptr,
+                    &render_coords );
+    return;
+  }
+
+  // Try to render whatever we may have cached from ::update.
+  for( auto itr = this->drawables_.begin(); itr != this->drawables_.end(); ++itr )
+  {
+    (*itr)->draw( target );
+  }
+}
+
+void FinalFantasyDecorator::set_bounds( const IntRect& bounds )
+{
+  // Moving the widget style does not change its pixels
+  if( this->drawables_.updated() == true && this->texture_ != nullptr &&
+      this->texture_->size() == bounds.size() )
+  {
+    IntRect frame_bounds = this->frame_bounds();
+
+    frame_bounds.x += bounds.x - this->position().x;
+    frame_bounds.y += bounds.y - this->position().y;
+
+    Transformable::set_bounds( bounds );
+    this->set_frame_bounds( frame_bounds );
+
+    return;
+  }
+
+  Decorator::set_bounds( bounds );
+}
+
+// Private scope
+
+void FinalFantasyDecorator::build( const Point2i& origin )
+{
+  Gradient::raw_ptr grad = nullptr;
+  FinalFantasyFrame::raw_ptr frame = nullptr;
+
   // Wipe our existing object state; we are out of date and need to rebuild
   this->drawables_.clear();
 
   grad = new Gradient();
   frame = new FinalFantasyFrame();
 
-  frame->set_position( this->position() );
+  frame->set_position( origin );
   frame->set_size( this->size() );
 
   grad->set_colors( this->g_colors_[0] );
 
   // These invalid dimensions signal our widgets to apply their dimensions
   // onto this object upon insertion into the widget tree.
-  grad->set_position( this->position() );
+  grad->set_position( origin );
   grad->set_size( this->size() );
 
   // grad->set_margins( this->margins_ );
@@ -107,20 +175,69 @@ void FinalFantasyDecorator::update( void )
   }
 
   // Set the intended unaffected rendering coordinates of the border we are
-  // using.
-  this->set_frame_bounds( frame->frame_bounds() );
+  // using, relative to our own position.
+  IntRect frame_bounds = frame->frame_bounds();
+  frame_bounds.x += this->position().x - origin.x;
+  frame_bounds.y += this->position().y - origin.y;
 
-  // Dirty flag cleared; we are up-to-date
-  this->drawables_.set_updated( true );
+  this->set_frame_bounds( frame_bounds );
 }
 
-void FinalFantasyDecorator::draw( const RenderTarget& target ) const
+bool FinalFantasyDecorator::update_cache( void )
 {
-  // Try to render whatever we may have cached from ::update.
+  if( this->size().w <= 0 || this->size().h <= 0 ) {
+    return false;
+  }
+
+  RenderWindow* context = nom::render_interface();
+  if( context == nullptr ) {
+    NOM_LOG_ERR(  NOM_LOG_CATEGORY_RENDER, "Could not update cache:",
+                  "invalid renderer." );
+    return false;
+  }
+
+  // A new texture, rather than re-initializing the existing one -- copies of
+  // this object share the texture cache
+  this->texture_.reset( new Texture() );
+
+  // Obtain the optimal pixel format for the platform
+  RendererInfo caps = context->caps();
+
+  if( this->texture_->initialize( caps.optimal_texture_format(),
+      SDL_TEXTUREACCESS_TARGET, this->size() ) == false )
+  {
+    NOM_LOG_ERR(  NOM_LOG_CATEGORY_RENDER, "Could not update cache:",
+                  "failed texture creation." );
+    return false;
+  }
+
+  this->texture_->set_blend_mode( SDL_BLENDMODE_BLEND );
+
+  if( context->set_render_target( this->texture_.get() ) == false ) {
+    NOM_LOG_ERR(  NOM_LOG_CATEGORY_RENDER, "Could not update cache:",
+                  "could not set rendering target." );
+    return false;
+  }
+
+  if( context->fill( Color4i::Transparent ) == false ) {
+    NOM_LOG_ERR(  NOM_LOG_CATEGORY_RENDER, "Could not update cache:",
+                  "failed to set the render target's color." );
+    context->reset_render_target();
+    return false;
+  }
+
   for( auto itr = this->drawables_.begin(); itr != this->drawables_.end(); ++itr )
   {
-    (*itr)->draw( target );
+    (*itr)->draw( *context );
   }
+
+  if( context->reset_render_target() == false ) {
+    NOM_LOG_ERR(  NOM_LOG_CATEGORY_RENDER, "Could not update cache:",
+                  "failed to reset the rendering target." );
+    return false;
+  }
+
+  return true;
 }
 
 } // namespace nom
@@ -31,6 +31,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // Private headers
 #include "nomlib/system/init.hpp"           // SystemColors
 #include "nomlib/system/ColorDatabase.hpp"  // ColorDatabase
+#include "nomlib/graphics/RenderWindow.hpp"
+#include "nomlib/system/SDL_helpers.hpp"
 
 namespace nom {
 
@@ -38,6 +40,8 @@ FinalFantasyFrame::FinalFantasyFrame( void )
 {
   // NOM_LOG_TRACE( NOM );
 
+  this->initialize_colors();
+
   // No need to update the object's rendered state because we do not have
   // sufficient information for rendering to occur -- position & size.
   // this->update();
@@ -56,6 +60,8 @@ FinalFantasyFrame::FinalFantasyFrame  (
 {
   // NOM_LOG_TRACE( NOM );
 
+  this->initialize_colors();
+
   this->update();
 }
 
@@ -86,63 +92,84 @@ const IntRect& FinalFantasyFrame::frame_bounds( void ) const
   return this->frame_bounds_;
 }
 
-void FinalFantasyFrame::draw( RenderTarget& target ) const
+const Color4i& FinalFantasyFrame::inner_border_color( void ) const
 {
-  Drawables::container drawables = this->drawables_.drawables();
-
-  for( auto itr = drawables.begin(); itr != drawables.end(); ++itr )
-  {
-    (*itr)->draw( target );
-  }
+  return this->inner_border_color_;
 }
 
-void FinalFantasyFrame::set_frame_bounds( const IntRect& bounds )
+const Color4i& FinalFantasyFrame::outer_border_color( void ) const
 {
-  this->frame_bounds_ = bounds;
+  return this->outer_border_color_;
 }
 
-// Private scope
-
-void FinalFantasyFrame::update( void )
+void FinalFantasyFrame::draw( RenderTarget& target ) const
 {
   // Our rendering bounds are invalid -- nothing to render!
   if( this->valid() == false ) return;
 
-  // We have already updated our window -- nothing to render!
-  if ( this->drawables_.updated() == true ) return;
-
-  // Need to always clear our data cache before updating
-  this->drawables_.clear();
+  SDL_Renderer* renderer = target.renderer();
 
   int x = this->position().x;
   int y = this->position().y;
 
-  int width = this->size().w;
-  int height = this->size().h;
+  int x_offset = x + this->size().w - 1;
+  int y_offset = y + this->size().h - 1;
 
-  int x_offset = x + width - 1;
-  int y_offset = y + height - 1;
+  // Inner border frame -- top1 & left1; the outer border frame is drawn on
+  // top of the line ends
+  const SDL_Point inner_border[3] = {
+    { x_offset, y + 1 },
+    { x + 1, y + 1 },
+    { x + 1, y_offset }
+  };
 
-  Color4i inner_border = SystemColors::colors().find_color( "FinalFantasyInnerBorder" );
-  Color4i outer_border = SystemColors::colors().find_color( "FinalFantasyOuterBorder" );
+  // Outer border frame -- top0, left0, right0 & bottom0
+  SDL_Rect outer_border = SDL_RECT( this->position(), this->size() );
+
+  const Color4i& inner = this->inner_border_color_;
+  const Color4i& outer = this->outer_border_color_;
+
+  if( SDL_SetRenderDrawColor( renderer, inner.r, inner.g, inner.b, inner.a ) != 0 ||
+      SDL_RenderDrawLines( renderer, inner_border, 3 ) != 0 )
+  {
+    NOM_LOG_ERR( NOM, SDL_GetError() );
+    return;
+  }
 
-  // Outer border frame -- top0
-  this->drawables_.push_back( new Line( IntRect( x, y, x_offset, y), outer_border ) );
+  if( SDL_SetRenderDrawColor( renderer, outer.r, outer.g, outer.b, outer.a ) != 0 ||
+      SDL_RenderDrawRect( renderer, &outer_border ) != 0 )
+  {
+    NOM_LOG_ERR( NOM, SDL_GetError() );
+    return;
+  }
+}
 
-  // Inner border frame -- top1
-  this->drawables_.push_back( new Line( IntRect( x, y + 1, x_offset, y + 1), inner_border ) );
+void FinalFantasyFrame::set_frame_bounds( const IntRect& bounds )
+{
+  this->frame_bounds_ = bounds;
+}
 
-  // Outer border frame -- left0
-  this->drawables_.push_back( new Line( IntRect( x, y + 1, x, y_offset), outer_border ) );
+void FinalFantasyFrame::set_border_colors( const Color4i& inner,
+                                           const Color4i& outer )
+{
+  this->inner_border_color_ = inner;
+  this->outer_border_color_ = outer;
+}
 
-  // Inner border frame -- left1
-  this->drawables_.push_back( new Line( IntRect( x + 1, y + 2, x + 1, y_offset), inner_border ) );
+// Private scope
 
-  // Outer border frame -- right0
-  this->drawables_.push_back( new Line( IntRect( x_offset, y, x_offset, y_offset), outer_border ) );
+void FinalFantasyFrame::initialize_colors( void )
+{
+  this->inner_border_color_ =
+    SystemColors::colors().find_color( "FinalFantasyInnerBorder" );
+  this->outer_border_color_ =
+    SystemColors::colors().find_color( "FinalFantasyOuterBorder" );
+}
 
-  // Outer border frame -- bottom0
-  this->drawables_.push_back( new Line( IntRect( x, y_offset, x_offset, y_offset), outer_border ) );
+void FinalFantasyFrame::update( void )
+{
+  // Our rendering bounds are invalid -- nothing to render!
+  if( this->valid() == false ) return;
 
   // Calculate our border boundary; this is a convenience to other interfaces
   // that have to deal with such visual details, such as nom::UIWidget and
@@ -157,8 +184,6 @@ void FinalFantasyFrame::update( void )
   frame_size.h = this->size().h - 3;
 
   this->set_frame_bounds( IntRect( frame_pos, frame_size ) );
-
-  this->drawables_.set_updated( true );
 }
 
 } // namespace nom
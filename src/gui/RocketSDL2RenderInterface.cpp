@@ -44,8 +44,76 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nomlib/graphics/Image.hpp"
 #include "nomlib/graphics/Texture.hpp"
 
+#include <algorithm>
+#include <vector>
+
 namespace nom {
 
+namespace priv {
+
+/// \brief Geometry retained for libRocket between frames.
+///
+/// \see RocketSDL2RenderInterface::CompileGeometry
+struct RocketCompiledGeometry
+{
+  std::vector<Rocket::Core::Vertex> vertices;
+  std::vector<int> indices;
+  Rocket::Core::TextureHandle texture = 0;
+};
+
+/// \brief The number of batches that geometry may be moved past to join a
+/// batch of its texture.
+const nom::size_type MAX_BATCH_SEARCH = 16;
+
+/// \brief Draw indexed triangles with a texture.
+///
+/// \remarks The vertex and color arrays must be enabled.
+void draw_elements( const Rocket::Core::Vertex* vertices, const int* indices,
+                    int num_indices, Rocket::Core::TextureHandle texture_handle )
+{
+  SDL_Texture* sdl_texture = NULL;
+  float texw = 1.0f;
+  float texh = 1.0f;
+
+  auto nom_texture = (nom::Texture*)texture_handle;
+  if( nom_texture != nullptr ) {
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    sdl_texture = (SDL_Texture*) nom_texture->texture();
+    SDL_GL_BindTexture(sdl_texture, &texw, &texh);
+
+    // SDL may back the texture with a larger (or rectangle) GL texture, in
+    // which case the texture coordinates are rescaled to fit
+    if( texw != 1.0f || texh != 1.0f ) {
+      glMatrixMode(GL_TEXTURE);
+      glPushMatrix();
+      glLoadIdentity();
+      glScalef(texw, texh, 1);
+      glMatrixMode(GL_MODELVIEW);
+    }
+  }
+
+  const GLsizei stride = sizeof(Rocket::Core::Vertex);
+  glVertexPointer(2, GL_FLOAT, stride, &vertices[0].position);
+  glColorPointer(4, GL_UNSIGNED_BYTE, stride, &vertices[0].colour);
+  glTexCoordPointer(2, GL_FLOAT, stride, &vertices[0].tex_coord);
+
+  glDrawElements(GL_TRIANGLES, num_indices, GL_UNSIGNED_INT, indices);
+
+  if( sdl_texture != nullptr ) {
+
+    if( texw != 1.0f || texh != 1.0f ) {
+      glMatrixMode(GL_TEXTURE);
+      glPopMatrix();
+      glMatrixMode(GL_MODELVIEW);
+    }
+
+    SDL_GL_UnbindTexture(sdl_texture);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+  }
+}
+
+} // namespace priv
+
 priv::glUseProgramObjectARB_func RocketSDL2RenderInterface::ctx_ = nullptr;
 
 // static
@@ -134,69 +202,229 @@ RenderGeometry( Rocket::Core::Vertex* vertices, int num_vertices, int* indices,
                 int num_indices, Rocket::Core::TextureHandle texture_handle,
                 const Rocket::Core::Vector2f& translation )
 {
-  SDL_Texture* sdl_texture = NULL;
+  if( this->batching_ == true ) {
+    this->batch_geometry( vertices, num_vertices, indices, num_indices,
+                          texture_handle, translation );
+  } else {
+    this->render_geometry(  vertices, indices, num_indices, texture_handle,
+                            translation );
+  }
+}
 
-  // Support for independent resolution scale -- SDL2 logical viewport -- we
-  // translate positioning coordinates in respect to the current scale
-  Point2f scale;
-  SDL_RenderGetScale( this->window_->renderer(), &scale.x, &scale.y );
+Rocket::Core::CompiledGeometryHandle RocketSDL2RenderInterface::
+CompileGeometry(  Rocket::Core::Vertex* vertices, int num_vertices,
+                  int* indices, int num_indices,
+                  Rocket::Core::TextureHandle texture_handle )
+{
+  auto geometry = new priv::RocketCompiledGeometry();
+  NOM_ASSERT(geometry != nullptr);
 
-  // SDL uses shaders that we need to disable here
-  if( RocketSDL2RenderInterface::ctx_ ) {
-    RocketSDL2RenderInterface::ctx_(0); // glUseProgramObjectARB(0);
+  geometry->vertices.assign(vertices, vertices + num_vertices);
+  geometry->indices.assign(indices, indices + num_indices);
+  geometry->texture = texture_handle;
+
+  // ::ReleaseCompiledGeometry is responsible for freeing this pointer now
+  return( (Rocket::Core::CompiledGeometryHandle) geometry );
+}
+
+void RocketSDL2RenderInterface::
+RenderCompiledGeometry( Rocket::Core::CompiledGeometryHandle geometry,
+                        const Rocket::Core::Vector2f& translation )
+{
+  auto compiled = (priv::RocketCompiledGeometry*) geometry;
+  if( compiled == nullptr || compiled->indices.empty() == true ) {
+    return;
+  }
+
+  if( this->batching_ == true ) {
+    this->batch_geometry( compiled->vertices.data(), compiled->vertices.size(),
+                          compiled->indices.data(), compiled->indices.size(),
+                          compiled->texture, translation );
+  } else {
+    this->render_geometry(  compiled->vertices.data(),
+                            compiled->indices.data(), compiled->indices.size(),
+                            compiled->texture, translation );
+  }
+}
+
+void RocketSDL2RenderInterface::
+ReleaseCompiledGeometry(Rocket::Core::CompiledGeometryHandle geometry)
+{
+  auto compiled = (priv::RocketCompiledGeometry*) geometry;
+  if( compiled != nullptr ) {
+    NOM_DELETE_PTR(compiled);
+  }
+}
+
+void RocketSDL2RenderInterface::begin_batch()
+{
+  this->batching_ = true;
+}
+
+void RocketSDL2RenderInterface::flush()
+{
+  this->draw_batches();
+
+  if( this->state_applied_ == true ) {
+    this->restore_state();
   }
+}
+
+void RocketSDL2RenderInterface::end_batch()
+{
+  this->flush();
+  this->batching_ = false;
+}
+
+void RocketSDL2RenderInterface::
+render_geometry(  const Rocket::Core::Vertex* vertices, const int* indices,
+                  int num_indices, Rocket::Core::TextureHandle texture_handle,
+                  const Rocket::Core::Vector2f& translation )
+{
+  this->apply_state();
 
   glPushMatrix();
+  glTranslatef(translation.x, translation.y, 0);
 
-  glTranslatef(translation.x * scale.x, translation.y * scale.y, 0);
+  priv::draw_elements(vertices, indices, num_indices, texture_handle);
 
-  std::vector<Rocket::Core::Vector2f> Positions(num_vertices);
-  std::vector<Rocket::Core::Colourb> Colors(num_vertices);
-  std::vector<Rocket::Core::Vector2f> TexCoords(num_vertices);
-  float texw, texh;
+  glPopMatrix();
 
-  auto nom_texture = (nom::Texture*)texture_handle;
-  if( nom_texture != nullptr ) {
-    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-    sdl_texture = (SDL_Texture*) nom_texture->texture();
-    SDL_GL_BindTexture(sdl_texture, &texw, &texh);
+  this->restore_state();
+}
+
+void RocketSDL2RenderInterface::
+batch_geometry( const Rocket::Core::Vertex* vertices, int num_vertices,
+                const int* indices, int num_indices,
+                Rocket::Core::TextureHandle texture_handle,
+                const Rocket::Core::Vector2f& translation )
+{
+  if( num_vertices < 1 || num_indices < 1 ) {
+    return;
   }
 
-  for( int i = 0; i < num_vertices; i++ )
-  {
-    Positions[i].x = vertices[i].position.x * scale.x;
-    Positions[i].y = vertices[i].position.y * scale.y;
-    Colors[i] = vertices[i].colour;
-
-    if( sdl_texture != nullptr ) {
-      TexCoords[i].x = vertices[i].tex_coord.x * texw;
-      TexCoords[i].y = vertices[i].tex_coord.y * texh;
-    } else {
-      TexCoords[i] = vertices[i].tex_coord;
+  // Translate the vertices up front, so that the batch is drawn at once
+  const int base_vertex = this->batch_vertices_.size();
+  Rocket::Core::Vector2f min = vertices[0].position + translation;
+  Rocket::Core::Vector2f max = min;
+
+  for( int i = 0; i != num_vertices; ++i ) {
+    Rocket::Core::Vertex vertex = vertices[i];
+    vertex.position += translation;
+
+    min.x = std::min(min.x, vertex.position.x);
+    min.y = std::min(min.y, vertex.position.y);
+    max.x = std::max(max.x, vertex.position.x);
+    max.y = std::max(max.y, vertex.position.y);
+
+    this->batch_vertices_.push_back(vertex);
+  }
+
+  // Look for an earlier batch of this texture that the geometry can be moved
+  // to; it cannot be moved past anything that it overlaps
+  nom::size_type batch_index = this->num_batches_;
+  nom::size_type num_searched = 0;
+  for( nom::size_type i = this->num_batches_; i != 0; --i ) {
+    const GeometryBatch& batch = this->batches_[i - 1];
+
+    if( batch.texture == texture_handle ) {
+      batch_index = i - 1;
+      break;
     }
+
+    if( min.x < batch.max.x && batch.min.x < max.x &&
+        min.y < batch.max.y && batch.min.y < max.y )
+    {
+      break;
+    }
+
+    if( ++num_searched == priv::MAX_BATCH_SEARCH ) {
+      break;
+    }
+  }
+
+  if( batch_index == this->num_batches_ ) {
+
+    if( this->num_batches_ == this->batches_.size() ) {
+      this->batches_.emplace_back();
+    }
+    ++this->num_batches_;
+
+    GeometryBatch& batch = this->batches_[batch_index];
+    batch.texture = texture_handle;
+    batch.indices.clear();
+    batch.min = min;
+    batch.max = max;
+  }
+
+  GeometryBatch& batch = this->batches_[batch_index];
+  batch.min.x = std::min(batch.min.x, min.x);
+  batch.min.y = std::min(batch.min.y, min.y);
+  batch.max.x = std::max(batch.max.x, max.x);
+  batch.max.y = std::max(batch.max.y, max.y);
+
+  for( int i = 0; i != num_indices; ++i ) {
+    batch.indices.push_back(base_vertex + indices[i]);
+  }
+}
+
+void RocketSDL2RenderInterface::draw_batches()
+{
+  if( this->num_batches_ == 0 ) {
+    return;
   }
 
+  if( this->state_applied_ == false ) {
+    this->apply_state();
+  }
+
+  for( nom::size_type i = 0; i != this->num_batches_; ++i ) {
+    const GeometryBatch& batch = this->batches_[i];
+
+    priv::draw_elements(  this->batch_vertices_.data(), batch.indices.data(),
+                          batch.indices.size(), batch.texture );
+  }
+
+  this->batch_vertices_.clear();
+  this->num_batches_ = 0;
+}
+
+void RocketSDL2RenderInterface::apply_state()
+{
+  // Support for independent resolution scale -- SDL2 logical viewport -- we
+  // translate positioning coordinates in respect to the current scale
+  Point2f scale;
+  SDL_RenderGetScale( this->window_->renderer(), &scale.x, &scale.y );
+
+  // SDL uses shaders that we need to disable here
+  if( RocketSDL2RenderInterface::ctx_ ) {
+    RocketSDL2RenderInterface::ctx_(0); // glUseProgramObjectARB(0);
+  }
+
+  glMatrixMode(GL_MODELVIEW);
+  glPushMatrix();
+  glScalef(scale.x, scale.y, 1);
+
   glEnableClientState(GL_VERTEX_ARRAY);
   glEnableClientState(GL_COLOR_ARRAY);
-  glVertexPointer(2, GL_FLOAT, 0, &Positions[0]);
-  glColorPointer(4, GL_UNSIGNED_BYTE, 0, &Colors[0]);
-  glTexCoordPointer(2, GL_FLOAT, 0, &TexCoords[0]);
 
   glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
   glEnable(GL_BLEND);
   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-  glDrawElements(GL_TRIANGLES, num_indices, GL_UNSIGNED_INT, indices);
+
+  this->state_applied_ = true;
+}
+
+void RocketSDL2RenderInterface::restore_state()
+{
   glDisableClientState(GL_VERTEX_ARRAY);
   glDisableClientState(GL_COLOR_ARRAY);
 
-  if( sdl_texture != nullptr ) {
-    SDL_GL_UnbindTexture(sdl_texture);
-    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-  }
-
   glColor4f(1.0, 1.0, 1.0, 1.0);
   glPopMatrix();
 
+  this->state_applied_ = false;
+
   /* Reset blending and draw a fake point just outside the screen to let SDL know that it needs to reset its state in case it wants to render a texture */
   glDisable(GL_BLEND);
   SDL_SetRenderDrawBlendMode(this->window_->renderer(), SDL_BLENDMODE_NONE);
@@ -216,6 +444,9 @@ RenderGeometry( Rocket::Core::Vertex* vertices, int num_vertices, int* indices,
 
 void RocketSDL2RenderInterface::EnableScissorRegion(bool enable)
 {
+  // The batched geometry was clipped by the previous region
+  this->draw_batches();
+
   if(enable)
   {
     glEnable(GL_SCISSOR_TEST);
@@ -228,6 +459,8 @@ void RocketSDL2RenderInterface::EnableScissorRegion(bool enable)
 
 void RocketSDL2RenderInterface::SetScissorRegion(int x, int y, int width, int height)
 {
+  this->draw_batches();
+
   // Size2i window = this->window_->size();
   // glScissor(x, window.w - (y + height), width, height);
 
@@ -378,6 +611,9 @@ bool RocketSDL2RenderInterface::GenerateTexture(Rocket::Core::TextureHandle& tex
 void RocketSDL2RenderInterface::
 ReleaseTexture(Rocket::Core::TextureHandle texture_handle)
 {
+  // The batched geometry may still refer to the texture
+  this->draw_batches();
+
   auto texture = (nom::Texture*)texture_handle;
   if( texture != nullptr ) {
     NOM_DELETE_PTR(texture);
@@ -467,7 +467,21 @@ void UIContext::draw()
 {
   if( this->context_ )
   {
+    nom::RocketSDL2RenderInterface* target =
+      NOM_DYN_PTR_CAST( nom::RocketSDL2RenderInterface*,
+                        Rocket::Core::GetRenderInterface() );
+
+    // Batch the geometry of the whole context, so that the renderer state is
+    // set up and restored once rather than for every element
+    if( target != nullptr ) {
+      target->begin_batch();
+    }
+
     this->context_->Render();
+
+    if( target != nullptr ) {
+      target->end_batch();
+    }
   }
 }
 
@@ -0,0 +1,358 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include "nomlib/ptree/Object.hpp"
+
+// Private headers
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "nomlib/ptree/Value.hpp"
+
+namespace nom {
+
+namespace priv {
+
+/// \brief Hash a member key by its interned address.
+///
+/// \remarks Equal keys share the same address; see nom::VString.
+uint32 hash_member_key(const VString& key)
+{
+  uint64 addr = reinterpret_cast<uintptr_t>( key.c_str() );
+
+  // Fibonacci hashing; the high bits are mixed from every bit of the address
+  return static_cast<uint32>( (addr * 11400714819323198485ull) >> 32 );
+}
+
+bool equal_member_keys(const VString& lhs, const VString& rhs)
+{
+  return( lhs.c_str() == rhs.c_str() );
+}
+
+bool member_key_less( const Object::value_type* lhs,
+                      const Object::value_type* rhs )
+{
+  return( std::strcmp( lhs->first.c_str(), rhs->first.c_str() ) < 0 );
+}
+
+} // namespace priv
+
+Object::Object()
+{
+  // NOM_LOG_TRACE(NOM);
+}
+
+Object::~Object()
+{
+  // NOM_LOG_TRACE(NOM);
+}
+
+Object::Object(const self_type& rhs) :
+  members_(rhs.members_),
+  index_(rhs.index_)
+{
+  // NOM_LOG_TRACE(NOM);
+}
+
+Object::self_type& Object::operator =(const self_type& rhs)
+{
+  this->members_ = rhs.members_;
+  this->index_ = rhs.index_;
+
+  return *this;
+}
+
+Object::Object(self_type&& rhs) :
+  members_( std::move(rhs.members_) ),
+  index_( std::move(rhs.index_) )
+{
+  // NOM_LOG_TRACE(NOM);
+}
+
+Object::self_type& Object::operator =(self_type&& rhs)
+{
+  this->members_ = std::move(rhs.members_);
+  this->index_ = std::move(rhs.index_);
+
+  return *this;
+}
+
+Object::iterator Object::begin()
+{
+  return this->members_.begin();
+}
+
+Object::iterator Object::end()
+{
+  return this->members_.end();
+}
+
+Object::const_iterator Object::begin() const
+{
+  return this->members_.begin();
+}
+
+Object::const_iterator Object::end() const
+{
+  return this->members_.end();
+}
+
+Object::size_type Object::size() const
+{
+  return this->members_.size();
+}
+
+bool Object::empty() const
+{
+  return this->members_.empty();
+}
+
+void Object::clear()
+{
+  this->members_.clear();
+  this->index_.clear();
+}
+
+void Object::reserve(size_type num_members)
+{
+  this->members_.reserve(num_members);
+}
+
+Object::iterator Object::find(const VString& key)
+{
+  size_type pos = this->position(key);
+
+  if( pos == npos ) {
+    return this->members_.end();
+  }
+
+  return this->members_.begin() + pos;
+}
+
+Object::const_iterator Object::find(const VString& key) const
+{
+  size_type pos = this->position(key);
+
+  if( pos == npos ) {
+    return this->members_.end();
+  }
+
+  return this->members_.begin() + pos;
+}
+
+Value& Object::operator[](const VString& key)
+{
+  size_type pos = this->position(key);
+
+  if( pos != npos ) {
+    return this->members_[pos].second;
+  }
+
+  this->members_.emplace_back( key, Value::null );
+  this->index_member( this->members_.size() - 1 );
+
+  return this->members_.back().second;
+}
+
+std::pair<Object::iterator, bool> Object::insert(const value_type& member)
+{
+  size_type pos = this->position(member.first);
+
+  if( pos != npos ) {
+    return std::make_pair(this->members_.begin() + pos, false);
+  }
+
+  this->members_.push_back(member);
+  this->index_member( this->members_.size() - 1 );
+
+  return std::make_pair(this->members_.end() - 1, true);
+}
+
+std::pair<Object::iterator, bool> Object::insert(value_type&& member)
+{
+  size_type pos = this->position(member.first);
+
+  if( pos != npos ) {
+    return std::make_pair(this->members_.begin() + pos, false);
+  }
+
+  this->members_.push_back( std::move(member) );
+  this->index_member( this->members_.size() - 1 );
+
+  return std::make_pair(this->members_.end() - 1, true);
+}
+
+Object::iterator Object::erase(iterator pos)
+{
+  size_type offset = pos - this->members_.begin();
+
+  this->members_.erase(pos);
+
+  // Every member that followed has moved down by one position
+  this->rebuild_index();
+
+  return this->members_.begin() + offset;
+}
+
+bool Object::operator ==(const self_type& rhs) const
+{
+  if( this->size() != rhs.size() ) {
+    return false;
+  }
+
+  for( auto itr = this->members_.begin(); itr != this->members_.end(); ++itr ) {
+
+    auto res = rhs.find(itr->first);
+    if( res == rhs.end() || !( res->second == itr->second ) ) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool Object::operator !=(const self_type& rhs) const
+{
+  return !(*this == rhs);
+}
+
+bool Object::operator <(const self_type& rhs) const
+{
+  std::vector<const value_type*> lhs_members;
+  std::vector<const value_type*> rhs_members;
+
+  lhs_members.reserve( this->size() );
+  rhs_members.reserve( rhs.size() );
+
+  for( auto itr = this->members_.begin(); itr != this->members_.end(); ++itr ) {
+    lhs_members.push_back( &(*itr) );
+  }
+
+  for( auto itr = rhs.members_.begin(); itr != rhs.members_.end(); ++itr ) {
+    rhs_members.push_back( &(*itr) );
+  }
+
+  std::sort(lhs_members.begin(), lhs_members.end(), priv::member_key_less);
+  std::sort(rhs_members.begin(), rhs_members.end(), priv::member_key_less);
+
+  return std::lexicographical_compare(
+    lhs_members.begin(), lhs_members.end(),
+    rhs_members.begin(), rhs_members.end(),
+    [](const value_type* lhs, const value_type* rhs) {
+      if( priv::member_key_less(lhs, rhs) ) {
+        return true;
+      } else if( priv::member_key_less(rhs, lhs) ) {
+        return false;
+      }
+
+      return( lhs->second < rhs->second );
+    }
+  );
+}
+
+Object::size_type Object::position(const VString& key) const
+{
+  if( this->index_.empty() == true ) {
+
+    for( size_type pos = 0; pos != this->members_.size(); ++pos ) {
+      if( priv::equal_member_keys(this->members_[pos].first, key) ) {
+        return pos;
+      }
+    }
+
+    return npos;
+  }
+
+  const uint32 mask = this->index_.size() - 1;
+  uint32 slot = priv::hash_member_key(key) & mask;
+
+  while( this->index_[slot] != 0 ) {
+
+    size_type pos = this->index_[slot] - 1;
+    if( priv::equal_member_keys(this->members_[pos].first, key) ) {
+      return pos;
+    }
+
+    slot = (slot + 1) & mask;
+  }
+
+  return npos;
+}
+
+void Object::index_member(size_type pos)
+{
+  if( this->members_.size() <= INDEX_THRESHOLD ) {
+    return;
+  }
+
+  // Keep the table at most half full
+  if( this->members_.size() * 2 > this->index_.size() ) {
+    this->rebuild_index();
+    return;
+  }
+
+  const uint32 mask = this->index_.size() - 1;
+  uint32 slot = priv::hash_member_key(this->members_[pos].first) & mask;
+
+  while( this->index_[slot] != 0 ) {
+    slot = (slot + 1) & mask;
+  }
+
+  this->index_[slot] = pos + 1;
+}
+
+void Object::rebuild_index()
+{
+  this->index_.clear();
+
+  if( this->members_.size() <= INDEX_THRESHOLD ) {
+    return;
+  }
+
+  size_type num_slots = 16;
+  while( num_slots < this->members_.size() * 4 ) {
+    num_slots *= 2;
+  }
+
+  this->index_.resize(num_slots, 0);
+
+  const uint32 mask = num_slots - 1;
+  for( size_type pos = 0; pos != this->members_.size(); ++pos ) {
+
+    uint32 slot = priv::hash_member_key(this->members_[pos].first) & mask;
+
+    while( this->index_[slot] != 0 ) {
+      slot = (slot + 1) & mask;
+    }
+
+    this->index_[slot] = pos + 1;
+  }
+}
+
+} // namespace nom
@@ -28,82 +28,324 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 #include "nomlib/ptree/VString.hpp"
 
-#include "nomlib/core/helpers.hpp"
+// Private headers
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace nom {
 
-VString::VString()
+namespace priv {
+
+/// \brief The key shared by every empty member key and array index.
+const char EMPTY_KEY[] = "";
+
+/// \brief The key of lookups for strings that have never been interned; it
+/// matches no member.
+const char MISSING_KEY[] = "";
+
+/// \brief The process-wide storage for interned member keys.
+///
+/// \remarks An open-addressing hash table of pointers into a block allocated
+/// arena. Nothing is ever removed, so the stored pointers stay valid for the
+/// lifetime of the program.
+class KeyPool
+{
+  public:
+    KeyPool() :
+      size_(0),
+      block_pos_(nullptr),
+      block_remaining_(0)
+    {
+      this->slots_.resize(MIN_SLOTS);
+    }
+
+    /// \brief Get the interned copy of a key, storing it when it is new.
+    const char* intern(const char* key, nom::size_type length)
+    {
+      uint32 hash = KeyPool::hash(key, length);
+
+      std::lock_guard<std::mutex> lock(this->mutex_);
+
+      nom::size_type mask = this->slots_.size() - 1;
+      nom::size_type pos = hash & mask;
+      while( this->slots_[pos].key != nullptr ) {
+
+        const Slot& slot = this->slots_[pos];
+        if( slot.hash == hash && slot.length == length &&
+            std::memcmp(slot.key, key, length) == 0 )
+        {
+          return slot.key;
+        }
+
+        pos = (pos + 1) & mask;
+      }
+
+      Slot& slot = this->slots_[pos];
+      slot.key = this->store(key, length);
+      slot.length = length;
+      slot.hash = hash;
+      ++this->size_;
+
+      // Keep the load factor at or below one half
+      if( this->size_ * 2 > this->slots_.size() ) {
+        this->grow();
+      }
+
+      return slot.key;
+    }
+
+    /// \brief Get the interned copy of a key without storing it.
+    ///
+    /// \returns NULL when the key has never been interned.
+    const char* find(const char* key, nom::size_type length)
+    {
+      uint32 hash = KeyPool::hash(key, length);
+
+      std::lock_guard<std::mutex> lock(this->mutex_);
+
+      nom::size_type mask = this->slots_.size() - 1;
+      nom::size_type pos = hash & mask;
+      while( this->slots_[pos].key != nullptr ) {
+
+        const Slot& slot = this->slots_[pos];
+        if( slot.hash == hash && slot.length == length &&
+            std::memcmp(slot.key, key, length) == 0 )
+        {
+          return slot.key;
+        }
+
+        pos = (pos + 1) & mask;
+      }
+
+      return nullptr;
+    }
+
+  private:
+    static const nom::size_type MIN_SLOTS = 256;
+    static const nom::size_type BLOCK_SIZE = 4096;
+
+    struct Slot
+    {
+      Slot() :
+        key(nullptr),
+        length(0),
+        hash(0)
+      {
+      }
+
+      const char* key;
+      nom::size_type length;
+      uint32 hash;
+    };
+
+    /// \brief FNV-1a hash of a key.
+    static uint32 hash(const char* key, nom::size_type length)
+    {
+      uint32 hash = 2166136261u;
+
+      for( nom::size_type idx = 0; idx != length; ++idx ) {
+        hash ^= static_cast<uint8>(key[idx]);
+        hash *= 16777619u;
+      }
+
+      return hash;
+    }
+
+    /// \brief Copy a key, with its null terminator, into the arena.
+    const char* store(const char* key, nom::size_type length)
+    {
+      nom::size_type bytes = length + 1;
+      char* dest = nullptr;
+
+      if( bytes > BLOCK_SIZE / 4 ) {
+        // Oversized keys get their own block, so that the current block is
+        // not abandoned half-used
+        this->blocks_.emplace_back( new char[bytes] );
+        dest = this->blocks_.back().get();
+      } else {
+        if( bytes > this->block_remaining_ ) {
+          this->blocks_.emplace_back( new char[BLOCK_SIZE] );
+          this->block_pos_ = this->blocks_.back().get();
+          this->block_remaining_ = BLOCK_SIZE;
+        }
+
+        dest = this->block_pos_;
+        this->block_pos_ += bytes;
+        this->block_remaining_ -= bytes;
+      }
+
+      std::memcpy(dest, key, length);
+      dest[length] = '\0';
+
+      return dest;
+    }
+
+    void grow()
+    {
+      std::vector<Slot> slots( this->slots_.size() * 2 );
+      nom::size_type mask = slots.size() - 1;
+
+      for( auto itr = this->slots_.begin(); itr != this->slots_.end(); ++itr ) {
+
+        if( itr->key == nullptr ) {
+          continue;
+        }
+
+        nom::size_type pos = itr->hash & mask;
+        while( slots[pos].key != nullptr ) {
+          pos = (pos + 1) & mask;
+        }
+
+        slots[pos] = *itr;
+      }
+
+      this->slots_.swap(slots);
+    }
+
+    std::mutex mutex_;
+    std::vector<Slot> slots_;
+    nom::size_type size_;
+
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* block_pos_;
+    nom::size_type block_remaining_;
+};
+
+/// \remarks The pool is intentionally never destroyed; member keys may
+/// outlive static destruction order.
+KeyPool& key_pool()
+{
+  static KeyPool* pool = new KeyPool();
+
+  return *pool;
+}
+
+/// \brief Get the interned copy of a key, interning the key when it is new.
+const char* intern_key(const char* key, nom::size_type length)
 {
-  NOM_LOG_TRACE_PRIO(NOM_LOG_CATEGORY_TRACE, NOM_LOG_PRIORITY_VERBOSE);
+  if( length == 0 ) {
+    return EMPTY_KEY;
+  }
+
+  return key_pool().intern(key, length);
+}
+
+/// \brief Get the interned copy of a key, without interning the key.
+///
+/// \returns MISSING_KEY when the key has never been interned.
+const char* find_interned_key(const char* key, nom::size_type length)
+{
+  if( length == 0 ) {
+    return EMPTY_KEY;
+  }
+
+  const char* interned = key_pool().find(key, length);
+  if( interned == nullptr ) {
+    return MISSING_KEY;
+  }
 
-  this->index_ = 0;
+  return interned;
+}
+
+} // namespace priv
+
+VString::VString() :
+  key_(priv::EMPTY_KEY),
+  index_(0)
+{
+  NOM_PTREE_TRACE();
 }
 
 VString::~VString()
 {
-  NOM_LOG_TRACE_PRIO(NOM_LOG_CATEGORY_TRACE, NOM_LOG_PRIORITY_VERBOSE);
+  NOM_PTREE_TRACE();
 }
 
-VString::VString(const char* key)
+VString::VString(const char* key) :
+  key_( priv::intern_key( key, std::strlen(key) ) ),
+  index_(0)
 {
-  NOM_LOG_TRACE_PRIO(NOM_LOG_CATEGORY_TRACE, NOM_LOG_PRIORITY_VERBOSE);
+  NOM_PTREE_TRACE();
+}
 
-  this->cstr_ = std::string(key);
-  this->index_ = 0;
+VString::VString(const std::string& key) :
+  key_( priv::intern_key( key.c_str(), key.size() ) ),
+  index_(0)
+{
+  NOM_PTREE_TRACE();
 }
 
-VString::VString(const std::string& key)
+// Static
+VString VString::find(const char* key)
 {
-  NOM_LOG_TRACE_PRIO(NOM_LOG_CATEGORY_TRACE, NOM_LOG_PRIORITY_VERBOSE);
+  VString result;
+  result.key_ = priv::find_interned_key( key, std::strlen(key) );
 
-  this->cstr_ = key;
-  this->index_ = 0;
+  return result;
 }
 
-VString::VString(ArrayIndex index)
+// Static
+VString VString::find(const std::string& key)
 {
-  NOM_LOG_TRACE_PRIO(NOM_LOG_CATEGORY_TRACE, NOM_LOG_PRIORITY_VERBOSE);
+  VString result;
+  result.key_ = priv::find_interned_key( key.c_str(), key.size() );
 
-  this->index_ = index;
+  return result;
 }
 
-VString::VString(const self_type& rhs)
+VString::VString(ArrayIndex index) :
+  key_(priv::EMPTY_KEY),
+  index_(index)
 {
-  NOM_LOG_TRACE_PRIO(NOM_LOG_CATEGORY_TRACE, NOM_LOG_PRIORITY_VERBOSE);
+  NOM_PTREE_TRACE();
+}
 
-  this->cstr_ = rhs.cstr_;
-  this->index_ = rhs.index_;
+VString::VString(const self_type& rhs) :
+  key_(rhs.key_),
+  index_(rhs.index_)
+{
+  NOM_PTREE_TRACE();
 }
 
 VString::self_type& VString::operator =(const self_type& rhs)
 {
-  VString copy(rhs);
-  this->swap(copy);
+  this->key_ = rhs.key_;
+  this->index_ = rhs.index_;
 
   return *this;
 }
 
-void VString::swap(VString& rhs)
+VString::VString(self_type&& rhs) :
+  key_(rhs.key_),
+  index_(rhs.index_)
+{
+  NOM_PTREE_TRACE();
+}
+
+VString::self_type& VString::operator =(self_type&& rhs)
 {
-  std::swap(this->cstr_, rhs.cstr_);
-  std::swap(this->index_, rhs.index_);
+  this->key_ = rhs.key_;
+  this->index_ = rhs.index_;
+
+  return *this;
 }
 
-// TODO: Try to use a more efficient sorting algorithm for string comparisons?
 bool VString::operator <(const self_type& rhs) const
 {
-  if( this->cstr_ != "" && rhs.cstr_ != "" ) {
-    return( nom::compare_string_sensitive(this->cstr_, rhs.cstr_) < 0);
+  if( this->key_ != priv::EMPTY_KEY && rhs.key_ != priv::EMPTY_KEY ) {
+    return( this->key_ != rhs.key_ && std::strcmp(this->key_, rhs.key_) < 0 );
   } else {
     return(this->index_ < rhs.index_);
   }
 }
 
-// TODO: Try to use a more efficient sorting algorithm for string comparisons?
 bool VString::operator ==(const self_type& rhs) const
 {
-  if( this->cstr_ != "" && rhs.cstr_ != "" ) {
-    return( nom::compare_string_sensitive(this->cstr_, rhs.cstr_) == 0);
+  if( this->key_ == priv::MISSING_KEY || rhs.key_ == priv::MISSING_KEY ) {
+    return false;
+  } else if( this->key_ != priv::EMPTY_KEY && rhs.key_ != priv::EMPTY_KEY ) {
+    return(this->key_ == rhs.key_);
   } else {
     return(this->index_ == rhs.index_);
   }
@@ -111,12 +353,12 @@ bool VString::operator ==(const self_type& rhs) const
 
 std::string VString::string() const
 {
-  return this->cstr_;
+  return this->key_;
 }
 
 const char* VString::c_str() const
 {
-  return this->cstr_.c_str();
+  return this->key_;
 }
 
 ArrayIndex VString::index() const
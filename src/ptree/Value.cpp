@@ -30,6 +30,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Private headers
 #include "nomlib/core/helpers.hpp"
+#include <atomic>
 #include <cassert>
 
 // Forward declarations
@@ -47,38 +48,86 @@ namespace nom {
 // Static initializations
 const Value& Value::null = Value();
 
-Value::Value() :
-  type_(ValueType::Null)
+/// \brief Array or object node values, shared between copies of a
+/// nom::Value.
+///
+/// \remarks The node is copied on the first modification made through a
+/// nom::Value that shares it -- see also: Value::mutable_object.
+template <typename T>
+struct Value::SharedNode
 {
-  // NOM_LOG_TRACE(NOM);
-}
+  SharedNode() :
+    refs(1)
+  {
+  }
 
-Value::~Value()
+  SharedNode(const T& rhs) :
+    values(rhs),
+    refs(1)
+  {
+  }
+
+  SharedNode(T&& rhs) :
+    values( std::move(rhs) ),
+    refs(1)
+  {
+  }
+
+  T values;
+
+  /// \brief The number of nom::Value objects referring to this node.
+  std::atomic<uint32> refs;
+};
+
+namespace priv {
+
+/// \brief Give up one reference to a shared node, freeing it with the last.
+template <typename T>
+void release_node(T*& node)
 {
-  NOM_LOG_TRACE_PRIO(NOM_LOG_CATEGORY_TRACE, NOM_LOG_PRIORITY_VERBOSE);
+  if( --node->refs == 0 ) {
+    NOM_DELETE_PTR(node);
+  }
 
-  switch(this->type_) {
+  node = nullptr;
+}
 
-    default: /* Nothing to free for most primitive types */ break;
+/// \brief Obtain an unshared node, copying the node when it is shared.
+template <typename T>
+void detach_node(T*& node)
+{
+  NOM_ASSERT(node != nullptr);
 
-    case ValueType::String:
-    {
-      if( this->value_.string_ != nullptr ) {
-        nom::free_string(this->value_.string_);
-        this->value_.string_ = nullptr;
-      }
-    } break;
+  if( node->refs > 1 ) {
+    T* shared = node;
+    node = new T(shared->values);
 
-    case ValueType::ArrayValues:
-    case ValueType::ObjectValues:
-    {
-      NOM_DELETE_PTR(this->value_.object_);
-    } break;
+    if( --shared->refs == 0 ) {
+      // Another owner released the node while we were copying it
+      NOM_DELETE_PTR(shared);
+    }
   }
 }
 
+} // namespace priv
+
+Value::Value() :
+  type_(ValueType::Null),
+  inline_string_(false)
+{
+  // NOM_LOG_TRACE(NOM);
+}
+
+Value::~Value()
+{
+  NOM_PTREE_TRACE();
+
+  this->release();
+}
+
 Value::Value(int val) :
-  type_(ValueType::SignedInteger)
+  type_(ValueType::SignedInteger),
+  inline_string_(false)
 {
   //NOM_LOG_TRACE(NOM);
 
@@ -86,7 +135,8 @@ Value::Value(int val) :
 }
 
 Value::Value(uint val) :
-  type_(ValueType::UnsignedInteger)
+  type_(ValueType::UnsignedInteger),
+  inline_string_(false)
 {
   //NOM_LOG_TRACE(NOM);
 
@@ -94,7 +144,8 @@ Value::Value(uint val) :
 }
 
 Value::Value(real64 val) :
-  type_(ValueType::RealNumber)
+  type_(ValueType::RealNumber),
+  inline_string_(false)
 {
   //NOM_LOG_TRACE(NOM);
 
@@ -107,7 +158,7 @@ Value::Value(const char* str) :
   //NOM_LOG_TRACE(NOM);
 
   nom::size_type str_len = nom::string_length(str);
-  this->value_.string_ = nom::duplicate_string(str, str_len);
+  this->init_string(str, str_len);
 }
 
 Value::Value(const std::string& str) :
@@ -116,11 +167,12 @@ Value::Value(const std::string& str) :
   //NOM_LOG_TRACE(NOM);
 
   nom::size_type str_len = nom::string_length(str);
-  this->value_.string_ = nom::duplicate_string(str, str_len);
+  this->init_string(str.c_str(), str_len);
 }
 
 Value::Value(bool val) :
-  type_(ValueType::Boolean)
+  type_(ValueType::Boolean),
+  inline_string_(false)
 {
   //NOM_LOG_TRACE(NOM);
 
@@ -128,15 +180,44 @@ Value::Value(bool val) :
 }
 
 Value::Value(const Object& obj) :
-  type_(ValueType::ObjectValues)
+  type_(ValueType::ObjectValues),
+  inline_string_(false)
+{
+  // NOM_LOG_TRACE(NOM);
+
+  this->value_.object_ = new SharedNode<Object>(obj);
+}
+
+Value::Value(Object&& obj) :
+  type_(ValueType::ObjectValues),
+  inline_string_(false)
+{
+  // NOM_LOG_TRACE(NOM);
+
+  this->value_.object_ = new SharedNode<Object>( std::move(obj) );
+}
+
+Value::Value(const Array& arr) :
+  type_(ValueType::ArrayValues),
+  inline_string_(false)
+{
+  // NOM_LOG_TRACE(NOM);
+
+  this->value_.array_ = new SharedNode<Array>(arr);
+}
+
+Value::Value(Array&& arr) :
+  type_(ValueType::ArrayValues),
+  inline_string_(false)
 {
   // NOM_LOG_TRACE(NOM);
 
-  this->value_.object_ = new Object(obj);
+  this->value_.array_ = new SharedNode<Array>( std::move(arr) );
 }
 
 Value::Value(ValueType type) :
-  type_(type)
+  type_(type),
+  inline_string_(false)
 {
   // NOM_LOG_TRACE( NOM );
 
@@ -172,9 +253,14 @@ Value::Value(ValueType type) :
     } break;
 
     case ValueType::ArrayValues:
+    {
+      this->value_.array_ = new SharedNode<Array>();
+      NOM_ASSERT(this->value_.array_ != nullptr);
+    } break;
+
     case ValueType::ObjectValues:
     {
-      this->value_.object_ = new Object();
+      this->value_.object_ = new SharedNode<Object>();
       NOM_ASSERT(this->value_.object_ != nullptr);
     } break;
   }
@@ -185,6 +271,7 @@ Value::Value(const Value& rhs)
   // NOM_LOG_TRACE(NOM);
 
   this->type_ = rhs.type_;
+  this->inline_string_ = rhs.inline_string_;
 
   switch(this->type_)
   {
@@ -218,19 +305,30 @@ Value::Value(const Value& rhs)
 
     case ValueType::String:
     {
-      const char* rhs_string_value = rhs.value_.string_;
-      if( rhs_string_value != nullptr ) {
+      if( rhs.inline_string_ == true ) {
+        this->value_ = rhs.value_;
+      } else if( rhs.value_.string_ != nullptr ) {
+        const char* rhs_string_value = rhs.value_.string_;
         nom::size_type str_len = nom::string_length(rhs_string_value);
 
         this->value_.string_ =
           nom::duplicate_string(rhs_string_value, str_len);
+      } else {
+        this->value_.string_ = nullptr;
       }
     } break;
 
+    // Share the node until either one of us modifies it
     case ValueType::ArrayValues:
+    {
+      this->value_.array_ = rhs.value_.array_;
+      ++this->value_.array_->refs;
+    } break;
+
     case ValueType::ObjectValues:
     {
-      this->value_.object_ = new Object(*rhs.value_.object_);
+      this->value_.object_ = rhs.value_.object_;
+      ++this->value_.object_->refs;
     } break;
   } // end switch type
 }
@@ -245,15 +343,98 @@ Value::SelfType& Value::operator =(const SelfType& rhs)
   return *this;
 }
 
+Value::Value(SelfType&& rhs)
+{
+  // NOM_LOG_TRACE(NOM);
+
+  this->steal(rhs);
+}
+
+Value::SelfType& Value::operator =(SelfType&& rhs)
+{
+  if( this != &rhs ) {
+    this->release();
+    this->steal(rhs);
+  }
+
+  return *this;
+}
+
 void Value::swap(Value& rhs)
 {
   Value::ValueType temp = this->type_;
 
   this->type_ = rhs.type_;
   rhs.type_ = temp;
+  std::swap(this->inline_string_, rhs.inline_string_);
   std::swap(this->value_, rhs.value_);
 }
 
+void Value::init_string(const char* str, nom::size_type length)
+{
+  if( length < SMALL_STRING_SIZE ) {
+    this->inline_string_ = true;
+    std::memcpy(this->value_.small_string_, str, length);
+    this->value_.small_string_[length] = '\0';
+  } else {
+    this->inline_string_ = false;
+    this->value_.string_ = nom::duplicate_string(str, length);
+  }
+}
+
+void Value::release()
+{
+  switch(this->type_) {
+
+    default: /* Nothing to free for most primitive types */ break;
+
+    case ValueType::String:
+    {
+      if( this->inline_string_ == false && this->value_.string_ != nullptr ) {
+        nom::free_string(this->value_.string_);
+        this->value_.string_ = nullptr;
+      }
+    } break;
+
+    case ValueType::ArrayValues:
+    {
+      priv::release_node(this->value_.array_);
+    } break;
+
+    case ValueType::ObjectValues:
+    {
+      priv::release_node(this->value_.object_);
+    } break;
+  }
+
+  this->type_ = ValueType::Null;
+  this->inline_string_ = false;
+}
+
+void Value::steal(Value& rhs)
+{
+  this->type_ = rhs.type_;
+  this->inline_string_ = rhs.inline_string_;
+  this->value_ = rhs.value_;
+
+  rhs.type_ = ValueType::Null;
+  rhs.inline_string_ = false;
+}
+
+Object* Value::mutable_object()
+{
+  priv::detach_node(this->value_.object_);
+
+  return &this->value_.object_->values;
+}
+
+Array* Value::mutable_array()
+{
+  priv::detach_node(this->value_.array_);
+
+  return &this->value_.array_->values;
+}
+
 bool Value::operator <(const Value& rhs) const
 {
   bool comp_result = false;
@@ -293,28 +474,44 @@ bool Value::operator <(const Value& rhs) const
 
     case ValueType::String:
     {
-      if( this->value_.string_ == nullptr || rhs.value_.string_ == nullptr ) {
+      const char* lhs_str = this->get_cstring();
+      const char* rhs_str = rhs.get_cstring();
+
+      if( lhs_str == nullptr || rhs_str == nullptr ) {
 
-        if( rhs.value_.string_ != nullptr ) {
+        if( rhs_str != nullptr ) {
           comp_result = true;
         } else {
           comp_result = false;
         }
       } else {
-        comp_result =
-          nom::compare_cstr_sensitive(this->value_.string_, rhs.value_.string_) < 0;
+        comp_result = nom::compare_cstr_sensitive(lhs_str, rhs_str) < 0;
       }
     } break;
 
     case ValueType::ArrayValues:
+    {
+      const Array& lhs_arr = this->value_.array_->values;
+      const Array& rhs_arr = rhs.value_.array_->values;
+
+      int delta = lhs_arr.size() - rhs_arr.size();
+      if( delta > 0 ) {
+        comp_result = delta < 0;
+      } else {
+        comp_result = lhs_arr < rhs_arr;
+      }
+    } break;
+
     case ValueType::ObjectValues:
     {
-      int delta =
-        this->value_.object_->size() - rhs.value_.object_->size();
+      const Object& lhs_obj = this->value_.object_->values;
+      const Object& rhs_obj = rhs.value_.object_->values;
+
+      int delta = lhs_obj.size() - rhs_obj.size();
       if( delta > 0 ) {
         comp_result = delta < 0;
       } else {
-        comp_result = *this->value_.object_ < *rhs.value_.object_;
+        comp_result = lhs_obj < rhs_obj;
       }
     } break;
   } // end switch type
@@ -376,20 +573,33 @@ bool Value::operator ==(const Value& rhs) const
 
     case ValueType::String:
     {
-      if( this->value_.string_ == nullptr || rhs.value_.string_ == nullptr ) {
-        comp_result = this->value_.string_ == rhs.value_.string_;
+      const char* lhs_str = this->get_cstring();
+      const char* rhs_str = rhs.get_cstring();
+
+      if( lhs_str == nullptr || rhs_str == nullptr ) {
+        comp_result = lhs_str == rhs_str;
       } else {
-        comp_result =
-          nom::compare_cstr_sensitive(this->value_.string_, rhs.value_.string_) == 0;
+        comp_result = nom::compare_cstr_sensitive(lhs_str, rhs_str) == 0;
       }
     } break;
 
+    // Copies sharing the same node are always equal
     case ValueType::ArrayValues:
+    {
+      const Array& lhs_arr = this->value_.array_->values;
+      const Array& rhs_arr = rhs.value_.array_->values;
+
+      comp_result =
+        ( this->value_.array_ == rhs.value_.array_ ) || ( lhs_arr == rhs_arr );
+    } break;
+
     case ValueType::ObjectValues:
     {
+      const Object& lhs_obj = this->value_.object_->values;
+      const Object& rhs_obj = rhs.value_.object_->values;
+
       comp_result =
-        ( this->value_.object_->size() == rhs.value_.object_->size() ) &&
-        ( *this->value_.object_ ) == ( *rhs.value_.object_ );
+        ( this->value_.object_ == rhs.value_.object_ ) || ( lhs_obj == rhs_obj );
     } break;
   }
 
@@ -570,6 +780,11 @@ real32 Value::get_float() const
 const char* Value::get_cstring() const
 {
   if( this->string_type() ) {
+
+    if( this->inline_string_ == true ) {
+      return this->value_.small_string_;
+    }
+
     return this->value_.string_;
   }
 
@@ -579,7 +794,7 @@ const char* Value::get_cstring() const
 std::string Value::get_string() const
 {
   if( this->string_type() ) {
-    return std::string(this->value_.string_);
+    return std::string( this->get_cstring() );
   }
 
   return "\0";
@@ -598,7 +813,7 @@ bool Value::array_valid() const
 {
   if( this->array_type() )
   {
-    if( this->value_.object_ != nullptr )
+    if( this->value_.array_ != nullptr )
     {
       return true;
     }
@@ -620,22 +835,22 @@ bool Value::object_valid() const
   return false;
 }
 
-const Object Value::array() const
+const Array Value::array() const
 {
   if( this->array_valid() )
   {
-    return Object( *this->value_.object_ );
+    return Array(this->value_.array_->values);
   }
 
   // Err; not initialized..!
-  return Object();
+  return Array();
 }
 
 const Object Value::object() const
 {
   if( this->object_valid() )
   {
-    return Object( *this->value_.object_ );
+    return Object(this->value_.object_->values);
   }
 
   // Err; not initialized..!
@@ -659,10 +874,16 @@ nom::size_type Value::size() const
     } break;
 
     case ValueType::ArrayValues:
+    {
+      if( this->array_valid() == true ) {
+        result = this->value_.array_->values.size();
+      }
+    } break;
+
     case ValueType::ObjectValues:
     {
-      if( this->array_valid() == true || this->object_valid() == true ) {
-        result = this->value_.object_->size();
+      if( this->object_valid() == true ) {
+        result = this->value_.object_->values.size();
       }
     } break;
   }
@@ -681,10 +902,16 @@ bool Value::empty() const
     default: break;
 
     case ValueType::ArrayValues:
+    {
+      if( this->array_valid() == true ) {
+        result = this->value_.array_->values.empty();
+      }
+    } break;
+
     case ValueType::ObjectValues:
     {
-      if( this->array_valid() == true || this->object_valid() == true ) {
-        result = this->value_.object_->empty();
+      if( this->object_valid() == true ) {
+        result = this->value_.object_->values.empty();
       }
     } break;
   }
@@ -701,10 +928,16 @@ void Value::clear()
     default: break;
 
     case ValueType::ArrayValues:
+    {
+      if( this->array_valid() == true ) {
+        this->mutable_array()->clear();
+      }
+    } break;
+
     case ValueType::ObjectValues:
     {
-      if( this->array_valid() == true || this->object_valid() == true ) {
-        this->value_.object_->clear();
+      if( this->object_valid() == true ) {
+        this->mutable_object()->clear();
       }
     } break;
   }
@@ -719,22 +952,13 @@ Value& Value::operator[](ArrayIndex index)
     *this = Value(ValueType::ArrayValues);
   }
 
-  VString key(index);
+  Array* arr = this->mutable_array();
 
-  // Returns an iterator pointing to the first element in the container whose
-  // key is not considered to go before k -- key_type -- (i.e., either it is
-  // equivalent or goes after).
-  ObjectIterator it = this->value_.object_->lower_bound(key);
-
-  if( it != this->value_.object_->end() && (*it).first == key ) {
-    return (*it).second;
+  if( index >= arr->size() ) {
+    arr->resize(index + 1);
   }
 
-  ObjectPair default_value(key, Value::null);
-
-  it = this->value_.object_->insert(it, default_value);
-
-  return (*it).second;
+  return (*arr)[index];
 }
 
 Value& Value::operator[](int index)
@@ -748,19 +972,17 @@ const Value& Value::operator[](ArrayIndex index) const
 {
   NOM_ASSERT( this->null_type() || this->array_type() );
 
-  if( this->null_type() ) {
+  if( this->array_valid() == false ) {
     return Value::null;
   }
 
-  VString key(index);
-
-  ObjectConstIterator it = this->value_.object_->find(key);
+  const Array& arr = this->value_.array_->values;
 
-  if( it == this->value_.object_->end() ) {
+  if( index >= arr.size() ) {
     return Value::null;
   }
 
-  return (*it).second;
+  return arr[index];
 }
 
 const Value& Value::operator[](int index) const
@@ -778,18 +1000,9 @@ Value& Value::operator[](const char* key)
     *this = Value(ValueType::ObjectValues);
   }
 
-  auto it = this->value_.object_->lower_bound(key);
+  Object* obj = this->mutable_object();
 
-  if( it != this->value_.object_->end() && (*it).first == key ) {
-    return (*it).second;
-  }
-
-  auto default_value =
-    std::pair<VString, Value>(key, Value::null);
-  auto res = this->value_.object_->insert(it, default_value);
-
-  Value& value = (*res).second;
-  return value;
+  return (*obj)[key];
 }
 
 Value& Value::operator[](const std::string& key)
@@ -799,30 +1012,41 @@ Value& Value::operator[](const std::string& key)
 
 const Value& Value::operator[](const char* key) const
 {
-  const Value& found = this->find(key);
-
-  if( found == Value::null ) {
-    return Value::null;
-  }
-
-  return found;
+  return this->find(key);
 }
 
 const Value& Value::operator[](const std::string& key) const
 {
-  const Value& found = this->find( key.c_str() );
+  return this->find(key);
+}
 
-  if( found == Value::null ) {
-    return Value::null;
+// Implementation derives from JsonCpp
+Value& Value::push_back(const Value& val)
+{
+  NOM_ASSERT( this->null_type() || this->array_type() );
+
+  if( this->null_type() ) {
+    *this = Value(ValueType::ArrayValues);
   }
 
-  return found;
+  Array* arr = this->mutable_array();
+  arr->push_back(val);
+
+  return arr->back();
 }
 
-// Implementation derives from JsonCpp
-Value& Value::push_back(const Value& val)
+Value& Value::push_back(Value&& val)
 {
-  return (*this)[ ArrayIndex( this->size() )] = val;
+  NOM_ASSERT( this->null_type() || this->array_type() );
+
+  if( this->null_type() ) {
+    *this = Value(ValueType::ArrayValues);
+  }
+
+  Array* arr = this->mutable_array();
+  arr->push_back( std::move(val) );
+
+  return arr->back();
 }
 
 const Value& Value::find(const std::string& key) const
@@ -830,9 +1054,14 @@ const Value& Value::find(const std::string& key) const
   // Sanity check
   NOM_ASSERT( this->null_type() || this->object_type() );
 
-  auto res = this->value_.object_->find( key );
+  if( this->object_valid() == false ) {
+    return Value::null;
+  }
+
+  const Object& obj = this->value_.object_->values;
+  auto res = obj.find( VString::find(key) );
 
-  if( res == this->value_.object_->end() ) // No match found
+  if( res == obj.end() ) // No match found
   {
     return Value::null;
   }
@@ -846,51 +1075,32 @@ const Value& Value::find(const std::string& key) const
 
 Value Value::erase(const std::string& key)
 {
-  VString k(key);
+  VString k = VString::find(key);
   Value ret = Value::null;
 
   // Invalid object state!
   NOM_ASSERT( this->null_type() || this->object_type() );
 
-  auto res = this->value_.object_->find(k);
+  if( this->object_valid() == false ) {
+    return ret;
+  }
+
+  Object* obj = this->mutable_object();
+  auto res = obj->find(k);
 
-  if( res == this->value_.object_->end() ) {
+  if( res == obj->end() ) {
     // Failure; no match found
     return ret;
   } else {
     // Success; matching key value found
-    ret = res->second;
+    ret = std::move(res->second);
 
-    this->value_.object_->erase(res);
+    obj->erase(res);
   }
 
   return ret;
 }
 
-// Value Value::erase( int index )
-// {
-//   // Sanity check
-//   NOM_ASSERT( this->null_type() || this->array_type() );
-
-//   VString k( index );
-//   auto res = this->value_.object_->find( k );
-
-//   if( res == this->value_.object_->end() )
-//   {
-//     // No match found
-//     return Value::null;
-//   }
-//   else
-//   {
-//     // Success -- match found; erasing found key pair!
-//     this->value_.object_->erase( res );
-
-//     return res->second;
-//   }
-
-//   return Value::null;
-// }
-
 Value::Members Value::member_names() const
 {
   Members keys;
@@ -900,7 +1110,10 @@ Value::Members Value::member_names() const
 
   if( ! this->object_valid() ) return keys;
 
-  for( auto itr = this->value_.object_->begin(); itr != this->value_.object_->end(); ++itr )
+  const Object& obj = this->value_.object_->values;
+  keys.reserve( obj.size() );
+
+  for( auto itr = obj.begin(); itr != obj.end(); ++itr )
   {
     // VString object stores the member key
 
@@ -914,12 +1127,12 @@ Value::ConstIterator Value::begin() const
 {
   if( this->array_valid() ) // ArrayIterator
   {
-    Value::ConstIterator itr = this->value_.object_->begin();
-    return Value::ConstIterator( itr );
+    Array& arr = this->value_.array_->values;
+    return Value::ConstIterator( arr.begin(), 0 );
   }
   else if ( this->object_valid() ) // ObjectIterator
   {
-    Value::ConstIterator itr = this->value_.object_->begin();
+    Value::ConstIterator itr = this->value_.object_->values.begin();
     return Value::ConstIterator( itr );
   }
 
@@ -931,12 +1144,12 @@ Value::ConstIterator Value::end() const
 {
   if( this->array_valid() ) // ArrayIterator
   {
-    Value::ConstIterator itr = this->value_.object_->end();
-    return Value::ConstIterator( itr );
+    Array& arr = this->value_.array_->values;
+    return Value::ConstIterator( arr.end(), arr.size() );
   }
   else if ( this->object_valid() ) // ObjectIterator
   {
-    Value::ConstIterator itr = this->value_.object_->end();
+    Value::ConstIterator itr = this->value_.object_->values.end();
     return Value::ConstIterator( itr );
   }
 
@@ -948,12 +1161,12 @@ Value::Iterator Value::begin()
 {
   if( this->array_valid() ) // ArrayIterator
   {
-    Value::Iterator itr = this->value_.object_->begin();
-    return Value::Iterator( itr );
+    Array* arr = this->mutable_array();
+    return Value::Iterator( arr->begin(), 0 );
   }
   else if ( this->object_valid() ) // ObjectIterator
   {
-    Value::Iterator itr = this->value_.object_->begin();
+    Value::Iterator itr = this->mutable_object()->begin();
     return Value::Iterator( itr );
   }
 
@@ -964,12 +1177,12 @@ Value::Iterator Value::end()
 {
   if( this->array_valid() ) // ArrayIterator
   {
-    Value::Iterator itr = this->value_.object_->end();
-    return Value::Iterator( itr );
+    Array* arr = this->mutable_array();
+    return Value::Iterator( arr->end(), arr->size() );
   }
   else if ( this->object_valid() ) // ObjectIterator
   {
-    Value::Iterator itr = this->value_.object_->end();
+    Value::Iterator itr = this->mutable_object()->end();
     return Value::Iterator( itr );
   }
 
@@ -53,6 +53,12 @@ ValueConstIterator::ValueConstIterator(const ObjectIterator& rhs) :
   //NOM_LOG_TRACE(NOM);
 }
 
+ValueConstIterator::ValueConstIterator(const ArrayIterator& rhs, ArrayIndex index) :
+  ValueIteratorBase(rhs, index)
+{
+  //NOM_LOG_TRACE(NOM);
+}
+
 ValueConstIterator::SelfType&
 ValueConstIterator::operator =(const DerivedType& rhs)
 {
@@ -53,6 +53,12 @@ ValueIterator::ValueIterator(const ObjectIterator& rhs) :
   //NOM_LOG_TRACE(NOM);
 }
 
+ValueIterator::ValueIterator(const ArrayIterator& rhs, ArrayIndex index) :
+  ValueIteratorBase(rhs, index)
+{
+  //NOM_LOG_TRACE(NOM);
+}
+
 ValueIterator::SelfType& ValueIterator::operator =(const SelfType& rhs)
 {
   this->copy(rhs);
@@ -31,6 +31,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace nom {
 
 ValueIteratorBase::ValueIteratorBase() :
+  index_(0),
   type_(IteratorType::Null)
 {
   //NOM_LOG_TRACE(NOM);
@@ -43,11 +44,21 @@ ValueIteratorBase::~ValueIteratorBase()
 
 ValueIteratorBase::ValueIteratorBase(const ObjectIterator& rhs) :
   object_(rhs),
+  index_(0),
   type_(IteratorType::ObjectValues)
 {
   //NOM_LOG_TRACE(NOM);
 }
 
+ValueIteratorBase::
+ValueIteratorBase(const ArrayIterator& rhs, ArrayIndex index) :
+  array_(rhs),
+  index_(index),
+  type_(IteratorType::ArrayValues)
+{
+  //NOM_LOG_TRACE(NOM);
+}
+
 bool ValueIteratorBase::valid() const
 {
   if( this->type() != IteratorType::Null ) return true;
@@ -103,25 +114,45 @@ bool ValueIteratorBase::key(const std::string& member) const
 
 ArrayIndex ValueIteratorBase::index() const
 {
-  const VString& key = this->object_->first;
+  if( this->type() == IteratorType::ArrayValues )
+  {
+    return this->index_;
+  }
+  else if( this->type() == IteratorType::ObjectValues )
+  {
+    const VString& key = this->object_->first;
+
+    return key.index();
+  }
 
-  return key.index();
+  return 0;
 }
 
 void ValueIteratorBase::copy(const SelfType& rhs)
 {
   this->object_ = rhs.object_;
+  this->array_ = rhs.array_;
+  this->index_ = rhs.index_;
   this->type_ = rhs.type();
 }
 
 ValueIteratorBase::ValueTypeReference ValueIteratorBase::dereference() const
 {
+  if( this->type() == IteratorType::ArrayValues )
+  {
+    return *this->array_;
+  }
+
   return this->object_->second;
 }
 
 ValueIteratorBase::ValueTypePointer ValueIteratorBase::pointer() const
 {
-  if( this->type() == IteratorType::ObjectValues )
+  if( this->type() == IteratorType::ArrayValues )
+  {
+    return this->array_->get();
+  }
+  else if( this->type() == IteratorType::ObjectValues )
   {
     return this->object_->second.get();
   }
@@ -133,26 +164,27 @@ ValueIteratorBase::ValueTypePointer ValueIteratorBase::pointer() const
 
 bool ValueIteratorBase::operator ==(const SelfType& rhs) const
 {
-  if( this->type() == IteratorType::ObjectValues )
+  if( this->type() != rhs.type() )
+  {
+    return false;
+  }
+  else if( this->type() == IteratorType::ArrayValues )
+  {
+    return this->array_ == rhs.array_;
+  }
+  else if( this->type() == IteratorType::ObjectValues )
   {
     return this->object_ == rhs.object_;
   }
   else // IteratorType::NullValue
   {
-    return ( rhs.type() == IteratorType::Null );
+    return true;
   }
 }
 
 bool ValueIteratorBase::operator !=(const SelfType& rhs) const
 {
-  if( this->type() == IteratorType::ObjectValues )
-  {
-    return ! ( this->object_ == rhs.object_ );
-  }
-  else // IteratorType::NullValue
-  {
-    return ! ( rhs.type() == IteratorType::Null );
-  }
+  return ! ( *this == rhs );
 }
 
 ValueIteratorBase::DifferenceType
@@ -163,7 +195,12 @@ ValueIteratorBase::operator -(const SelfType& rhs) const
 
 void ValueIteratorBase::increment()
 {
-  if( this->type() == IteratorType::ObjectValues )
+  if( this->type() == IteratorType::ArrayValues )
+  {
+    ++this->array_;
+    ++this->index_;
+  }
+  else if( this->type() == IteratorType::ObjectValues )
   {
     ++this->object_;
   }
@@ -175,7 +212,12 @@ void ValueIteratorBase::increment()
 
 void ValueIteratorBase::decrement()
 {
-  if( this->type() == IteratorType::ObjectValues )
+  if( this->type() == IteratorType::ArrayValues )
+  {
+    --this->array_;
+    --this->index_;
+  }
+  else if( this->type() == IteratorType::ObjectValues )
   {
     --this->object_;
   }
@@ -188,7 +230,11 @@ void ValueIteratorBase::decrement()
 ValueIteratorBase::DifferenceType
 ValueIteratorBase::distance(const SelfType& rhs) const
 {
-  if( this->type() == IteratorType::ObjectValues )
+  if( this->type() == IteratorType::ArrayValues )
+  {
+    return std::distance( this->array_, rhs.array_ );
+  }
+  else if( this->type() == IteratorType::ObjectValues )
   {
     return std::distance( this->object_, rhs.object_ );
   }
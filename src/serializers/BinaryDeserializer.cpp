@@ -0,0 +1,518 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include "nomlib/serializers/BinaryDeserializer.hpp"
+
+// Private headers
+#include <cstring>
+#include <vector>
+
+#include "nomlib/system/MappedFile.hpp"
+
+namespace nom {
+
+namespace priv {
+
+/// \brief A string table entry; refers to the string in place.
+struct BinaryString
+{
+  const char* data;
+  uint32 length;
+
+  /// \brief The member key interned from this string, once the string has
+  /// been used as a key.
+  VString key;
+  bool interned;
+};
+
+/// \brief An array or object node whose contents are still being decoded.
+struct BinaryContainer
+{
+  BinaryContainer(bool is_object, uint32 count) :
+    object_type(is_object),
+    remaining(count)
+  {
+  }
+
+  bool object_type;
+
+  /// \brief The number of elements or members left to decode.
+  uint32 remaining;
+
+  Array array;
+  Object object;
+
+  /// \brief The key of the object member whose value is being decoded.
+  VString key;
+};
+
+/// \brief Read a 32-bit unsigned integer in little-endian byte order.
+uint32 decode_uint32(const char* pos)
+{
+  const uint8* bytes = reinterpret_cast<const uint8*>(pos);
+
+  return( NOM_SCAST(uint32, bytes[0]) |
+          NOM_SCAST(uint32, bytes[1]) << 8 |
+          NOM_SCAST(uint32, bytes[2]) << 16 |
+          NOM_SCAST(uint32, bytes[3]) << 24 );
+}
+
+/// \brief A decoder for the documents written by nom::BinarySerializer.
+class BinaryReader
+{
+  public:
+    BinaryReader(const char* source, nom::size_type length) :
+      pos_(source),
+      end_(source + length),
+      error_(nullptr),
+      budget_(0)
+    {
+    }
+
+    bool parse(Value& output);
+
+    /// \brief Get the description of the error that stopped decoding.
+    const char* error() const
+    {
+      return this->error_;
+    }
+
+  private:
+    bool fail(const char* message)
+    {
+      this->error_ = message;
+
+      return false;
+    }
+
+    nom::size_type remaining() const
+    {
+      return this->end_ - this->pos_;
+    }
+
+    /// \brief Validate the header and index the string table.
+    bool parse_header();
+
+    bool read_uint8(uint8& value);
+    bool read_uint32(uint32& value);
+    bool read_string(uint32& index);
+    bool read_key(VString& key);
+    bool parse_scalar(uint8 type, Value& dest);
+
+    /// \brief Pop the innermost container off the stack as a nom::Value.
+    Value close_container();
+
+    const char* pos_;
+    const char* end_;
+    const char* error_;
+
+    /// \brief The number of value stream bytes not yet claimed by the
+    /// elements and members of the containers opened so far.
+    ///
+    /// \remarks Every element is encoded in bytes of its own, so the counts
+    /// of all the containers in a document fit within its value stream; this
+    /// bounds the memory reserved for the whole tree, however deeply corrupt
+    /// counts are nested.
+    uint64 budget_;
+
+    std::vector<BinaryString> strings_;
+
+    std::vector<BinaryContainer> stack_;
+};
+
+bool BinaryReader::parse(Value& output)
+{
+  Value value;
+
+  if( this->parse_header() == false ) {
+    return false;
+  }
+
+  while( true ) {
+
+    // Decode the next value; the contents of arrays and objects are decoded
+    // by the iterations that follow their count
+    uint8 type = 0;
+
+    if( this->read_uint8(type) == false ) {
+      return false;
+    }
+
+    if( type == Value::ValueType::ArrayValues ||
+        type == Value::ValueType::ObjectValues )
+    {
+      bool object_type = (type == Value::ValueType::ObjectValues);
+      uint32 count = 0;
+
+      if( this->read_uint32(count) == false ) {
+        return false;
+      }
+
+      // Each element takes at least a type, and each member a key index too
+      uint64 min_size = NOM_SCAST(uint64, count) * (object_type ? 5 : 1);
+      if( min_size > this->remaining() || min_size > this->budget_ ) {
+        return this->fail("The container count exceeds the document size");
+      }
+
+      this->budget_ -= min_size;
+
+      this->stack_.emplace_back(object_type, count);
+
+      BinaryContainer& top = this->stack_.back();
+      if( object_type == true ) {
+        top.object.reserve(count);
+      } else {
+        top.array.reserve(count);
+      }
+
+      if( count != 0 ) {
+
+        if( object_type == true && this->read_key(top.key) == false ) {
+          return false;
+        }
+
+        continue;
+      }
+
+      // Empty array or object
+      value = this->close_container();
+    } else if( this->parse_scalar(type, value) == false ) {
+      return false;
+    }
+
+    // Store the value in its container, closing every container that ends
+    // right after it
+    while( true ) {
+
+      if( this->stack_.empty() == true ) {
+
+        if( this->pos_ != this->end_ ) {
+          return this->fail("Unexpected data after the top-level value");
+        }
+
+        output = std::move(value);
+
+        return true;
+      }
+
+      BinaryContainer& top = this->stack_.back();
+      if( top.object_type == true ) {
+        top.object[top.key] = std::move(value);
+      } else {
+        top.array.push_back( std::move(value) );
+      }
+
+      if( --top.remaining != 0 ) {
+
+        if( top.object_type == true && this->read_key(top.key) == false ) {
+          return false;
+        }
+
+        // Decode the next element
+        break;
+      }
+
+      value = this->close_container();
+    }
+  }
+}
+
+bool BinaryReader::parse_header()
+{
+  if( this->remaining() < BINARY_VALUE_HEADER_SIZE ) {
+    return this->fail("The document is too short to hold a header");
+  }
+
+  uint32 signature = decode_uint32(this->pos_);
+  uint32 version = decode_uint32(this->pos_ + 4);
+  uint32 num_strings = decode_uint32(this->pos_ + 8);
+  uint32 table_size = decode_uint32(this->pos_ + 12);
+  uint32 values_size = decode_uint32(this->pos_ + 16);
+
+  this->pos_ += BINARY_VALUE_HEADER_SIZE;
+
+  if( signature != BINARY_VALUE_SIGNATURE ) {
+    return this->fail("Not a binary nom::Value document");
+  } else if( version != BINARY_VALUE_VERSION ) {
+    return this->fail("Unsupported document version");
+  }
+
+  if( NOM_SCAST(uint64, table_size) + values_size != this->remaining() ) {
+    return this->fail("The document size does not match its header");
+  }
+
+  // Each entry takes at least a length and a null terminator
+  if( num_strings > table_size / 5 ) {
+    return this->fail("The string table is too small for its string count");
+  }
+
+  const char* table_end = this->pos_ + table_size;
+  this->budget_ = values_size;
+
+  this->strings_.resize(num_strings);
+  for( auto itr = this->strings_.begin(); itr != this->strings_.end(); ++itr ) {
+
+    if( table_end - this->pos_ < 4 ) {
+      return this->fail("Unexpected end of the string table");
+    }
+
+    itr->length = decode_uint32(this->pos_);
+    itr->data = this->pos_ + 4;
+    itr->interned = false;
+
+    if( NOM_SCAST(nom::size_type, table_end - itr->data) <= itr->length ) {
+      return this->fail("Unexpected end of the string table");
+    } else if( itr->data[itr->length] != '\0' ) {
+      return this->fail("Expected a null terminator after a string");
+    }
+
+    this->pos_ = itr->data + itr->length + 1;
+  }
+
+  if( this->pos_ != table_end ) {
+    return this->fail("The string table size does not match its contents");
+  }
+
+  return true;
+}
+
+bool BinaryReader::read_uint8(uint8& value)
+{
+  if( this->remaining() < 1 ) {
+    return this->fail("Unexpected end of input");
+  }
+
+  value = NOM_SCAST(uint8, *this->pos_);
+  ++this->pos_;
+
+  return true;
+}
+
+bool BinaryReader::read_uint32(uint32& value)
+{
+  if( this->remaining() < 4 ) {
+    return this->fail("Unexpected end of input");
+  }
+
+  value = decode_uint32(this->pos_);
+  this->pos_ += 4;
+
+  return true;
+}
+
+bool BinaryReader::read_string(uint32& index)
+{
+  if( this->read_uint32(index) == false ) {
+    return false;
+  }
+
+  if( index >= this->strings_.size() ) {
+    return this->fail("String index is out of range");
+  }
+
+  return true;
+}
+
+bool BinaryReader::read_key(VString& key)
+{
+  uint32 index = 0;
+
+  if( this->read_string(index) == false ) {
+    return false;
+  }
+
+  BinaryString& str = this->strings_[index];
+
+  if( str.interned == false ) {
+    str.key = VString(str.data);
+    str.interned = true;
+  }
+
+  key = str.key;
+
+  return true;
+}
+
+bool BinaryReader::parse_scalar(uint8 type, Value& dest)
+{
+  switch( type )
+  {
+    default:
+    {
+      return this->fail("Unknown value type");
+    }
+
+    case Value::ValueType::Null:
+    {
+      dest = Value::null;
+      return true;
+    }
+
+    case Value::ValueType::SignedInteger:
+    case Value::ValueType::UnsignedInteger:
+    {
+      uint32 value = 0;
+
+      if( this->read_uint32(value) == false ) {
+        return false;
+      }
+
+      if( type == Value::ValueType::SignedInteger ) {
+        dest = Value( NOM_SCAST(int, value) );
+      } else {
+        dest = Value( NOM_SCAST(uint, value) );
+      }
+
+      return true;
+    }
+
+    case Value::ValueType::RealNumber:
+    {
+      uint32 low = 0;
+      uint32 high = 0;
+
+      if( this->read_uint32(low) == false ||
+          this->read_uint32(high) == false )
+      {
+        return false;
+      }
+
+      uint64 bits = NOM_SCAST(uint64, high) << 32 | low;
+      real64 value = 0;
+      std::memcpy( &value, &bits, sizeof(value) );
+
+      dest = Value(value);
+
+      return true;
+    }
+
+    case Value::ValueType::String:
+    {
+      uint32 index = 0;
+
+      if( this->read_string(index) == false ) {
+        return false;
+      }
+
+      // The string is null-terminated in place
+      dest = Value( this->strings_[index].data );
+
+      return true;
+    }
+
+    case Value::ValueType::Boolean:
+    {
+      uint8 value = 0;
+
+      if( this->read_uint8(value) == false ) {
+        return false;
+      }
+
+      dest = Value( value != 0 );
+
+      return true;
+    }
+  }
+}
+
+Value BinaryReader::close_container()
+{
+  BinaryContainer& top = this->stack_.back();
+
+  Value value;
+  if( top.object_type == true ) {
+    value = Value( std::move(top.object) );
+  } else {
+    value = Value( std::move(top.array) );
+  }
+
+  this->stack_.pop_back();
+
+  return value;
+}
+
+} // namespace priv
+
+BinaryDeserializer::BinaryDeserializer()
+{
+  // NOM_LOG_TRACE( NOM );
+}
+
+BinaryDeserializer::~BinaryDeserializer()
+{
+  // NOM_LOG_TRACE( NOM );
+}
+
+Value BinaryDeserializer::deserialize(const std::string& source)
+{
+  return this->deserialize( source.data(), source.size() );
+}
+
+Value BinaryDeserializer::deserialize(const char* source, nom::size_type length)
+{
+  Value output;
+
+  if( this->parse(source, length, output) == false ) {
+    return Value::null;
+  }
+
+  return output;
+}
+
+bool BinaryDeserializer::load(const std::string& filename, Value& output)
+{
+  MappedFile fp;
+
+  if( fp.open(filename) == false ) {
+    NOM_LOG_ERR( NOM, "Could not access file:", filename );
+    return false;
+  }
+
+  if( this->parse( fp.data(), fp.size(), output ) == false ) {
+    NOM_LOG_ERR( NOM, "Could not parse file:", filename );
+    return false;
+  }
+
+  return true;
+}
+
+bool BinaryDeserializer::parse( const char* source, nom::size_type length,
+                                Value& output ) const
+{
+  priv::BinaryReader reader(source, length);
+
+  if( reader.parse(output) == false ) {
+    NOM_LOG_ERR(  NOM, "Could not decode the input source object:",
+                  reader.error() );
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace nom
@@ -0,0 +1,226 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include "nomlib/serializers/BinarySerializer.hpp"
+
+// Private headers
+#include <cstring>
+#include <fstream>
+
+#include "nomlib/serializers/JsonDeserializer.hpp"
+
+namespace nom {
+
+namespace priv {
+
+void write_uint8(uint8 value, std::string& dest)
+{
+  dest += NOM_SCAST(char, value);
+}
+
+/// \brief Append a 32-bit unsigned integer in little-endian byte order.
+void write_uint32(uint32 value, std::string& dest)
+{
+  dest += NOM_SCAST(char, value & 0xFF);
+  dest += NOM_SCAST(char, (value >> 8) & 0xFF);
+  dest += NOM_SCAST(char, (value >> 16) & 0xFF);
+  dest += NOM_SCAST(char, (value >> 24) & 0xFF);
+}
+
+/// \brief Append a 64-bit IEEE-754 number in little-endian byte order.
+void write_real64(real64 value, std::string& dest)
+{
+  uint64 bits = 0;
+  std::memcpy( &bits, &value, sizeof(bits) );
+
+  write_uint32( NOM_SCAST(uint32, bits & 0xFFFFFFFF), dest );
+  write_uint32( NOM_SCAST(uint32, bits >> 32), dest );
+}
+
+} // namespace priv
+
+BinarySerializer::BinarySerializer()
+{
+  // NOM_LOG_TRACE( NOM );
+}
+
+BinarySerializer::~BinarySerializer()
+{
+  // NOM_LOG_TRACE( NOM );
+}
+
+std::string BinarySerializer::serialize(const Value& source)
+{
+  std::string values;
+  std::string output;
+
+  this->strings_.clear();
+  this->table_.clear();
+
+  this->write_value(source, values);
+
+  output.reserve(  BINARY_VALUE_HEADER_SIZE + this->table_.size() +
+                  values.size() );
+
+  priv::write_uint32(BINARY_VALUE_SIGNATURE, output);
+  priv::write_uint32(BINARY_VALUE_VERSION, output);
+  priv::write_uint32( this->strings_.size(), output );
+  priv::write_uint32( this->table_.size(), output );
+  priv::write_uint32( values.size(), output );
+
+  output += this->table_;
+  output += values;
+
+  return output;
+}
+
+bool BinarySerializer::save(const Value& source, const std::string& filename)
+{
+  std::ofstream fp;
+
+  fp.open( filename, std::ios::out | std::ios::binary );
+
+  if( ! fp.is_open() || ! fp.good() ) {
+    NOM_LOG_ERR( NOM, "Could not save output to file:", filename );
+    return false;
+  }
+
+  std::string output = this->serialize(source);
+  fp.write( output.data(), output.size() );
+
+  if( fp.good() == false ) {
+    NOM_LOG_ERR( NOM, "Could not save output to file:", filename );
+    return false;
+  }
+
+  return true;
+}
+
+void BinarySerializer::write_value(const Value& source, std::string& dest)
+{
+  priv::write_uint8( source.type(), dest );
+
+  switch( source.type() )
+  {
+    default:
+    case Value::ValueType::Null:
+    {
+      break;
+    }
+
+    case Value::ValueType::SignedInteger:
+    {
+      priv::write_uint32( NOM_SCAST(uint32, source.get_int() ), dest );
+      break;
+    }
+
+    case Value::ValueType::UnsignedInteger:
+    {
+      priv::write_uint32( source.get_uint(), dest );
+      break;
+    }
+
+    case Value::ValueType::RealNumber:
+    {
+      priv::write_real64( source.get_double(), dest );
+      break;
+    }
+
+    case Value::ValueType::String:
+    {
+      priv::write_uint32( this->string_index( source.get_cstring() ), dest );
+      break;
+    }
+
+    case Value::ValueType::Boolean:
+    {
+      priv::write_uint8( source.get_bool() ? 1 : 0, dest );
+      break;
+    }
+
+    case Value::ValueType::ArrayValues:
+    {
+      priv::write_uint32( source.size(), dest );
+
+      for( auto itr = source.begin(); itr != source.end(); ++itr ) {
+        this->write_value(*itr, dest);
+      }
+
+      break;
+    }
+
+    case Value::ValueType::ObjectValues:
+    {
+      priv::write_uint32( source.size(), dest );
+
+      for( auto itr = source.begin(); itr != source.end(); ++itr ) {
+        priv::write_uint32( this->string_index( itr.key() ), dest );
+        this->write_value(*itr, dest);
+      }
+
+      break;
+    }
+  }
+}
+
+uint32 BinarySerializer::string_index(const char* str)
+{
+  auto res = this->strings_.find(str);
+
+  if( res != this->strings_.end() ) {
+    return res->second;
+  }
+
+  uint32 index = this->strings_.size();
+  uint32 length = std::strlen(str);
+
+  this->strings_.emplace(str, index);
+
+  // The null terminator lets readers use the string in place
+  priv::write_uint32(length, this->table_);
+  this->table_.append(str, length);
+  this->table_ += '\0';
+
+  return index;
+}
+
+bool convert_json_to_binary( const std::string& json_filename,
+                             const std::string& filename )
+{
+  JsonDeserializer json;
+  BinarySerializer fp;
+  Value source;
+
+  if( json.load(json_filename, source) == false ) {
+    return false;
+  }
+
+  return fp.save(source, filename);
+}
+
+} // namespace nom
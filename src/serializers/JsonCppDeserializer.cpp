@@ -184,7 +184,7 @@ bool JsonCppDeserializer::read( const Json::Value& source, Value& dest ) const
 
         this->read_array( source[root_key], val );
 
-        objects[root_key] = val;
+        objects[root_key] = std::move(val);
         // objects[root_key].push_back( val );
       }
 
@@ -235,11 +235,11 @@ bool JsonCppDeserializer::read( const Json::Value& source, Value& dest ) const
   // objects; b) JSON object(s) containing objects.
   if( array.size() > 0 )
   {
-    dest = objects;
+    dest = std::move(objects);
   }
   else
   {
-    dest = objects;
+    dest = std::move(objects);
   }
 
   return true;
@@ -342,7 +342,7 @@ bool JsonCppDeserializer::read_array( const Json::Value& object, Value& dest ) c
           return false;
         }
 
-        arr.push_back( val );
+        arr.push_back( std::move(val) );
         break;
       }
 
@@ -360,7 +360,7 @@ bool JsonCppDeserializer::read_array( const Json::Value& object, Value& dest ) c
           return false;
         }
 
-        arr.push_back( val );
+        arr.push_back( std::move(val) );
 
         break;
       }
@@ -374,14 +374,14 @@ bool JsonCppDeserializer::read_array( const Json::Value& object, Value& dest ) c
           return false;
         }
 
-        arr.push_back( val );
+        arr.push_back( std::move(val) );
 
         break;
       }
     }
   }
 
-  dest = arr;
+  dest = std::move(arr);
   // dest.push_back( arr );
 
   return true;
@@ -489,7 +489,7 @@ bool JsonCppDeserializer::read_object( const Json::Value& object, Value& dest )
                 return false;
               }
 
-              obj[key] = val;
+              obj[key] = std::move(val);
               break;
             }
 
@@ -504,7 +504,7 @@ bool JsonCppDeserializer::read_object( const Json::Value& object, Value& dest )
                 return false;
               }
 
-              obj[key] = val;
+              obj[key] = std::move(val);
               break;
             }
           } // end switch object[key] type
@@ -518,12 +518,4 @@ bool JsonCppDeserializer::read_object( const Json::Value& object, Value& dest )
   return true;
 }
 
-std::unique_ptr<IValueDeserializer> make_unique_json_deserializer()
-{
-  std::unique_ptr<IValueDeserializer> deserializer =
-    nom::make_unique<JsonCppDeserializer>();
-
-  return std::move(deserializer);
-}
-
 } // namespace nom
@@ -362,7 +362,7 @@ bool JsonCppSerializer::write_array( const Value& object, Json::Value& dest ) co
 {
   uint index = 0;
 
-  Value array = object.array();
+  Array array = object.array();
 
   for( auto itr = array.begin(); itr != array.end(); ++itr )
   {
@@ -0,0 +1,698 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include "nomlib/serializers/JsonDeserializer.hpp"
+
+// Private headers
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "nomlib/core/helpers.hpp"
+#include "nomlib/system/MappedFile.hpp"
+
+namespace nom {
+
+namespace priv {
+
+/// \brief An array or object node whose contents are still being parsed.
+struct JsonContainer
+{
+  explicit JsonContainer(bool is_object) :
+    object_type(is_object)
+  {
+  }
+
+  bool object_type;
+  Array array;
+  Object object;
+
+  /// \brief The key of the object member whose value is being parsed.
+  VString key;
+};
+
+/// \brief A single pass JSON parser that builds nom::Value nodes as it goes.
+class JsonReader
+{
+  public:
+    JsonReader(const char* source, nom::size_type length) :
+      begin_(source),
+      pos_(source),
+      end_(source + length),
+      error_(nullptr)
+    {
+    }
+
+    bool parse(Value& output);
+
+    /// \brief Get the description of the syntax error that stopped parsing.
+    const char* error() const
+    {
+      return this->error_;
+    }
+
+    /// \brief Get the line number of the syntax error, starting from one.
+    nom::size_type error_line() const;
+
+    /// \brief Get the column number of the syntax error, starting from one.
+    nom::size_type error_column() const;
+
+  private:
+    bool fail(const char* message)
+    {
+      this->error_ = message;
+
+      return false;
+    }
+
+    /// \brief Skip whitespace and comments.
+    bool skip_whitespace();
+
+    bool parse_key(JsonContainer& container);
+    bool parse_scalar(Value& dest);
+    bool parse_string(std::string& dest);
+    bool parse_number(Value& dest);
+    bool parse_literal(const char* literal, nom::size_type length);
+    bool parse_hex4(uint32& code);
+
+    /// \brief Pop the innermost container off the stack as a nom::Value.
+    Value close_container();
+
+    const char* begin_;
+    const char* pos_;
+    const char* end_;
+    const char* error_;
+
+    /// \brief Reusable buffer for decoding string values and member keys.
+    std::string scratch_;
+
+    std::vector<JsonContainer> stack_;
+};
+
+static bool is_digit(char c)
+{
+  return( c >= '0' && c <= '9' );
+}
+
+static void append_utf8(uint32 code, std::string& dest)
+{
+  if( code < 0x80 ) {
+    dest += NOM_SCAST(char, code);
+  } else if( code < 0x800 ) {
+    dest += NOM_SCAST(char, 0xC0 | (code >> 6) );
+    dest += NOM_SCAST(char, 0x80 | (code & 0x3F) );
+  } else if( code < 0x10000 ) {
+    dest += NOM_SCAST(char, 0xE0 | (code >> 12) );
+    dest += NOM_SCAST(char, 0x80 | ( (code >> 6) & 0x3F) );
+    dest += NOM_SCAST(char, 0x80 | (code & 0x3F) );
+  } else {
+    dest += NOM_SCAST(char, 0xF0 | (code >> 18) );
+    dest += NOM_SCAST(char, 0x80 | ( (code >> 12) & 0x3F) );
+    dest += NOM_SCAST(char, 0x80 | ( (code >> 6) & 0x3F) );
+    dest += NOM_SCAST(char, 0x80 | (code & 0x3F) );
+  }
+}
+
+bool JsonReader::parse(Value& output)
+{
+  Value value;
+
+  // Skip the UTF-8 byte order mark
+  if( this->end_ - this->pos_ >= 3 &&
+      std::memcmp(this->pos_, "\xEF\xBB\xBF", 3) == 0 )
+  {
+    this->pos_ += 3;
+  }
+
+  if( this->skip_whitespace() == false ) {
+    return false;
+  }
+
+  while( true ) {
+
+    // Parse the next value; the contents of arrays and objects are parsed by
+    // the iterations that follow their opening bracket
+    if( this->pos_ == this->end_ ) {
+      return this->fail("Unexpected end of input; expected a value");
+    }
+
+    if( *this->pos_ == '{' || *this->pos_ == '[' ) {
+
+      bool object_type = (*this->pos_ == '{');
+      char close = object_type ? '}' : ']';
+
+      ++this->pos_;
+      this->stack_.emplace_back(object_type);
+
+      if( this->skip_whitespace() == false ) {
+        return false;
+      }
+
+      if( this->pos_ == this->end_ || *this->pos_ != close ) {
+
+        if( object_type == true &&
+            this->parse_key( this->stack_.back() ) == false )
+        {
+          return false;
+        }
+
+        continue;
+      }
+
+      // Empty array or object
+      ++this->pos_;
+      value = this->close_container();
+    } else if( this->parse_scalar(value) == false ) {
+      return false;
+    }
+
+    // Store the value in its container, closing every container that ends
+    // right after it
+    while( true ) {
+
+      if( this->stack_.empty() == true ) {
+
+        if( this->skip_whitespace() == false ) {
+          return false;
+        }
+
+        if( this->pos_ != this->end_ ) {
+          return this->fail("Unexpected data after the top-level value");
+        }
+
+        output = std::move(value);
+
+        return true;
+      }
+
+      JsonContainer& top = this->stack_.back();
+      if( top.object_type == true ) {
+        top.object[top.key] = std::move(value);
+      } else {
+        top.array.push_back( std::move(value) );
+      }
+
+      if( this->skip_whitespace() == false ) {
+        return false;
+      }
+
+      char close = top.object_type ? '}' : ']';
+      if( this->pos_ != this->end_ && *this->pos_ == ',' ) {
+        ++this->pos_;
+
+        if( this->skip_whitespace() == false ) {
+          return false;
+        }
+
+        if( top.object_type == true && this->parse_key(top) == false ) {
+          return false;
+        }
+
+        // Parse the next element
+        break;
+      } else if( this->pos_ != this->end_ && *this->pos_ == close ) {
+        ++this->pos_;
+        value = this->close_container();
+      } else if( top.object_type == true ) {
+        return this->fail("Expected ',' or '}' after an object member");
+      } else {
+        return this->fail("Expected ',' or ']' after an array element");
+      }
+    }
+  }
+}
+
+nom::size_type JsonReader::error_line() const
+{
+  nom::size_type line = 1;
+
+  for( const char* pos = this->begin_; pos != this->pos_; ++pos ) {
+    if( *pos == '\n' ) {
+      ++line;
+    }
+  }
+
+  return line;
+}
+
+nom::size_type JsonReader::error_column() const
+{
+  const char* line_begin = this->pos_;
+
+  while( line_begin != this->begin_ && *(line_begin - 1) != '\n' ) {
+    --line_begin;
+  }
+
+  return( this->pos_ - line_begin + 1 );
+}
+
+bool JsonReader::skip_whitespace()
+{
+  while( this->pos_ != this->end_ ) {
+
+    char c = *this->pos_;
+    if( c == ' ' || c == '\t' || c == '\n' || c == '\r' ) {
+      ++this->pos_;
+    } else if( c == '/' && this->end_ - this->pos_ >= 2 ) {
+
+      if( this->pos_[1] == '/' ) {
+        this->pos_ += 2;
+        while( this->pos_ != this->end_ && *this->pos_ != '\n' ) {
+          ++this->pos_;
+        }
+      } else if( this->pos_[1] == '*' ) {
+        const char* comment_begin = this->pos_;
+
+        this->pos_ += 2;
+        while( this->end_ - this->pos_ >= 2 &&
+               ( this->pos_[0] != '*' || this->pos_[1] != '/' ) )
+        {
+          ++this->pos_;
+        }
+
+        if( this->end_ - this->pos_ < 2 ) {
+          this->pos_ = comment_begin;
+          return this->fail("Unterminated comment");
+        }
+
+        this->pos_ += 2;
+      } else {
+        return true;
+      }
+    } else {
+      return true;
+    }
+  }
+
+  return true;
+}
+
+bool JsonReader::parse_key(JsonContainer& container)
+{
+  if( this->pos_ == this->end_ || *this->pos_ != '"' ) {
+    return this->fail("Expected a string for the object member key");
+  }
+
+  if( this->parse_string(this->scratch_) == false ) {
+    return false;
+  }
+
+  container.key = VString(this->scratch_);
+
+  if( this->skip_whitespace() == false ) {
+    return false;
+  }
+
+  if( this->pos_ == this->end_ || *this->pos_ != ':' ) {
+    return this->fail("Expected ':' after the object member key");
+  }
+
+  ++this->pos_;
+
+  return this->skip_whitespace();
+}
+
+bool JsonReader::parse_scalar(Value& dest)
+{
+  switch( *this->pos_ )
+  {
+    default:
+    {
+      return this->fail("Expected a value");
+    }
+
+    case '"':
+    {
+      if( this->parse_string(this->scratch_) == false ) {
+        return false;
+      }
+
+      dest = Value(this->scratch_);
+      return true;
+    }
+
+    case 't':
+    {
+      dest = Value(true);
+      return this->parse_literal("true", 4);
+    }
+
+    case 'f':
+    {
+      dest = Value(false);
+      return this->parse_literal("false", 5);
+    }
+
+    case 'n':
+    {
+      dest = Value::null;
+      return this->parse_literal("null", 4);
+    }
+
+    case '-':
+    case '0': case '1': case '2': case '3': case '4':
+    case '5': case '6': case '7': case '8': case '9':
+    {
+      return this->parse_number(dest);
+    }
+  }
+}
+
+bool JsonReader::parse_string(std::string& dest)
+{
+  // Skip the opening quote
+  ++this->pos_;
+  dest.clear();
+
+  while( true ) {
+
+    const char* run = this->pos_;
+    while( this->pos_ != this->end_ && *this->pos_ != '"' &&
+           *this->pos_ != '\\' )
+    {
+      ++this->pos_;
+    }
+
+    dest.append(run, this->pos_ - run);
+
+    if( this->pos_ == this->end_ ) {
+      return this->fail("Unterminated string");
+    } else if( *this->pos_ == '"' ) {
+      ++this->pos_;
+      return true;
+    }
+
+    // Escape sequence
+    ++this->pos_;
+    if( this->pos_ == this->end_ ) {
+      return this->fail("Unterminated string");
+    }
+
+    char c = *this->pos_;
+    ++this->pos_;
+
+    switch( c )
+    {
+      default:
+      {
+        --this->pos_;
+        return this->fail("Invalid escape sequence");
+      }
+
+      case '"':
+      case '\\':
+      case '/': dest += c; break;
+      case 'b': dest += '\b'; break;
+      case 'f': dest += '\f'; break;
+      case 'n': dest += '\n'; break;
+      case 'r': dest += '\r'; break;
+      case 't': dest += '\t'; break;
+
+      case 'u':
+      {
+        uint32 code = 0;
+        if( this->parse_hex4(code) == false ) {
+          return false;
+        }
+
+        if( code >= 0xD800 && code <= 0xDBFF ) {
+
+          // UTF-16 surrogate pair
+          uint32 low = 0;
+          if( this->end_ - this->pos_ < 2 || this->pos_[0] != '\\' ||
+              this->pos_[1] != 'u' )
+          {
+            return this->fail("Expected the low half of a surrogate pair");
+          }
+
+          this->pos_ += 2;
+          if( this->parse_hex4(low) == false ) {
+            return false;
+          }
+
+          if( low < 0xDC00 || low > 0xDFFF ) {
+            return this->fail("Invalid low half of a surrogate pair");
+          }
+
+          code = 0x10000 + ( (code - 0xD800) << 10 ) + (low - 0xDC00);
+        } else if( code >= 0xDC00 && code <= 0xDFFF ) {
+          return this->fail("Unexpected low half of a surrogate pair");
+        }
+
+        append_utf8(code, dest);
+        break;
+      }
+    }
+  }
+}
+
+bool JsonReader::parse_number(Value& dest)
+{
+  const char* start = this->pos_;
+  bool negative = false;
+  bool overflow = false;
+  bool real_number = false;
+  uint64 integer = 0;
+
+  if( *this->pos_ == '-' ) {
+    negative = true;
+    ++this->pos_;
+  }
+
+  if( this->pos_ == this->end_ || is_digit(*this->pos_) == false ) {
+    return this->fail("Invalid number");
+  }
+
+  if( *this->pos_ == '0' ) {
+    ++this->pos_;
+  } else {
+    while( this->pos_ != this->end_ && is_digit(*this->pos_) == true ) {
+
+      uint32 digit = *this->pos_ - '0';
+      if( integer > (NOM_UINT64_MAX - digit) / 10 ) {
+        overflow = true;
+      } else {
+        integer = integer * 10 + digit;
+      }
+
+      ++this->pos_;
+    }
+  }
+
+  if( this->pos_ != this->end_ && *this->pos_ == '.' ) {
+    real_number = true;
+    ++this->pos_;
+
+    if( this->pos_ == this->end_ || is_digit(*this->pos_) == false ) {
+      return this->fail("Expected a digit after the decimal point");
+    }
+
+    while( this->pos_ != this->end_ && is_digit(*this->pos_) == true ) {
+      ++this->pos_;
+    }
+  }
+
+  if( this->pos_ != this->end_ && (*this->pos_ == 'e' || *this->pos_ == 'E') ) {
+    real_number = true;
+    ++this->pos_;
+
+    if( this->pos_ != this->end_ && (*this->pos_ == '+' || *this->pos_ == '-') ) {
+      ++this->pos_;
+    }
+
+    if( this->pos_ == this->end_ || is_digit(*this->pos_) == false ) {
+      return this->fail("Expected a digit in the exponent");
+    }
+
+    while( this->pos_ != this->end_ && is_digit(*this->pos_) == true ) {
+      ++this->pos_;
+    }
+  }
+
+  if( real_number == false && overflow == false ) {
+
+    if( negative == true ) {
+      if( integer <= NOM_SCAST(uint64, NOM_INT32_MAX) + 1 ) {
+        dest = Value( NOM_SCAST(int, -NOM_SCAST(int64, integer) ) );
+        return true;
+      }
+    } else if( integer <= NOM_SCAST(uint64, NOM_INT32_MAX) ) {
+      dest = Value( NOM_SCAST(int, integer) );
+      return true;
+    } else if( integer <= NOM_UINT32_MAX ) {
+      dest = Value( NOM_SCAST(uint, integer) );
+      return true;
+    }
+  }
+
+  // Everything else is stored as a real number; strtod needs a
+  // null-terminated copy of the number, as the input may not be terminated
+  nom::size_type length = this->pos_ - start;
+  char buffer[64];
+  std::string long_number;
+  const char* number = buffer;
+
+  if( length < sizeof(buffer) ) {
+    std::memcpy(buffer, start, length);
+    buffer[length] = '\0';
+  } else {
+    long_number.assign(start, length);
+    number = long_number.c_str();
+  }
+
+  dest = Value( std::strtod(number, nullptr) );
+
+  return true;
+}
+
+bool JsonReader::parse_literal(const char* literal, nom::size_type length)
+{
+  if( NOM_SCAST(nom::size_type, this->end_ - this->pos_) < length ||
+      std::memcmp(this->pos_, literal, length) != 0 )
+  {
+    return this->fail("Invalid literal; expected true, false or null");
+  }
+
+  this->pos_ += length;
+
+  return true;
+}
+
+bool JsonReader::parse_hex4(uint32& code)
+{
+  if( this->end_ - this->pos_ < 4 ) {
+    return this->fail("Expected four hexadecimal digits");
+  }
+
+  code = 0;
+  for( nom::size_type idx = 0; idx != 4; ++idx ) {
+
+    char c = *this->pos_;
+    code <<= 4;
+
+    if( c >= '0' && c <= '9' ) {
+      code |= c - '0';
+    } else if( c >= 'a' && c <= 'f' ) {
+      code |= c - 'a' + 10;
+    } else if( c >= 'A' && c <= 'F' ) {
+      code |= c - 'A' + 10;
+    } else {
+      return this->fail("Expected four hexadecimal digits");
+    }
+
+    ++this->pos_;
+  }
+
+  return true;
+}
+
+Value JsonReader::close_container()
+{
+  JsonContainer& top = this->stack_.back();
+
+  Value value;
+  if( top.object_type == true ) {
+    value = Value( std::move(top.object) );
+  } else {
+    value = Value( std::move(top.array) );
+  }
+
+  this->stack_.pop_back();
+
+  return value;
+}
+
+} // namespace priv
+
+JsonDeserializer::JsonDeserializer()
+{
+  // NOM_LOG_TRACE( NOM );
+}
+
+JsonDeserializer::~JsonDeserializer()
+{
+  // NOM_LOG_TRACE( NOM );
+}
+
+Value JsonDeserializer::deserialize(const std::string& source)
+{
+  return this->deserialize( source.data(), source.size() );
+}
+
+Value JsonDeserializer::deserialize(const char* source, nom::size_type length)
+{
+  Value output;
+
+  if( this->parse(source, length, output) == false ) {
+    return Value::null;
+  }
+
+  return output;
+}
+
+bool JsonDeserializer::load(const std::string& filename, Value& output)
+{
+  MappedFile fp;
+
+  if( fp.open(filename) == false ) {
+    NOM_LOG_ERR( NOM, "Could not access file:", filename );
+    return false;
+  }
+
+  if( this->parse( fp.data(), fp.size(), output ) == false ) {
+    NOM_LOG_ERR( NOM, "Could not parse file:", filename );
+    return false;
+  }
+
+  return true;
+}
+
+bool JsonDeserializer::parse( const char* source, nom::size_type length,
+                              Value& output ) const
+{
+  priv::JsonReader reader(source, length);
+
+  if( reader.parse(output) == false ) {
+    NOM_LOG_ERR(  NOM, "Could not parse the input source object as JSON:",
+                  reader.error(), "at line", reader.error_line(), "column",
+                  reader.error_column() );
+    return false;
+  }
+
+  return true;
+}
+
+std::unique_ptr<IValueDeserializer> make_unique_json_deserializer()
+{
+  std::unique_ptr<IValueDeserializer> deserializer =
+    nom::make_unique<JsonDeserializer>();
+
+  return deserializer;
+}
+
+} // namespace nom
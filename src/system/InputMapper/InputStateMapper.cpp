@@ -36,6 +36,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nomlib/system/EventHandler.hpp"
 #include "nomlib/system/InputMapper/InputAction.hpp"
 
+#include <algorithm>
+
 namespace nom {
 
 InputStateMapper::InputStateMapper( void )
@@ -81,6 +83,8 @@ bool InputStateMapper::insert( const std::string& key, const InputActionMapper&
     return false;
   }
 
+  this->invalidate_index();
+
   return true;
 }
 
@@ -94,7 +98,14 @@ bool InputStateMapper::erase(const std::string& key)
     // Err -- match **not** found
     result = false;
   } else {
+
+    // Keep the actions alive for the remainder of the dispatch in progress
+    if( this->dispatching_ > 0 ) {
+      this->retired_actions_.push_back(itr->second.actions);
+    }
+
     this->states_.erase(itr);
+    this->invalidate_index();
     // Success -- match found
     result = true;
   }
@@ -115,6 +126,7 @@ bool InputStateMapper::activate( const std::string& key )
   else // Match found; set the input mapping as the active context.
   {
     itr->second.active = true;
+    this->invalidate_index();
 
     return true;
   }
@@ -135,6 +147,7 @@ bool InputStateMapper::disable( const std::string& key )
   else // Match found; disable the requested state
   {
     itr->second.active = false;
+    this->invalidate_index();
     return true;
   }
 
@@ -147,6 +160,8 @@ void InputStateMapper::disable( void )
   {
     itr->second.active = false;
   }
+
+  this->invalidate_index();
 }
 
 bool InputStateMapper::activate_only( const std::string& key )
@@ -178,6 +193,7 @@ bool InputStateMapper::activate_only( const std::string& key )
   else // Match found; enable the requested state
   {
     it->second.active = true;
+    this->invalidate_index();
     return true;
   }
 
@@ -186,7 +202,14 @@ bool InputStateMapper::activate_only( const std::string& key )
 
 void InputStateMapper::clear( void )
 {
+  if( this->dispatching_ > 0 ) {
+    for( auto itr = this->states_.begin(); itr != this->states_.end(); ++itr ) {
+      this->retired_actions_.push_back(itr->second.actions);
+    }
+  }
+
   this->states_.clear();
+  this->invalidate_index();
 }
 
 void InputStateMapper::dump( void )
@@ -225,89 +248,214 @@ void InputStateMapper::set_event_handler(EventHandler& evt_handler)
 
 // Private scope
 
-void InputStateMapper::on_event(const Event& ev)
+bool InputStateMapper::dispatch_key(const Event& ev, uint64& key)
 {
+  uint32 code = 0;
+
+  switch(ev.type)
+  {
+    default: return false;
+
+    case Event::KEY_PRESS:
+    case Event::KEY_RELEASE:
+    {
+      code = NOM_SCAST(uint32, ev.key.sym);
+    } break;
+
+    case Event::MOUSE_BUTTON_CLICK:
+    case Event::MOUSE_BUTTON_RELEASE:
+    {
+      code = ev.mouse.button;
+    } break;
+
+    // The wheel direction is matched against the action's criteria
+    case Event::MOUSE_WHEEL:
+    {
+      code = 0;
+    } break;
+
+    case Event::JOYSTICK_AXIS_MOTION:
+    {
+      code = ev.jaxis.axis;
+    } break;
+
+    case Event::JOYSTICK_BUTTON_PRESS:
+    case Event::JOYSTICK_BUTTON_RELEASE:
+    {
+      code = ev.jbutton.button;
+    } break;
+
+    case Event::JOYSTICK_HAT_MOTION:
+    {
+      code = ev.jhat.hat;
+    } break;
+
+    case Event::GAME_CONTROLLER_AXIS_MOTION:
+    {
+      code = NOM_SCAST(uint8, ev.caxis.axis);
+    } break;
+
+    case Event::GAME_CONTROLLER_BUTTON_PRESS:
+    case Event::GAME_CONTROLLER_BUTTON_RELEASE:
+    {
+      code = NOM_SCAST(uint8, ev.cbutton.button);
+    } break;
+  }
+
+  key = (NOM_SCAST(uint64, ev.type) << 32) | code;
+
+  return true;
+}
+
+void InputStateMapper::update_index()
+{
+  this->index_.clear();
+
   for( auto itr = this->states_.begin(); itr != this->states_.end(); ++itr ) {
 
-    if( itr->second.active == true ) {
-
-      InputActionMapper::ActionMap input_map = itr->second.actions;
-
-      for( auto itr = input_map.begin(); itr != input_map.end(); ++itr ) {
-
-        switch(ev.type)
-        {
-          default: break;
-
-          case Event::KEY_PRESS:
-          case Event::KEY_RELEASE:
-          {
-            if( this->on_key_press(*itr->second, ev) == true ) {
-              itr->second->operator()(ev);
-            }
-          } break;
-
-          case Event::MOUSE_BUTTON_CLICK:
-          case Event::MOUSE_BUTTON_RELEASE:
-          {
-            if( this->on_mouse_button(*itr->second, ev) == true ) {
-              itr->second->operator()(ev);
-            }
-          } break;
-
-          case Event::MOUSE_WHEEL:
-          {
-            if( this->on_mouse_wheel(*itr->second, ev) == true ) {
-              itr->second->operator()(ev);
-            }
-          } break;
-
-          case Event::JOYSTICK_AXIS_MOTION:
-          {
-            if( this->on_joystick_axis(*itr->second, ev) == true ) {
-              itr->second->operator()(ev);
-            }
-          } break;
-
-          case Event::JOYSTICK_BUTTON_PRESS:
-          case Event::JOYSTICK_BUTTON_RELEASE:
-          {
-            if( this->on_joystick_button(*itr->second, ev) == true ) {
-              itr->second->operator()(ev);
-            }
-          } break;
-
-          case Event::JOYSTICK_HAT_MOTION:
-          {
-            if( this->on_joystick_hat(*itr->second, ev) == true ) {
-              itr->second->operator()(ev);
-            }
-          } break;
-
-          case Event::GAME_CONTROLLER_AXIS_MOTION:
-          {
-            if( this->on_game_controller_axis(*itr->second, ev) == true ) {
-              itr->second->operator()(ev);
-            }
-          } break;
-
-          case Event::GAME_CONTROLLER_BUTTON_PRESS:
-          case Event::GAME_CONTROLLER_BUTTON_RELEASE:
-          {
-            if( this->on_game_controller_button(*itr->second, ev) == true ) {
-              itr->second->operator()(ev);
-            }
-          } break;
-        }
-      } // end input_map iteration
-    } // end conditional active input state
+    if( itr->second.active == false ) {
+      continue;
+    }
+
+    const InputActionMapper::ActionMap& input_map = itr->second.actions;
+    for( auto it = input_map.begin(); it != input_map.end(); ++it ) {
+
+      InputDispatch entry;
+      if( it->second == nullptr ||
+          InputStateMapper::dispatch_key(it->second->event(), entry.key) == false )
+      {
+        continue;
+      }
+
+      entry.action = it->second.get();
+      this->index_.push_back(entry);
+    }
+  }
+
+  // Preserve the relative order of the actions sharing a key
+  std::stable_sort( this->index_.begin(), this->index_.end(),
+                    [](const InputDispatch& lhs, const InputDispatch& rhs) {
+                      return lhs.key < rhs.key;
+                    });
+
+  this->index_dirty_ = false;
+}
+
+void InputStateMapper::invalidate_index()
+{
+  this->index_dirty_ = true;
+  ++this->index_generation_;
+}
+
+void InputStateMapper::on_event(const Event& ev)
+{
+  uint64 key = 0;
+
+  // Not an event type that we map actions to; nothing to do
+  if( InputStateMapper::dispatch_key(ev, key) == false ) {
+    return;
+  }
+
+  // Nested dispatches may re-build the index; the outer dispatch stops on
+  // the generation change before it could touch the old positions
+  if( this->index_dirty_ == true ) {
+    this->update_index();
+  }
+
+  auto first =
+    std::lower_bound( this->index_.begin(), this->index_.end(), key,
+                      [](const InputDispatch& lhs, uint64 rhs) {
+                        return lhs.key < rhs;
+                      });
+  auto last =
+    std::upper_bound( first, this->index_.end(), key,
+                      [](uint64 lhs, const InputDispatch& rhs) {
+                        return lhs < rhs.key;
+                      });
+
+  nom::size_type pos = first - this->index_.begin();
+  const nom::size_type end_pos = last - this->index_.begin();
+  const uint32 generation = this->index_generation_;
+
+  ++this->dispatching_;
+
+  for( ; pos != end_pos; ++pos ) {
+
+    const InputAction* action = this->index_[pos].action;
+    if( this->on_action(*action, ev) == true ) {
+      action->operator()(ev);
+
+      // The callback has changed the states; the remaining actions may no
+      // longer belong to an active state
+      if( this->index_generation_ != generation ) {
+        break;
+      }
+    }
+  }
+
+  --this->dispatching_;
+
+  if( this->dispatching_ == 0 ) {
+    this->retired_actions_.clear();
+  }
+}
+
+bool InputStateMapper::on_action(const InputAction& mapping, const Event& ev)
+{
+  switch(ev.type)
+  {
+    default: return false;
+
+    case Event::KEY_PRESS:
+    case Event::KEY_RELEASE:
+    {
+      return this->on_key_press(mapping, ev);
+    }
+
+    case Event::MOUSE_BUTTON_CLICK:
+    case Event::MOUSE_BUTTON_RELEASE:
+    {
+      return this->on_mouse_button(mapping, ev);
+    }
+
+    case Event::MOUSE_WHEEL:
+    {
+      return this->on_mouse_wheel(mapping, ev);
+    }
+
+    case Event::JOYSTICK_AXIS_MOTION:
+    {
+      return this->on_joystick_axis(mapping, ev);
+    }
+
+    case Event::JOYSTICK_BUTTON_PRESS:
+    case Event::JOYSTICK_BUTTON_RELEASE:
+    {
+      return this->on_joystick_button(mapping, ev);
+    }
+
+    case Event::JOYSTICK_HAT_MOTION:
+    {
+      return this->on_joystick_hat(mapping, ev);
+    }
+
+    case Event::GAME_CONTROLLER_AXIS_MOTION:
+    {
+      return this->on_game_controller_axis(mapping, ev);
+    }
+
+    case Event::GAME_CONTROLLER_BUTTON_PRESS:
+    case Event::GAME_CONTROLLER_BUTTON_RELEASE:
+    {
+      return this->on_game_controller_button(mapping, ev);
+    }
   }
 }
 
 bool
 InputStateMapper::on_key_press(const InputAction& mapping, const Event& ev)
 {
-  Event evt = mapping.event();
+  const Event& evt = mapping.event();
 
   if( evt.type != ev.type ) {
     return false;
@@ -338,7 +486,7 @@ InputStateMapper::on_key_press(const InputAction& mapping, const Event& ev)
 
 bool InputStateMapper::on_mouse_button( const InputAction& mapping, const Event& ev )
 {
-  Event evt = mapping.event();
+  const Event& evt = mapping.event();
 
   if( evt.type != ev.type ) {
     return false;
@@ -359,7 +507,7 @@ bool InputStateMapper::on_mouse_button( const InputAction& mapping, const Event&
 
 bool InputStateMapper::on_mouse_wheel( const InputAction& mapping, const Event& ev )
 {
-  Event evt = mapping.event();
+  const Event& evt = mapping.event();
 
   if( evt.type != ev.type ) {
     return false;
@@ -393,7 +541,7 @@ bool InputStateMapper::on_mouse_wheel( const InputAction& mapping, const Event&
 bool InputStateMapper::
 on_joystick_button(const InputAction& mapping, const Event& ev)
 {
-  Event evt = mapping.event();
+  const Event& evt = mapping.event();
 
   if( evt.type != ev.type ) {
     return false;
@@ -415,7 +563,7 @@ on_joystick_button(const InputAction& mapping, const Event& ev)
 bool InputStateMapper::
 on_joystick_axis(const InputAction& mapping, const Event& ev)
 {
-  Event evt = mapping.event();
+  const Event& evt = mapping.event();
 
   if( evt.type != ev.type ) {
     return false;
@@ -435,7 +583,7 @@ on_joystick_axis(const InputAction& mapping, const Event& ev)
 bool InputStateMapper::
 on_joystick_hat(const InputAction& mapping, const Event& ev)
 {
-  Event evt = mapping.event();
+  const Event& evt = mapping.event();
 
   if( evt.type != ev.type ) {
     return false;
@@ -459,7 +607,7 @@ on_joystick_hat(const InputAction& mapping, const Event& ev)
 bool InputStateMapper::
 on_game_controller_button(const InputAction& mapping, const Event& ev)
 {
-  Event evt = mapping.event();
+  const Event& evt = mapping.event();
 
   if( evt.type != ev.type ) {
     return false;
@@ -481,7 +629,7 @@ on_game_controller_button(const InputAction& mapping, const Event& ev)
 bool InputStateMapper::
 on_game_controller_axis(const InputAction& mapping, const Event& ev)
 {
-  Event evt = mapping.event();
+  const Event& evt = mapping.event();
 
   if( evt.type != ev.type ) {
     return false;
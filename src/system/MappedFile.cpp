@@ -0,0 +1,189 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include "nomlib/system/MappedFile.hpp"
+
+// Private headers
+#include <fstream>
+
+#if defined( NOM_PLATFORM_WINDOWS )
+  #include <windows.h>
+#elif defined( NOM_PLATFORM_POSIX )
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+namespace nom {
+
+namespace priv {
+
+/// \brief Map a file into memory for reading.
+///
+/// \returns The mapping, or NULL when the file could not be mapped; the
+/// caller should fall back to regular file I/O.
+void* map_file(const std::string& filename, nom::size_type& size)
+{
+#if defined( NOM_PLATFORM_WINDOWS )
+  HANDLE fd = CreateFileA(  filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                            nullptr );
+  if( fd == INVALID_HANDLE_VALUE ) {
+    return nullptr;
+  }
+
+  LARGE_INTEGER file_size;
+  HANDLE mapping = nullptr;
+  if( GetFileSizeEx(fd, &file_size) != 0 && file_size.QuadPart > 0 ) {
+    mapping = CreateFileMappingA(fd, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  }
+  CloseHandle(fd);
+
+  if( mapping == nullptr ) {
+    return nullptr;
+  }
+
+  // The view keeps the mapping object alive
+  void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+
+  size = file_size.QuadPart;
+
+  return data;
+#elif defined( NOM_PLATFORM_POSIX )
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if( fd < 0 ) {
+    return nullptr;
+  }
+
+  struct stat file_info;
+  void* data = MAP_FAILED;
+  if( fstat(fd, &file_info) == 0 && file_info.st_size > 0 ) {
+    data = mmap(nullptr, file_info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+
+  // The mapping keeps the file open
+  ::close(fd);
+
+  if( data == MAP_FAILED ) {
+    return nullptr;
+  }
+
+  size = file_info.st_size;
+
+  return data;
+#else
+  return nullptr;
+#endif
+}
+
+void unmap_file(void* mapping, nom::size_type size)
+{
+#if defined( NOM_PLATFORM_WINDOWS )
+  UnmapViewOfFile(mapping);
+#elif defined( NOM_PLATFORM_POSIX )
+  munmap(mapping, size);
+#endif
+}
+
+} // namespace priv
+
+MappedFile::MappedFile() :
+  data_(nullptr),
+  size_(0),
+  mapping_(nullptr)
+{
+}
+
+MappedFile::~MappedFile()
+{
+  this->close();
+}
+
+bool MappedFile::open(const std::string& filename)
+{
+  this->close();
+
+  this->mapping_ = priv::map_file(filename, this->size_);
+  if( this->mapping_ != nullptr ) {
+    this->data_ = NOM_SCAST(const char*, this->mapping_);
+    return true;
+  }
+
+  // Empty files cannot be mapped, and not every platform can map files
+  std::ifstream fp(filename, std::ios::in | std::ios::binary);
+  if( fp.is_open() == false ) {
+    return false;
+  }
+
+  fp.seekg(0, std::ios::end);
+  std::streamoff file_size = fp.tellg();
+  fp.seekg(0, std::ios::beg);
+
+  if( file_size < 0 ) {
+    return false;
+  }
+
+  this->buffer_.resize(file_size);
+  if( file_size > 0 && fp.read(this->buffer_.data(), file_size).good() == false ) {
+    this->buffer_.clear();
+    return false;
+  }
+
+  this->size_ = this->buffer_.size();
+  if( this->size_ > 0 ) {
+    this->data_ = this->buffer_.data();
+  }
+
+  return true;
+}
+
+void MappedFile::close()
+{
+  if( this->mapping_ != nullptr ) {
+    priv::unmap_file(this->mapping_, this->size_);
+    this->mapping_ = nullptr;
+  }
+
+  this->buffer_.clear();
+  this->data_ = nullptr;
+  this->size_ = 0;
+}
+
+const char* MappedFile::data() const
+{
+  return this->data_;
+}
+
+nom::size_type MappedFile::size() const
+{
+  return this->size_;
+}
+
+} // namespace nom
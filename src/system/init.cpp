@@ -204,6 +204,9 @@ void quit( void )
 
   NOM_LOG_DEBUG( NOM_LOG_CATEGORY_MEMORY_TOTALS, "Total memory allocation (in bytes): ", IObject::total_alloc_bytes );
   NOM_LOG_DEBUG( NOM_LOG_CATEGORY_MEMORY_TOTALS, "Total memory deallocation (in bytes): ", IObject::total_dealloc_bytes );
+
+  // Write out the pending log messages, if any, before the application exits
+  SDL2Logger::flush();
 }
 
 } // namespace nom
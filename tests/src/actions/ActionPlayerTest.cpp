@@ -0,0 +1,319 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nomlib/config.hpp>
+#include <nomlib/core/helpers.hpp>
+#include <nomlib/system/init.hpp>
+#include <nomlib/actions/ActionPlayer.hpp>
+#include <nomlib/actions/IActionObject.hpp>
+
+using namespace nom;
+
+/// \brief An action that completes after a fixed number of frames.
+class FrameCountAction: public IActionObject
+{
+  public:
+    explicit FrameCountAction(uint32 num_frames) :
+      num_frames_(num_frames)
+    {
+    }
+
+    virtual ~FrameCountAction()
+    {
+    }
+
+    virtual std::unique_ptr<IActionObject> clone() const override
+    {
+      return( nom::make_unique<FrameCountAction>(this->num_frames_) );
+    }
+
+    virtual IActionObject::FrameState next_frame(real32 delta_time) override
+    {
+      if( this->num_frames_ > 0 ) {
+        --this->num_frames_;
+      }
+
+      if( this->num_frames_ == 0 ) {
+        return FrameState::COMPLETED;
+      } else {
+        return FrameState::PLAYING;
+      }
+    }
+
+    virtual IActionObject::FrameState prev_frame(real32 delta_time) override
+    {
+      return this->next_frame(delta_time);
+    }
+
+    virtual void pause(real32 delta_time) override {}
+    virtual void resume(real32 delta_time) override {}
+    virtual void rewind(real32 delta_time) override {}
+    virtual void release() override {}
+
+  private:
+    uint32 num_frames_;
+};
+
+/// \brief nom::ActionPlayer scheduling unit tests
+class ActionPlayerTest: public ::testing::Test
+{
+  public:
+    /// \remarks This method is called at the start of each unit test.
+    ActionPlayerTest()
+    {
+      //
+    }
+
+    /// \remarks This method is called at the end of each unit test.
+    virtual ~ActionPlayerTest()
+    {
+      //
+    }
+
+    /// \remarks This method is called after construction, at the start of each
+    /// unit test.
+    virtual void SetUp()
+    {
+      //
+    }
+
+    /// \remarks This method is called before destruction, at the end of each
+    /// unit test.
+    virtual void TearDown()
+    {
+      //
+    }
+
+  protected:
+    const real32 DELTA_TIME = 16.0f;
+
+    /// \brief The number of frames to run the stress tests for.
+    const uint32 NUM_FRAMES = 200;
+
+    /// \brief The number of actions spawned per frame in the stress tests.
+    const uint32 ACTIONS_PER_FRAME = 500;
+
+    ActionPlayer player;
+};
+
+TEST_F(ActionPlayerTest, HandleRefersToRunningAction)
+{
+  auto action = std::make_shared<FrameCountAction>(2);
+  ActionPlayer::handle_type handle = player.enqueue_action(action);
+
+  ASSERT_NE(ActionPlayer::INVALID_HANDLE, handle);
+  EXPECT_TRUE( player.action_running(handle) );
+  EXPECT_EQ(1, player.num_actions() );
+
+  EXPECT_TRUE( player.update(DELTA_TIME) );
+  EXPECT_TRUE( player.action_running(handle) );
+
+  EXPECT_FALSE( player.update(DELTA_TIME) );
+  EXPECT_FALSE( player.action_running(handle) );
+  EXPECT_TRUE( player.idle() );
+}
+
+TEST_F(ActionPlayerTest, StaleHandleIsNeverReused)
+{
+  ActionPlayer::handle_type handle =
+    player.enqueue_action( std::make_shared<FrameCountAction>(1) );
+  player.update(DELTA_TIME);
+
+  // The freed slot is recycled, but the old handle must not refer to the
+  // new occupant
+  ActionPlayer::handle_type next_handle =
+    player.enqueue_action( std::make_shared<FrameCountAction>(1) );
+
+  EXPECT_NE(handle, next_handle);
+  EXPECT_FALSE( player.action_running(handle) );
+  EXPECT_FALSE( player.cancel_action(handle) );
+  EXPECT_TRUE( player.action_running(next_handle) );
+}
+
+TEST_F(ActionPlayerTest, CancelActionByHandle)
+{
+  uint32 num_callbacks = 0;
+  ActionPlayer::handle_type handle =
+    player.enqueue_action(  std::make_shared<FrameCountAction>(10),
+                            [&num_callbacks]() { ++num_callbacks; } );
+
+  EXPECT_TRUE( player.cancel_action(handle) );
+  EXPECT_FALSE( player.action_running(handle) );
+  EXPECT_EQ(0, player.num_actions() );
+
+  player.update(DELTA_TIME);
+  EXPECT_EQ(0, num_callbacks);
+}
+
+TEST_F(ActionPlayerTest, RunActionReplacesActionWithSameName)
+{
+  auto action0 = std::make_shared<FrameCountAction>(10);
+  action0->set_name("action");
+  auto action1 = std::make_shared<FrameCountAction>(10);
+  action1->set_name("action");
+
+  ActionPlayer::handle_type handle0 = player.enqueue_action(action0);
+  ActionPlayer::handle_type handle1 = player.enqueue_action(action1);
+
+  EXPECT_FALSE( player.action_running(handle0) );
+  EXPECT_TRUE( player.action_running(handle1) );
+  EXPECT_TRUE( player.action_running("action") );
+  EXPECT_EQ(1, player.num_actions() );
+
+  EXPECT_TRUE( player.cancel_action("action") );
+  EXPECT_FALSE( player.action_running(handle1) );
+  EXPECT_TRUE( player.idle() );
+}
+
+TEST_F(ActionPlayerTest, CompletionCallbackCanEnqueueActions)
+{
+  uint32 num_completed = 0;
+  const uint32 NUM_CHAINED = 100;
+
+  std::function<void()> on_completion = [&]() {
+    ++num_completed;
+    if( num_completed < NUM_CHAINED ) {
+      player.enqueue_action(  std::make_shared<FrameCountAction>(1),
+                              on_completion );
+    }
+  };
+
+  player.enqueue_action(  std::make_shared<FrameCountAction>(1),
+                          on_completion );
+
+  while( player.update(DELTA_TIME) == true ) {
+    // Keep going until the chain is exhausted
+  }
+
+  EXPECT_EQ(NUM_CHAINED, num_completed);
+  EXPECT_TRUE( player.idle() );
+}
+
+TEST_F(ActionPlayerTest, ActionsCompleteInEnqueuedOrder)
+{
+  std::vector<int> order;
+  for( int idx = 0; idx != 8; ++idx ) {
+    player.enqueue_action(  std::make_shared<FrameCountAction>(1),
+                            [&order, idx]() { order.push_back(idx); } );
+  }
+
+  player.update(DELTA_TIME);
+
+  ASSERT_EQ(8, order.size() );
+  for( int idx = 0; idx != 8; ++idx ) {
+    EXPECT_EQ(idx, order[idx]);
+  }
+}
+
+TEST_F(ActionPlayerTest, ManyUnnamedActionsComplete)
+{
+  uint64 num_runs = 0;
+  uint64 num_completed = 0;
+
+  for( uint32 frame = 0; frame != NUM_FRAMES; ++frame ) {
+
+    for( uint32 idx = 0; idx != ACTIONS_PER_FRAME; ++idx ) {
+      player.run_action(  std::make_shared<FrameCountAction>(1 + idx % 8),
+                          [&num_completed]() { ++num_completed; } );
+      ++num_runs;
+    }
+
+    player.update(DELTA_TIME);
+
+    // No action outlives eight frames
+    EXPECT_GE(8 * ACTIONS_PER_FRAME, player.num_actions() );
+  }
+
+  while( player.update(DELTA_TIME) == true ) {
+    // Drain the remaining actions
+  }
+
+  EXPECT_EQ(num_runs, num_completed);
+  EXPECT_TRUE( player.idle() );
+}
+
+TEST_F(ActionPlayerTest, ManyNamedActionsComplete)
+{
+  uint64 num_runs = 0;
+  uint64 num_completed = 0;
+
+  // A fixed pool of names, large enough that a name is free again by the
+  // time that it is reused
+  std::vector<std::string> names;
+  for( uint32 idx = 0; idx != ACTIONS_PER_FRAME * 16; ++idx ) {
+    names.push_back( "action_" + std::to_string(idx) );
+  }
+
+  for( uint32 frame = 0; frame != NUM_FRAMES; ++frame ) {
+
+    for( uint32 idx = 0; idx != ACTIONS_PER_FRAME; ++idx ) {
+      auto action = std::make_shared<FrameCountAction>(1 + idx % 8);
+      action->set_name( names[num_runs % names.size()] );
+      player.run_action(  action,
+                          [&num_completed]() { ++num_completed; } );
+      ++num_runs;
+    }
+
+    player.update(DELTA_TIME);
+
+    EXPECT_GE(8 * ACTIONS_PER_FRAME, player.num_actions() );
+  }
+
+  while( player.update(DELTA_TIME) == true ) {
+    // Drain the remaining actions
+  }
+
+  // No action was replaced by another of the same name
+  EXPECT_EQ(num_runs, num_completed);
+  EXPECT_TRUE( player.idle() );
+
+  for( auto itr = names.begin(); itr != names.end(); ++itr ) {
+    EXPECT_FALSE( player.action_running(*itr) );
+  }
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  // Set the current working directory path to the path leading to this
+  // executable file; used for unit tests that require file-system I/O.
+  if( nom::init(argc, argv) == false ) {
+    NOM_LOG_CRIT(NOM_LOG_CATEGORY_APPLICATION, "Could not initialize nomlib.");
+    return NOM_EXIT_FAILURE;
+  }
+  atexit(nom::quit);
+
+  return RUN_ALL_TESTS();
+}
@@ -28,6 +28,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 #include <iostream>
 #include <string>
+#include <fstream>
+#include <iterator>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -261,6 +264,50 @@ TEST_F(ALAudioTest, SoundBuffer)
   EXPECT_EQ( 455, buffer.getDuration() );
 }
 
+TEST_F(ALAudioTest, SoundBufferSamples)
+{
+  dev = test::create_audio_handle();
+
+  // The decoded samples are released once uploaded
+  SoundBuffer buffer;
+  EXPECT_TRUE( buffer.load(RESOURCE_AUDIO_SOUND) );
+  EXPECT_TRUE( buffer.samples().empty() );
+
+  SoundBuffer retained;
+  retained.set_retain_samples(true);
+  EXPECT_TRUE( retained.load(RESOURCE_AUDIO_SOUND) );
+  EXPECT_FALSE( retained.samples().empty() );
+
+  // Decoding from memory yields the same audio
+  std::ifstream fp( RESOURCE_AUDIO_SOUND, std::ios::binary );
+  std::vector<char> data( ( std::istreambuf_iterator<char>(fp) ),
+                          std::istreambuf_iterator<char>() );
+  ASSERT_FALSE( data.empty() );
+
+  SoundBuffer memory;
+  memory.set_retain_samples(true);
+  EXPECT_TRUE( memory.load( data.data(), data.size() ) );
+  EXPECT_EQ( 455, memory.getDuration() );
+  EXPECT_EQ( retained.samples(), memory.samples() );
+}
+
+TEST_F(ALAudioTest, SoundBank)
+{
+  dev = test::create_audio_handle();
+
+  SoundBank sounds;
+  EXPECT_EQ( 1, sounds.load_dir(APP_RESOURCES_DIR, 2) );
+  EXPECT_EQ( 1, sounds.size() );
+
+  SoundBuffer* buffer = sounds.find("cursor_wrong.wav");
+  ASSERT_TRUE( buffer != nullptr );
+  EXPECT_EQ( 455, buffer->getDuration() );
+  EXPECT_TRUE( sounds.find("nonexistent.wav") == nullptr );
+
+  sounds.clear();
+  EXPECT_EQ( 0, sounds.size() );
+}
+
 TEST_F(ALAudioTest, Sound)
 {
   SoundBuffer buffer;
@@ -304,6 +351,73 @@ TEST_F(ALAudioTest, Music)
   EXPECT_EQ( nom::SoundStatus::Stopped, sound.getStatus() );
 }
 
+TEST_F(ALAudioTest, MusicStream)
+{
+  Music sound;
+  dev = test::create_audio_handle();
+
+  EXPECT_FALSE( sound.streaming() );
+  ASSERT_TRUE( sound.open(RESOURCE_AUDIO_SOUND) );
+  EXPECT_TRUE( sound.streaming() );
+  EXPECT_EQ( nom::SoundStatus::Stopped, sound.getStatus() );
+  EXPECT_EQ( 0.0f, sound.getPlayPosition() );
+
+  sound.setLooping(true);
+  sound.set_loop_points(0.1f, 0.4f);
+  EXPECT_EQ( true, sound.getLooping() );
+  EXPECT_EQ( 0.1f, sound.loop_start() );
+  EXPECT_EQ( 0.4f, sound.loop_end() );
+
+  sound.Play();
+  EXPECT_EQ( nom::SoundStatus::Playing, sound.getStatus() );
+
+  sound.setPlayPosition(0.3f);
+  EXPECT_NEAR( 0.3f, sound.getPlayPosition(), 0.05f );
+
+  sound.Pause();
+  EXPECT_EQ( nom::SoundStatus::Paused, sound.getStatus() );
+
+  sound.Stop();
+  EXPECT_EQ( nom::SoundStatus::Stopped, sound.getStatus() );
+  EXPECT_EQ( 0.0f, sound.getPlayPosition() );
+
+  sound.close();
+  EXPECT_FALSE( sound.streaming() );
+}
+
+TEST_F(ALAudioTest, VoicePool)
+{
+  SoundBuffer buffer;
+  VoicePool voices;
+  dev = test::create_audio_handle();
+
+  EXPECT_TRUE( buffer.load(RESOURCE_AUDIO_SOUND) );
+  ASSERT_TRUE( voices.initialize(2) );
+  EXPECT_EQ( 2, voices.num_voices() );
+
+  auto low = voices.play(buffer);
+  auto high = voices.play(buffer, 10);
+  EXPECT_NE( VoicePool::INVALID_HANDLE, low );
+  EXPECT_NE( VoicePool::INVALID_HANDLE, high );
+  EXPECT_EQ( 2, voices.num_active() );
+
+  // The pool is exhausted; the low priority voice is stolen
+  auto steal = voices.play(buffer, 5);
+  EXPECT_NE( VoicePool::INVALID_HANDLE, steal );
+  EXPECT_FALSE( voices.playing(low) );
+  EXPECT_TRUE( voices.playing(high) );
+  EXPECT_EQ( 1, voices.num_stolen() );
+
+  // Neither voice may be stolen by a less important sound
+  EXPECT_EQ( VoicePool::INVALID_HANDLE, voices.play(buffer, 1) );
+
+  EXPECT_TRUE( voices.stop(high) );
+  EXPECT_FALSE( voices.stop(high) );
+
+  voices.stop(buffer);
+  EXPECT_EQ( 0, voices.num_active() );
+}
+
 TEST_F(ALAudioTest, AudioDeviceLocatorAPI)
 {
   dev = test::create_audio_handle();
@@ -0,0 +1,352 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "nomlib/config.hpp"
+#include "nomlib/core.hpp"
+
+namespace nom {
+
+class AsyncLogWriterTest: public ::testing::Test
+{
+  public:
+    AsyncLogWriterTest( void )
+    {
+      this->options.async = true;
+      this->options.outputs = LogOptions::OUTPUT_FILE;
+      this->options.file_path = "AsyncLogWriterTest.log";
+      this->options.max_file_size = 0;
+      this->options.overflow = LogOptions::OVERFLOW_BLOCK;
+    }
+
+    ~AsyncLogWriterTest( void )
+    {
+      // ...
+    }
+
+    virtual void SetUp( void )
+    {
+      this->remove_log_files();
+    }
+
+    virtual void TearDown( void )
+    {
+      this->remove_log_files();
+    }
+
+    void remove_log_files()
+    {
+      std::remove( this->options.file_path.c_str() );
+
+      for( uint32 idx = 1; idx != 4; ++idx ) {
+        std::string path = this->options.file_path + "." + std::to_string(idx);
+        std::remove( path.c_str() );
+      }
+    }
+
+    /// \brief Get the lines of a log file.
+    std::vector<std::string> read_lines(const std::string& path)
+    {
+      std::vector<std::string> lines;
+      std::ifstream fp( path.c_str() );
+      std::string line;
+
+      while( std::getline(fp, line) ) {
+        lines.push_back(line);
+      }
+
+      return lines;
+    }
+
+    /// \brief Get the size of a file, or -1 when it does not exist.
+    int64 file_size(const std::string& path)
+    {
+      std::ifstream fp( path.c_str(), std::ios::binary | std::ios::ate );
+
+      if( fp.is_open() == false ) {
+        return -1;
+      }
+
+      return fp.tellg();
+    }
+
+  protected:
+    LogOptions options;
+};
+
+TEST_F(AsyncLogWriterTest, WriteInOrder)
+{
+  const uint32 NUM_MESSAGES = 1000;
+  int cat = NOM_LOG_CATEGORY_TEST;
+
+  this->options.queue_capacity = 64;
+
+  {
+    AsyncLogWriter writer(this->options);
+    EXPECT_EQ(64, writer.capacity() );
+
+    for( uint32 idx = 0; idx != NUM_MESSAGES; ++idx ) {
+      std::string msg = "message " + std::to_string(idx) + "\n";
+      EXPECT_TRUE( writer.push(cat, SDL_LOG_PRIORITY_INFO, msg.c_str() ) );
+    }
+
+    writer.flush();
+
+    EXPECT_EQ(NUM_MESSAGES, writer.num_logged(cat) );
+    EXPECT_EQ(0, writer.num_logged(NOM_LOG_CATEGORY_APPLICATION) );
+    EXPECT_EQ(0, writer.num_dropped() );
+
+    // Every message has been written out by now
+    std::vector<std::string> lines = this->read_lines(this->options.file_path);
+    EXPECT_EQ(NUM_MESSAGES, lines.size() );
+  }
+
+  std::vector<std::string> lines = this->read_lines(this->options.file_path);
+  ASSERT_EQ(NUM_MESSAGES, lines.size() );
+
+  for( uint32 idx = 0; idx != NUM_MESSAGES; ++idx ) {
+    EXPECT_EQ("INFO: message " + std::to_string(idx), lines[idx]);
+  }
+}
+
+TEST_F(AsyncLogWriterTest, MultipleThreads)
+{
+  const uint32 NUM_THREADS = 4;
+  const uint32 NUM_MESSAGES = 2500;
+
+  this->options.queue_capacity = 16;
+
+  {
+    AsyncLogWriter writer(this->options);
+    std::vector<std::thread> producers;
+
+    for( uint32 thread_id = 0; thread_id != NUM_THREADS; ++thread_id ) {
+      producers.push_back( std::thread( [&writer, thread_id, NUM_MESSAGES]() {
+        for( uint32 idx = 0; idx != NUM_MESSAGES; ++idx ) {
+          std::string msg = std::to_string(thread_id) + " " + std::to_string(idx);
+          writer.push(NOM_LOG_CATEGORY_CUSTOM + thread_id, SDL_LOG_PRIORITY_WARN,
+                      msg.c_str() );
+        }
+      }));
+    }
+
+    for( auto itr = producers.begin(); itr != producers.end(); ++itr ) {
+      itr->join();
+    }
+
+    for( uint32 thread_id = 0; thread_id != NUM_THREADS; ++thread_id ) {
+      EXPECT_EQ(NUM_MESSAGES, writer.num_logged(NOM_LOG_CATEGORY_CUSTOM + thread_id) );
+    }
+    EXPECT_EQ(0, writer.num_dropped() );
+  }
+
+  std::vector<std::string> lines = this->read_lines(this->options.file_path);
+  ASSERT_EQ(NUM_THREADS * NUM_MESSAGES, lines.size() );
+
+  // The messages of each thread are written in the order that they were
+  // logged in
+  std::vector<int> next_message(NUM_THREADS, 0);
+  for( auto itr = lines.begin(); itr != lines.end(); ++itr ) {
+    int thread_id = -1;
+    int idx = -1;
+
+    ASSERT_EQ(2, std::sscanf(itr->c_str(), "WARN: %d %d", &thread_id, &idx) );
+    ASSERT_TRUE(thread_id >= 0 && thread_id < (int)NUM_THREADS);
+    EXPECT_EQ(next_message[thread_id], idx);
+    next_message[thread_id] = idx + 1;
+  }
+}
+
+TEST_F(AsyncLogWriterTest, OverflowDrop)
+{
+  const uint32 NUM_MESSAGES = 10000;
+  int cat = NOM_LOG_CATEGORY_TEST;
+
+  this->options.queue_capacity = 2;
+  this->options.overflow = LogOptions::OVERFLOW_DROP;
+
+  uint64 num_logged = 0;
+  {
+    AsyncLogWriter writer(this->options);
+
+    for( uint32 idx = 0; idx != NUM_MESSAGES; ++idx ) {
+      writer.push(cat, SDL_LOG_PRIORITY_INFO, "message");
+    }
+
+    writer.flush();
+
+    num_logged = writer.num_logged(cat);
+    EXPECT_EQ(NUM_MESSAGES, num_logged + writer.num_dropped(cat) );
+    EXPECT_EQ(writer.num_dropped(), writer.num_dropped(cat) );
+  }
+
+  std::vector<std::string> lines = this->read_lines(this->options.file_path);
+  EXPECT_EQ(num_logged, lines.size() );
+}
+
+TEST_F(AsyncLogWriterTest, OverflowCount)
+{
+  const uint32 NUM_MESSAGES = 10000;
+  int cat = NOM_LOG_CATEGORY_TEST;
+
+  this->options.queue_capacity = 2;
+  this->options.overflow = LogOptions::OVERFLOW_COUNT;
+
+  uint64 num_dropped = 0;
+  {
+    AsyncLogWriter writer(this->options);
+
+    for( uint32 idx = 0; idx != NUM_MESSAGES; ++idx ) {
+      writer.push(cat, SDL_LOG_PRIORITY_INFO, "message");
+    }
+
+    num_dropped = writer.num_dropped(cat);
+  }
+
+  std::vector<std::string> lines = this->read_lines(this->options.file_path);
+
+  uint64 num_reported = 0;
+  for( auto itr = lines.begin(); itr != lines.end(); ++itr ) {
+    unsigned long long count = 0;
+    if( std::sscanf(itr->c_str(), "WARN: %llu log messages were dropped", &count) == 1 ) {
+      num_reported += count;
+    }
+  }
+
+  EXPECT_EQ(num_dropped, num_reported);
+}
+
+TEST_F(AsyncLogWriterTest, RotateFiles)
+{
+  const nom::size_type MAX_FILE_SIZE = 256;
+  int cat = NOM_LOG_CATEGORY_TEST;
+
+  this->options.max_file_size = MAX_FILE_SIZE;
+  this->options.max_files = 3;
+
+  {
+    AsyncLogWriter writer(this->options);
+
+    for( uint32 idx = 0; idx != 100; ++idx ) {
+      writer.push(cat, SDL_LOG_PRIORITY_INFO, "rotating message\n");
+    }
+  }
+
+  const std::string& path = this->options.file_path;
+
+  EXPECT_GT( this->file_size(path), 0 );
+  EXPECT_LE( this->file_size(path), MAX_FILE_SIZE );
+  EXPECT_GT( this->file_size(path + ".1"), 0 );
+  EXPECT_LE( this->file_size(path + ".1"), MAX_FILE_SIZE );
+  EXPECT_GT( this->file_size(path + ".2"), 0 );
+  EXPECT_EQ( -1, this->file_size(path + ".3") );
+}
+
+TEST_F(AsyncLogWriterTest, SDL2LoggerOutput)
+{
+  int cat = NOM_LOG_CATEGORY_TEST;
+
+  SDL2Logger::initialize(this->options);
+  ASSERT_TRUE( SDL2Logger::log_writer() != nullptr );
+
+  SDL2Logger::set_logging_priority( cat, nom::LogPriority::NOM_LOG_PRIORITY_INFO );
+
+  NOM_LOG_INFO( cat, "logged from the", "application" );
+  NOM_LOG_DEBUG( cat, "filtered out" );
+
+  SDL2Logger::flush();
+  EXPECT_EQ(1, SDL2Logger::log_writer()->num_logged(cat) );
+
+  SDL2Logger::shutdown();
+  EXPECT_TRUE( SDL2Logger::log_writer() == nullptr );
+
+  std::vector<std::string> lines = this->read_lines(this->options.file_path);
+  ASSERT_EQ(1, lines.size() );
+  EXPECT_EQ("INFO: logged from the application", lines[0]);
+}
+
+/// \brief Replace the writer while other threads are logging.
+TEST_F(AsyncLogWriterTest, SDL2LoggerShutdownWhileLogging)
+{
+  const uint32 NUM_THREADS = 4;
+  const uint32 NUM_MESSAGES = 500;
+  int cat = NOM_LOG_CATEGORY_TEST;
+  std::atomic<uint32> num_finished(0);
+  std::vector<std::thread> threads;
+
+  SDL2Logger::set_logging_priority( cat, nom::LogPriority::NOM_LOG_PRIORITY_INFO );
+  SDL2Logger::initialize(this->options);
+
+  for( uint32 idx = 0; idx != NUM_THREADS; ++idx ) {
+    threads.emplace_back( [&]() {
+      for( uint32 msg = 0; msg != NUM_MESSAGES; ++msg ) {
+        NOM_LOG_INFO( cat, "logged while the writer is replaced" );
+      }
+
+      ++num_finished;
+    });
+  }
+
+  while( num_finished.load() != NUM_THREADS ) {
+    SDL2Logger::shutdown();
+    SDL2Logger::initialize(this->options);
+  }
+
+  for( auto itr = threads.begin(); itr != threads.end(); ++itr ) {
+    itr->join();
+  }
+
+  SDL2Logger::shutdown();
+  EXPECT_TRUE( SDL2Logger::log_writer() == nullptr );
+
+  // The messages logged between writers went to the console instead
+  std::vector<std::string> lines = this->read_lines(this->options.file_path);
+  EXPECT_GT( lines.size(), 0 );
+  EXPECT_LE( lines.size(), NUM_THREADS * NUM_MESSAGES );
+
+  for( auto itr = lines.begin(); itr != lines.end(); ++itr ) {
+    EXPECT_EQ("INFO: logged while the writer is replaced", *itr);
+  }
+}
+
+} // namespace nom
+
+int main( int argc, char** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+
+  return RUN_ALL_TESTS();
+}
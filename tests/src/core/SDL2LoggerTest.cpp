@@ -48,6 +48,26 @@ void log_message( void* ptr, int cat, SDL_LogPriority prio, const char* msg )
   std::cout << msg << std::endl;
 }
 
+/// \brief The last message received by captured_log_message.
+std::string captured_message;
+
+/// \brief Customized log output function that records the message.
+///
+/// \remarks This function is used only in the
+/// SDL2LoggerTest::FilteredMessage and SDL2LoggerTest::LongMessage unit tests.
+void captured_log_message(  void* ptr, int cat, SDL_LogPriority prio,
+                            const char* msg )
+{
+  captured_message = msg;
+}
+
+/// \brief Counts the number of times that a log argument is evaluated.
+int evaluated_argument( int& num_evaluations )
+{
+  ++num_evaluations;
+  return num_evaluations;
+}
+
 /// \remarks For use with NOM_LOG_TRACE functionality testing
 struct FunctionTraceTest
 {
@@ -308,6 +328,59 @@ TEST( SDL2LoggerTest, CustomLogOutputFunction )
   NOM_LOG_CRIT(cat, out);
 }
 
+TEST( SDL2LoggerTest, FilteredMessage )
+{
+  int cat = NOM_LOG_CATEGORY_TEST;
+  int num_evaluations = 0;
+
+  SDL_LogOutputFunction prev_log_output = nullptr;
+  void* prev_data = nullptr;
+  SDL_LogGetOutputFunction( &prev_log_output, &prev_data );
+  SDL_LogSetOutputFunction( captured_log_message, nullptr );
+
+  // Should not see this logged message; the arguments are never evaluated
+  SDL2Logger::set_logging_priority( cat, nom::LogPriority::NOM_LOG_PRIORITY_WARN );
+  EXPECT_FALSE( SDL2Logger::enabled( cat, nom::LogPriority::NOM_LOG_PRIORITY_INFO ) );
+
+  captured_message.clear();
+  NOM_LOG_INFO( cat, "evaluated:", evaluated_argument(num_evaluations) );
+  EXPECT_EQ( 0, num_evaluations );
+  EXPECT_EQ( "", captured_message );
+
+  // Should see this logged message
+  EXPECT_TRUE( SDL2Logger::enabled( cat, nom::LogPriority::NOM_LOG_PRIORITY_WARN ) );
+
+  NOM_LOG_MESSAGE( cat, nom::LogPriority::NOM_LOG_PRIORITY_WARN, "evaluated:",
+                   evaluated_argument(num_evaluations), Point2i(1, 2) );
+  EXPECT_EQ( 1, num_evaluations );
+  EXPECT_EQ( "evaluated: 1 1, 2\n", captured_message );
+
+  SDL_LogSetOutputFunction( prev_log_output, prev_data );
+}
+
+TEST( SDL2LoggerTest, LongMessage )
+{
+  int cat = NOM_LOG_CATEGORY_TEST;
+
+  SDL_LogOutputFunction prev_log_output = nullptr;
+  void* prev_data = nullptr;
+  SDL_LogGetOutputFunction( &prev_log_output, &prev_data );
+  SDL_LogSetOutputFunction( captured_log_message, nullptr );
+
+  SDL2Logger::set_logging_priority( cat, nom::LogPriority::NOM_LOG_PRIORITY_VERBOSE );
+
+  // The message is truncated to the logging buffer
+  std::string out( priv::LogBuffer::MAX_MESSAGE_LENGTH * 2, 'x' );
+
+  captured_message.clear();
+  NOM_LOG_INFO( cat, out, "tail" );
+  ASSERT_EQ( priv::LogBuffer::MAX_MESSAGE_LENGTH - 1, captured_message.size() );
+  EXPECT_EQ( '\n', captured_message.back() );
+  EXPECT_EQ( std::string::npos, captured_message.find("tail") );
+
+  SDL_LogSetOutputFunction( prev_log_output, prev_data );
+}
+
 int main( int argc, char** argv )
 {
   ::testing::InitGoogleTest( &argc, argv );
@@ -0,0 +1,151 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include <gtest/gtest.h>
+
+#include <nomlib/config.hpp>
+#include <nomlib/system/init.hpp>
+#include <nomlib/graphics/fonts/GlyphAtlas.hpp>
+
+using namespace nom;
+
+/// \brief nom::GlyphAtlas unit tests
+class GlyphAtlasTest: public ::testing::Test
+{
+  public:
+    /// \remarks This method is called at the start of each unit test.
+    GlyphAtlasTest()
+    {
+      //
+    }
+
+    /// \remarks This method is called at the end of each unit test.
+    virtual ~GlyphAtlasTest()
+    {
+      //
+    }
+
+  protected:
+    GlyphAtlas atlas;
+};
+
+TEST_F(GlyphAtlasTest, EmptyAtlas)
+{
+  EXPECT_TRUE( atlas.empty() );
+  EXPECT_EQ(0, atlas.size() );
+  EXPECT_FALSE( atlas.contains('A') );
+  EXPECT_TRUE( atlas.find(0x263A) == nullptr );
+
+  // An empty glyph is returned for missing codepoints, without storing it
+  EXPECT_EQ(0, atlas.glyph('A').advance);
+  EXPECT_EQ(Glyph().bounds.w, atlas.glyph(0x263A).bounds.w);
+  EXPECT_TRUE( atlas.empty() );
+}
+
+TEST_F(GlyphAtlasTest, DirectRangeGlyphs)
+{
+  atlas['A'].advance = 8;
+  atlas[0xE9].advance = 9; // Latin-1 e acute
+
+  EXPECT_EQ(2, atlas.size() );
+  EXPECT_TRUE( atlas.contains('A') );
+  EXPECT_TRUE( atlas.contains(0xE9) );
+  EXPECT_FALSE( atlas.contains('B') );
+
+  EXPECT_EQ(8, atlas.glyph('A').advance);
+  EXPECT_EQ(9, atlas.glyph(0xE9).advance);
+
+  // Lookups of missing codepoints within the range do not insert glyphs
+  EXPECT_EQ(0, atlas.glyph('B').advance);
+  EXPECT_EQ(2, atlas.size() );
+}
+
+TEST_F(GlyphAtlasTest, ExtendedRangeGlyphs)
+{
+  // Inserted out of order
+  atlas[0x263A].advance = 3;
+  atlas[0x0100].advance = 1;
+  atlas[0x10348].advance = 4;
+  atlas[0x2000].advance = 2;
+
+  EXPECT_EQ(4, atlas.size() );
+  EXPECT_EQ(1, atlas.glyph(0x0100).advance);
+  EXPECT_EQ(2, atlas.glyph(0x2000).advance);
+  EXPECT_EQ(3, atlas.glyph(0x263A).advance);
+  EXPECT_EQ(4, atlas.glyph(0x10348).advance);
+  EXPECT_FALSE( atlas.contains(0x2001) );
+
+  // Existing glyphs are not replaced
+  atlas[0x2000].bounds.w = 12;
+  EXPECT_EQ(2, atlas.glyph(0x2000).advance);
+  EXPECT_EQ(12, atlas.glyph(0x2000).bounds.w);
+  EXPECT_EQ(4, atlas.size() );
+}
+
+TEST_F(GlyphAtlasTest, ClearAtlas)
+{
+  atlas['A'].advance = 8;
+  atlas[0x263A].advance = 3;
+
+  atlas.clear();
+
+  EXPECT_TRUE( atlas.empty() );
+  EXPECT_FALSE( atlas.contains('A') );
+  EXPECT_FALSE( atlas.contains(0x263A) );
+
+  // Glyphs inserted after clearing start out empty
+  EXPECT_EQ(0, atlas['A'].advance);
+}
+
+TEST_F(GlyphAtlasTest, CopyAtlas)
+{
+  atlas['A'].advance = 8;
+  atlas[0x263A].advance = 3;
+
+  GlyphAtlas copy(atlas);
+  atlas['A'].advance = 16;
+
+  EXPECT_EQ(2, copy.size() );
+  EXPECT_EQ(8, copy.glyph('A').advance);
+  EXPECT_EQ(3, copy.glyph(0x263A).advance);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  // Set the current working directory path to the path leading to this
+  // executable file; used for unit tests that require file-system I/O.
+  if( nom::init(argc, argv) == false ) {
+    NOM_LOG_CRIT(NOM_LOG_CATEGORY_APPLICATION, "Could not initialize nomlib.");
+    return NOM_EXIT_FAILURE;
+  }
+  atexit(nom::quit);
+
+  return RUN_ALL_TESTS();
+}
@@ -201,6 +201,19 @@ TEST_F( GradientTest, RightToLeftLinearFill )
   EXPECT_TRUE( this->compare() );
 }
 
+TEST_F( GradientTest, MultipleColorStops )
+{
+  Color4iColors stops = { Color4i::Red, Color4i::Green, Color4i::Blue };
+
+  this->grad1.set_colors( stops );
+  this->grad1.set_fill_direction( Gradient::FillDirection::Top );
+  this->grad2.set_colors( stops );
+  this->grad2.set_fill_direction( Gradient::FillDirection::Left );
+
+  EXPECT_EQ( NOM_EXIT_SUCCESS, this->on_run() );
+  EXPECT_TRUE( this->compare() );
+}
+
 // TOOD: Verify / fix margins calculations for left to right directions
 TEST_F( GradientTest, Margins )
 {
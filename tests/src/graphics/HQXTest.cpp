@@ -0,0 +1,234 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include <iterator>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nomlib/config.hpp>
+#include <nomlib/system/init.hpp>
+#include <nomlib/graphics/hqx/hqx.hpp>
+
+using namespace nom;
+
+/// \brief hqx rescale algorithm unit tests
+class HQXTest: public ::testing::Test
+{
+  public:
+    /// \remarks This method is called at the start of each unit test.
+    HQXTest()
+    {
+      //
+    }
+
+    /// \remarks This method is called at the end of each unit test.
+    virtual ~HQXTest()
+    {
+      //
+    }
+
+    /// \remarks This method is called after construction, at the start of each
+    /// unit test.
+    virtual void SetUp()
+    {
+      // Start every test from an unbuilt lookup table
+      priv::hqx_set_color_mode(priv::HQX_COLOR_COMPACT);
+      priv::hqx_set_color_mode(priv::HQX_COLOR_TABLE);
+
+      this->frame_.resize(FRAME_WIDTH * FRAME_HEIGHT);
+
+      // Synthetic frame of hard edged stripes over a gradient; gives the
+      // algorithm a mix of flat areas and edges to interpolate
+      for( int y = 0; y != FRAME_HEIGHT; ++y ) {
+        for( int x = 0; x != FRAME_WIDTH; ++x ) {
+
+          uint32 pixel = 0xFF000000 | (x << 16) | (y << 8) | ((x ^ y) & 0xFF);
+          if( ( (x / 8) + (y / 8) ) % 3 == 0 ) {
+            pixel = 0xFFFFFFFF;
+          }
+
+          this->frame_[x + (y * FRAME_WIDTH)] = pixel;
+        }
+      }
+    }
+
+    /// \remarks This method is called before destruction, at the end of each
+    /// unit test.
+    virtual void TearDown()
+    {
+      // Release the lookup table
+      priv::hqx_set_color_mode(priv::HQX_COLOR_COMPACT);
+      priv::hqx_set_color_mode(priv::HQX_COLOR_TABLE);
+
+      priv::hqx_set_path(priv::HQX_PATH_SIMD);
+      priv::hqx_set_max_threads(0);
+    }
+
+  protected:
+    /// \brief The dimensions of the test frame; the SNES resolution.
+    static const int FRAME_WIDTH = 256;
+    static const int FRAME_HEIGHT = 224;
+
+    std::vector<uint32> frame_;
+
+    typedef void (*hqx_func)(uint32*, uint32*, int, int);
+
+    /// \brief Rescale the test frame using the given color mode.
+    void scale_frame_in_mode( enum priv::HQXColorMode mode,
+                              hqx_func scale, int factor,
+                              std::vector<uint32>& output )
+    {
+      output.assign(FRAME_WIDTH * factor * FRAME_HEIGHT * factor, 0);
+
+      priv::hqx_set_color_mode(mode);
+
+      priv::hqxInit();
+      scale(this->frame_.data(), output.data(), FRAME_WIDTH, FRAME_HEIGHT);
+    }
+
+    /// \brief Rescale the test frame with the given kernel implementation.
+    void scale_frame( enum priv::HQXPath path, uint32 num_threads,
+                      hqx_func scale, int factor, std::vector<uint32>& output )
+    {
+      output.assign(FRAME_WIDTH * factor * FRAME_HEIGHT * factor, 0);
+
+      priv::hqx_set_path(path);
+      priv::hqx_set_max_threads(num_threads);
+
+      priv::hqxInit();
+      scale(this->frame_.data(), output.data(), FRAME_WIDTH, FRAME_HEIGHT);
+    }
+
+    /// \brief Compare the output of the kernel implementations and thread
+    /// counts against the single-threaded scalar reference.
+    void expect_paths_equal(hqx_func scale, int factor)
+    {
+      std::vector<uint32> expected;
+      std::vector<uint32> result;
+
+      this->scale_frame(priv::HQX_PATH_SCALAR, 1, scale, factor, expected);
+
+      // The thread counts include one that does not divide the frame height
+      const uint32 num_threads[] = { 1, 3, 4 };
+      for( auto itr = std::begin(num_threads);
+           itr != std::end(num_threads);
+           ++itr )
+      {
+        this->scale_frame(priv::HQX_PATH_SCALAR, *itr, scale, factor, result);
+        EXPECT_TRUE(expected == result) << "threads: " << *itr;
+
+        this->scale_frame(priv::HQX_PATH_SIMD, *itr, scale, factor, result);
+        EXPECT_TRUE(expected == result) << "SIMD threads: " << *itr;
+      }
+    }
+
+    /// \brief Compare the output of the compact color mode against the
+    /// lookup table.
+    void expect_modes_equal(hqx_func scale, int factor)
+    {
+      std::vector<uint32> table_output;
+      std::vector<uint32> compact_output;
+
+      this->scale_frame_in_mode( priv::HQX_COLOR_TABLE, scale, factor,
+                                 table_output );
+      this->scale_frame_in_mode( priv::HQX_COLOR_COMPACT, scale, factor,
+                                 compact_output );
+
+      EXPECT_TRUE(table_output == compact_output);
+    }
+};
+
+TEST_F(HQXTest, ColorModesAreEquivalent)
+{
+  priv::hqx_set_color_mode(priv::HQX_COLOR_TABLE);
+  priv::hqxInit();
+
+  ASSERT_TRUE(priv::RGBtoYUV != nullptr);
+
+  for( uint32 c = 0; c != 16777216; ++c ) {
+    ASSERT_EQ(priv::RGBtoYUV[c], priv::rgb_to_yuv_compact(c))
+    << "color: " << c;
+  }
+}
+
+TEST_F(HQXTest, InitBuildsTableOnce)
+{
+  priv::hqx_set_color_mode(priv::HQX_COLOR_TABLE);
+  EXPECT_TRUE(priv::RGBtoYUV == nullptr);
+
+  priv::hqxInit();
+  uint32* table = priv::RGBtoYUV;
+  EXPECT_TRUE(table != nullptr);
+
+  priv::hqxInit();
+  EXPECT_EQ(table, priv::RGBtoYUV);
+}
+
+TEST_F(HQXTest, CompactModeReleasesTable)
+{
+  priv::hqx_set_color_mode(priv::HQX_COLOR_TABLE);
+  priv::hqxInit();
+  EXPECT_TRUE(priv::RGBtoYUV != nullptr);
+
+  priv::hqx_set_color_mode(priv::HQX_COLOR_COMPACT);
+  EXPECT_EQ(priv::HQX_COLOR_COMPACT, priv::hqx_color_mode());
+  EXPECT_TRUE(priv::RGBtoYUV == nullptr);
+
+  priv::hqxInit();
+  EXPECT_TRUE(priv::RGBtoYUV == nullptr);
+}
+
+TEST_F(HQXTest, KernelPathsAreEquivalent)
+{
+  this->expect_paths_equal(priv::hq2x_32, 2);
+  this->expect_paths_equal(priv::hq3x_32, 3);
+  this->expect_paths_equal(priv::hq4x_32, 4);
+}
+
+TEST_F(HQXTest, ColorModesScaleEquivalently)
+{
+  this->expect_modes_equal(priv::hq2x_32, 2);
+  this->expect_modes_equal(priv::hq3x_32, 3);
+  this->expect_modes_equal(priv::hq4x_32, 4);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  // Set the current working directory path to the path leading to this
+  // executable file; used for unit tests that require file-system I/O.
+  if( nom::init(argc, argv) == false ) {
+    NOM_LOG_CRIT(NOM_LOG_CATEGORY_APPLICATION, "Could not initialize nomlib.");
+    return NOM_EXIT_FAILURE;
+  }
+  atexit(nom::quit);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,221 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include <iterator>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nomlib/config.hpp>
+#include <nomlib/system/init.hpp>
+#include <nomlib/graphics/scale2x/scale2x.hpp>
+
+using namespace nom;
+
+/// \brief scale2x rescale algorithm unit tests
+class ScaleXTest: public ::testing::Test
+{
+  public:
+    /// \remarks This method is called at the start of each unit test.
+    ScaleXTest()
+    {
+      //
+    }
+
+    /// \remarks This method is called at the end of each unit test.
+    virtual ~ScaleXTest()
+    {
+      //
+    }
+
+    /// \remarks This method is called after construction, at the start of each
+    /// unit test.
+    virtual void SetUp()
+    {
+      //
+    }
+
+    /// \remarks This method is called before destruction, at the end of each
+    /// unit test.
+    virtual void TearDown()
+    {
+      priv::scalex_set_path(priv::SCALEX_PATH_SIMD);
+      priv::scalex_set_max_threads(0);
+    }
+
+  protected:
+    typedef bool (*scalex_func)(  void*, void*, const int32, const int32,
+                                  const int32, const int32, int32 );
+
+    /// \brief Generate a frame of pseudo-random pixels drawn from a small
+    /// palette, so that neighbouring pixels are frequently equal.
+    std::vector<uint32> make_frame(int width, int height)
+    {
+      std::vector<uint32> frame(width * height);
+
+      uint32 seed = width * 31 + height;
+      for( auto itr = frame.begin(); itr != frame.end(); ++itr ) {
+        seed = seed * 1103515245 + 12345;
+        *itr = 0xFF000000 | ( (seed >> 16) % 3 );
+      }
+
+      return frame;
+    }
+
+    /// \brief Rescale a 32-bit frame with the given implementation.
+    std::vector<uint32> scale_frame(  enum priv::ScaleXPath path,
+                                      uint32 num_threads, scalex_func scale,
+                                      int factor,
+                                      const std::vector<uint32>& frame,
+                                      int width, int height )
+    {
+      std::vector<uint32> output(width * factor * height * factor, 0);
+
+      priv::scalex_set_path(path);
+      priv::scalex_set_max_threads(num_threads);
+
+      EXPECT_TRUE( scale( (void*)frame.data(), output.data(), width, height,
+                          32, width * 4, width * factor * 4 ) );
+
+      return output;
+    }
+
+    /// \brief Compare the output of the implementations and thread counts
+    /// against the single-threaded scalar reference.
+    void expect_paths_equal(scalex_func scale, int factor)
+    {
+      // Includes dimensions smaller than one SIMD step, sizes that are not a
+      // multiple of it and a frame tall enough to be split across threads
+      const int sizes[][2] = {  {1, 1}, {2, 3}, {5, 1}, {1, 7}, {7, 9},
+                                {17, 33}, {301, 45} };
+
+      for( auto size = std::begin(sizes); size != std::end(sizes); ++size ) {
+
+        int width = (*size)[0];
+        int height = (*size)[1];
+        std::vector<uint32> frame = this->make_frame(width, height);
+
+        std::vector<uint32> expected =
+          this->scale_frame(  priv::SCALEX_PATH_SCALAR, 1, scale, factor,
+                              frame, width, height );
+
+        const uint32 num_threads[] = { 1, 3, 4 };
+        for( auto itr = std::begin(num_threads);
+             itr != std::end(num_threads);
+             ++itr )
+        {
+          EXPECT_TRUE( expected ==
+                       this->scale_frame( priv::SCALEX_PATH_SCALAR, *itr,
+                                          scale, factor, frame, width,
+                                          height ) )
+          << "size: " << width << "x" << height << " threads: " << *itr;
+
+          EXPECT_TRUE( expected ==
+                       this->scale_frame( priv::SCALEX_PATH_SIMD, *itr,
+                                          scale, factor, frame, width,
+                                          height ) )
+          << "size: " << width << "x" << height << " SIMD threads: " << *itr;
+        }
+      }
+    }
+};
+
+TEST_F(ScaleXTest, Scale2xPathsAreEquivalent)
+{
+  this->expect_paths_equal(priv::scale2x, 2);
+}
+
+TEST_F(ScaleXTest, Scale3xPathsAreEquivalent)
+{
+  this->expect_paths_equal(priv::scale3x, 3);
+}
+
+TEST_F(ScaleXTest, Scale4xPathsAreEquivalent)
+{
+  this->expect_paths_equal(priv::scale4x, 4);
+}
+
+TEST_F(ScaleXTest, Scale2xKnownPattern)
+{
+  // A two by two checkerboard; the edge pixels of the frame are clamped, so
+  // each pixel sees its own color outside of the frame
+  //
+  //   X o
+  //   o X
+  const uint32 X = 0xFFFFFFFF;
+  const uint32 o = 0xFF000000;
+
+  std::vector<uint32> frame = { X, o,
+                                o, X };
+
+  const std::vector<uint32> expected = {  X, X, o, o,
+                                          X, o, X, o,
+                                          o, X, o, X,
+                                          o, o, X, X };
+
+  EXPECT_TRUE( expected ==
+               this->scale_frame( priv::SCALEX_PATH_SIMD, 1, priv::scale2x, 2,
+                                  frame, 2, 2 ) );
+}
+
+TEST_F(ScaleXTest, Scale3xMatchesAcrossColorDepths)
+{
+  const int width = 17;
+  const int height = 33;
+  std::vector<uint32> frame = this->make_frame(width, height);
+
+  std::vector<uint32> expected =
+    this->scale_frame(  priv::SCALEX_PATH_SCALAR, 1, priv::scale3x, 3, frame,
+                        width, height );
+
+  // The frame's palette only differs in the lowest byte
+  std::vector<uint8> frame8( frame.begin(), frame.end() );
+  std::vector<uint8> output8(width * 3 * height * 3, 0);
+
+  EXPECT_TRUE( priv::scale3x( frame8.data(), output8.data(), width, height,
+                              8, width, width * 3 ) );
+
+  for( nom::size_type i = 0; i != expected.size(); ++i ) {
+    ASSERT_EQ( (uint8)expected[i], output8[i] ) << "pixel: " << i;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  // Set the current working directory path to the path leading to this
+  // executable file; used for unit tests that require file-system I/O.
+  if( nom::init(argc, argv) == false ) {
+    NOM_LOG_CRIT(NOM_LOG_CATEGORY_APPLICATION, "Could not initialize nomlib.");
+    return NOM_EXIT_FAILURE;
+  }
+  atexit(nom::quit);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,197 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nomlib/config.hpp>
+#include <nomlib/system/init.hpp>
+#include <nomlib/graphics/SkylinePacker.hpp>
+
+using namespace nom;
+
+/// \brief nom::SkylinePacker unit tests
+class SkylinePackerTest: public ::testing::Test
+{
+  public:
+    /// \remarks This method is called at the start of each unit test.
+    SkylinePackerTest()
+    {
+      //
+    }
+
+    /// \remarks This method is called at the end of each unit test.
+    virtual ~SkylinePackerTest()
+    {
+      //
+    }
+
+  protected:
+    /// \brief Check that every rectangle lies within the bin, and that no two
+    /// rectangles overlap.
+    ::testing::AssertionResult
+    disjoint(const std::vector<IntRect>& rects, const Size2i& bin_size)
+    {
+      for( auto itr = rects.begin(); itr != rects.end(); ++itr ) {
+
+        if( itr->x < 0 || itr->y < 0 || itr->x + itr->w > bin_size.w ||
+            itr->y + itr->h > bin_size.h )
+        {
+          return ::testing::AssertionFailure()
+            << "rectangle " << *itr << " is out of bounds";
+        }
+
+        for( auto other = rects.begin(); other != itr; ++other ) {
+          if( itr->x < other->x + other->w && other->x < itr->x + itr->w &&
+              itr->y < other->y + other->h && other->y < itr->y + itr->h )
+          {
+            return ::testing::AssertionFailure()
+              << "rectangle " << *itr << " overlaps " << *other;
+          }
+        }
+      }
+
+      return ::testing::AssertionSuccess();
+    }
+
+    /// \brief Deterministic pseudo-random rectangle dimensions.
+    Size2i next_dims()
+    {
+      this->seed_ = this->seed_ * 1103515245 + 12345;
+      int w = 1 + (this->seed_ >> 16) % 24;
+
+      this->seed_ = this->seed_ * 1103515245 + 12345;
+      int h = 1 + (this->seed_ >> 16) % 24;
+
+      return Size2i(w, h);
+    }
+
+  private:
+    uint32 seed_ = 1;
+};
+
+TEST_F(SkylinePackerTest, EmptyBin)
+{
+  SkylinePacker packer;
+
+  EXPECT_EQ(IntRect::null, packer.pack( Size2i(1, 1) ) );
+  EXPECT_FLOAT_EQ(0.0f, packer.occupancy() );
+}
+
+TEST_F(SkylinePackerTest, PackRowsBottomLeft)
+{
+  SkylinePacker packer( Size2i(64, 64) );
+
+  EXPECT_EQ( IntRect(0, 0, 32, 16), packer.pack( Size2i(32, 16) ) );
+  EXPECT_EQ( IntRect(32, 0, 32, 16), packer.pack( Size2i(32, 16) ) );
+  EXPECT_EQ( IntRect(0, 16, 64, 8), packer.pack( Size2i(64, 8) ) );
+
+  EXPECT_FLOAT_EQ(0.375f, packer.occupancy() );
+}
+
+TEST_F(SkylinePackerTest, RejectOversizedRect)
+{
+  SkylinePacker packer( Size2i(64, 64) );
+
+  EXPECT_EQ(IntRect::null, packer.pack( Size2i(65, 1) ) );
+  EXPECT_EQ(IntRect::null, packer.pack( Size2i(1, 65) ) );
+  EXPECT_EQ(IntRect::null, packer.pack( Size2i(0, 8) ) );
+
+  EXPECT_EQ( IntRect(0, 0, 64, 64), packer.pack( Size2i(64, 64) ) );
+  EXPECT_EQ(IntRect::null, packer.pack( Size2i(1, 1) ) );
+}
+
+TEST_F(SkylinePackerTest, PackedRectsAreDisjoint)
+{
+  const Size2i BIN_SIZE(256, 256);
+  SkylinePacker packer(BIN_SIZE);
+  std::vector<IntRect> rects;
+
+  for( int idx = 0; idx != 1000; ++idx ) {
+
+    IntRect rect = packer.pack( this->next_dims() );
+    if( rect != IntRect::null ) {
+      rects.push_back(rect);
+    }
+  }
+
+  EXPECT_TRUE( this->disjoint(rects, BIN_SIZE) );
+
+  // The bin should be reasonably well used by the time it rejects rectangles
+  EXPECT_GT(packer.occupancy(), 0.75f);
+}
+
+TEST_F(SkylinePackerTest, GrowKeepsPackedRects)
+{
+  SkylinePacker packer( Size2i(64, 64) );
+  std::vector<IntRect> rects;
+
+  for( int idx = 0; idx != 500; ++idx ) {
+
+    Size2i dims = this->next_dims();
+    IntRect rect = packer.pack(dims);
+
+    if( rect == IntRect::null ) {
+      // Double the bin, as nom::TrueTypeFont does with its glyph pages
+      packer.grow( Size2i(packer.size().w * 2, packer.size().h * 2) );
+      rect = packer.pack(dims);
+    }
+
+    ASSERT_NE(IntRect::null, rect);
+    rects.push_back(rect);
+  }
+
+  EXPECT_TRUE( this->disjoint( rects, packer.size() ) );
+}
+
+TEST_F(SkylinePackerTest, ResetBin)
+{
+  SkylinePacker packer( Size2i(16, 16) );
+
+  EXPECT_EQ( IntRect(0, 0, 16, 16), packer.pack( Size2i(16, 16) ) );
+
+  packer.reset( Size2i(32, 32) );
+  EXPECT_FLOAT_EQ(0.0f, packer.occupancy() );
+  EXPECT_EQ( IntRect(0, 0, 32, 32), packer.pack( Size2i(32, 32) ) );
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  // Set the current working directory path to the path leading to this
+  // executable file; used for unit tests that require file-system I/O.
+  if( nom::init(argc, argv) == false ) {
+    NOM_LOG_CRIT(NOM_LOG_CATEGORY_APPLICATION, "Could not initialize nomlib.");
+    return NOM_EXIT_FAILURE;
+  }
+  atexit(nom::quit);
+
+  return RUN_ALL_TESTS();
+}
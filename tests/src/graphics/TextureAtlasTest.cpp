@@ -0,0 +1,215 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nomlib/config.hpp>
+#include <nomlib/system/init.hpp>
+#include <nomlib/graphics/Image.hpp>
+#include <nomlib/graphics/TextureAtlas.hpp>
+#include <nomlib/graphics/sprite/SpriteSheet.hpp>
+
+using namespace nom;
+
+/// \brief nom::TextureAtlas unit tests
+///
+/// \remarks These tests exercise the packing of images only; uploading the
+/// pages with nom::TextureAtlas::build requires a rendering context.
+class TextureAtlasTest: public ::testing::Test
+{
+  public:
+    /// \remarks This method is called at the start of each unit test.
+    TextureAtlasTest()
+    {
+      //
+    }
+
+    /// \remarks This method is called at the end of each unit test.
+    virtual ~TextureAtlasTest()
+    {
+      //
+    }
+
+  protected:
+    /// \brief Create an image of the given dimensions.
+    ///
+    /// \remarks The image is shared, rather than copied, because copies of a
+    /// nom::Image do not share the ownership of its pixels.
+    std::shared_ptr<Image> make_image(const Size2i& dims)
+    {
+      auto img = std::make_shared<Image>();
+      EXPECT_TRUE( img->create(dims, TextureAtlas::PIXEL_FORMAT) );
+
+      return img;
+    }
+};
+
+TEST_F(TextureAtlasTest, EmptyAtlas)
+{
+  TextureAtlas atlas;
+
+  EXPECT_EQ(0, atlas.size() );
+  EXPECT_EQ(0, atlas.pages() );
+  EXPECT_FALSE( atlas.valid(TextureAtlas::INVALID_HANDLE) );
+  EXPECT_EQ(IntRect::null, atlas.bounds(TextureAtlas::INVALID_HANDLE) );
+  EXPECT_EQ(TextureAtlas::INVALID_HANDLE, atlas.find("missing") );
+  EXPECT_TRUE( atlas.page_texture(0) == nullptr );
+}
+
+TEST_F(TextureAtlasTest, PackIntoOnePage)
+{
+  TextureAtlas atlas( Size2i(64, 64), 1 );
+  std::vector<TextureAtlas::handle_type> handles;
+
+  for( auto idx = 0; idx != 9; ++idx ) {
+    handles.push_back( atlas.insert( *this->make_image( Size2i(16, 16) ) ) );
+    ASSERT_TRUE( atlas.valid( handles.back() ) );
+  }
+
+  EXPECT_EQ(9, atlas.size() );
+  EXPECT_EQ(1, atlas.pages() );
+  EXPECT_EQ(Size2i(64, 64), atlas.page_size(0) );
+
+  for( auto itr = handles.begin(); itr != handles.end(); ++itr ) {
+    IntRect bounds = atlas.bounds(*itr);
+
+    EXPECT_EQ(0, atlas.page(*itr) );
+    EXPECT_EQ(Size2i(16, 16), bounds.size() );
+
+    // The padding keeps the images apart
+    for( auto other = handles.begin(); other != itr; ++other ) {
+      IntRect rhs = atlas.bounds(*other);
+      EXPECT_FALSE( bounds.x < rhs.x + rhs.w + 1 &&
+                    rhs.x < bounds.x + bounds.w + 1 &&
+                    bounds.y < rhs.y + rhs.h + 1 &&
+                    rhs.y < bounds.y + bounds.h + 1 )
+      << bounds << " is adjacent to " << rhs;
+    }
+  }
+
+  // The textures are not available before the atlas is built
+  EXPECT_TRUE( atlas.texture( handles.front() ) == nullptr );
+}
+
+TEST_F(TextureAtlasTest, NewPageWhenFull)
+{
+  TextureAtlas atlas( Size2i(32, 32), 0 );
+  TextureAtlas::handle_type handle = TextureAtlas::INVALID_HANDLE;
+
+  for( auto idx = 0; idx != 4; ++idx ) {
+    handle = atlas.insert( *this->make_image( Size2i(16, 16) ) );
+    EXPECT_EQ(0, atlas.page(handle) );
+  }
+
+  EXPECT_FLOAT_EQ(1.0f, atlas.occupancy(0) );
+
+  handle = atlas.insert( *this->make_image( Size2i(16, 16) ) );
+  EXPECT_EQ(2, atlas.pages() );
+  EXPECT_EQ(1, atlas.page(handle) );
+  EXPECT_EQ(IntRect(0, 0, 16, 16), atlas.bounds(handle) );
+
+  // Smaller images still fill the holes of the earlier pages first
+  TextureAtlas sparse( Size2i(32, 32), 0 );
+  sparse.insert( *this->make_image( Size2i(32, 16) ) );
+  sparse.insert( *this->make_image( Size2i(32, 17) ) );
+  handle = sparse.insert( *this->make_image( Size2i(8, 8) ) );
+
+  EXPECT_EQ(2, sparse.pages() );
+  EXPECT_EQ(0, sparse.page(handle) );
+}
+
+TEST_F(TextureAtlasTest, OversizedImage)
+{
+  TextureAtlas atlas( Size2i(32, 32), 1 );
+
+  auto handle = atlas.insert( *this->make_image( Size2i(100, 20) ) );
+
+  ASSERT_TRUE( atlas.valid(handle) );
+  EXPECT_EQ(1, atlas.pages() );
+  EXPECT_EQ(Size2i(101, 32), atlas.page_size(0) );
+  EXPECT_EQ(IntRect(0, 0, 100, 20), atlas.bounds(handle) );
+}
+
+TEST_F(TextureAtlasTest, NamedImages)
+{
+  TextureAtlas atlas( Size2i(64, 64), 1 );
+
+  auto icon = atlas.insert( "icon", *this->make_image( Size2i(8, 8) ) );
+  ASSERT_TRUE( atlas.valid(icon) );
+  EXPECT_EQ(icon, atlas.find("icon") );
+
+  // Inserting the same name again leaves the atlas untouched
+  EXPECT_EQ(icon, atlas.insert( "icon", *this->make_image( Size2i(8, 8) ) ) );
+  EXPECT_EQ(1, atlas.size() );
+
+  atlas.clear();
+  EXPECT_EQ(0, atlas.size() );
+  EXPECT_EQ(0, atlas.pages() );
+  EXPECT_FALSE( atlas.valid(icon) );
+  EXPECT_EQ(TextureAtlas::INVALID_HANDLE, atlas.find("icon") );
+}
+
+TEST_F(TextureAtlasTest, SpriteSheetFrames)
+{
+  TextureAtlas atlas( Size2i(32, 32), 0 );
+  std::vector<TextureAtlas::handle_type> frames;
+
+  for( auto idx = 0; idx != 5; ++idx ) {
+    frames.push_back( atlas.insert( *this->make_image( Size2i(16, 16) ) ) );
+  }
+
+  std::vector<TextureAtlas::handle_type> first_page( frames.begin(),
+                                                     frames.begin() + 4 );
+  SpriteSheet sheet = atlas.sprite_sheet(first_page);
+
+  ASSERT_EQ(4, sheet.frames() );
+  for( auto idx = 0; idx != sheet.frames(); ++idx ) {
+    EXPECT_EQ( atlas.bounds( first_page[idx] ), sheet.dimensions(idx) );
+  }
+
+  // The frames of a sprite sheet are drawn from a single texture
+  EXPECT_TRUE( atlas.sprite_sheet(frames).empty() );
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  // Set the current working directory path to the path leading to this
+  // executable file; used for unit tests that require file-system I/O.
+  if( nom::init(argc, argv) == false ) {
+    NOM_LOG_CRIT(NOM_LOG_CATEGORY_APPLICATION, "Could not initialize nomlib.");
+    return NOM_EXIT_FAILURE;
+  }
+  atexit(nom::quit);
+
+  return RUN_ALL_TESTS();
+}
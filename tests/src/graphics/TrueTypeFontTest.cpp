@@ -502,6 +502,53 @@ TEST_F(TrueTypeFontTest, UseAllTextStyles)
   EXPECT_TRUE( this->compare() );
 }
 
+TEST_F(TrueTypeFontTest, RenderToTextureCache)
+{
+  std::string font =
+    this->resources.path() + "OpenSans-Regular.ttf";
+
+  EXPECT_EQ(true, this->load_font(font) )
+  << "Could not load font file: " << font;
+
+  this->rendered_text.set_render_mode(Text::RenderMode::RenderToTexture);
+
+  // The texture is not rendered until the text is drawn
+  EXPECT_FALSE( this->rendered_text.cached() );
+
+  EXPECT_EQ( NOM_EXIT_SUCCESS, this->on_run() );
+
+  EXPECT_TRUE( this->rendered_text.cached() );
+  EXPECT_GT( Text::cache_memory(), 0 );
+
+  // Changes to the text must invalidate its texture
+  this->rendered_text.set_color(Color4i::Magenta);
+  EXPECT_FALSE( this->rendered_text.cached() );
+
+  // ...while the memory is released with the render mode
+  this->rendered_text.set_render_mode(Text::RenderMode::GlyphBatch);
+  EXPECT_EQ( 0, Text::cache_memory() );
+}
+
+TEST_F(TrueTypeFontTest, RenderToTextureCacheBudget)
+{
+  std::string font =
+    this->resources.path() + "OpenSans-Regular.ttf";
+
+  EXPECT_EQ(true, this->load_font(font) )
+  << "Could not load font file: " << font;
+
+  // The text is drawn from its glyphs when its texture does not fit
+  Text::set_cache_budget(0);
+  this->rendered_text.set_render_mode(Text::RenderMode::RenderToTexture);
+
+  EXPECT_EQ( NOM_EXIT_SUCCESS, this->on_run() );
+
+  EXPECT_FALSE( this->rendered_text.cached() );
+  EXPECT_EQ( 0, Text::cache_memory() );
+
+  Text::set_cache_budget(Text::DEFAULT_CACHE_BUDGET);
+}
+
 /// \remarks This test is only ran when the interactive flag (-i) is passed.
 TEST_F(TrueTypeFontTest, InteractiveGlyphCache)
 {
@@ -28,6 +28,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 #include <iostream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -40,7 +42,8 @@ namespace nom {
 class PropertyTreeTest: public ::testing::Test
 {
   protected:
-    // ...
+    /// \brief The number of member keys processed by the stress tests.
+    const nom::size_type NUM_KEYS = 100000;
 };
 
 TEST_F( PropertyTreeTest, ConstructNullValue )
@@ -371,6 +374,247 @@ TEST_F( PropertyTreeTest, OperatorConstructDeepDepth )
   EXPECT_EQ( "Hello!", o[0]["cards"]["ID_0"][1].get_string() ) << o;
 }
 
+TEST_F( PropertyTreeTest, MoveValues )
+{
+  Value str( "a string too long to be stored in-place" );
+  Value moved( std::move(str) );
+
+  EXPECT_EQ( Value::ValueType::Null, str.type() );
+  EXPECT_EQ( "a string too long to be stored in-place", moved.get_string() );
+
+  Value obj;
+  obj["key"] = "value";
+  obj["array"].push_back( Value(1) );
+
+  Value dest;
+  dest = std::move(obj);
+
+  EXPECT_EQ( Value::ValueType::Null, obj.type() );
+  EXPECT_EQ( "value", dest["key"].get_string() );
+  EXPECT_EQ( 1, dest["array"][0].get_int() );
+}
+
+TEST_F( PropertyTreeTest, SmallStringValues )
+{
+  Value empty( "" );
+  Value small( "fifteen chars!!" );
+  Value large( "sixteen chars!!!" );
+
+  EXPECT_STREQ( "", empty.get_cstring() );
+  EXPECT_STREQ( "fifteen chars!!", small.get_cstring() );
+  EXPECT_STREQ( "sixteen chars!!!", large.get_cstring() );
+
+  Value small_copy( small );
+  Value large_copy;
+  large_copy = large;
+
+  EXPECT_EQ( small, small_copy );
+  EXPECT_EQ( large, large_copy );
+  EXPECT_TRUE( small < large );
+  EXPECT_NE( small.get_cstring(), small_copy.get_cstring() );
+
+  small_copy.swap(large_copy);
+  EXPECT_EQ( "sixteen chars!!!", small_copy.get_string() );
+  EXPECT_EQ( "fifteen chars!!", large_copy.get_string() );
+}
+
+TEST_F( PropertyTreeTest, CopyOnWriteObjectValues )
+{
+  Value obj;
+  obj["nested"]["x"] = 1;
+  obj["nested"]["y"] = 2;
+  obj["list"].push_back( Value("element") );
+
+  Value copy( obj );
+  EXPECT_EQ( obj, copy );
+
+  copy["nested"]["x"] = 10;
+  copy["list"].push_back( Value("another element") );
+  copy["extra"] = true;
+
+  EXPECT_EQ( 1, obj["nested"]["x"].get_int() );
+  EXPECT_EQ( 1, obj["list"].size() );
+  EXPECT_EQ( 2, obj.size() );
+
+  EXPECT_EQ( 10, copy["nested"]["x"].get_int() );
+  EXPECT_EQ( 2, copy["nested"]["y"].get_int() );
+  EXPECT_EQ( 2, copy["list"].size() );
+  EXPECT_EQ( 3, copy.size() );
+
+  // Writing through the non-const iterators must not reach the original
+  Value iter_copy( obj );
+  for( auto itr = iter_copy.begin(); itr != iter_copy.end(); ++itr ) {
+    *itr = Value::null;
+  }
+
+  EXPECT_TRUE( obj["nested"].object_type() );
+  EXPECT_TRUE( iter_copy["nested"].null_type() );
+
+  Value erase_copy( obj );
+  erase_copy.erase( "nested" );
+  EXPECT_EQ( 2, obj.size() );
+  EXPECT_EQ( 1, erase_copy.size() );
+}
+
+TEST_F( PropertyTreeTest, ArrayValuesIteration )
+{
+  Value arr;
+  arr[0] = "zero";
+  arr[1] = 1;
+  arr[2] = true;
+
+  ArrayIndex idx = 0;
+  for( auto itr = arr.begin(); itr != arr.end(); ++itr ) {
+    EXPECT_EQ( idx, itr.index() );
+    EXPECT_STREQ( "\0", itr.key() );
+    EXPECT_EQ( arr[idx], *itr );
+    ++idx;
+  }
+  EXPECT_EQ( 3, idx );
+
+  // Writing past the end fills the gap with null values
+  arr[5] = "five";
+  EXPECT_EQ( 6, arr.size() );
+  EXPECT_TRUE( arr[3].null_type() );
+  EXPECT_TRUE( arr[4].null_type() );
+
+  const Value& const_arr = arr;
+  EXPECT_EQ( Value::null, const_arr[100] );
+  EXPECT_EQ( 6, arr.size() );
+
+  Array values = arr.array();
+  EXPECT_EQ( 6, values.size() );
+  EXPECT_EQ( "five", values[5].get_string() );
+}
+
+TEST_F( PropertyTreeTest, ObjectValuesInsertionOrder )
+{
+  const int NUM_MEMBERS = 64;
+  Value obj;
+  Value reversed;
+
+  // Enough members for the object to index its keys
+  for( int idx = 0; idx != NUM_MEMBERS; ++idx ) {
+    obj["key" + std::to_string(NUM_MEMBERS - idx)] = idx;
+  }
+
+  for( int idx = NUM_MEMBERS - 1; idx >= 0; --idx ) {
+    reversed["key" + std::to_string(NUM_MEMBERS - idx)] = idx;
+  }
+
+  Value::Members members = obj.member_names();
+  ASSERT_EQ( NUM_MEMBERS, members.size() );
+  EXPECT_EQ( "key64", members.front() );
+  EXPECT_EQ( "key1", members.back() );
+
+  for( int idx = 0; idx != NUM_MEMBERS; ++idx ) {
+    EXPECT_EQ( idx, obj.find("key" + std::to_string(NUM_MEMBERS - idx)).get_int() );
+  }
+
+  // Member order is not significant to comparison
+  EXPECT_EQ( obj, reversed );
+  EXPECT_FALSE( obj < reversed );
+  EXPECT_FALSE( reversed < obj );
+
+  EXPECT_EQ( Value(10), obj.erase("key54") );
+  EXPECT_EQ( Value::null, obj.find("key54") );
+  EXPECT_EQ( 11, obj.find("key53").get_int() );
+  EXPECT_EQ( NUM_MEMBERS - 1, obj.size() );
+  EXPECT_NE( obj, reversed );
+
+  obj["key54"] = 10;
+  EXPECT_EQ( obj, reversed );
+  EXPECT_EQ( "key54", obj.member_names().back() );
+}
+
+TEST_F( PropertyTreeTest, InternedMemberKeys )
+{
+  VString x0( "x" );
+  VString x1( std::string("x") );
+  VString y( "y" );
+
+  EXPECT_EQ( x0.c_str(), x1.c_str() );
+  EXPECT_NE( x0.c_str(), y.c_str() );
+  EXPECT_TRUE( x0 == x1 );
+  EXPECT_FALSE( x0 == y );
+  EXPECT_TRUE( x0 < y );
+  EXPECT_FALSE( y < x0 );
+  EXPECT_FALSE( x0 < x1 );
+  EXPECT_EQ( "x", x1.string() );
+
+  VString copy( x0 );
+  VString assigned;
+  assigned = y;
+  EXPECT_EQ( x0.c_str(), copy.c_str() );
+  EXPECT_EQ( y.c_str(), assigned.c_str() );
+
+  // Array index keys
+  EXPECT_TRUE( VString(ArrayIndex(1)) == VString(ArrayIndex(1)) );
+  EXPECT_TRUE( VString(ArrayIndex(0)) < VString(ArrayIndex(1)) );
+  EXPECT_STREQ( "", VString(ArrayIndex(1)).c_str() );
+
+  // Keys long enough to need their own storage
+  std::string long_key( 2048, 'k' );
+  EXPECT_EQ( VString(long_key).c_str(), VString(long_key.c_str()).c_str() );
+  EXPECT_EQ( long_key, VString(long_key).string() );
+}
+
+TEST_F( PropertyTreeTest, LookupsDoNotInternMemberKeys )
+{
+  Value obj;
+  obj["ptree_lookup_present"] = 1;
+  const Value& cobj = obj;
+
+  EXPECT_EQ( VString("ptree_lookup_present").c_str(),
+             VString::find("ptree_lookup_present").c_str() );
+  EXPECT_EQ( 1, cobj["ptree_lookup_present"].get_int() );
+
+  EXPECT_TRUE( cobj["ptree_lookup_missing"].null_type() );
+  EXPECT_TRUE( cobj.find( std::string("ptree_lookup_missing") ).null_type() );
+  EXPECT_TRUE( obj.erase("ptree_lookup_missing").null_type() );
+  EXPECT_EQ( 1, obj.size() );
+
+  // None of the lookups above stored the missing key
+  EXPECT_FALSE( VString::find("ptree_lookup_missing") ==
+                VString::find("ptree_lookup_missing") );
+  EXPECT_FALSE( VString::find("ptree_lookup_missing") == VString() );
+}
+
+TEST_F( PropertyTreeTest, ManyMemberKeys )
+{
+  const char* const KEY_NAMES[] = {
+    "x", "y", "w", "h", "name", "frame_id", "sheet_filename", "offset_x"
+  };
+  const nom::size_type NUM_KEY_NAMES = sizeof(KEY_NAMES) / sizeof(KEY_NAMES[0]);
+
+  std::vector<VString> names;
+  for( nom::size_type idx = 0; idx != NUM_KEY_NAMES; ++idx ) {
+    names.push_back( VString( KEY_NAMES[idx] ) );
+  }
+
+  // Keys interned by another thread are the same keys
+  std::vector<VString> keys;
+  std::thread worker( [&keys, &KEY_NAMES, NUM_KEY_NAMES, this]() {
+    keys.reserve(NUM_KEYS);
+    for( nom::size_type idx = 0; idx != NUM_KEYS; ++idx ) {
+      keys.push_back( VString( KEY_NAMES[idx % NUM_KEY_NAMES] ) );
+    }
+  });
+  worker.join();
+
+  ASSERT_EQ( NUM_KEYS, keys.size() );
+  for( nom::size_type idx = 0; idx != NUM_KEYS; ++idx ) {
+    const VString& name = names[idx % NUM_KEY_NAMES];
+    const VString& other = names[(idx + 1) % NUM_KEY_NAMES];
+
+    ASSERT_EQ( name.c_str(), keys[idx].c_str() );
+    ASSERT_TRUE( keys[idx] == name );
+    ASSERT_FALSE( keys[idx] == other );
+  }
+
+  EXPECT_EQ( "sheet_filename", keys[6].string() );
+}
+
 } // namespace nom
 
 int main( int argc, char **argv )
@@ -0,0 +1,336 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include <cstdio>
+#include <string>
+
+#include "gtest/gtest.h"
+
+// nom::init functions
+#include "nomlib/system/init.hpp"
+#include "nomlib/system/dialog_messagebox.hpp"
+
+#include <nomlib/serializers.hpp>
+#include <nomlib/ptree.hpp> // Property Tree (nom::Value)
+
+#include "nomlib/tests/serializers/common.hpp"
+
+namespace nom {
+
+/// \brief This unit test covers the round trip of nom::Value objects through
+/// the binary serializer and deserializer.
+class BinarySerializerTest: public ::testing::Test
+{
+  public:
+    const std::string APP_NAME = "BinarySerializerTest";
+
+    BinarySerializerTest()
+    {
+      // ...
+    }
+
+    virtual ~BinarySerializerTest()
+    {
+      // ...
+    }
+
+    /// \remarks This method is called after construction, at the start of each
+    /// unit test.
+    virtual void SetUp()
+    {
+      // nom::init sets the working directory to this executable's directory
+      // path; i.e.: build/tests or build/tests/Debug depending on build
+      // environment. Resource path roots become absolute directory paths from
+      // here on out.
+      if( resources.load_file(APP_NAME + ".json") == false )
+      {
+        FAIL()
+        << "Could not determine the root resource path for " << APP_NAME << ".json";
+      }
+    }
+
+  protected:
+    nom::SearchPath resources;
+    BinarySerializer fp_out;
+    BinaryDeserializer fp_in;
+
+    Value round_trip( const Value& in )
+    {
+      return( fp_in.deserialize( fp_out.serialize( in ) ) );
+    }
+};
+
+TEST_F( BinarySerializerTest, SerializeLayout )
+{
+  Value in;
+  in["a"] = 1;
+
+  // Header; signature, version, string count, string table size and value
+  // stream size
+  std::string expected( "NOMV" );
+  expected += std::string( "\x01\x00\x00\x00", 4 );
+  expected += std::string( "\x01\x00\x00\x00", 4 );
+  expected += std::string( "\x06\x00\x00\x00", 4 );
+  expected += std::string( "\x0E\x00\x00\x00", 4 );
+
+  // String table
+  expected += std::string( "\x01\x00\x00\x00" "a" "\x00", 6 );
+
+  // Value stream; an object with one member, "a", holding 1
+  expected += std::string( "\x07\x01\x00\x00\x00", 5 );
+  expected += std::string( "\x00\x00\x00\x00", 4 );
+  expected += std::string( "\x01\x01\x00\x00\x00", 5 );
+
+  EXPECT_EQ( expected, fp_out.serialize( in ) );
+}
+
+TEST_F( BinarySerializerTest, ScalarValues )
+{
+  const Value SCALAR_VALUES[] = {
+    Value::null,
+    Value( 0 ),
+    Value( -5 ),
+    Value( NOM_INT32_MIN ),
+    Value( NOM_INT32_MAX ),
+    Value( NOM_UINT32_MAX ),
+    Value( -0.5 ),
+    Value( 1.0e300 ),
+    Value( "" ),
+    Value( "short" ),
+    Value( "a string too long to be stored within the value itself" ),
+    Value( "\xE2\x9C\x93 UTF-8" ),
+    Value( true ),
+    Value( false ),
+  };
+
+  for( auto itr = std::begin(SCALAR_VALUES); itr != std::end(SCALAR_VALUES); ++itr ) {
+
+    Value o = round_trip( *itr );
+
+    EXPECT_EQ( itr->type(), o.type() ) << *itr;
+    EXPECT_EQ( *itr, o ) << *itr;
+  }
+}
+
+TEST_F( BinarySerializerTest, ArrayValues )
+{
+  Value in;
+  in[0] = 1;
+  in[1] = "two";
+  in[2][0] = 3.5;
+  in[2][1] = Value( Array() );
+  in[3] = Value( Object() );
+
+  Value o = round_trip( in );
+
+  ASSERT_TRUE( o.array_type() );
+  ASSERT_EQ( 4, o.size() );
+  EXPECT_TRUE( o[2][1].array_type() );
+  EXPECT_TRUE( o[3].object_type() );
+  EXPECT_EQ( in, o );
+}
+
+TEST_F( BinarySerializerTest, ObjectValues )
+{
+  Value in;
+  in["name"] = "Bobby Jones";
+  in["cards"][0]["id"] = 1;
+  in["cards"][0]["name"] = "Geezard";
+  in["cards"][1]["id"] = 2;
+  in["cards"][1]["name"] = "Funguar";
+  in["owner"]["name"] = "Bobby Jones";
+  in["owner"]["active"] = true;
+
+  Value o = round_trip( in );
+
+  ASSERT_TRUE( o.object_type() );
+  EXPECT_EQ( "Funguar", o["cards"][1]["name"].get_string() );
+  EXPECT_EQ( in, o );
+
+  // Member order is kept
+  Value::Members keys = o.member_names();
+  ASSERT_EQ( 3, keys.size() );
+  EXPECT_EQ( "name", keys[0] );
+  EXPECT_EQ( "cards", keys[1] );
+  EXPECT_EQ( "owner", keys[2] );
+}
+
+TEST_F( BinarySerializerTest, StringTable )
+{
+  Value in;
+  for( int idx = 0; idx != 100; ++idx ) {
+    in[idx]["name"] = "sprite_frame";
+    in[idx]["filename"] = "sheet.png";
+  }
+
+  std::string output = fp_out.serialize( in );
+
+  // Each distinct string is stored once: "name", "sprite_frame", "filename"
+  // and "sheet.png"
+  ASSERT_LT( 12, output.size() );
+  EXPECT_EQ( std::string( "\x04\x00\x00\x00", 4 ), output.substr( 8, 4 ) );
+
+  EXPECT_EQ( in, fp_in.deserialize( output ) );
+}
+
+TEST_F( BinarySerializerTest, InvalidInput )
+{
+  Value in;
+  in["cards"][0]["id"] = 1;
+  in["cards"][0]["name"] = "Geezard";
+  in["cards"][0]["power"] = 0.5;
+  in["count"] = 1;
+
+  const std::string output = fp_out.serialize( in );
+
+  // Keep the expected errors out of the log
+  SDL2Logger::set_logging_priority( NOM, NOM_LOG_PRIORITY_CRITICAL );
+
+  EXPECT_TRUE( fp_in.deserialize( "" ).null_type() );
+  EXPECT_TRUE( fp_in.deserialize( "{\"cards\":[]}" ).null_type() );
+
+  // Every truncation of the document fails
+  for( nom::size_type length = 0; length != output.size(); ++length ) {
+    EXPECT_TRUE( fp_in.deserialize( output.data(), length ).null_type() )
+    << "length: " << length;
+  }
+
+  EXPECT_TRUE( fp_in.deserialize( output + '\0' ).null_type() );
+
+  // Unsupported version
+  std::string source = output;
+  source[4] = 2;
+  EXPECT_TRUE( fp_in.deserialize( source ).null_type() );
+
+  // Corrupt bytes must not be read past the end of the document
+  for( nom::size_type pos = 0; pos != output.size(); ++pos ) {
+    source = output;
+    source[pos] = ~source[pos];
+    fp_in.deserialize( source );
+  }
+
+  SDL2Logger::set_logging_priority( NOM, NOM_LOG_PRIORITY_VERBOSE );
+}
+
+/// \brief Nested containers that each declare a count which fits within the
+/// rest of the document, but not alongside the counts of their parents.
+TEST_F( BinarySerializerTest, InvalidContainerCounts )
+{
+  const nom::size_type NUM_ARRAYS = 20000;
+  const nom::size_type PADDING_SIZE = 100000;
+
+  std::string source( "NOMV" );
+  source += std::string( "\x01\x00\x00\x00", 4 );
+  source += std::string( "\x00\x00\x00\x00", 4 );
+  source += std::string( "\x00\x00\x00\x00", 4 );
+  source += std::string( "\x40\x0D\x03\x00", 4 ); // 200000 bytes
+
+  // Each array declares 100000 elements; reserving them all at once would
+  // take tens of gigabytes
+  for( nom::size_type idx = 0; idx != NUM_ARRAYS; ++idx ) {
+    source += std::string( "\x06\xA0\x86\x01\x00", 5 );
+  }
+  source += std::string( PADDING_SIZE, '\0' );
+
+  SDL2Logger::set_logging_priority( NOM, NOM_LOG_PRIORITY_CRITICAL );
+
+  EXPECT_TRUE( fp_in.deserialize( source ).null_type() );
+
+  SDL2Logger::set_logging_priority( NOM, NOM_LOG_PRIORITY_VERBOSE );
+}
+
+TEST_F( BinarySerializerTest, ConvertJsonToBinary )
+{
+  const std::string FILENAME = APP_NAME + "_inventory.bin";
+  JsonDeserializer json;
+  Value expected;
+  Value o;
+
+  ASSERT_TRUE( json.load( resources.path() + RESOURCE_JSON_INVENTORY, expected ) );
+
+  ASSERT_TRUE( convert_json_to_binary( resources.path() + RESOURCE_JSON_INVENTORY,
+                                       FILENAME ) );
+  ASSERT_TRUE( fp_in.load( FILENAME, o ) );
+
+  std::remove( FILENAME.c_str() );
+
+  EXPECT_EQ( 2, o.size() );
+  EXPECT_EQ( expected, o );
+
+  EXPECT_FALSE( convert_json_to_binary( "missing_file.json", FILENAME ) );
+  EXPECT_FALSE( fp_in.load( "missing_file.bin", o ) );
+}
+
+/// \brief Load the JSON test fixtures, and their binary conversions.
+TEST_F( BinarySerializerTest, LoadFixtures )
+{
+  const std::string FIXTURES[] = {
+    RESOURCE_JSON_INVENTORY,
+    RESOURCE_JSON_GAMEDATA
+  };
+
+  JsonDeserializer json;
+
+  for( auto itr = std::begin(FIXTURES); itr != std::end(FIXTURES); ++itr ) {
+
+    const std::string json_filename = resources.path() + *itr;
+    const std::string filename = APP_NAME + "_" + *itr + ".bin";
+
+    ASSERT_TRUE( convert_json_to_binary( json_filename, filename ) );
+
+    Value json_in;
+    ASSERT_TRUE( json.load( json_filename, json_in ) );
+
+    // Loading over a previous document replaces it
+    Value in;
+    ASSERT_TRUE( fp_in.load( filename, in ) );
+    ASSERT_TRUE( fp_in.load( filename, in ) );
+
+    std::remove( filename.c_str() );
+
+    EXPECT_EQ( json_in, in );
+  }
+}
+
+} // namespace nom
+
+int main( int argc, char** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+
+  // Set the current working directory path to the path leading to this
+  // executable file; used for unit tests that require file-system I/O.
+  if( nom::init( argc, argv ) == false )
+  {
+    nom::DialogMessageBox( "Critical Error", "Could not initialize nomlib.", nom::MessageBoxType::NOM_DIALOG_ERROR );
+    return NOM_EXIT_FAILURE;
+  }
+  atexit( nom::quit );
+
+  return RUN_ALL_TESTS();
+}
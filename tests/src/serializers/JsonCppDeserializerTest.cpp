@@ -1,5 +1,6 @@
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -279,6 +280,58 @@ TEST_F( JsonCppDeserializerTest, DeserializeObjectValuesSanity2 )
   ASSERT_TRUE( in == out );
 }
 
+/// \brief Load a large config tree, then copy and modify it.
+///
+/// \remarks Copies share their array and object nodes until one of them is
+/// written to.
+TEST_F( JsonCppDeserializerTest, LoadAndCopyLargeTree )
+{
+  const nom::size_type NUM_FRAMES = 5000;
+  const nom::size_type NUM_COPIES = 100;
+  std::string source;
+
+  source += "{\"frames\":[";
+  for( nom::size_type idx = 0; idx != NUM_FRAMES; ++idx ) {
+
+    if( idx != 0 ) {
+      source += ",";
+    }
+
+    source += "{\"name\":\"sprite_frame_" + std::to_string(idx) + "\",";
+    source += "\"filename\":\"Resources/sprites/sheet.png\",";
+    source += "\"x\":" + std::to_string(idx % 512) + ",";
+    source += "\"y\":" + std::to_string(idx / 512) + ",";
+    source += "\"width\":16,\"height\":16,\"visible\":true}";
+  }
+  source += "]}\n";
+
+  Value in = expected_in(source);
+
+  ASSERT_TRUE( in["frames"].array_type() );
+  ASSERT_EQ( NUM_FRAMES, in["frames"].size() );
+
+  std::vector<Value> copies;
+  for( nom::size_type idx = 0; idx != NUM_COPIES; ++idx ) {
+    copies.push_back(in);
+
+    const Value& copy = copies.back();
+    EXPECT_EQ( NUM_FRAMES, copy["frames"].size() );
+  }
+
+  // Modifying a copy must leave the original and the other copies intact
+  Value& modified = copies.front();
+  modified["frames"][0]["x"] = 1024;
+
+  EXPECT_EQ( 1024, modified["frames"][0]["x"].get_int() );
+  EXPECT_EQ( "sprite_frame_1", modified["frames"][1]["name"].get_string() );
+  EXPECT_EQ( 0, in["frames"][0]["x"].get_int() );
+  EXPECT_EQ( "sprite_frame_1", in["frames"][1]["name"].get_string() );
+  const Value& unmodified = copies.back();
+  EXPECT_EQ( 0, unmodified["frames"][0]["x"].get_int() );
+  EXPECT_TRUE( unmodified == in );
+  EXPECT_FALSE( modified == in );
+}
+
 } // namespace nom
 
 int main( int argc, char** argv )
@@ -0,0 +1,340 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+// nom::init functions
+#include "nomlib/system/init.hpp"
+#include "nomlib/system/dialog_messagebox.hpp"
+
+#include <nomlib/serializers.hpp>
+#include <nomlib/ptree.hpp> // Property Tree (nom::Value)
+
+#include "nomlib/tests/serializers/common.hpp"
+
+namespace nom {
+
+/// \brief This unit test covers the single pass de-serialization of JSON
+/// objects to the equivalent nom::Value node type.
+class JsonDeserializerTest: public ::testing::Test
+{
+  public:
+    const std::string APP_NAME = "JsonDeserializerTest";
+
+    JsonDeserializerTest()
+    {
+      // ...
+    }
+
+    virtual ~JsonDeserializerTest()
+    {
+      // ...
+    }
+
+    /// \remarks This method is called after construction, at the start of each
+    /// unit test.
+    virtual void SetUp()
+    {
+      // nom::init sets the working directory to this executable's directory
+      // path; i.e.: build/tests or build/tests/Debug depending on build
+      // environment. Resource path roots become absolute directory paths from
+      // here on out.
+      if( resources.load_file(APP_NAME + ".json") == false )
+      {
+        FAIL()
+        << "Could not determine the root resource path for " << APP_NAME << ".json";
+      }
+    }
+
+  protected:
+    nom::SearchPath resources;
+    JsonDeserializer fp;
+
+    Value expected_in( const std::string& in )
+    {
+      return( fp.deserialize( in ) );
+    }
+};
+
+TEST_F( JsonDeserializerTest, DeserializeNullValue )
+{
+  Value o = expected_in( "null\n" );
+
+  EXPECT_EQ( Value::null, o );
+}
+
+TEST_F( JsonDeserializerTest, DeserializeInvalidInput )
+{
+  Value o = expected_in( "\n" );
+
+  EXPECT_EQ( true, o.null_type() );
+}
+
+TEST_F( JsonDeserializerTest, DeserializeArrayValues )
+{
+  Value o = expected_in( "[{\"arr\":[null,\"Yeah, buddy!\",-8,10,false,8.25]}]\n" );
+
+  ASSERT_TRUE( o.array_type() );
+  ASSERT_TRUE( o[0].object_type() );
+  ASSERT_TRUE( o[0]["arr"].array_type() );
+  ASSERT_EQ( 6, o[0]["arr"].size() );
+
+  EXPECT_TRUE( o[0]["arr"][0].null_type() );
+  EXPECT_EQ( "Yeah, buddy!", o[0]["arr"][1].get_string() );
+  EXPECT_EQ( -8, o[0]["arr"][2].get_int() );
+  EXPECT_EQ( 10, o[0]["arr"][3].get_int() );
+  EXPECT_EQ( false, o[0]["arr"][4].get_bool() );
+  EXPECT_EQ( 8.25, o[0]["arr"][5].get_double() );
+}
+
+TEST_F( JsonDeserializerTest, DeserializeObjectValues )
+{
+  Value o = expected_in( "{\"obj\":{\"key1\":\"Hello\",\"key2\":true,\"key3\":null,\"key4\":8.239999771118164}}\n" );
+
+  ASSERT_TRUE( o.object_type() );
+  ASSERT_EQ( 1, o.size() );
+  ASSERT_TRUE( o["obj"].object_type() );
+  ASSERT_EQ( 4, o["obj"].size() );
+
+  EXPECT_EQ( "Hello", o["obj"]["key1"].get_string() );
+  EXPECT_EQ( true, o["obj"]["key2"].get_bool() );
+  EXPECT_TRUE( o["obj"]["key3"].null_type() );
+  EXPECT_EQ( 8.24f, o["obj"]["key4"].get_float() );
+}
+
+TEST_F( JsonDeserializerTest, DeserializeObjectValuesSanity2 )
+{
+  Value in = expected_in( "{\"object1\":{\"boolean1\":false,\"null\":null,\"response1\":\"Yeah buddy!\"},\"object2\":{\"array2\":[0,2,3,\"hax\"],\"boolean2\":true,\"deep_object\":{\"h\":{\"boolean\":false,\"deep_deep_deep_object\":{\"deep_deep_deep_array\":[\"string_1\",\"string_2\"],\"h\":240,\"w\":420},\"key\":\"pair\",\"null\":null},\"w\":-4},\"response2\":\"Light weight!\"},\"object3\":[{\"cmd\":[\"hax\",\"gibson\"],\"deep_object\":{\"h\":{\"boolean\":false,\"deep_deep_deep_object\":{\"deep_deep_deep_array\":[\"string_1\",\"string_2\"],\"h\":240,\"w\":420},\"key\":\"pair\",\"null\":null},\"w\":-4}}],\"object5\":[\"hello, there!\",-1,false]}\n" );
+
+  Value out = sanity2_out();
+
+  ASSERT_TRUE( in == out );
+}
+
+TEST_F( JsonDeserializerTest, DeserializeTopLevelValues )
+{
+  Value arr = expected_in( "[1,[2,[3,[]]],{}]" );
+
+  ASSERT_TRUE( arr.array_type() );
+  ASSERT_EQ( 3, arr.size() );
+  EXPECT_EQ( 1, arr[0].get_int() );
+  EXPECT_EQ( 3, arr[1][1][0].get_int() );
+  EXPECT_TRUE( arr[1][1][1].array_type() );
+  EXPECT_EQ( 0, arr[1][1][1].size() );
+  EXPECT_TRUE( arr[2].object_type() );
+  EXPECT_EQ( 0, arr[2].size() );
+
+  EXPECT_EQ( "top-level string", expected_in( "\"top-level string\"" ).get_string() );
+
+  // Members that are neither arrays nor objects are kept at the top level
+  Value obj = expected_in( "{\"version\":\"0.4.0\",\"frames\":[]}" );
+  EXPECT_EQ( "0.4.0", obj["version"].get_string() );
+  EXPECT_TRUE( obj["frames"].array_type() );
+}
+
+TEST_F( JsonDeserializerTest, DeserializeNumbers )
+{
+  Value o = expected_in( "[0,-0,2147483647,-2147483648,2147483648,4294967295,4294967296,1.5e3,-2E-2,12345678901234567890123]" );
+
+  ASSERT_EQ( 10, o.size() );
+
+  EXPECT_EQ( Value::ValueType::SignedInteger, o[0].type() );
+  EXPECT_EQ( Value::ValueType::SignedInteger, o[1].type() );
+  EXPECT_EQ( NOM_INT32_MAX, o[2].get_int() );
+  EXPECT_EQ( NOM_INT32_MIN, o[3].get_int() );
+
+  EXPECT_EQ( Value::ValueType::UnsignedInteger, o[4].type() );
+  EXPECT_EQ( 2147483648u, o[4].get_uint() );
+  EXPECT_EQ( NOM_UINT32_MAX, o[5].get_uint() );
+
+  EXPECT_EQ( Value::ValueType::RealNumber, o[6].type() );
+  EXPECT_EQ( 4294967296.0, o[6].get_double() );
+  EXPECT_EQ( 1500.0, o[7].get_double() );
+  EXPECT_EQ( -0.02, o[8].get_double() );
+  EXPECT_EQ( 12345678901234567890123.0, o[9].get_double() );
+}
+
+TEST_F( JsonDeserializerTest, DeserializeStringEscapes )
+{
+  Value o = expected_in( "[\"\\\"\\\\\\/\\b\\f\\n\\r\\t\",\"\\u0041\\u00e9\\u20AC\\ud83d\\ude00\"]" );
+
+  ASSERT_EQ( 2, o.size() );
+  EXPECT_EQ( "\"\\/\b\f\n\r\t", o[0].get_string() );
+  EXPECT_EQ( "A\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80", o[1].get_string() );
+}
+
+TEST_F( JsonDeserializerTest, DeserializeComments )
+{
+  Value o = expected_in(
+    "// Sprite sheet\n"
+    "{\n"
+    "  /* The sheet's dimensions */\n"
+    "  \"width\": 256, // pixels\n"
+    "  \"height\": /* pixels */ 128\n"
+    "}\n"
+    "// EOF"
+  );
+
+  ASSERT_TRUE( o.object_type() );
+  EXPECT_EQ( 256, o["width"].get_int() );
+  EXPECT_EQ( 128, o["height"].get_int() );
+}
+
+TEST_F( JsonDeserializerTest, DeserializeMemberOrder )
+{
+  Value o = expected_in( "{\"c\":1,\"a\":2,\"b\":3,\"a\":4}" );
+
+  Value::Members members = o.member_names();
+  ASSERT_EQ( 3, members.size() );
+  EXPECT_EQ( "c", members[0] );
+  EXPECT_EQ( "a", members[1] );
+  EXPECT_EQ( "b", members[2] );
+
+  // The last duplicate member wins
+  EXPECT_EQ( 4, o["a"].get_int() );
+}
+
+TEST_F( JsonDeserializerTest, DeserializeSyntaxErrors )
+{
+  const char* const INVALID_INPUT[] = {
+    "[1,]",
+    "[1 2]",
+    "{\"key\" 1}",
+    "{\"key\":1,}",
+    "{key:1}",
+    "{\"key\":1",
+    "[\"unterminated]",
+    "\"\\x\"",
+    "\"\\ud83d\"",
+    "\"\\ude00\"",
+    "\"\\ude00\\ud83d\"",
+    "tru",
+    "-",
+    "1.",
+    "1e",
+    "01",
+    "[1] [2]",
+    "/* unterminated comment",
+  };
+
+  for( auto itr = std::begin(INVALID_INPUT); itr != std::end(INVALID_INPUT); ++itr ) {
+    EXPECT_TRUE( expected_in(*itr).null_type() ) << *itr;
+  }
+}
+
+TEST_F( JsonDeserializerTest, DeserializeBuffer )
+{
+  // The buffer is not null-terminated
+  const char source[] = { '[', '4', '2', ']', '4', '2' };
+
+  Value o = fp.deserialize( source, 4 );
+  ASSERT_TRUE( o.array_type() );
+  EXPECT_EQ( 42, o[0].get_int() );
+
+  // A number that runs up to the end of the buffer
+  EXPECT_EQ( 42, fp.deserialize( source + 4, 2 ).get_int() );
+}
+
+TEST_F( JsonDeserializerTest, LoadResourceFiles )
+{
+  Value o;
+
+  ASSERT_TRUE( fp.load( resources.path() + RESOURCE_JSON_INVENTORY, o ) );
+  EXPECT_EQ( 2, o.size() );
+
+  ASSERT_TRUE( fp.load( resources.path() + RESOURCE_JSON_GAMEDATA, o ) );
+  EXPECT_EQ( 28, o.size() );
+
+  EXPECT_FALSE( fp.load( resources.path() + "missing_file.json", o ) );
+}
+
+/// \brief Load a large sprite sheet like document with both JSON
+/// deserializers.
+TEST_F( JsonDeserializerTest, LoadLargeTree )
+{
+  const nom::size_type NUM_FRAMES = 5000;
+  const std::string FILENAME = APP_NAME + "_large_tree.json";
+  JsonCppDeserializer jsoncpp;
+  std::string source;
+
+  source += "{\"frames\":[";
+  for( nom::size_type idx = 0; idx != NUM_FRAMES; ++idx ) {
+
+    if( idx != 0 ) {
+      source += ",";
+    }
+
+    source += "{\"name\":\"sprite_frame_" + std::to_string(idx) + "\",";
+    source += "\"filename\":\"Resources/sprites/sheet.png\",";
+    source += "\"x\":" + std::to_string(idx % 512) + ",";
+    source += "\"y\":" + std::to_string(idx / 512) + ",";
+    source += "\"width\":16,\"height\":16,\"visible\":true}";
+  }
+  source += "]}\n";
+
+  std::ofstream out(FILENAME, std::ios::out | std::ios::binary);
+  out << source;
+  out.close();
+
+  Value in;
+  ASSERT_TRUE( fp.load(FILENAME, in) );
+
+  Value jsoncpp_in;
+  ASSERT_TRUE( jsoncpp.load(FILENAME, jsoncpp_in) );
+
+  std::remove( FILENAME.c_str() );
+
+  ASSERT_TRUE( in["frames"].array_type() );
+  ASSERT_EQ( NUM_FRAMES, in["frames"].size() );
+  EXPECT_EQ( "sprite_frame_1", in["frames"][1]["name"].get_string() );
+  EXPECT_EQ( 9, in["frames"][NUM_FRAMES - 1]["y"].get_int() );
+  EXPECT_TRUE( in["frames"][NUM_FRAMES - 1]["visible"].get_bool() );
+  EXPECT_TRUE( in == jsoncpp_in );
+}
+
+} // namespace nom
+
+int main( int argc, char** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+
+  // Set the current working directory path to the path leading to this
+  // executable file; used for unit tests that require file-system I/O.
+  if( nom::init( argc, argv ) == false )
+  {
+    nom::DialogMessageBox( "Critical Error", "Could not initialize nomlib.", nom::MessageBoxType::NOM_DIALOG_ERROR );
+    return NOM_EXIT_FAILURE;
+  }
+  atexit( nom::quit );
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,220 @@
+/******************************************************************************
+
+  nomlib - C++11 cross-platform game engine
+
+Copyright (c) 2013, 2014 Jeffrey Carpenter <i8degrees@gmail.com>
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+******************************************************************************/
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <nomlib/system.hpp>
+
+namespace nom {
+
+class InputStateMapperTest: public ::testing::Test
+{
+  public:
+    InputStateMapperTest( void )
+    {
+      // ...
+    }
+
+    ~InputStateMapperTest( void )
+    {
+      // ...
+    }
+
+    virtual void SetUp( void )
+    {
+      this->input_mapper.set_event_handler(this->evt_handler);
+    }
+
+    /// \brief Generate a keyboard event through the event handler.
+    void push_key(int32 sym, InputState state = InputState::PRESSED)
+    {
+      Event ev;
+      ev.type =
+        (state == InputState::PRESSED) ? Event::KEY_PRESS : Event::KEY_RELEASE;
+      ev.timestamp = 0;
+      ev.key.sym = sym;
+      ev.key.mod = KMOD_NONE;
+      ev.key.repeat = 0;
+      ev.key.state = state;
+      ev.key.window_id = 0;
+
+      this->evt_handler.push_event(ev);
+    }
+
+  protected:
+    EventHandler evt_handler;
+    InputStateMapper input_mapper;
+
+    /// \brief The callbacks in the order that they were triggered in.
+    std::vector<std::string> triggered;
+};
+
+TEST_F(InputStateMapperTest, DispatchToMatchingActions)
+{
+  InputActionMapper game_state;
+  InputActionMapper menu_state;
+
+  game_state.insert( "a", KeyboardAction(SDLK_a),
+                     [=](const Event& evt) { this->triggered.push_back("a"); } );
+  game_state.insert( "b", KeyboardAction(SDLK_b),
+                     [=](const Event& evt) { this->triggered.push_back("b"); } );
+  game_state.insert( "a_up", KeyboardAction(SDLK_a, InputState::RELEASED),
+                     [=](const Event& evt) { this->triggered.push_back("a_up"); } );
+  menu_state.insert( "menu_a", KeyboardAction(SDLK_a),
+                     [=](const Event& evt) { this->triggered.push_back("menu_a"); } );
+
+  EXPECT_TRUE( this->input_mapper.insert("game", game_state, true) );
+  EXPECT_TRUE( this->input_mapper.insert("menu", menu_state, false) );
+
+  this->push_key(SDLK_a);
+  this->push_key(SDLK_c);
+  this->push_key(SDLK_a, InputState::RELEASED);
+
+  ASSERT_EQ(2, this->triggered.size() );
+  EXPECT_EQ("a", this->triggered[0]);
+  EXPECT_EQ("a_up", this->triggered[1]);
+
+  // Activating a state takes effect on the next event
+  this->triggered.clear();
+  EXPECT_TRUE( this->input_mapper.activate_only("menu") );
+  this->push_key(SDLK_a);
+  this->push_key(SDLK_b);
+
+  ASSERT_EQ(1, this->triggered.size() );
+  EXPECT_EQ("menu_a", this->triggered[0]);
+
+  this->triggered.clear();
+  this->input_mapper.disable();
+  this->push_key(SDLK_a);
+  EXPECT_EQ(0, this->triggered.size() );
+}
+
+TEST_F(InputStateMapperTest, DispatchOrder)
+{
+  InputActionMapper state1;
+  InputActionMapper state2;
+
+  // Actions are triggered in the order of their state keys, then by their
+  // action keys
+  state1.insert( "b", KeyboardAction(SDLK_SPACE),
+                 [=](const Event& evt) { this->triggered.push_back("state1_b"); } );
+  state1.insert( "a", KeyboardAction(SDLK_SPACE),
+                 [=](const Event& evt) { this->triggered.push_back("state1_a"); } );
+  state2.insert( "a", KeyboardAction(SDLK_SPACE),
+                 [=](const Event& evt) { this->triggered.push_back("state2_a"); } );
+
+  EXPECT_TRUE( this->input_mapper.insert("state2", state2, true) );
+  EXPECT_TRUE( this->input_mapper.insert("state1", state1, true) );
+
+  this->push_key(SDLK_SPACE);
+
+  ASSERT_EQ(3, this->triggered.size() );
+  EXPECT_EQ("state1_a", this->triggered[0]);
+  EXPECT_EQ("state1_b", this->triggered[1]);
+  EXPECT_EQ("state2_a", this->triggered[2]);
+}
+
+/// \remarks Toggling between two states bound to the same input must not
+/// trigger the newly activated state's action with the same event.
+TEST_F(InputStateMapperTest, StateChangeStopsDispatch)
+{
+  InputActionMapper game_state;
+  InputActionMapper pause_state;
+
+  game_state.insert( "pause", KeyboardAction(SDLK_ESCAPE),
+    [=](const Event& evt) {
+      this->triggered.push_back("pause");
+      this->input_mapper.activate_only("pause");
+    });
+
+  pause_state.insert( "resume", KeyboardAction(SDLK_ESCAPE),
+    [=](const Event& evt) {
+      this->triggered.push_back("resume");
+      this->input_mapper.activate_only("game");
+    });
+
+  EXPECT_TRUE( this->input_mapper.insert("game", game_state, true) );
+  EXPECT_TRUE( this->input_mapper.insert("pause", pause_state, false) );
+
+  this->push_key(SDLK_ESCAPE);
+  ASSERT_EQ(1, this->triggered.size() );
+  EXPECT_EQ("pause", this->triggered[0]);
+  EXPECT_TRUE( this->input_mapper.active("pause") );
+  EXPECT_FALSE( this->input_mapper.active("game") );
+
+  this->push_key(SDLK_ESCAPE);
+  ASSERT_EQ(2, this->triggered.size() );
+  EXPECT_EQ("resume", this->triggered[1]);
+  EXPECT_TRUE( this->input_mapper.active("game") );
+}
+
+TEST_F(InputStateMapperTest, EraseStateDuringDispatch)
+{
+  InputActionMapper state;
+
+  state.insert( "quit", KeyboardAction(SDLK_q),
+    [=](const Event& evt) {
+      this->triggered.push_back("quit");
+
+      // The action that is being triggered is destroyed along with its state
+      this->input_mapper.erase("state");
+    });
+
+  EXPECT_TRUE( this->input_mapper.insert("state", state, true) );
+
+  this->push_key(SDLK_q);
+  this->push_key(SDLK_q);
+
+  ASSERT_EQ(1, this->triggered.size() );
+  EXPECT_EQ("quit", this->triggered[0]);
+  EXPECT_FALSE( this->input_mapper.erase("state") );
+
+  // Re-inserting a state updates the dispatch index
+  EXPECT_TRUE( this->input_mapper.insert("state", state, true) );
+  EXPECT_TRUE( this->input_mapper.erase("state") );
+  this->push_key(SDLK_q);
+  EXPECT_EQ(1, this->triggered.size() );
+
+  EXPECT_TRUE( this->input_mapper.insert("state", state, true) );
+  this->input_mapper.clear();
+  this->push_key(SDLK_q);
+  EXPECT_EQ(1, this->triggered.size() );
+}
+
+} // namespace nom
+
+int main( int argc, char** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+
+  return RUN_ALL_TESTS();
+}